@@ -0,0 +1,1212 @@
+#include "hooking/actor_registry.h"
+#include "hooking/cutscene_settings.h"
+#include "hooking/motion_trace.h"
+#include "hooking/name_lists.h"
+#include "hooking/offline_hooks.h"
+#include "hooking/skeleton.h"
+#include "hooking/stereo_camera_frame.h"
+#include "hooking/weapon.h"
+
+// Runs the hot paths of the layer on fixed inputs, so that their cost can be compared between two builds without the game or a headset.
+// Every benchmark is timed in batches of iterations, so that reading the clock doesn't dominate paths that only take a few hundred nanoseconds.
+
+struct BenchOptions {
+    uint32_t batches = 2000;
+    uint32_t batchSize = 64;
+    std::string filter;
+    std::filesystem::path jsonPath;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    std::vector<double> iterationTimesNs; // the average of every batch
+};
+
+// results are written here so that the compiler can't drop the work that's being timed
+static volatile float s_sink = 0.0f;
+
+static double Mean(const std::vector<double>& values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    return sum / (double)values.size();
+}
+
+static double Percentile(std::vector<double> values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const size_t idx = std::min(values.size() - 1, (size_t)(percentile * (double)(values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+// calls run(iteration) with increasing iterations, so that the fixtures go through the same inputs on every run
+template <typename F>
+static BenchResult Measure(std::string name, const BenchOptions& options, F&& run) {
+    BenchResult result = { .name = std::move(name) };
+    result.iterationTimesNs.reserve(options.batches);
+
+    // warm up the caches and the branch predictors before timing anything
+    uint32_t iteration = 0;
+    for (uint32_t i = 0; i < options.batchSize * 4; i++) {
+        run(iteration++);
+    }
+
+    for (uint32_t batch = 0; batch < options.batches; batch++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < options.batchSize; i++) {
+            run(iteration++);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        result.iterationTimesNs.emplace_back(std::chrono::duration<double, std::nano>(end - start).count() / (double)options.batchSize);
+    }
+    result.iterations = (uint64_t)options.batches * options.batchSize;
+    return result;
+}
+
+// the player pose solve of hook_ModifyBoneMatrix: turn the body towards the headset, then reach both hands towards the controllers
+class SkeletonSolveFixture {
+public:
+    using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+    SkeletonSolveFixture() {
+        m_skeleton.Load(PlayerSkeleton::BONES, &PlayerSkeleton::FindBone);
+        m_rootIndex = m_skeleton.GetBoneIndex("Skl_Root");
+        m_arms[0] = { m_skeleton.GetBoneIndex("Arm_1_L"), m_skeleton.GetBoneIndex("Arm_2_L"), m_skeleton.GetBoneIndex("Wrist_L") };
+        m_arms[1] = { m_skeleton.GetBoneIndex("Arm_1_R"), m_skeleton.GetBoneIndex("Arm_2_R"), m_skeleton.GetBoneIndex("Wrist_R") };
+        m_rootPos = m_skeleton.GetLocalPos(m_rootIndex);
+    }
+
+    void Run(uint32_t iteration) {
+        // the hands move in circles in front of the body while the body slowly turns
+        const float angle = glm::radians((float)(iteration % 360));
+        const glm::fquat yaw = glm::angleAxis(angle * 0.1f, glm::vec3(0.0f, 1.0f, 0.0f));
+        m_skeleton.SetLocalMatrix(m_rootIndex, RigidPose(yaw, m_rootPos).ToMatrix34());
+        m_skeleton.UpdateWorldMatrices();
+
+        for (size_t side = 0; side < m_arms.size(); side++) {
+            const auto& [arm1, arm2, wrist] = m_arms[side];
+            const float sideSign = side == 0 ? 1.0f : -1.0f;
+            const glm::vec3 shoulderPos = m_skeleton.GetWorldMatrix(arm1)[3];
+            const glm::vec3 targetPos = shoulderPos + yaw * glm::vec3(0.1f * sideSign + 0.15f * sinf(angle), -0.25f + 0.1f * cosf(angle), 0.3f);
+            const glm::vec3 poleDir = yaw * glm::vec3(sideSign, -1.0f, -0.5f);
+            m_skeleton.SolveTwoBoneIK(arm1, arm2, wrist, targetPos, poleDir, sideSign);
+            s_sink = m_skeleton.GetWorldMatrix(wrist)[3].x;
+        }
+    }
+
+private:
+    Skeleton m_skeleton;
+    int m_rootIndex = -1;
+    std::array<std::array<int, 3>, 2> m_arms = {};
+    glm::vec3 m_rootPos = glm::vec3(0.0f);
+};
+
+// a controller that alternates between a slash and a stab every second, fed through the attack detection of one hand at the given sample rate
+class MotionAnalyserFixture {
+public:
+    explicit MotionAnalyserFixture(uint32_t sampleRate): m_samplePeriod(1'000'000'000 / sampleRate) {
+        const glm::fvec3 headsetPos = glm::fvec3(0.0f, 1.6f, 0.0f);
+        const glm::fvec3 shoulderPos = glm::fvec3(0.2f, 1.4f, 0.0f);
+
+        for (uint32_t i = 0; i < sampleRate * 2; i++) {
+            const bool isSlash = i < sampleRate;
+            const float phase = (float)(i % sampleRate) / (float)sampleRate;
+
+            glm::fquat rotation = glm::identity<glm::fquat>();
+            glm::fvec3 position = shoulderPos + glm::fvec3(0.0f, 0.0f, -0.4f);
+            glm::fvec3 linearVelocity = glm::fvec3(0.0f);
+            glm::fvec3 angularVelocity = glm::fvec3(0.0f);
+            if (isSlash) {
+                // swing down around the shoulder, fastest halfway through
+                const float speed = 10.0f * sinf(glm::pi<float>() * phase);
+                const float angle = 10.0f / glm::pi<float>() * (1.0f - cosf(glm::pi<float>() * phase));
+                rotation = glm::angleAxis(-angle, glm::fvec3(1.0f, 0.0f, 0.0f));
+                angularVelocity = rotation * glm::fvec3(-speed, 0.0f, 0.0f);
+                position = shoulderPos + rotation * glm::fvec3(0.0f, 0.0f, -0.4f);
+                linearVelocity = glm::cross(angularVelocity, position - shoulderPos);
+            }
+            else {
+                // thrust forward and pull back
+                const float speed = 2.0f * sinf(glm::two_pi<float>() * phase);
+                const float distance = 1.0f / glm::pi<float>() * (1.0f - cosf(glm::two_pi<float>() * phase));
+                position += glm::fvec3(0.0f, 0.0f, -distance);
+                linearVelocity = glm::fvec3(0.0f, 0.0f, -speed);
+            }
+
+            m_samples.push_back({
+                .handPose = { { rotation.x, rotation.y, rotation.z, rotation.w }, { position.x, position.y, position.z } },
+                .linearVelocity = { linearVelocity.x, linearVelocity.y, linearVelocity.z },
+                .angularVelocity = { angularVelocity.x, angularVelocity.y, angularVelocity.z },
+                .headsetPose = { { 0.0f, 0.0f, 0.0f, 1.0f }, { headsetPos.x, headsetPos.y, headsetPos.z } }
+            });
+        }
+    }
+
+    void Run(uint32_t iteration) {
+        const MotionTrace::Sample& sample = m_samples[iteration % m_samples.size()];
+        m_analyser.Update(MotionTrace::GetHandLocation(sample), MotionTrace::GetHandVelocity(sample), MotionTrace::GetHeadsetMatrix(sample), (XrTime)(iteration + 1) * m_samplePeriod);
+        s_sink = m_analyser.GetAttackStrength();
+    }
+
+private:
+    XrTime m_samplePeriod;
+    std::vector<MotionTrace::Sample> m_samples;
+    WeaponMotionAnalyser m_analyser;
+};
+
+// one pass of hook_UpdateActorList over a busy area, with a few actors despawning and spawning at other addresses in every pass,
+// followed by the diff that the entity debugger collects
+class ActorRegistryPassFixture {
+public:
+    static constexpr uint32_t ACTOR_COUNT = 1200;
+    static constexpr uint32_t NAME_COUNT = 40;
+    static constexpr uint32_t ACTOR_LIFETIME = 128; // passes before an actor is replaced, staggered so that ~9 are replaced per pass
+
+    ActorRegistryPassFixture() {
+        static constexpr std::array<const char*, 5> PREFIXES = { "Obj_", "Enemy_", "Npc_", "Weapon_", "Item_" };
+        for (uint32_t i = 0; i < NAME_COUNT; i++) {
+            m_names.emplace_back(std::format("{}Fixture_{:03}", PREFIXES[i % PREFIXES.size()], i));
+        }
+    }
+
+    void Run(uint32_t iteration) {
+        m_registry.BeginPass();
+        for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+            const uint32_t respawns = (iteration + i) / ACTOR_LIFETIME;
+            const uint32_t actorPtr = 0x30000000 + i * 0x1000 + (respawns % 2) * 0x800;
+            m_registry.Touch(actorPtr, m_names[(i + respawns) % NAME_COUNT].c_str());
+        }
+        m_registry.EndPass();
+
+        m_registry.CollectDiff(m_diff);
+        s_sink = (float)(m_diff.added.size() + m_diff.removed.size());
+    }
+
+private:
+    std::vector<std::string> m_names;
+    ActorRegistry m_registry;
+    ActorRegistry::Diff m_diff;
+};
+
+// the camera hooks of one frame: new views are located once per frame, then the game requests the camera projection of both eyes
+// for its layers, shadows and the light prepass, with a few different near and far planes
+class StereoProjectionFixture {
+public:
+    static constexpr uint32_t PROJECTIONS_PER_EYE = 24;
+    static constexpr std::array<std::array<float, 2>, 3> CLIP_PLANES = { { { 0.25f, 500.0f }, { 0.1f, 25000.0f }, { 1.0f, 100.0f } } };
+
+    // provides the two calls that StereoCameraFrame::Sync makes on RND_Renderer
+    struct Renderer {
+        uint64_t viewsGeneration = 0;
+        std::array<XrView, 2> views = {};
+
+        uint64_t GetViewsGeneration() const { return viewsGeneration; }
+        std::optional<std::array<XrView, 2>> GetPoses() const { return views; }
+    };
+
+    StereoProjectionFixture() {
+        m_renderer.views[0] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { -0.032f, 1.6f, 0.0f } }, { -0.9f, 0.7f, 0.8f, -0.85f } };
+        m_renderer.views[1] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.032f, 1.6f, 0.0f } }, { -0.7f, 0.9f, 0.8f, -0.85f } };
+    }
+
+    void Run(uint32_t iteration) {
+        m_renderer.viewsGeneration = iteration + 1;
+
+        for (size_t side = 0; side < 2; side++) {
+            for (uint32_t i = 0; i < PROJECTIONS_PER_EYE; i++) {
+                const auto& [zNear, zFar] = CLIP_PLANES[i % CLIP_PLANES.size()];
+                m_projection.zNear = zNear;
+                m_projection.zFar = zFar;
+                m_projection.deviceZScale = 1.0f;
+                m_projection.deviceZOffset = 0.0f;
+                m_frame.Sync(m_renderer);
+                m_frame.ApplyTo(side, m_projection);
+            }
+        }
+        s_sink = m_projection.matrix.getLE()[0][0];
+    }
+
+private:
+    Renderer m_renderer;
+    StereoCameraFrame m_frame;
+    BESeadPerspectiveProjection m_projection = {};
+};
+
+// runs work on other threads for as long as it exists, for the paths that the game's threads and the present thread share
+class BackgroundLoad {
+public:
+    template <typename F>
+    BackgroundLoad(uint32_t threadCount, F work) {
+        for (uint32_t i = 0; i < threadCount; i++) {
+            m_threads.emplace_back([this, work] {
+                while (!m_stop.load(std::memory_order_relaxed)) {
+                    work();
+                }
+            });
+        }
+    }
+    ~BackgroundLoad() {
+        m_stop.store(true, std::memory_order_relaxed);
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+private:
+    std::atomic_bool m_stop = false;
+    std::vector<std::thread> m_threads;
+};
+
+// times every call on its own while threadCount threads call log(thread, call) at the same time, for the latency that the callers see
+template <typename F>
+static BenchResult MeasureCallerLatency(std::string name, const BenchOptions& options, uint32_t threadCount, F&& log) {
+    const uint32_t callsPerThread = std::max(1u, options.batches * options.batchSize / threadCount);
+    std::vector<std::vector<double>> threadTimesNs(threadCount);
+    std::atomic_uint32_t readyThreads = 0;
+
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < threadCount; thread++) {
+        threads.emplace_back([&, thread] {
+            std::vector<double>& timesNs = threadTimesNs[thread];
+            timesNs.reserve(callsPerThread);
+            readyThreads++;
+            while (readyThreads.load() < threadCount) {
+                std::this_thread::yield();
+            }
+
+            for (uint32_t call = 0; call < callsPerThread; call++) {
+                const auto start = std::chrono::steady_clock::now();
+                log(thread, call);
+                const auto end = std::chrono::steady_clock::now();
+                timesNs.emplace_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    BenchResult result = { .name = std::move(name) };
+    for (const std::vector<double>& timesNs : threadTimesNs) {
+        result.iterationTimesNs.insert(result.iterationTimesNs.end(), timesNs.begin(), timesNs.end());
+    }
+    result.iterations = result.iterationTimesNs.size();
+    return result;
+}
+
+// how Log::print worked before the messages were queued: the message is formatted on the calling thread, then written to the log
+// file and the console under a lock and flushed right away. The console is a second file here, since the bench prints its results there.
+class SynchronousLog {
+public:
+    SynchronousLog(const std::filesystem::path& logPath, const std::filesystem::path& consolePath): m_logFile(logPath, std::ios::out | std::ios::trunc), m_console(consolePath, std::ios::out | std::ios::trunc) {}
+
+    template <class... Args>
+    void Print(const char* format, Args&&... args) {
+        const std::string message = std::vformat(format, std::make_format_args(args...));
+        std::lock_guard lock(m_mutex);
+        const std::string line = message + "\n";
+        m_logFile << line;
+        m_logFile.flush();
+        m_console << message << std::endl;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::ofstream m_logFile;
+    std::ofstream m_console;
+};
+
+// where the logging thread writes to in the caller latency benchmark, so that both loggers write and flush a file
+static std::ofstream s_logOutput;
+
+// the round trip of a matrix that a hook reads from guest memory, changes and writes back
+class BEMatrixConversionFixture {
+public:
+    static constexpr uint32_t MATRIX_COUNT = 64;
+
+    BEMatrixConversionFixture() {
+        for (uint32_t i = 0; i < MATRIX_COUNT; i++) {
+            const glm::fquat rotation = glm::angleAxis(glm::radians((float)i * 5.0f), glm::normalize(glm::fvec3(1.0f, 2.0f, 3.0f)));
+            m_matrices[i].setLEMatrix(RigidPose(rotation, glm::fvec3((float)i, 1.6f, -(float)i)).ToMatrix34());
+        }
+    }
+
+    void Run(uint32_t iteration) {
+        BEMatrix34& matrix = m_matrices[iteration % MATRIX_COUNT];
+        glm::fmat4x3 leMatrix = matrix.getLEMatrix();
+        leMatrix[3] += glm::fvec3(0.001f);
+        matrix.setLEMatrix(leMatrix);
+        s_sink = leMatrix[3].x;
+    }
+
+private:
+    std::array<BEMatrix34, MATRIX_COUNT> m_matrices = {};
+};
+
+// the parts of the player pose solve on their own: the world matrices of the whole skeleton, and the IK of one arm
+class SkeletonPartsFixture {
+public:
+    using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+    SkeletonPartsFixture() {
+        m_skeleton.Load(PlayerSkeleton::BONES, &PlayerSkeleton::FindBone);
+        m_rootIndex = m_skeleton.GetBoneIndex("Skl_Root");
+        m_rootPos = m_skeleton.GetLocalPos(m_rootIndex);
+        m_arm = { m_skeleton.GetBoneIndex("Arm_1_R"), m_skeleton.GetBoneIndex("Arm_2_R"), m_skeleton.GetBoneIndex("Wrist_R") };
+        m_skeleton.UpdateWorldMatrices();
+        m_shoulderPos = m_skeleton.GetWorldMatrix(m_arm[0])[3];
+    }
+
+    // the root turns, so that every bone has to be updated
+    void UpdateWorldMatrices(uint32_t iteration) {
+        const glm::fquat yaw = glm::angleAxis(glm::radians((float)(iteration % 360)), glm::vec3(0.0f, 1.0f, 0.0f));
+        m_skeleton.SetLocalMatrix(m_rootIndex, RigidPose(yaw, m_rootPos).ToMatrix34());
+        m_skeleton.UpdateWorldMatrices();
+        s_sink = m_skeleton.GetWorldMatrix(m_arm[2])[3].x;
+    }
+
+    void SolveTwoBoneIK(uint32_t iteration) {
+        const float angle = glm::radians((float)(iteration % 360));
+        const glm::vec3 targetPos = m_shoulderPos + glm::vec3(-0.1f + 0.15f * sinf(angle), -0.25f + 0.1f * cosf(angle), 0.3f);
+        m_skeleton.SolveTwoBoneIK(m_arm[0], m_arm[1], m_arm[2], targetPos, glm::vec3(-1.0f, -1.0f, -0.5f), -1.0f);
+        s_sink = m_skeleton.GetWorldMatrix(m_arm[2])[3].x;
+    }
+
+private:
+    Skeleton m_skeleton;
+    int m_rootIndex = -1;
+    glm::vec3 m_rootPos = glm::vec3(0.0f);
+    std::array<int, 3> m_arm = {};
+    glm::vec3 m_shoulderPos = glm::vec3(0.0f);
+};
+
+// the lookup of an event's first-person settings when a cutscene starts, for every event in the table and as many unknown ones
+class EventSettingsLookupFixture {
+public:
+    EventSettingsLookupFixture() {
+        for (std::string_view eventName : CutsceneSettings::EVENT_NAME_LIST) {
+            m_eventNames.emplace_back(eventName);
+            m_eventNames.emplace_back(std::string(eventName) + "_Unknown");
+        }
+    }
+
+    void Run(uint32_t iteration) {
+        s_sink = CemuHooks::FindEventSettings(m_eventNames[iteration % m_eventNames.size()]).has_value() ? 1.0f : 0.0f;
+    }
+
+private:
+    std::vector<std::string> m_eventNames;
+};
+
+// looks up names of which half are listed and half are one character off, through the NameSets that the hooks use and through
+// the way that the hooks looked them up before, which copied the name into a std::string and compared it with every listed name
+class NameListLookupFixture {
+public:
+    NameListLookupFixture() {
+        for (std::string_view name : NameLists::NON_DROPPABLE_ITEM_NAMES) {
+            AddName(m_itemNames, name);
+        }
+        for (std::string_view name : NameLists::ACTOR_JOB_NAME_LIST) {
+            AddName(m_jobNames, name);
+        }
+    }
+
+    void FindItem(uint32_t iteration) {
+        s_sink = NameLists::NON_DROPPABLE_ITEMS.contains(m_itemNames[iteration % m_itemNames.size()]) ? 1.0f : 0.0f;
+    }
+    void ScanItems(uint32_t iteration) {
+        s_sink = IsListed(m_itemNames[iteration % m_itemNames.size()], NameLists::NON_DROPPABLE_ITEM_NAMES) ? 1.0f : 0.0f;
+    }
+
+    void FindJob(uint32_t iteration) {
+        s_sink = (float)NameLists::FindActorJob(m_jobNames[iteration % m_jobNames.size()]);
+    }
+    void ScanJobs(uint32_t iteration) {
+        s_sink = IsListed(m_jobNames[iteration % m_jobNames.size()], NameLists::ACTOR_JOB_NAME_LIST) ? 1.0f : 0.0f;
+    }
+
+private:
+    static void AddName(std::vector<std::string>& names, std::string_view name) {
+        names.emplace_back(name);
+        std::string miss(name);
+        miss.back()++;
+        names.emplace_back(std::move(miss));
+    }
+
+    template <size_t N>
+    static bool IsListed(std::string name, const std::array<std::string_view, N>& list) {
+        for (std::string_view listed : list) {
+            if (name == listed) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::string> m_itemNames;
+    std::vector<std::string> m_jobNames;
+};
+
+// what initCutsceneDefaultSettings does once at startup with the graphic pack's table, unchanged by the user: reading it for the entries
+// that differ from the compiled table, and the way it was done before the table was compiled, which parsed every entry with substr()
+// into a map of std::strings that hook_GetEventName looked the events up in
+class CutsceneTableStartupFixture {
+public:
+    CutsceneTableStartupFixture() {
+        for (std::string_view entry : CUTSCENE_SETTINGS_TABLE) {
+            m_guestTable.append(entry);
+            m_guestTable.push_back('\0');
+        }
+        m_guestTable.push_back('\0');
+    }
+
+    void ReadOverrides(uint32_t iteration) {
+        CutsceneSettings::Overrides overrides;
+        s_sink = (float)CutsceneSettings::ReadOverrides(m_guestTable.c_str(), overrides, [](std::string_view flag) {});
+    }
+
+    void ParseIntoMap(uint32_t iteration) {
+        std::unordered_map<std::string, HybridEventSettings> eventSettings;
+        const char* currPtr = m_guestTable.c_str();
+        while (true) {
+            const std::string line(currPtr);
+            if (line.empty()) {
+                break;
+            }
+            size_t commaPos = line.find(',');
+            if (commaPos != std::string::npos) {
+                HybridEventSettings entry = {};
+                std::string settingsStr = line.substr(commaPos + 1);
+                std::string eventName = line.substr(0, commaPos);
+                size_t pos = 0;
+                while ((pos = settingsStr.find(',')) != std::string::npos) {
+                    std::string setting = settingsStr.substr(0, pos);
+                    CutsceneSettings::ApplyFlag(setting, entry);
+                    settingsStr.erase(0, pos + 1);
+                }
+                CutsceneSettings::ApplyFlag(settingsStr, entry);
+                eventSettings.insert_or_assign(eventName, entry);
+            }
+            currPtr += line.length() + 1;
+        }
+        s_sink = (float)eventSettings.size();
+    }
+
+private:
+    std::string m_guestTable;
+};
+
+// the player skeleton that CemuHooks sets up once at startup: loaded from the compiled bone table, and parsed from its data file with
+// stringstreams the way it was done before the table was compiled, into a map of the bone names and the same matrices
+class SkeletonStartupFixture {
+public:
+    using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+    void Load(uint32_t iteration) {
+        Skeleton skeleton;
+        skeleton.Load(PlayerSkeleton::BONES, &PlayerSkeleton::FindBone);
+        s_sink = skeleton.GetWorldMatrix(PlayerSkeleton::BONE_COUNT - 1)[3].x;
+    }
+
+    void ParseWithStreams(uint32_t iteration) {
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> boneNameMap;
+        std::vector<int> parentIndices;
+        std::vector<glm::mat4> localMatrices;
+        std::vector<glm::mat4> worldMatrices;
+
+        std::stringstream ss{ std::string(SkeletonSources::GameROMPlayer) };
+        std::string line;
+        std::vector<std::pair<int, int>> parentStack;
+        parentStack.push_back({ -1, -1 });
+        while (std::getline(ss, line)) {
+            int indent = 0;
+            while (indent < line.length() && line[indent] == ' ') indent++;
+
+            size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos) continue;
+
+            std::string content = line.substr(start);
+            size_t p1 = content.find('|');
+            if (p1 == std::string::npos) continue;
+
+            std::string currentName = content.substr(0, p1);
+            size_t lastChar = currentName.find_last_not_of(' ');
+            if (lastChar != std::string::npos) currentName = currentName.substr(0, lastChar + 1);
+
+            size_t p2 = content.find('|', p1 + 1);
+            if (p2 == std::string::npos) continue;
+
+            glm::vec3 pos, rotEuler;
+            std::stringstream ssPos(content.substr(p1 + 1, p2 - p1 - 1));
+            ssPos >> pos.x >> pos.y >> pos.z;
+            std::stringstream ssRot(content.substr(p2 + 1));
+            ssRot >> rotEuler.x >> rotEuler.y >> rotEuler.z;
+
+            while (parentStack.size() > 1 && parentStack.back().first >= indent) {
+                parentStack.pop_back();
+            }
+
+            const int newIndex = (int)names.size();
+            names.emplace_back(currentName);
+            boneNameMap[currentName] = newIndex;
+            parentIndices.emplace_back(parentStack.back().second);
+            localMatrices.emplace_back(glm::translate(glm::identity<glm::mat4>(), pos) * glm::eulerAngleZYX(rotEuler.x, rotEuler.y, rotEuler.z));
+            worldMatrices.emplace_back(parentStack.back().second == -1 ? localMatrices.back() : worldMatrices[parentStack.back().second] * localMatrices.back());
+            parentStack.push_back({ indent, newIndex });
+        }
+        s_sink = worldMatrices.back()[3].x;
+    }
+};
+
+// the guest memory and headset state of one frame of first-person gameplay, which the hook benchmarks call the hooks against.
+// The guest memory is a GuestArena with the structures from game_structs.h that the hooks read, the headset and controllers are set
+// on the OfflineHookHost at the start of every frame.
+class GuestFrameFixture {
+public:
+    using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+    static constexpr uint32_t ACTOR_COUNT = 48;
+    static constexpr std::array<std::string_view, 7> JOB_NAMES = { "job0_1", "job0_2", "job1_1", "job1_2", "job2_1_ragdoll_related", "job2_2", "job4" };
+    // VPADStatus is private to controls.cpp, hook_InjectXRInput reads and writes 0xAC bytes of it
+    static constexpr uint32_t VPAD_STATUS_SIZE = 0xAC;
+
+    struct Bone {
+        uint32_t name;
+        uint32_t matrix;
+        uint32_t scale;
+    };
+
+    explicit GuestFrameFixture(OfflineHooks& hooks): m_hooks(hooks) {
+        GuestArena& arena = hooks.GetArena();
+
+        // first-person gameplay without a cutscene, and an empty list of cutscene settings that the graphic pack changed
+        data_VRSettingsIn settings = {};
+        settings.cameraModeSetting = 1;
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[5] = arena.AllocateValue(settings);
+        hCPU.gpr[6] = arena.AllocateString("");
+        hooks.Call("hook_UpdateSettings", hCPU);
+
+        // the player and the other actors are registered through the actor list, the vtables only have to differ between actor names
+        for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+            ActorWiiU actor = {};
+            actor.vtable = 0x10100000 + i * 0x100;
+            actor.name.c_str = arena.AllocateString(i == 0 ? "GameROMPlayer" : std::format("Enemy_Fixture_{:03}", i));
+            actor.mtx.setLEMatrix(glm::fmat4x3(glm::translate(glm::identity<glm::fmat4>(), glm::fvec3(0.0f, 0.0f, -(float)i))));
+            m_actors[i] = arena.AllocateValue(actor);
+
+            hCPU = {};
+            hCPU.gpr[5] = i;
+            hCPU.gpr[6] = m_actors[i];
+            hCPU.gpr[7] = ACTOR_COUNT;
+            hooks.Call("hook_UpdateActorList", hCPU);
+        }
+        for (size_t i = 0; i < JOB_NAMES.size(); i++) {
+            m_jobNames[i] = arena.AllocateString(JOB_NAMES[i]);
+        }
+
+        // the player model with a matrix and a scale for every bone of its skeleton
+        sead::FixedSafeString100 modelName = {};
+        m_model = arena.Allocate(0x128 + sizeof(modelName));
+        modelName.c_str = m_model + 0x128 + offsetof(sead::FixedSafeString100, data);
+        std::ranges::copy(std::string_view("GameROMPlayer"), modelName.data);
+        arena.WriteValue(m_model + 0x128, modelName);
+
+        BEMatrix34 boneMatrix;
+        boneMatrix.setLEMatrix(glm::fmat4x3(glm::identity<glm::fmat4>()));
+        BEVec3 boneScale;
+        boneScale = glm::fvec3(1.0f);
+        for (const SkeletonData::BoneData& bone : PlayerSkeleton::BONES) {
+            m_bones.push_back({
+                .name = arena.AllocateString(bone.name),
+                .matrix = arena.AllocateValue(boneMatrix),
+                .scale = arena.AllocateValue(boneScale)
+            });
+        }
+
+        m_vpadStatus = arena.Allocate(VPAD_STATUS_SIZE);
+
+        m_input.inGame.in_game = true;
+        for (XrActionStatePose& pose : m_input.inGame.pose) {
+            pose.isActive = XR_TRUE;
+        }
+        m_views[0] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { -0.032f, 1.6f, 0.0f } }, { -0.9f, 0.7f, 0.8f, -0.85f } };
+        m_views[1] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.032f, 1.6f, 0.0f } }, { -0.7f, 0.9f, 0.8f, -0.85f } };
+    }
+
+    HookProfiler::HookFunction Find(std::string_view name) const {
+        HookProfiler::HookFunction hook = m_hooks.Find(std::string(name));
+        checkAssert(hook != nullptr, std::format("{} isn't registered by CemuHooks!", name).c_str());
+        return hook;
+    }
+
+    // the hands move in circles in front of the headset, like in SkeletonSolveFixture, and the headset locates new views
+    void BeginFrame(uint32_t iteration) {
+        const float angle = glm::radians((float)(iteration % 360));
+        for (uint32_t side = 0; side < 2; side++) {
+            const float sideSign = side == 0 ? -1.0f : 1.0f;
+            m_input.inGame.poseLocation[side].pose = { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.2f * sideSign + 0.15f * sinf(angle), 1.2f + 0.1f * cosf(angle), -0.3f } };
+        }
+        m_hooks.GetHost().SetInput(m_input);
+        m_hooks.GetHost().SetViews(m_views);
+    }
+
+    // returns whether the player pose was solved in this frame
+    bool EndFrame(uint32_t iteration) {
+        const bool solvedPlayerPose = m_hooks.GetHost().GetFrameState(iteration).solvedPlayerPose;
+        m_hooks.GetHost().EndFrame();
+        return solvedPlayerPose;
+    }
+
+    // the game poses every bone of the player model once per eye, the pose is only solved by the first call of a frame
+    void PosePlayerModel(HookProfiler::HookFunction modifyBoneMatrix, uint32_t frameCounter) const {
+        for (uint32_t i = 0; i < m_bones.size(); i++) {
+            PPCInterpreter_t hCPU = {};
+            hCPU.gpr[3] = m_model;
+            hCPU.gpr[4] = m_bones[i].matrix;
+            hCPU.gpr[5] = m_bones[i].scale;
+            hCPU.gpr[6] = m_bones[i].name;
+            hCPU.gpr[7] = i;
+            hCPU.gpr[8] = frameCounter;
+            modifyBoneMatrix(&hCPU);
+        }
+    }
+
+    const std::array<uint32_t, ACTOR_COUNT>& GetActors() const { return m_actors; }
+    const std::array<uint32_t, JOB_NAMES.size()>& GetJobNames() const { return m_jobNames; }
+    uint32_t GetVpadStatus() const { return m_vpadStatus; }
+
+private:
+    OfflineHooks& m_hooks;
+    std::array<uint32_t, ACTOR_COUNT> m_actors = {};
+    std::array<uint32_t, JOB_NAMES.size()> m_jobNames = {};
+    uint32_t m_model = 0;
+    std::vector<Bone> m_bones;
+    uint32_t m_vpadStatus = 0;
+    InputState m_input = {};
+    std::array<XrView, 2> m_views = {};
+};
+
+// a hook that does as little as the cheapest hooks do, called through a function pointer like Cemu calls the registered hooks,
+// either directly, through HookProfiler::Profiled or through HookProfiler::Captured, so that the differences are what the hook profiler
+// and the capture check add to every hook call
+static void FakeHook(PPCInterpreter_t* hCPU) {
+    hCPU->instructionPointer = hCPU->sprNew.LR;
+    hCPU->gpr[3] = hCPU->gpr[3] + 1;
+}
+
+class HookCallFixture {
+public:
+    HookCallFixture() {
+        HookProfiler::Register<&FakeHook>("bench_FakeHook");
+        m_hCPU.sprNew.LR = 0x02000000;
+    }
+
+    void CallDirect(uint32_t iteration) {
+        m_direct(&m_hCPU);
+        s_sink = (float)m_hCPU.gpr[3];
+    }
+
+    void CallProfiled(uint32_t iteration) {
+        m_profiled(&m_hCPU);
+        s_sink = (float)m_hCPU.gpr[3];
+    }
+
+    void CallCaptured(uint32_t iteration) {
+        m_captured(&m_hCPU);
+        s_sink = (float)m_hCPU.gpr[3];
+    }
+
+private:
+    PPCInterpreter_t m_hCPU = {};
+    // volatile, so that the calls can't be inlined
+    HookProfiler::HookFunction volatile m_direct = &FakeHook;
+    HookProfiler::HookFunction volatile m_profiled = &HookProfiler::Profiled<&FakeHook>;
+    HookProfiler::HookFunction volatile m_captured = &HookProfiler::Captured<&FakeHook>;
+};
+
+// hook_RouteActorJob on its own, for every actor and job of the frame and a job that isn't routed, alternating between the eyes
+class RouteActorJobFixture {
+public:
+    RouteActorJobFixture(GuestFrameFixture& frame, OfflineHooks& hooks): m_frame(frame), m_routeActorJob(frame.Find("hook_RouteActorJob")) {
+        std::ranges::copy(frame.GetJobNames(), m_jobNames.begin());
+        m_jobNames.back() = hooks.GetArena().AllocateString("job3");
+    }
+
+    void Run(uint32_t iteration) {
+        const auto& actors = m_frame.GetActors();
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[3] = actors[(iteration / (uint32_t)m_jobNames.size()) % actors.size()];
+        hCPU.gpr[4] = m_jobNames[iteration % m_jobNames.size()];
+        hCPU.gpr[5] = (iteration / (uint32_t)(m_jobNames.size() * actors.size())) & 1;
+        m_routeActorJob(&hCPU);
+        s_sink = (float)hCPU.gpr[3];
+    }
+
+private:
+    GuestFrameFixture& m_frame;
+    HookProfiler::HookFunction m_routeActorJob;
+    std::array<uint32_t, GuestFrameFixture::JOB_NAMES.size() + 1> m_jobNames = {};
+};
+
+// the player check of hook_RouteActorJob and hook_ChangeWeaponMtx, through the vtable cache and like it was done before the cache,
+// by copying the whole actor and comparing its name, for actors whose name is stored in the actor like the game's
+class ActorClassFixture {
+public:
+    static constexpr uint32_t ACTOR_COUNT = 48;
+
+    explicit ActorClassFixture(OfflineHooks& hooks) {
+        GuestArena& arena = hooks.GetArena();
+        for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+            const std::string name = i == 0 ? "GameROMPlayer" : std::format("Enemy_Fixture_{:03}", i);
+            ActorWiiU actor = {};
+            actor.vtable = 0x10200000 + i * 0x100;
+            std::ranges::copy(name, actor.name.data);
+            m_actors[i] = arena.AllocateValue(actor);
+            actor.name.c_str = m_actors[i] + offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, data);
+            arena.WriteValue(m_actors[i], actor);
+
+            // the first check of a vtable falls back to the name and fills the cache
+            CemuHooks::GetActorClass(m_actors[i]);
+        }
+    }
+
+    void FindCached(uint32_t iteration) {
+        s_sink = (float)(CemuHooks::GetActorClass(m_actors[iteration % ACTOR_COUNT]) == ActorClass::PLAYER);
+    }
+
+    void CompareName(uint32_t iteration) {
+        ActorWiiU actor;
+        CemuHooks::readMemory(m_actors[iteration % ACTOR_COUNT], &actor);
+        s_sink = (float)(actor.name.getLE() == "GameROMPlayer");
+    }
+
+private:
+    std::array<uint32_t, ACTOR_COUNT> m_actors = {};
+};
+
+// hook_ChangeWeaponMtx for the weapons in both hands of the player while both drop buttons are held, which checks if the weapon
+// can be dropped. The weapons are ones that can't be dropped, arrows and ones whose names only differ slightly from those.
+class ChangeWeaponMtxFixture {
+public:
+    static constexpr std::array<std::string_view, 8> WEAPON_NAMES = {
+        "Weapon_Sword_070", "Weapon_Sword_071", "Weapon_Sword_502", "Weapon_Sword_50",
+        "Obj_ArrowNormal_A_01", "Weapon_Bow_001", "Weapon_Lsword_001", "Weapon_Shield_001"
+    };
+
+    ChangeWeaponMtxFixture(GuestFrameFixture& frame, OfflineHooks& hooks): m_player(frame.GetActors()[0]), m_changeWeaponMtx(frame.Find("hook_ChangeWeaponMtx")) {
+        GuestArena& arena = hooks.GetArena();
+
+        BESeadLookAtCamera camera = {};
+        camera.pos = glm::fvec3(0.0f, 1.6f, 0.0f);
+        camera.at = glm::fvec3(0.0f, 1.6f, -1.0f);
+        camera.up = glm::fvec3(0.0f, 1.0f, 0.0f);
+        m_camera = arena.AllocateValue(camera);
+
+        BEMatrix34 matrix;
+        matrix.setLEMatrix(glm::fmat4x3(glm::identity<glm::fmat4>()));
+        m_matrices = { arena.AllocateValue(matrix), arena.AllocateValue(matrix), arena.AllocateValue(matrix) };
+        m_boneNames = { arena.AllocateString("Weapon_L"), arena.AllocateString("Weapon_R") };
+
+        for (size_t i = 0; i < WEAPON_NAMES.size(); i++) {
+            auto weapon = std::make_unique<Weapon>();
+            m_weapons[i] = arena.Allocate(sizeof(Weapon));
+            weapon->name.c_str = m_weapons[i] + offsetof(Weapon, name) + offsetof(sead::FixedSafeString40, data);
+            std::ranges::copy(WEAPON_NAMES[i], weapon->name.data);
+            arena.WriteValue(m_weapons[i], *weapon);
+        }
+
+        // the benchmark is constructed right before it runs, so the other benchmarks can't change the input in between
+        InputState input = hooks.GetHost().GetInput();
+        input.inGame.in_game = true;
+        input.inGame.drop_weapon = { true, true };
+        hooks.GetHost().SetInput(input);
+    }
+
+    void Run(uint32_t iteration) {
+        const uint32_t side = iteration & 1;
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[3] = m_player;
+        hCPU.gpr[4] = m_boneNames[side];
+        hCPU.gpr[5] = m_matrices[0];
+        hCPU.gpr[6] = m_matrices[1];
+        hCPU.gpr[7] = m_matrices[2];
+        hCPU.gpr[8] = m_weapons[(iteration / 2) % m_weapons.size()];
+        hCPU.gpr[10] = m_camera;
+        m_changeWeaponMtx(&hCPU);
+        s_sink = (float)hCPU.gpr[11];
+    }
+
+private:
+    uint32_t m_player;
+    HookProfiler::HookFunction m_changeWeaponMtx;
+    uint32_t m_camera = 0;
+    std::array<uint32_t, 3> m_matrices = {};
+    std::array<uint32_t, 2> m_boneNames = {};
+    std::array<uint32_t, WEAPON_NAMES.size()> m_weapons = {};
+};
+
+// hook_ModifyBoneMatrix for every bone of the player model for both eyes, which solves the player pose once and writes the bones
+class ModifyBoneMatrixFixture {
+public:
+    explicit ModifyBoneMatrixFixture(GuestFrameFixture& frame): m_frame(frame), m_modifyBoneMatrix(frame.Find("hook_ModifyBoneMatrix")) {}
+
+    void Run(uint32_t iteration) {
+        m_frame.BeginFrame(iteration);
+        for (uint32_t side = 0; side < 2; side++) {
+            m_frame.PosePlayerModel(m_modifyBoneMatrix, iteration);
+        }
+        s_sink = m_frame.EndFrame(iteration) ? 1.0f : 0.0f;
+    }
+
+private:
+    GuestFrameFixture& m_frame;
+    HookProfiler::HookFunction m_modifyBoneMatrix;
+};
+
+// the hooks of a whole frame in the order the graphic pack calls them, run through the functions that CemuHooks registers with Cemu:
+// the input poll, then for both eyes the camera side markers around the actor jobs of every actor and the posing of the player model.
+// Every hook is timed as well, as the frame.hook_pattern.<hook> results.
+class FrameHookPatternFixture {
+public:
+    enum Hook {
+        INJECT_XR_INPUT,
+        BEGIN_CAMERA_SIDE,
+        ROUTE_ACTOR_JOB,
+        MODIFY_BONE_MATRIX,
+        END_CAMERA_SIDE,
+        HOOK_COUNT
+    };
+    static constexpr std::array<std::string_view, HOOK_COUNT> HOOK_NAMES = { "hook_InjectXRInput", "hook_BeginCameraSide", "hook_RouteActorJob", "hook_ModifyBoneMatrix", "hook_EndCameraSide" };
+
+    explicit FrameHookPatternFixture(GuestFrameFixture& frame): m_frame(frame) {
+        for (size_t i = 0; i < HOOK_COUNT; i++) {
+            m_hooks[i] = frame.Find(HOOK_NAMES[i]);
+        }
+    }
+
+    void Run(uint32_t iteration) {
+        m_frame.BeginFrame(iteration);
+
+        std::array<double, HOOK_COUNT> frameNs = {};
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[4] = m_frame.GetVpadStatus();
+        frameNs[INJECT_XR_INPUT] += Time([&] { m_hooks[INJECT_XR_INPUT](&hCPU); });
+
+        for (uint32_t side = 0; side < 2; side++) {
+            hCPU = {};
+            hCPU.gpr[0] = side;
+            frameNs[BEGIN_CAMERA_SIDE] += Time([&] { m_hooks[BEGIN_CAMERA_SIDE](&hCPU); });
+
+            frameNs[ROUTE_ACTOR_JOB] += Time([&] {
+                for (uint32_t actor : m_frame.GetActors()) {
+                    for (uint32_t jobName : m_frame.GetJobNames()) {
+                        hCPU = {};
+                        hCPU.gpr[3] = actor;
+                        hCPU.gpr[4] = jobName;
+                        hCPU.gpr[5] = side;
+                        m_hooks[ROUTE_ACTOR_JOB](&hCPU);
+                    }
+                }
+            });
+
+            frameNs[MODIFY_BONE_MATRIX] += Time([&] { m_frame.PosePlayerModel(m_hooks[MODIFY_BONE_MATRIX], iteration); });
+
+            hCPU = {};
+            hCPU.gpr[3] = side;
+            frameNs[END_CAMERA_SIDE] += Time([&] { m_hooks[END_CAMERA_SIDE](&hCPU); });
+        }
+        s_sink = m_frame.EndFrame(iteration) ? 1.0f : 0.0f;
+
+        for (size_t i = 0; i < HOOK_COUNT; i++) {
+            m_hookFrameNs[i].emplace_back(frameNs[i]);
+        }
+    }
+
+    // the time that every hook took per frame in the timed batches of the last Measure, averaged per batch like Measure does
+    std::vector<BenchResult> GetHookResults(const std::string& name, const BenchOptions& options) const {
+        std::vector<BenchResult> results;
+        const size_t timedFrames = (size_t)options.batches * options.batchSize;
+        if (m_hookFrameNs[0].size() < timedFrames) {
+            return results;
+        }
+
+        for (size_t i = 0; i < HOOK_COUNT; i++) {
+            BenchResult& result = results.emplace_back(BenchResult{ .name = std::format("{}.{}", name, HOOK_NAMES[i]), .iterations = timedFrames });
+            const auto timed = m_hookFrameNs[i].end() - (ptrdiff_t)timedFrames;
+            for (uint32_t batch = 0; batch < options.batches; batch++) {
+                double batchNs = 0.0;
+                for (uint32_t frame = 0; frame < options.batchSize; frame++) {
+                    batchNs += timed[batch * options.batchSize + frame];
+                }
+                result.iterationTimesNs.emplace_back(batchNs / (double)options.batchSize);
+            }
+        }
+        return results;
+    }
+
+private:
+    template <typename F>
+    static double Time(F&& call) {
+        const auto start = std::chrono::steady_clock::now();
+        call();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    GuestFrameFixture& m_frame;
+    std::array<HookProfiler::HookFunction, HOOK_COUNT> m_hooks = {};
+    std::array<std::vector<double>, HOOK_COUNT> m_hookFrameNs;
+};
+
+// one line per benchmark, in the format that tools/metrics_compare reads next to its own CSV files
+static bool WriteJson(const std::filesystem::path& path, const std::vector<BenchResult>& results) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "{\"benchmarks\":[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        file << std::format("{}{{\"name\":\"{}\",\"iterations\":{},\"mean_ns\":{:.1f},\"p50_ns\":{:.1f},\"p99_ns\":{:.1f}}}\n",
+            i == 0 ? "" : ",", result.name, result.iterations, Mean(result.iterationTimesNs), Percentile(result.iterationTimesNs, 0.5), Percentile(result.iterationTimesNs, 0.99)
+        );
+    }
+    file << "]}\n";
+    return true;
+}
+
+static void PrintUsage() {
+    std::cerr <<
+        "usage: BetterVR_Bench [options]\n"
+        "  --batches <n>      number of timed batches per benchmark (default 2000)\n"
+        "  --batch-size <n>   iterations per timed batch (default 64)\n"
+        "  --filter <text>    only run the benchmarks whose name contains the text\n"
+        "  --json <path>      also write the results to a JSON file that metrics_compare can compare\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+
+    for (LogType type : Log::ALL_LOG_TYPES) {
+        Log::setLogTypeEnabled(type, false);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--batches" && i + 1 < argc) {
+            options.batches = (uint32_t)std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--batch-size" && i + 1 < argc) {
+            options.batchSize = (uint32_t)std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    auto selected = [&](std::string_view name) {
+        return name.contains(options.filter);
+    };
+    auto run = [&](std::string name, auto&& body) {
+        if (selected(name)) {
+            results.emplace_back(Measure(std::move(name), options, body));
+        }
+    };
+
+    StereoProjectionFixture stereoProjection;
+    run("camera.stereo_projections", [&](uint32_t iteration) { stereoProjection.Run(iteration); });
+
+    SkeletonSolveFixture skeletonSolve;
+    run("skeleton.solve_pose", [&](uint32_t iteration) { skeletonSolve.Run(iteration); });
+
+    MotionAnalyserFixture motionAnalyser(90);
+    run("weapon.motion_analyser_update", [&](uint32_t iteration) { motionAnalyser.Run(iteration); });
+    // the time windows hold more samples at a higher rate, the per-sample cost shouldn't grow with them
+    MotionAnalyserFixture motionAnalyser500Hz(500);
+    run("weapon.motion_analyser_update_500hz", [&](uint32_t iteration) { motionAnalyser500Hz.Run(iteration); });
+
+    ActorRegistryPassFixture actorRegistryPass;
+    run("actor_registry.pass", [&](uint32_t iteration) { actorRegistryPass.Run(iteration); });
+
+    BEMatrixConversionFixture beMatrixConversion;
+    run("be_matrix.round_trip", [&](uint32_t iteration) { beMatrixConversion.Run(iteration); });
+
+    SkeletonPartsFixture skeletonParts;
+    run("skeleton.update_world_matrices", [&](uint32_t iteration) { skeletonParts.UpdateWorldMatrices(iteration); });
+    run("skeleton.two_bone_ik", [&](uint32_t iteration) { skeletonParts.SolveTwoBoneIK(iteration); });
+
+    EventSettingsLookupFixture eventSettingsLookup;
+    run("settings.find_event_settings", [&](uint32_t iteration) { eventSettingsLookup.Run(iteration); });
+
+    NameListLookupFixture nameListLookup;
+    run("name_lists.non_droppable_items", [&](uint32_t iteration) { nameListLookup.FindItem(iteration); });
+    run("name_lists.non_droppable_items_linear", [&](uint32_t iteration) { nameListLookup.ScanItems(iteration); });
+    run("name_lists.actor_jobs", [&](uint32_t iteration) { nameListLookup.FindJob(iteration); });
+    run("name_lists.actor_jobs_linear", [&](uint32_t iteration) { nameListLookup.ScanJobs(iteration); });
+
+    // startup work only runs once and takes far longer than the hot paths, so every call is timed on its own and there are fewer of them
+    BenchOptions startupOptions = options;
+    startupOptions.batches = std::max(1u, options.batches / 10);
+    startupOptions.batchSize = 1;
+    auto runStartup = [&](std::string name, auto&& body) {
+        if (selected(name)) {
+            results.emplace_back(Measure(std::move(name), startupOptions, body));
+        }
+    };
+
+    SkeletonStartupFixture skeletonStartup;
+    runStartup("startup.skeleton_load_compiled", [&](uint32_t iteration) { skeletonStartup.Load(iteration); });
+    runStartup("startup.skeleton_parse_with_streams", [&](uint32_t iteration) { skeletonStartup.ParseWithStreams(iteration); });
+
+    CutsceneTableStartupFixture cutsceneTableStartup;
+    runStartup("startup.cutscene_table_overrides", [&](uint32_t iteration) { cutsceneTableStartup.ReadOverrides(iteration); });
+    runStartup("startup.cutscene_table_parse_into_map", [&](uint32_t iteration) { cutsceneTableStartup.ParseIntoMap(iteration); });
+
+    // the hooks on the game's threads read the settings while the present thread reads them for the overlays
+    run("settings.get_settings", [&](uint32_t iteration) { s_sink = (float)CemuHooks::GetSettings().cameraModeSetting.getLE(); });
+    if (selected("settings.get_settings_contended")) {
+        BackgroundLoad readers(2, [] { CemuHooks::GetSettings(); });
+        run("settings.get_settings_contended", [&](uint32_t iteration) { s_sink = (float)CemuHooks::GetSettings().cameraModeSetting.getLE(); });
+    }
+
+    // the controller state is stored by the present thread and read by the hooks, like OpenXR::m_input
+    std::atomic<InputState> inputState = InputState{};
+    run("input_state.atomic_load_store", [&](uint32_t iteration) {
+        InputState input = inputState.load();
+        input.inGame.inputTime = iteration;
+        inputState.store(input);
+    });
+    if (selected("input_state.atomic_load_contended")) {
+        BackgroundLoad writer(1, [&] {
+            InputState input = inputState.load();
+            input.inGame.inputTime++;
+            inputState.store(input);
+        });
+        run("input_state.atomic_load_contended", [&](uint32_t iteration) { s_sink = (float)inputState.load().inGame.inputTime; });
+    }
+
+    // the metrics that the hooks and the present thread update, with values that spread over every bucket of the histogram
+    const Metrics::Counter counter("bench.counter");
+    const Metrics::Histogram histogram("bench.histogram_us", { 0.5, 1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0 });
+    run("metrics.counter_add", [&](uint32_t iteration) { s_sink = (float)counter.Add(); });
+    run("metrics.histogram_record", [&](uint32_t iteration) { histogram.Record((double)(iteration % 64) * 20.0); });
+    // every thread adds to its own slots, so other threads updating the same counter shouldn't slow it down
+    if (selected("metrics.counter_add_contended")) {
+        BackgroundLoad adders(2, [&] { counter.Add(); });
+        run("metrics.counter_add_contended", [&](uint32_t iteration) { s_sink = (float)counter.Add(); });
+    }
+
+    // what a marker adds to the step it surrounds, both while the timeline is off like it is by default and while it's recording
+    const bool timelineWasEnabled = FrameTimeline::IsEnabled();
+    FrameTimeline::SetEnabled(false);
+    run("timeline.scope_disabled", [&](uint32_t iteration) { FrameTimeline::Scope scope("bench.scope"); });
+    if (selected("timeline.scope_enabled") || selected("timeline.record_enabled")) {
+        FrameTimeline::SetEnabled(true);
+        run("timeline.scope_enabled", [&](uint32_t iteration) { FrameTimeline::Scope scope("bench.scope"); });
+        // like the hook spans, which reuse the timestamps of the hook profiler
+        run("timeline.record_enabled", [&](uint32_t iteration) { FrameTimeline::Record("bench.record", iteration, iteration + 1); });
+    }
+    FrameTimeline::SetEnabled(timelineWasEnabled);
+
+    // the logging thread writes the messages into the sink instead of the console and log file
+    if (selected("log.print")) {
+        Log::setOutputOverride([](const std::string& text) { s_sink = (float)text.size(); });
+        {
+            Log log;
+            Log::setLogTypeEnabled(INFO, true);
+            run("log.print", [&](uint32_t iteration) { Log::print<INFO>("Frame {} took {:.3f} ms on {}", iteration, (float)iteration * 0.01f, "the bench"); });
+            Log::setLogTypeEnabled(INFO, false);
+        }
+        Log::setOutputOverride(nullptr);
+    }
+
+    // a call with a log type that's turned off, which should only cost the check of the log type mask
+    if (selected("log.print_disabled")) {
+        const bool wasEnabled = Log::isLogTypeEnabled(CONTROLS);
+        Log::setLogTypeEnabled(CONTROLS, false);
+        run("log.print_disabled", [&](uint32_t iteration) { Log::print<CONTROLS>("Frame {} took {:.3f} ms on {}", iteration, (float)iteration * 0.01f, "the bench"); });
+        Log::setLogTypeEnabled(CONTROLS, wasEnabled);
+    }
+
+    // the latency of a call from the game's threads while others log as well, for the queued logger and the one it replaced
+    constexpr uint32_t LOG_THREAD_COUNT = 4;
+    const std::filesystem::path logPath = std::filesystem::temp_directory_path() / "BetterVR_Bench_log.txt";
+    const std::filesystem::path consolePath = std::filesystem::temp_directory_path() / "BetterVR_Bench_console.txt";
+    if (selected("log.caller_latency_mt.queued")) {
+        s_logOutput.open(logPath, std::ios::out | std::ios::trunc);
+        Log::setOutputOverride([](const std::string& text) {
+            s_logOutput << text;
+            s_logOutput.flush();
+        });
+        {
+            Log log;
+            Log::setLogTypeEnabled(INFO, true);
+            results.emplace_back(MeasureCallerLatency("log.caller_latency_mt.queued", options, LOG_THREAD_COUNT, [](uint32_t thread, uint32_t call) {
+                Log::print<INFO>("Thread {} logged message {} after {:.3f} ms", thread, call, (float)call * 0.01f);
+            }));
+            Log::setLogTypeEnabled(INFO, false);
+        }
+        Log::setOutputOverride(nullptr);
+        s_logOutput.close();
+    }
+    if (selected("log.caller_latency_mt.mutex_vformat")) {
+        SynchronousLog synchronousLog(logPath, consolePath);
+        results.emplace_back(MeasureCallerLatency("log.caller_latency_mt.mutex_vformat", options, LOG_THREAD_COUNT, [&](uint32_t thread, uint32_t call) {
+            synchronousLog.Print("Thread {} logged message {} after {:.3f} ms", thread, call, (float)call * 0.01f);
+        }));
+    }
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(consolePath);
+
+    OfflineHooks hooks;
+    GuestFrameFixture guestFrame(hooks);
+
+    HookCallFixture hookCall;
+    run("hooks.call_direct", [&](uint32_t iteration) { hookCall.CallDirect(iteration); });
+    run("hooks.call_profiled", [&](uint32_t iteration) { hookCall.CallProfiled(iteration); });
+    run("hooks.call_captured", [&](uint32_t iteration) { hookCall.CallCaptured(iteration); });
+
+    RouteActorJobFixture routeActorJob(guestFrame, hooks);
+    run("hooks.route_actor_job", [&](uint32_t iteration) { routeActorJob.Run(iteration); });
+
+    ActorClassFixture actorClass(hooks);
+    run("actors.player_check_vtable_cache", [&](uint32_t iteration) { actorClass.FindCached(iteration); });
+    run("actors.player_check_name", [&](uint32_t iteration) { actorClass.CompareName(iteration); });
+
+    ChangeWeaponMtxFixture changeWeaponMtx(guestFrame, hooks);
+    run("weapon.change_weapon_mtx", [&](uint32_t iteration) { changeWeaponMtx.Run(iteration); });
+
+    ModifyBoneMatrixFixture modifyBoneMatrix(guestFrame);
+    run("skeleton.modify_bone_matrix", [&](uint32_t iteration) { modifyBoneMatrix.Run(iteration); });
+
+    FrameHookPatternFixture frameHookPattern(guestFrame);
+    run("frame.hook_pattern", [&](uint32_t iteration) { frameHookPattern.Run(iteration); });
+    std::ranges::move(frameHookPattern.GetHookResults("frame.hook_pattern", options), std::back_inserter(results));
+
+    std::cout << std::format("{:<44} {:>12} {:>12} {:>12} {:>12}\n", "benchmark", "iterations", "mean_ns", "p50_ns", "p99_ns");
+    for (const BenchResult& result : results) {
+        std::cout << std::format("{:<44} {:>12} {:>12.1f} {:>12.1f} {:>12.1f}\n", result.name, result.iterations, Mean(result.iterationTimesNs), Percentile(result.iterationTimesNs, 0.5), Percentile(result.iterationTimesNs, 0.99));
+    }
+
+    if (!options.jsonPath.empty() && !WriteJson(options.jsonPath, results)) {
+        Log::print<ERROR>("Couldn't write the results to {}", options.jsonPath.string());
+        return 1;
+    }
+    return 0;
+}
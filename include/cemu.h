@@ -42,4 +42,13 @@ struct PPCInterpreter_t {
 
 typedef void (*osLib_registerHLEFunctionPtr_t)(const char* libraryName, const char* functionName, void (*osFunction)(PPCInterpreter_t* hCPU));
 typedef void* (*memory_getBasePtr_t)();
-typedef uint64_t (*gameMeta_getTitleIdPtr_t)();
\ No newline at end of file
+typedef uint64_t (*gameMeta_getTitleIdPtr_t)();
+
+// the functions that Cemu exports for graphic pack hooks, which are looked up in the Cemu executable by FromCurrentProcess
+struct CemuExports {
+    osLib_registerHLEFunctionPtr_t osLib_registerHLEFunction = nullptr;
+    memory_getBasePtr_t memory_getBase = nullptr;
+    gameMeta_getTitleIdPtr_t gameMeta_getTitleId = nullptr;
+
+    static CemuExports FromCurrentProcess();
+};
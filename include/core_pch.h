@@ -0,0 +1,569 @@
+#pragma once
+
+// The parts of pch.h that don't depend on Windows, Vulkan or D3D12, so that BetterVR_Core and the tools can be built on any platform
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <ranges>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// OpenXR includes
+#include <openxr/openxr.h>
+
+// ImGui includes
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui.h>
+#include <implot3d.h>
+#include <implot.h>
+
+// glm includes
+#define GLM_FORCE_XYZW_ONLY
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <glm/gtx/string_cast.hpp>
+#include <glm/gtx/euler_angles.hpp>
+#undef GLM_ENABLE_EXPERIMENTAL
+
+inline glm::fvec2 ToGLM(const XrVector2f& vec) {
+    return glm::make_vec2(&vec.x);
+}
+
+inline glm::fvec3 ToGLM(const XrVector3f& vec) {
+    return glm::make_vec3(&vec.x);
+}
+
+inline glm::fquat ToGLM(const XrQuaternionf& quat) {
+    return glm::fquat(quat.w, quat.x, quat.y, quat.z);
+}
+
+
+inline XrVector2f ToXR(const glm::fvec2& vec) {
+    return { vec.x, vec.y };
+}
+
+inline XrVector3f ToXR(const glm::fvec3& vec) {
+    return { vec.x, vec.y, vec.z };
+}
+
+inline XrQuaternionf ToXR(const glm::fquat& quat) {
+    return { quat.x, quat.y, quat.z, quat.w };
+}
+
+inline glm::fmat4 ToMat4(const glm::fvec3& pos) {
+    return glm::translate(glm::identity<glm::fmat4>(), pos);
+}
+
+inline glm::fmat4 ToMat4(const glm::fquat& rot) {
+    return glm::mat4(rot);
+}
+
+inline glm::fmat4 ToMat4(const glm::fvec3& pos, const glm::fquat& rot) {
+    return ToMat4(pos) * ToMat4(rot);
+}
+
+
+inline std::string toLower(std::string str) {
+    std::ranges::transform(str, str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
+}
+
+inline uint32_t stringToHash(const char* str) {
+    uint32_t hash = 0;
+    while (*str) {
+        hash = (hash << 7) + *str++;
+    }
+    return hash;
+}
+
+#define PADDED_BYTES(from, up) uint8_t byte_##from[(up-from+0x04)]
+
+template<class T, template<class...> class U>
+inline constexpr bool is_instance_of_v = std::false_type{};
+
+template<template<class...> class U, class... Vs>
+inline constexpr bool is_instance_of_v<U<Vs...>,U> = std::true_type{};
+
+template <typename T1, typename T2>
+constexpr bool HAS_FLAG(T1 flags, T2 test_flag) {
+    return ((uint64_t)(flags) & (uint64_t)test_flag) == (uint64_t)(test_flag);
+}
+
+template <typename T>
+inline T swapEndianness(T val) {
+    if constexpr (std::is_floating_point<T>::value) {
+        union {
+            T f;
+            uint32_t i;
+        } bits;
+
+        bits.f = val;
+        bits.i = (bits.i & 0x000000FF) << 24 | (bits.i & 0x0000FF00) << 8  | (bits.i & 0x00FF0000) >> 8  | (bits.i & 0xFF000000) >> 24;
+
+        return bits.f;
+    }
+    else if constexpr (std::is_integral<T>::value) {
+        if constexpr (sizeof(T) == 1) {
+            return val;
+        }
+        else if constexpr (sizeof(T) == 2) {
+            return static_cast<T>((val << 8) | (val >> 8));
+        }
+        else if constexpr (sizeof(T) == 4) {
+            return ((val & 0x000000FF) << 24) | ((val & 0x0000FF00) <<  8) | ((val & 0x00FF0000) >>  8) | ((val & 0xFF000000) >> 24);
+        }
+        else {
+            union U {
+                T val;
+                std::array<std::uint8_t, sizeof(T)> raw;
+            } src, dst;
+
+            src.val = val;
+            std::reverse_copy(src.raw.begin(), src.raw.end(), dst.raw.begin());
+            return dst.val;
+        }
+    }
+    else {
+        union U {
+            T val;
+            std::array<std::uint8_t, sizeof(T)> raw;
+        } src, dst;
+
+        src.val = val;
+        std::reverse_copy(src.raw.begin(), src.raw.end(), dst.raw.begin());
+        return dst.val;
+    }
+}
+
+struct BETypeCompatible {
+};
+
+// BEType doesn't derive from BETypeCompatible, since the Itanium C++ ABI (GCC and Clang on Linux) can't place two empty bases
+// of the same type at the same address, which would pad every BEVec3 and BEMatrix34 whose first member is a BEType
+template<typename T>
+struct BEType {
+    T val;
+
+    BEType() = default;
+
+    BEType(T x) : val(swapEndianness(x)) {}
+
+    explicit operator T() {
+        return swapEndianness(val);
+    }
+
+    BEType<T>& operator =(T x) {
+        val = swapEndianness(x);
+        return *this;
+    }
+
+    BEType<T>& operator =(const BEType<T>& other) {
+        val = other.val;
+        return *this;
+    }
+
+    T getLE() const {
+        return swapEndianness(val);
+    }
+
+    T getBE() const {
+        return val;
+    }
+
+
+    bool operator ==(const BEType<T>& other) const { return val == other.val; }
+    bool operator ==(const T& other) const { return swapEndianness(val) == other; }
+    friend bool operator ==(const T& lhs, const BEType<T>& rhs) { return lhs == swapEndianness(rhs.val);}
+
+    bool operator !=(const BEType<T>& other) const { return val != other.val; }
+    bool operator !=(const T& other) const { return swapEndianness(val) != other.val; }
+    friend bool operator !=(const T& lhs, const BEType<T>& rhs) { return lhs != swapEndianness(rhs.val); }
+
+    bool operator <(const BEType<T>& other) const { return swapEndianness(val) < swapEndianness(other.val); }
+    bool operator <(const T& other) const { return swapEndianness(val) < other; }
+    friend bool operator <(const T& lhs, const BEType<T>& rhs) { return lhs < swapEndianness(rhs.val); }
+
+    bool operator >(const BEType<T>& other) const { return swapEndianness(val) > swapEndianness(other.val); }
+    bool operator >(const T& other) const { return swapEndianness(val) > other; }
+    friend bool operator >(const T& lhs, const BEType<T>& rhs) { return lhs > swapEndianness(rhs.val); }
+
+    bool operator <=(const BEType<T>& other) const { return swapEndianness(val) <= swapEndianness(other.val); }
+    bool operator <=(const T& other) const { return swapEndianness(val) <= other; }
+    friend bool operator <=(const T& lhs, const BEType<T>& rhs) { return lhs <= swapEndianness(rhs.val); }
+
+    bool operator >=(const BEType<T>& other) const { return swapEndianness(val) >= swapEndianness(other.val); }
+    bool operator >=(const T& other) const { return swapEndianness(val) >= other; }
+    friend bool operator >=(const T& lhs, const BEType<T>& rhs) { return lhs >= swapEndianness(rhs.val); }
+};
+
+
+template<typename T>
+inline constexpr bool is_BEType_v = std::is_base_of_v<BETypeCompatible, T> || is_instance_of_v<T, BEType>;
+
+struct BEVec2 : BETypeCompatible {
+    BEType<float> x;
+    BEType<float> y;
+
+    BEVec2() = default;
+    BEVec2(float x, float y): x(x), y(y) {}
+    BEVec2(BEType<float> x, BEType<float> y): x(x), y(y) {}
+};
+
+struct BEVec3 : BETypeCompatible {
+    BEType<float> x;
+    BEType<float> y;
+    BEType<float> z;
+
+    BEVec3() = default;
+    BEVec3(BEType<float> x, BEType<float> y, BEType<float> z): x(x), y(y), z(z) {}
+    BEVec3(float x, float y, float z): x(x), y(y), z(z) {}
+
+    float DistanceSq(BEVec3 other) const {
+        return (x.getLE() - other.x.getLE()) * (x.getLE() - other.x.getLE()) + (y.getLE() - other.y.getLE()) * (y.getLE() - other.y.getLE()) + (z.getLE() - other.z.getLE()) * (z.getLE() - other.z.getLE());
+    }
+
+    glm::fvec3 getLE() const {
+        return { x.getLE(), y.getLE(), z.getLE() };
+    }
+
+    bool operator==(const BEVec3& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    void operator=(const glm::fvec3& other) {
+        x = other.x;
+        y = other.y;
+        z = other.z;
+    }
+};
+
+struct BEMatrix34 : BETypeCompatible {
+    BEType<float> x_x;
+    BEType<float> y_x;
+    BEType<float> z_x;
+    BEType<float> pos_x;
+    BEType<float> x_y;
+    BEType<float> y_y;
+    BEType<float> z_y;
+    BEType<float> pos_y;
+    BEType<float> x_z;
+    BEType<float> y_z;
+    BEType<float> z_z;
+    BEType<float> pos_z;
+
+    BEMatrix34() = default;
+
+    float DistanceSq(const BEMatrix34& other) const {
+        return (pos_x.getLE() - other.pos_x.getLE()) * (pos_x.getLE() - other.pos_x.getLE()) + (pos_y.getLE() - other.pos_y.getLE()) * (pos_y.getLE() - other.pos_y.getLE()) + (pos_z.getLE() - other.pos_z.getLE()) * (pos_z.getLE() - other.pos_z.getLE());
+    }
+
+    std::array<std::array<float, 4>, 3> getLE() const {
+        std::array row0 = { x_x.getLE(), y_x.getLE(), z_x.getLE(), pos_x.getLE() };
+        std::array row1 = { x_y.getLE(), y_y.getLE(), z_y.getLE(), pos_y.getLE() };
+        std::array row2 = { x_z.getLE(), y_z.getLE(), z_z.getLE(), pos_z.getLE() };
+        return { row0, row1, row2 };
+    }
+
+    glm::mat4x3 getLEMatrix() const {
+        return glm::mat4x3(
+            glm::vec3(x_x.getLE(), x_y.getLE(), x_z.getLE()),      // X basis column
+            glm::vec3(y_x.getLE(), y_y.getLE(), y_z.getLE()),      // Y basis column
+            glm::vec3(z_x.getLE(), z_y.getLE(), z_z.getLE()),      // Z basis column
+            glm::vec3(pos_x.getLE(), pos_y.getLE(), pos_z.getLE()) // translation column
+        );
+    }
+
+    void setLEMatrix(const glm::mat4x3& m) {
+        // m[col][row]
+        x_x = m[0][0];
+        x_y = m[0][1];
+        x_z = m[0][2];
+        y_x = m[1][0];
+        y_y = m[1][1];
+        y_z = m[1][2];
+        z_x = m[2][0];
+        z_y = m[2][1];
+        z_z = m[2][2];
+
+        pos_x = m[3][0];
+        pos_y = m[3][1];
+        pos_z = m[3][2];
+    }
+
+    BEVec3 getPos() const {
+        return { pos_x, pos_y, pos_z };
+    }
+
+    void setPos(glm::fvec3 pos) {
+        pos_x = pos.x;
+        pos_y = pos.y;
+        pos_z = pos.z;
+    }
+
+    glm::fquat getRotLE() const {
+        return glm::quat_cast(glm::fmat3(getLEMatrix()));
+    }
+
+	void setRotLE(const glm::fquat& rotation) {
+        glm::fmat3 rotMat = glm::mat3_cast(rotation);
+
+        x_x = rotMat[0][0];
+        y_x = rotMat[1][0];
+        z_x = rotMat[2][0];
+        x_y = rotMat[0][1];
+        y_y = rotMat[1][1];
+        z_y = rotMat[2][1];
+        x_z = rotMat[0][2];
+        y_z = rotMat[1][2];
+        z_z = rotMat[2][2];
+    }
+};
+
+struct BEMatrix44 : BETypeCompatible {
+    BEType<float> a00;
+    BEType<float> a01;
+    BEType<float> a02;
+    BEType<float> a03;
+    BEType<float> a10;
+    BEType<float> a11;
+    BEType<float> a12;
+    BEType<float> a13;
+    BEType<float> a20;
+    BEType<float> a21;
+    BEType<float> a22;
+    BEType<float> a23;
+    BEType<float> a30;
+    BEType<float> a31;
+    BEType<float> a32;
+    BEType<float> a33;
+
+    BEMatrix44() = default;
+
+    glm::fmat4 getLE() const {
+        return glm::fmat4(
+            a00.getLE(), a01.getLE(), a02.getLE(), a03.getLE(),
+            a10.getLE(), a11.getLE(), a12.getLE(), a13.getLE(),
+            a20.getLE(), a21.getLE(), a22.getLE(), a23.getLE(),
+            a30.getLE(), a31.getLE(), a32.getLE(), a33.getLE()
+        );
+    }
+
+    void operator=(glm::fmat4 mtx) {
+        a00 = mtx[0][0];
+        a01 = mtx[0][1];
+        a02 = mtx[0][2];
+        a03 = mtx[0][3];
+        a10 = mtx[1][0];
+        a11 = mtx[1][1];
+        a12 = mtx[1][2];
+        a13 = mtx[1][3];
+        a20 = mtx[2][0];
+        a21 = mtx[2][1];
+        a22 = mtx[2][2];
+        a23 = mtx[2][3];
+        a30 = mtx[3][0];
+        a31 = mtx[3][1];
+        a32 = mtx[3][2];
+        a33 = mtx[3][3];
+    }
+};
+
+enum class EventMode {
+    NO_EVENT = 0,
+    ALWAYS_FIRST_PERSON = 1,
+    FOLLOW_DEFAULT_EVENT_SETTINGS = 2,
+    ALWAYS_THIRD_PERSON = 3,
+};
+
+struct data_VRSettingsIn {
+    BEType<int32_t> cameraModeSetting;
+    BEType<int32_t> leftHandedSetting;
+    BEType<int32_t> guiFollowSetting;
+    BEType<float> playerHeightSetting;
+    BEType<int32_t> enable2DVRView;
+    BEType<int32_t> cropFlatTo16x9Setting;
+    BEType<int32_t> enableDebugOverlay;
+    BEType<int32_t> buggyAngularVelocity;
+    BEType<int32_t> cutsceneCameraMode;
+    BEType<int32_t> cutsceneBlackBars;
+
+    bool IsLeftHanded() const {
+        return leftHandedSetting == 1;
+    }
+
+    bool IsFirstPersonMode() const {
+        return cameraModeSetting == 1;
+    }
+
+    bool IsThirdPersonMode() const {
+        return cameraModeSetting == 0;
+    }
+
+    EventMode GetCutsceneCameraMode() const {
+        // if in third-person mode, always use third-person cutscene camera
+        if (IsThirdPersonMode()) {
+            return EventMode::ALWAYS_THIRD_PERSON;
+        }
+
+        return (EventMode)cutsceneCameraMode.getLE();
+    }
+
+    bool UseBlackBarsForCutscenes() const {
+        return cutsceneBlackBars == 1;
+    }
+
+    bool UIFollowsLookingDirection() const {
+        return guiFollowSetting == 1;
+    }
+
+    bool Is2DVRViewEnabled() const {
+        return enable2DVRView == 1;
+    }
+
+    bool ShouldFlatPreviewBeCroppedTo16x9() const {
+        return cropFlatTo16x9Setting == 1;
+    }
+
+    bool ShowDebugOverlay() const {
+        return enableDebugOverlay.getLE() != 0;
+    }
+
+    float GetZNear() const {
+        return 0.1f;
+    }
+
+    float GetZFar() const {
+        return 25000.0f;
+    }
+
+    enum class AngularVelocityFixerMode {
+        AUTO = 0, // Angular velocity fixer is automatically enabled for Oculus Link
+        FORCED_ON = 1,
+        FORCED_OFF = 2,
+    };
+
+    AngularVelocityFixerMode AngularVelocityFixer_GetMode() {
+        return (AngularVelocityFixerMode)buggyAngularVelocity.getLE();
+    }
+
+    std::string ToString() const {
+        std::string buffer = "";
+        std::format_to(std::back_inserter(buffer), " - Camera Mode: {}\n", IsFirstPersonMode() ? "First Person" : "Third Person");
+        std::format_to(std::back_inserter(buffer), " - Left Handed: {}\n", IsLeftHanded() ? "Yes" : "No");
+        std::format_to(std::back_inserter(buffer), " - GUI Follow Setting: {}\n", UIFollowsLookingDirection() ? "Follow Looking Direction" : "Fixed");
+        std::format_to(std::back_inserter(buffer), " - Player Height: {} meters\n", playerHeightSetting.getLE());
+        std::format_to(std::back_inserter(buffer), " - 2D VR View Enabled: {}\n", Is2DVRViewEnabled() ? "Yes" : "No");
+        std::format_to(std::back_inserter(buffer), " - Crop Flat to 16:9: {}\n", ShouldFlatPreviewBeCroppedTo16x9() ? "Yes" : "No");
+        std::format_to(std::back_inserter(buffer), " - Debug Overlay: {}\n", ShowDebugOverlay() ? "Enabled" : "Disabled");
+        std::format_to(std::back_inserter(buffer), " - Cutscene Camera Mode: {}\n", GetCutsceneCameraMode() == EventMode::ALWAYS_FIRST_PERSON ? "Always First Person" : (GetCutsceneCameraMode() == EventMode::ALWAYS_THIRD_PERSON ? "Always Third Person" : "Follow Default Event Settings"));
+        std::format_to(std::back_inserter(buffer), " - Show Black Bars for Third-Person Cutscenes: {}\n", UseBlackBarsForCutscenes() ? "Yes" : "No");
+        return buffer;
+    }
+};
+
+
+
+#pragma pack(push, 1)
+struct BESeadProjection {
+    BEType<bool> dirty;
+    BEType<bool> deviceDirty;
+    BEType<uint8_t> pad0;
+    BEType<uint8_t> pad1;
+    BEMatrix44 matrix;
+    BEMatrix44 deviceMatrix;
+    BEType<uint32_t> devicePosture;
+    BEType<float> deviceZScale;
+    BEType<float> deviceZOffset;
+    BEType<uint32_t> __vftable;
+};
+
+struct BESeadPerspectiveProjection : BESeadProjection {
+    BEType<float> zNear;
+    BEType<float> zFar;
+    BEType<float> fovYRadiansOrAngle;
+    BEType<float> fovySin;
+    BEType<float> fovyCos;
+    BEType<float> fovyTan;
+    BEType<float> aspect;
+    BEVec2 offset;
+};
+#pragma pack(pop)
+static_assert(sizeof(BESeadProjection) == 0x94, "BESeadProjection size mismatch");
+static_assert(sizeof(BESeadPerspectiveProjection) == 0xB8, "BESeadPerspectiveProjection size mismatch");
+
+#pragma pack(push, 1)
+struct BESeadCamera {
+    BEMatrix34 mtx;
+    BEType<uint32_t> __vftable;
+};
+struct BESeadLookAtCamera : BESeadCamera {
+    BEVec3 pos;
+    BEVec3 at;
+    BEVec3 up;
+
+    bool operator==(const BESeadLookAtCamera& other) const {
+        return pos == other.pos && at == other.at && up == other.up;
+    }
+};
+#pragma pack(pop)
+static_assert(sizeof(BESeadCamera) == 0x34, "BESeadCamera size mismatch");
+static_assert(sizeof(BESeadLookAtCamera) == 0x58, "BESeadLookAtCamera size mismatch");
+struct data_VRProjectionMatrixOut {
+    BEType<float> aspectRatio;
+    BEType<float> fovY;
+    BEType<float> offsetX;
+    BEType<float> offsetY;
+};
+
+#include "game_structs.h"
+#include "cemu.h"
+#include "utils/logger.h"
+#include "utils/metrics.h"
+#include "utils/frame_timeline.h"
+#include "utils/frame_time_stats.h"
+#include "utils/frame_latency.h"
@@ -92,7 +92,7 @@ enum ActorFlags : int32_t {
     ActorFlags_ForceCalcInEvent = 0x10000000,
     ActorFlags_IsCameraOrEditCamera = 0x20000000,
     ActorFlags_InitializedMaybe = 0x40000000,
-    ActorFlags_PrepareForDeleteMaybe = 0x80000000,
+    ActorFlags_PrepareForDeleteMaybe = (int32_t)0x80000000,
 };
 
 enum ActorFlags2 : int32_t {
@@ -127,7 +127,7 @@ enum ActorFlags2 : int32_t {
     ActorFlags2_10000000 = 0x10000000,
     ActorFlags2_20000000 = 0x20000000,
     ActorFlags2_40000000 = 0x40000000,
-    ActorFlags2_80000000 = 0x80000000,
+    ActorFlags2_80000000 = (int32_t)0x80000000,
 };
 
 enum ActorFlags3 : int32_t {
@@ -162,7 +162,7 @@ enum ActorFlags3 : int32_t {
     ActorFlags3_10000000 = 0x10000000,
     ActorFlags3_20000000 = 0x20000000,
     ActorFlags3_40000000 = 0x40000000,
-    ActorFlags3_80000000 = 0x80000000,
+    ActorFlags3_80000000 = (int32_t)0x80000000,
 };
 
 struct ActorWiiU : BaseProc {
@@ -46,6 +46,8 @@ lfs f0, 0xC(r31)
 stfs f0, 8(r30)
 
 ; call custom bone matrix function
+; r8 = frame counter
+; r7 = int boneIdx
 ; r6 = char* boneName
 ; r5 = Vec3* scale
 ; r4 = sead::Matrix34*
@@ -53,6 +55,9 @@ stfs f0, 8(r30)
 
 mr r27, r6
 
+mr r7, r6 ; pass bone index
+lis r8, currentFrameCounter@ha
+lwz r8, currentFrameCounter@l(r8)
 lwz r6, 0x20(r1) ; load name
 
 lwz r3, 0x0C(r1) ; r31 = ksys::phys::ModelBoneAccessor*
@@ -0,0 +1,293 @@
+#pragma once
+#include "actor_types.h"
+
+// Flat registry of the actors that the game iterates over every frame.
+// The game walks its whole actor list each frame, so instead of clearing and rebuilding a map we stamp every actor with the
+// generation of the last pass that saw it, and EndPass() removes the actors that the pass didn't see.
+// Consumers can ask for the actors that were added, removed or renamed since they last checked, and only have to apply those changes.
+// Actors are keyed by their pointer, and their id is the pointer + the hash of their name, like the ids of the entity debugger.
+class ActorRegistry {
+public:
+    struct Actor {
+        uint32_t ptr = 0;        // 0 means the slot is empty
+        uint32_t id = 0;         // actor pointer + name hash
+        uint32_t nameHash = 0;
+        uint32_t nameId = 0;
+        uint32_t lastSeen = 0;   // generation of the last pass that saw this actor
+        uint32_t reportedId = 0; // id that the consumer was last told about, 0 if it never was
+        ActorClass type = ActorClass::UNKNOWN;
+    };
+
+    // the name points into the registry's interned names, which stay alive and in place until the consumer has collected the diff
+    // that reports the actor as removed or renamed, so the consumer can keep the name for as long as it tracks the actor
+    struct Change {
+        uint32_t id;
+        uint32_t ptr;
+        std::string_view name;
+        ActorClass type;
+        uint32_t previousId = 0; // the id that the consumer knew the actor by, only set for updated actors
+    };
+
+    struct Diff {
+        std::vector<Change> added;
+        std::vector<Change> removed;
+        std::vector<Change> updated; // actors that got a different name, and therefore a different id, at the same pointer
+
+        void clear() {
+            added.clear();
+            removed.clear();
+            updated.clear();
+        }
+    };
+
+    ActorRegistry() {
+        m_slots.resize(INITIAL_CAPACITY);
+    }
+
+    // called when the game starts iterating the actor list from the beginning
+    void BeginPass() {
+        // the previous pass might not have reached the end of the list, if the list got shorter while it was iterated
+        if (m_inPass) {
+            EndPass();
+        }
+        m_passGeneration++;
+        m_seenThisPass = 0;
+        m_inPass = true;
+    }
+
+    // called after the last actor of the list, removes every actor that the pass didn't see
+    void EndPass() {
+        m_inPass = false;
+        if (m_seenThisPass == m_count) {
+            return;
+        }
+
+        // erasing shifts entries around, so a slot is only advanced past when it wasn't erased
+        for (uint32_t i = 0; i < m_slots.size();) {
+            Actor& actor = m_slots[i];
+            if (actor.ptr != 0 && actor.lastSeen != m_passGeneration) {
+                if (actor.reportedId != 0) {
+                    m_removed.push_back({ .id = actor.reportedId, .ptr = actor.ptr, .name = GetName(actor.nameId), .type = actor.type });
+                    m_unreportedNames.emplace_back(actor.nameId);
+                }
+                else {
+                    ReleaseName(actor.nameId);
+                }
+                Erase(i);
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    // called by hook_UpdateActorList for every entry of the game's actor list, with the entry's index, the size of the list and
+    // the entry's actor, whose name is null or empty for entries that are skipped
+    // the pass is ended after the last entry was touched, so that the last actor of the list isn't pruned and re-added every pass
+    const Actor* VisitListEntry(uint32_t index, uint32_t listSize, uint32_t actorPtr, const char* actorName) {
+        if (index == 0) {
+            BeginPass();
+        }
+
+        const bool hasName = actorName != nullptr && actorName[0] != '\0';
+        if (hasName) {
+            Touch(actorPtr, actorName);
+        }
+
+        if (index + 1 >= listSize) {
+            EndPass();
+        }
+        // erasing in EndPass can move the touched actor to another slot
+        return hasName ? Find(actorPtr) : nullptr;
+    }
+
+    const Actor& Touch(uint32_t actorPtr, const char* actorName) {
+        const uint32_t nameHash = stringToHash(actorName);
+
+        uint32_t slot = FindSlot(actorPtr);
+        if (m_slots[slot].ptr != actorPtr) {
+            if ((m_count + 1) * 2 > m_slots.size()) {
+                Grow();
+                slot = FindSlot(actorPtr);
+            }
+            const uint32_t nameId = AcquireName(nameHash, actorName);
+            m_slots[slot] = { .ptr = actorPtr, .id = actorPtr + nameHash, .nameHash = nameHash, .nameId = nameId, .type = m_names[nameId].type };
+            m_count++;
+        }
+        else if (m_slots[slot].nameHash != nameHash) {
+            // the actor was replaced by another one at the same address before a pass noticed that it was gone
+            Actor& actor = m_slots[slot];
+            if (actor.reportedId != 0) {
+                m_unreportedNames.emplace_back(actor.nameId);
+            }
+            else {
+                ReleaseName(actor.nameId);
+            }
+            actor.nameId = AcquireName(nameHash, actorName);
+            actor.nameHash = nameHash;
+            actor.id = actorPtr + nameHash;
+            actor.type = m_names[actor.nameId].type;
+        }
+
+        Actor& actor = m_slots[slot];
+        if (actor.lastSeen != m_passGeneration) {
+            actor.lastSeen = m_passGeneration;
+            m_seenThisPass++;
+        }
+        return actor;
+    }
+
+    // fills the diff with everything that changed since the previous call
+    // the consumer has applied the previous diff by the time it collects the next one, so that's when the names of the actors
+    // that the previous diff reported as removed or renamed are released
+    void CollectDiff(Diff& diff) {
+        for (uint32_t nameId : m_reportedNames) {
+            ReleaseName(nameId);
+        }
+        m_reportedNames.clear();
+        std::swap(m_reportedNames, m_unreportedNames);
+
+        diff.clear();
+        std::swap(diff.removed, m_removed);
+
+        for (Actor& actor : m_slots) {
+            if (actor.ptr == 0 || actor.reportedId == actor.id)
+                continue;
+
+            if (actor.reportedId == 0) {
+                diff.added.push_back({ .id = actor.id, .ptr = actor.ptr, .name = GetName(actor.nameId), .type = actor.type });
+            }
+            else {
+                diff.updated.push_back({ .id = actor.id, .ptr = actor.ptr, .name = GetName(actor.nameId), .type = actor.type, .previousId = actor.reportedId });
+            }
+            actor.reportedId = actor.id;
+        }
+    }
+
+    // calls callback(const Actor&) for every actor that's currently in the registry
+    template <typename F>
+    void ForEachActor(F&& callback) const {
+        for (const Actor& actor : m_slots) {
+            if (actor.ptr != 0) {
+                callback(actor);
+            }
+        }
+    }
+
+    const Actor* Find(uint32_t actorPtr) const {
+        const Actor& actor = m_slots[FindSlot(actorPtr)];
+        return actor.ptr == actorPtr && actorPtr != 0 ? &actor : nullptr;
+    }
+
+    std::string_view GetName(uint32_t nameId) const { return m_names[nameId].name; }
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetNameCount() const { return (uint32_t)(m_names.size() - m_freeNameIds.size()); }
+    uint32_t GetGeneration() const { return m_passGeneration; }
+
+private:
+    static constexpr uint32_t INITIAL_CAPACITY = 2048;
+
+    struct Name {
+        std::string name;
+        ActorClass type = ActorClass::UNKNOWN;
+        uint32_t hash = 0;
+        uint32_t actors = 0; // number of actors that use this name, it's freed once this drops to zero
+    };
+
+    uint32_t Mask() const { return (uint32_t)m_slots.size() - 1; }
+
+    static uint32_t HashPtr(uint32_t ptr) {
+        return (ptr * 0x9E3779B1u) >> 7;
+    }
+
+    // returns either the slot that holds the actor or the empty slot where it should be inserted
+    uint32_t FindSlot(uint32_t actorPtr) const {
+        uint32_t slot = HashPtr(actorPtr) & Mask();
+        while (m_slots[slot].ptr != 0 && m_slots[slot].ptr != actorPtr) {
+            slot = (slot + 1) & Mask();
+        }
+        return slot;
+    }
+
+    // backward shift deletion, which keeps the probe sequences intact without needing tombstones
+    void Erase(uint32_t slot) {
+        uint32_t hole = slot;
+        uint32_t next = (hole + 1) & Mask();
+        while (m_slots[next].ptr != 0) {
+            uint32_t home = HashPtr(m_slots[next].ptr) & Mask();
+            if (((next - home) & Mask()) >= ((next - hole) & Mask())) {
+                m_slots[hole] = m_slots[next];
+                hole = next;
+            }
+            next = (next + 1) & Mask();
+        }
+        m_slots[hole] = {};
+        m_count--;
+    }
+
+    void Grow() {
+        std::vector<Actor> oldSlots = std::move(m_slots);
+        m_slots.assign(oldSlots.size() * 2, {});
+        for (const Actor& actor : oldSlots) {
+            if (actor.ptr != 0) {
+                m_slots[FindSlot(actor.ptr)] = actor;
+            }
+        }
+    }
+
+    uint32_t AcquireName(uint32_t nameHash, const char* actorName) {
+        auto [begin, end] = m_nameLookup.equal_range(nameHash);
+        for (auto it = begin; it != end; ++it) {
+            if (m_names[it->second].name == actorName) {
+                m_names[it->second].actors++;
+                return it->second;
+            }
+        }
+
+        uint32_t nameId = (uint32_t)m_names.size();
+        if (!m_freeNameIds.empty()) {
+            nameId = m_freeNameIds.back();
+            m_freeNameIds.pop_back();
+        }
+        else {
+            m_names.emplace_back();
+        }
+        m_names[nameId] = { .name = actorName, .type = ClassifyActorName(actorName), .hash = nameHash, .actors = 1 };
+        m_nameLookup.emplace(nameHash, nameId);
+        return nameId;
+    }
+
+    void ReleaseName(uint32_t nameId) {
+        Name& name = m_names[nameId];
+        if (--name.actors != 0) {
+            return;
+        }
+
+        auto [begin, end] = m_nameLookup.equal_range(name.hash);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == nameId) {
+                m_nameLookup.erase(it);
+                break;
+            }
+        }
+        name = {};
+        m_freeNameIds.emplace_back(nameId);
+    }
+
+    std::vector<Actor> m_slots;
+    uint32_t m_count = 0;
+    uint32_t m_passGeneration = 1;
+    uint32_t m_seenThisPass = 0;
+    bool m_inPass = false;
+
+    // actors that the consumer knew about and that were removed since it last collected a diff
+    std::vector<Change> m_removed;
+    // names that the consumer still uses for actors that were removed or renamed, which are released once it has seen that
+    std::vector<uint32_t> m_unreportedNames;
+    std::vector<uint32_t> m_reportedNames;
+
+    // a deque keeps the names in place when new ones are added, so the consumer can read them while the game touches actors
+    std::deque<Name> m_names;
+    std::vector<uint32_t> m_freeNameIds;
+    std::unordered_multimap<uint32_t, uint32_t> m_nameLookup;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+enum class ActorClass : uint8_t {
+    UNKNOWN,
+    PLAYER,
+    CAMERA,
+    WEAPON,
+    NPC,
+    ENEMY,
+    OTHER,
+    MIXED, // the vtable is shared by actors that are classified differently by name, so the name has to be checked instead
+};
+
+inline ActorClass ClassifyActorName(std::string_view actorName) {
+    if (actorName == "GameROMPlayer")
+        return ActorClass::PLAYER;
+    if (actorName == "GameRomCamera")
+        return ActorClass::CAMERA;
+    if (actorName.starts_with("Weapon_"))
+        return ActorClass::WEAPON;
+    if (actorName.starts_with("Npc_"))
+        return ActorClass::NPC;
+    if (actorName.starts_with("Enemy_"))
+        return ActorClass::ENEMY;
+    return ActorClass::OTHER;
+}
+
+// Maps an actor's vtable to the class it was resolved to by name the first time the vtable was seen.
+// Hooks can run on any of Cemu's emulated core threads, so the table is a fixed-size array of atomics where each entry packs the
+// vtable and its class together. Vtables are only ever added, and there are far fewer actor classes than entries.
+class ActorTypeCache {
+public:
+    ActorClass Find(uint32_t vtable) const {
+        if (vtable == 0)
+            return ActorClass::UNKNOWN;
+
+        for (uint32_t i = 0, slot = Hash(vtable); i < CAPACITY; i++, slot = (slot + 1) & (CAPACITY - 1)) {
+            uint64_t entry = m_entries[slot].load(std::memory_order_acquire);
+            if (entry == 0)
+                return ActorClass::UNKNOWN;
+            if ((uint32_t)(entry >> 8) == vtable)
+                return (ActorClass)(entry & 0xFF);
+        }
+        return ActorClass::UNKNOWN;
+    }
+
+    // records the name-based class of an actor with the given vtable, and demotes the vtable to MIXED on disagreement
+    void Observe(uint32_t vtable, ActorClass nameClass) {
+        if (vtable == 0 || nameClass == ActorClass::UNKNOWN)
+            return;
+
+        const uint64_t newEntry = ((uint64_t)vtable << 8) | (uint64_t)nameClass;
+        for (uint32_t i = 0, slot = Hash(vtable); i < CAPACITY; i++, slot = (slot + 1) & (CAPACITY - 1)) {
+            uint64_t entry = m_entries[slot].load(std::memory_order_acquire);
+            if (entry == 0) {
+                if (m_entries[slot].compare_exchange_strong(entry, newEntry, std::memory_order_acq_rel)) {
+                    return;
+                }
+                // another thread claimed this slot in the meantime, so check what it inserted
+            }
+
+            if ((uint32_t)(entry >> 8) != vtable)
+                continue;
+
+            if ((ActorClass)(entry & 0xFF) != nameClass && (ActorClass)(entry & 0xFF) != ActorClass::MIXED) {
+                Log::print<WARNING>("Actor vtable {:08X} is shared by actors of different types, falling back to name checks for it", vtable);
+                m_entries[slot].store(((uint64_t)vtable << 8) | (uint64_t)ActorClass::MIXED, std::memory_order_release);
+            }
+            return;
+        }
+    }
+
+private:
+    static constexpr uint32_t CAPACITY = 1024;
+
+    static uint32_t Hash(uint32_t vtable) {
+        // vtables are 4-byte aligned and close together
+        return ((vtable >> 2) * 0x9E3779B1u >> 16) & (CAPACITY - 1);
+    }
+
+    std::array<std::atomic_uint64_t, CAPACITY> m_entries = {};
+};
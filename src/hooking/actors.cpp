@@ -0,0 +1,67 @@
+#include "cemu_hooks.h"
+
+static std::mutex s_actorListMutex;
+static ActorRegistry s_actorRegistry;
+ActorTypeCache CemuHooks::s_actorTypes;
+glm::fvec3 CemuHooks::s_playerPos = {};
+uint32_t CemuHooks::s_playerMtxAddress = 0;
+uint32_t CemuHooks::s_cameraMtxAddress = 0;
+
+void CemuHooks::hook_UpdateActorList(PPCInterpreter_t* hCPU) {
+    hCPU->instructionPointer = hCPU->sprNew.LR;
+
+    std::scoped_lock lock(s_actorListMutex);
+
+    // r7 holds actor list size
+    // r5 holds current actor index
+    // r6 holds current actor* list entry
+
+    uint32_t actorLinkPtr = hCPU->gpr[6] + offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, c_str);
+    uint32_t actorNamePtr = 0;
+    readMemoryBE(actorLinkPtr, &actorNamePtr);
+    // the names are null-terminated in guest memory, so the view's data can be passed on as a C string
+    const char* actorName = actorNamePtr != 0 ? getString(actorNamePtr).data() : nullptr;
+
+    // Log::print("Updating actor list [{}/{}] {:08x} - {}", hCPU->gpr[5], hCPU->gpr[7], hCPU->gpr[6], actorName);
+    const ActorRegistry::Actor* actor = s_actorRegistry.VisitListEntry(hCPU->gpr[5], hCPU->gpr[7], hCPU->gpr[6], actorName);
+    if (actor == nullptr)
+        return;
+
+    // every actor is checked against the vtable cache so that vtables shared between actor types get noticed
+    uint32_t vtableAddr = getMemory<BEType<uint32_t>>(hCPU->gpr[6] + offsetof(ActorWiiU, vtable)).getLE();
+    s_actorTypes.Observe(vtableAddr, actor->type);
+
+    if (actor->type == ActorClass::PLAYER) {
+        BEMatrix34 mtx = {};
+        uint32_t actorMtxPtr = hCPU->gpr[6] + offsetof(ActorWiiU, mtx);
+        readMemory(actorMtxPtr, &mtx);
+        s_playerPos = mtx.getPos().getLE();
+        s_playerMtxAddress = actorMtxPtr;
+        s_playerAddress = hCPU->gpr[6];
+    }
+    else if (actor->type == ActorClass::CAMERA) {
+        uint32_t actorMtxPtr = hCPU->gpr[6] + offsetof(ActorWiiU, mtx);
+        s_cameraMtxAddress = actorMtxPtr;
+    }
+}
+
+ActorClass CemuHooks::GetActorClass(uint32_t actorPtr) {
+    uint32_t vtableAddr = getMemory<BEType<uint32_t>>(actorPtr + offsetof(ActorWiiU, vtable)).getLE();
+    if (ActorClass cached = s_actorTypes.Find(vtableAddr); cached != ActorClass::UNKNOWN && cached != ActorClass::MIXED) {
+        return cached;
+    }
+
+    // fall back to the actor's name for vtables that haven't been seen yet or are shared between types
+    uint32_t actorNamePtr = getMemory<BEType<uint32_t>>(actorPtr + offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, c_str)).getLE();
+    if (actorNamePtr == 0)
+        return ActorClass::UNKNOWN;
+
+    ActorClass nameClass = ClassifyActorName(getString(actorNamePtr));
+    s_actorTypes.Observe(vtableAddr, nameClass);
+    return nameClass;
+}
+
+void CemuHooks::CollectActorDiff(ActorRegistry::Diff& diff) {
+    std::scoped_lock lock(s_actorListMutex);
+    s_actorRegistry.CollectDiff(diff);
+}
@@ -1,28 +1,19 @@
 #include "cemu_hooks.h"
-#include "instance.h"
-#include "rendering/openxr.h"
+#include "cutscene_settings.h"
+#include "utils/rigid_pose.h"
+#include "stereo_camera_frame.h"
 
 
 void CemuHooks::hook_BeginCameraSide(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    OpenXR::EyeSide side = hCPU->gpr[0] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[0] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
     Log::print<RENDERING>("");
     Log::print<RENDERING>("===============================================================================");
     Log::print<RENDERING>("{0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0} {0}", side);
 }
 
-static std::pair<glm::quat, glm::quat> swingTwistY(const glm::quat& q) {
-    glm::vec3 yAxis(0, 1, 0);
-    glm::vec3 r(q.x, q.y, q.z);
-    float dot = glm::dot(r, yAxis);
-    glm::vec3 proj = yAxis * dot;
-    glm::quat twist = glm::normalize(glm::quat(q.w, proj.x, proj.y, proj.z));
-    glm::quat swing = q * glm::conjugate(twist);
-    return { swing, twist };
-}
-
 constexpr float hardcodedSwimOffset = 1.73f/* model height*/ - 0.3f /*head height*/;
 
 glm::fvec3 s_wsCameraPosition = glm::fvec3();
@@ -39,7 +30,7 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
 
     // read the camera matrix from the game's memory
     uint32_t ppc_cameraMatrixOffsetIn = hCPU->gpr[31];
-    OpenXR::EyeSide side = hCPU->gpr[3] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[3] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
     ActCamera actCam = {};
     readMemory(ppc_cameraMatrixOffsetIn, &actCam);
 
@@ -57,13 +48,13 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
     // remove verticality from the camera position to avoid pitch changes that aren't from the VR headset
     oldCameraPosition.y = oldCameraTarget.y;
 
-    // construct glm matrix from the existing camera parameters
-    glm::mat4 existingGameMtx = glm::lookAtRH(oldCameraPosition, oldCameraTarget, oldCameraUp);
+    // construct the camera's world pose from the existing camera parameters
+    RigidPose gameCameraPose = RigidPose(glm::lookAtRH(oldCameraPosition, oldCameraTarget, oldCameraUp)).Inverse();
 
     // pass real camera position and rotation to be used elsewhere
     // GetRenderCamera recalculates the left and right eye positions from the base camera position
     s_wsCameraPosition = oldCameraPosition;
-    s_wsCameraRotation = glm::quat_cast(glm::inverse(existingGameMtx));
+    s_wsCameraRotation = gameCameraPose.rotation;
 
     // rebase the rotation to the player position
     if (IsFirstPerson()) {
@@ -85,7 +76,7 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
         if (auto settings = GetFirstPersonSettingsForActiveEvent()) {
             if (settings->ignoreCameraRotation) {
                 glm::fquat playerRot = mtx.getRotLE();
-                auto [swing, baseYaw] = swingTwistY(playerRot);
+                auto [swing, baseYaw] = SwingTwistY(playerRot);
                 s_wsCameraRotation = baseYaw * glm::angleAxis(glm::radians(180.0f), glm::fvec3(0.0f, 1.0f, 0.0f));
             }
         }
@@ -98,25 +89,24 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
         //    s_wsCameraRotation *= glm::angleAxis(glm::radians(180.0f), glm::fvec3(0, 1, 0));
         //}
 
-        glm::mat4 playerMtx4 = glm::inverse(glm::translate(glm::identity<glm::mat4>(), playerPos) * glm::mat4(s_wsCameraRotation));
-        existingGameMtx = playerMtx4;
+        gameCameraPose = RigidPose(s_wsCameraRotation, playerPos);
     }
 
     // current VR headset camera matrix
-    auto viewsOpt = VRManager::instance().XR->GetRenderer()->GetMiddlePose();
+    auto viewsOpt = GetHost().GetMiddlePose();
     if (!viewsOpt) {
         Log::print<ERROR>("hook_UpdateCameraForGameplay: No views available for the middle pose.");
         return;
     }
     auto& views = viewsOpt.value();
 
-    // calculate final camera matrix
-    glm::mat4 finalPose = glm::inverse(existingGameMtx) * views;
+    // calculate final camera pose
+    RigidPose finalPose = gameCameraPose * RigidPose(views);
 
-    // extract camera up, forward and position from the final matrix
-    glm::fvec3 camPos = glm::fvec3(finalPose[3]);
-    glm::fvec3 forward = -glm::normalize(glm::fvec3(finalPose[2]));
-    glm::fvec3 up = glm::normalize(glm::fvec3(finalPose[1]));
+    // extract camera up, forward and position from the final pose
+    glm::fvec3 camPos = finalPose.position;
+    glm::fvec3 forward = -glm::normalize(finalPose.TransformDirection(glm::fvec3(0.0f, 0.0f, 1.0f)));
+    glm::fvec3 up = glm::normalize(finalPose.TransformDirection(glm::fvec3(0.0f, 1.0f, 0.0f)));
 
     float oldCameraDistance = glm::distance(oldCameraPosition, oldCameraTarget);
     glm::fvec3 target = camPos + forward * oldCameraDistance;
@@ -130,15 +120,20 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
     uint32_t ppc_cameraMatrixOffsetOut = hCPU->gpr[31];
     writeMemory(ppc_cameraMatrixOffsetOut, &actCam);
     s_framesSinceLastCameraUpdate = 0;
+
+    BETTERVR_COUNTER(s_cameraUpdates, "hooks.camera_updates");
+    s_cameraUpdates.Add();
 }
 
 glm::mat4 CemuHooks::s_lastCameraMtx = glm::mat4(1.0f);
+// the camera hooks run on several PPC threads, so every thread builds its own copy once per views generation
+static thread_local StereoCameraFrame t_stereoCameraFrame;
 
 void CemuHooks::hook_GetRenderCamera(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
     uint32_t cameraIn = hCPU->gpr[3];
     uint32_t cameraOut = hCPU->gpr[12];
-    OpenXR::EyeSide side = hCPU->gpr[11] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[11] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
     if (CemuHooks::UseBlackBarsDuringEvents()) {
         return;
@@ -151,16 +146,10 @@ void CemuHooks::hook_GetRenderCamera(PPCInterpreter_t* hCPU) {
 
     //s_lastCameraMtx = glm::fmat4x3(glm::inverse(glm::mat4(camera.mtx.getLEMatrix()))); // glm::inverse(glm::lookAtRH(camera.pos.getLE(), camera.at.getLE(), camera.up.getLE()));
 
-    // in-game camera
-    glm::mat4x3 viewMatrix = camera.mtx.getLEMatrix();
-    glm::mat4 worldGame = glm::inverse(glm::mat4(viewMatrix));
-    glm::vec3 basePos = glm::vec3(worldGame[3]);
-    glm::quat baseRot = glm::quat_cast(worldGame);
-
-    // overwrite with our stored camera pos/rot
-    basePos = s_wsCameraPosition;
-    baseRot = s_wsCameraRotation;
-    auto [swing, baseYaw] = swingTwistY(baseRot);
+    // use our stored camera pos/rot instead of the in-game camera
+    glm::vec3 basePos = s_wsCameraPosition;
+    glm::quat baseRot = s_wsCameraRotation;
+    auto [swing, baseYaw] = SwingTwistY(baseRot);
     glm::fquat baseYawWithoutClimbingFix = baseYaw;
 
     if (IsFirstPerson()) {
@@ -175,7 +164,7 @@ void CemuHooks::hook_GetRenderCamera(PPCInterpreter_t* hCPU) {
         if (auto settings = GetFirstPersonSettingsForActiveEvent()) {
             if (settings->ignoreCameraRotation) {
                 glm::fquat playerRot = mtx.getRotLE();
-                auto [swing, yaw] = swingTwistY(playerRot);
+                auto [swing, yaw] = SwingTwistY(playerRot);
                 baseYaw = yaw * glm::angleAxis(glm::radians(180.0f), glm::fvec3(0.0f, 1.0f, 0.0f));
                 baseYawWithoutClimbingFix = yaw * glm::angleAxis(glm::radians(180.0f), glm::fvec3(0.0f, 1.0f, 0.0f));
             }
@@ -186,22 +175,20 @@ void CemuHooks::hook_GetRenderCamera(PPCInterpreter_t* hCPU) {
         //}
     }
 
-    s_lastCameraMtx = glm::fmat4x3(glm::translate(glm::identity<glm::fmat4>(), basePos) * glm::mat4(baseYawWithoutClimbingFix));
+    s_lastCameraMtx = RigidPose(baseYawWithoutClimbingFix, basePos).ToMatrix();
 
     // vr camera
-    std::optional<XrPosef> currPoseOpt = VRManager::instance().XR->GetRenderer()->GetPose(side);
-    if (!currPoseOpt.has_value())
+    if (!t_stereoCameraFrame.Sync(GetHost()))
         return;
-    glm::fvec3 eyePos = ToGLM(currPoseOpt.value().position);
-    glm::fquat eyeRot = ToGLM(currPoseOpt.value().orientation);
+    glm::fvec3 eyePos = t_stereoCameraFrame.GetEye(side).pose.position;
+    glm::fquat eyeRot = t_stereoCameraFrame.GetEye(side).pose.rotation;
 
     glm::vec3 newPos = basePos + (baseYaw * eyePos);
     glm::fquat newRot = baseYaw * eyeRot;
 
-    glm::mat4 newWorldVR = glm::translate(glm::mat4(1.0f), newPos) * glm::mat4_cast(newRot);
-    glm::mat4 newViewVR = glm::inverse(newWorldVR);
+    glm::mat4 newViewVR = RigidPose(newRot, newPos).Inverse().ToMatrix();
 
-    camera.mtx.setLEMatrix(newViewVR);
+    camera.mtx.setLEMatrix(glm::mat4x3(newViewVR));
 
     camera.pos = newPos;
 
@@ -225,50 +212,6 @@ constexpr uint32_t seadOrthoProjection = 0x1027B5BC;
 constexpr uint32_t seadPerspectiveProjection = 0x1027B54C;
 
 
-// https://github.com/KhronosGroup/OpenXR-SDK/blob/858912260ca616f4c23f7fb61c89228c353eb124/src/common/xr_linear.h#L564C1-L632C2
-// https://github.com/aboood40091/sead/blob/45b629fb032d88b828600a1b787729f2d398f19d/engine/library/modules/src/gfx/seadProjection.cpp#L166
-
-static data_VRProjectionMatrixOut calculateFOVAndOffset(XrFovf viewFOV) {
-    float totalHorizontalFov = viewFOV.angleRight - viewFOV.angleLeft;
-    float totalVerticalFov = viewFOV.angleUp - viewFOV.angleDown;
-
-    float aspectRatio = totalHorizontalFov / totalVerticalFov;
-    float fovY = totalVerticalFov;
-    float projectionCenter_offsetX = (viewFOV.angleRight + viewFOV.angleLeft) / 2.0f;
-    float projectionCenter_offsetY = (viewFOV.angleUp + viewFOV.angleDown) / 2.0f;
-
-    data_VRProjectionMatrixOut ret = {};
-    ret.aspectRatio = aspectRatio;
-    ret.fovY = fovY;
-    ret.offsetX = projectionCenter_offsetX;
-    ret.offsetY = projectionCenter_offsetY;
-
-    return ret;
-}
-
-static glm::mat4 calculateProjectionMatrix(float nearZ, float farZ, const XrFovf& fov) {
-    float l = tanf(fov.angleLeft) * nearZ;
-    float r = tanf(fov.angleRight) * nearZ;
-    float b = tanf(fov.angleDown) * nearZ;
-    float t = tanf(fov.angleUp) * nearZ;
-
-    float invW = 1.0f / (r - l);
-    float invH = 1.0f / (t - b);
-    float invD = 1.0f / (farZ - nearZ);
-
-    glm::mat4 dst = {};
-    dst[0][0] = 2.0f * nearZ * invW;
-    dst[1][1] = 2.0f * nearZ * invH;
-    dst[0][2] = (r + l) * invW;
-    dst[1][2] = (t + b) * invH;
-    dst[2][2] = -(farZ + nearZ) * invD;
-    dst[2][3] = -(2.0f * farZ * nearZ) * invD;
-    dst[3][2] = -1.0f;
-    dst[3][3] = 0.0f;
-
-    return dst;
-}
-
 void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
@@ -278,7 +221,7 @@ void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
 
     uint32_t projectionIn = hCPU->gpr[3];
     uint32_t projectionOut = hCPU->gpr[12];
-    OpenXR::EyeSide side = hCPU->gpr[0] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[0] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
     BESeadPerspectiveProjection perspectiveProjection = {};
     readMemory(projectionIn, &perspectiveProjection);
@@ -292,39 +235,10 @@ void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
     perspectiveProjection.zFar = GetSettings().GetZFar();
     perspectiveProjection.zNear = GetSettings().GetZNear();
 
-    if (!VRManager::instance().XR->GetRenderer()->GetFOV(side).has_value()) {
+    if (!t_stereoCameraFrame.Sync(GetHost())) {
         return;
     }
-    XrFovf currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side).value();
-    auto newProjection = calculateFOVAndOffset(currFOV);
-
-    perspectiveProjection.aspect = newProjection.aspectRatio;
-    perspectiveProjection.fovYRadiansOrAngle = newProjection.fovY;
-    float halfAngle = newProjection.fovY.getLE() * 0.5f;
-    perspectiveProjection.fovySin = sinf(halfAngle);
-    perspectiveProjection.fovyCos = cosf(halfAngle);
-    perspectiveProjection.fovyTan = tanf(halfAngle);
-    perspectiveProjection.offset.x = newProjection.offsetX;
-    perspectiveProjection.offset.y = newProjection.offsetY;
-
-    glm::fmat4 newMatrix = calculateProjectionMatrix(perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), currFOV);
-    perspectiveProjection.matrix = newMatrix;
-
-    // calculate device matrix
-    glm::fmat4 newDeviceMatrix = newMatrix;
-
-    float zScale = perspectiveProjection.deviceZScale.getLE();
-    float zOffset = perspectiveProjection.deviceZOffset.getLE();
-
-    newDeviceMatrix[2][0] *= zScale;
-    newDeviceMatrix[2][1] *= zScale;
-    newDeviceMatrix[2][2] = (newDeviceMatrix[2][2] + newDeviceMatrix[3][2] * zOffset) * zScale;
-    newDeviceMatrix[2][3] = newDeviceMatrix[2][3] * zScale + newDeviceMatrix[3][3] * zOffset;
-
-    perspectiveProjection.deviceMatrix = newDeviceMatrix;
-
-    perspectiveProjection.dirty = false;
-    perspectiveProjection.deviceDirty = false;
+    t_stereoCameraFrame.ApplyTo(side, perspectiveProjection);
 
     writeMemory(projectionOut, &perspectiveProjection);
     hCPU->gpr[3] = projectionOut;
@@ -334,7 +248,7 @@ void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
 void CemuHooks::hook_ModifyLightPrePassProjectionMatrix(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    if (VRManager::instance().XR->GetRenderer() == nullptr) {
+    if (!GetHost().HasRenderer()) {
         return;
     }
 
@@ -343,48 +257,18 @@ void CemuHooks::hook_ModifyLightPrePassProjectionMatrix(PPCInterpreter_t* hCPU)
     }
 
     uint32_t projectionIn = hCPU->gpr[3];
-    OpenXR::EyeSide side = hCPU->gpr[11] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[11] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
     BESeadPerspectiveProjection perspectiveProjection = {};
     readMemory(projectionIn, &perspectiveProjection);
 
-    if (!VRManager::instance().XR->GetRenderer()->GetFOV(side).has_value()) {
+    if (!t_stereoCameraFrame.Sync(GetHost())) {
         return;
     }
 
     Log::print<RENDERING>("[{}] Modify light prepass projection", side);
 
-
-    XrFovf currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side).value();
-    auto newProjection = calculateFOVAndOffset(currFOV);
-
-    perspectiveProjection.aspect = newProjection.aspectRatio;
-    perspectiveProjection.fovYRadiansOrAngle = newProjection.fovY;
-    float halfAngle = newProjection.fovY.getLE() * 0.5f;
-    perspectiveProjection.fovySin = sinf(halfAngle);
-    perspectiveProjection.fovyCos = cosf(halfAngle);
-    perspectiveProjection.fovyTan = tanf(halfAngle);
-    perspectiveProjection.offset.x = newProjection.offsetX;
-    perspectiveProjection.offset.y = newProjection.offsetY;
-
-    glm::fmat4 newMatrix = calculateProjectionMatrix(perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), currFOV);
-    perspectiveProjection.matrix = newMatrix;
-
-    // calculate device matrix
-    glm::fmat4 newDeviceMatrix = newMatrix;
-
-    float zScale = perspectiveProjection.deviceZScale.getLE();
-    float zOffset = perspectiveProjection.deviceZOffset.getLE();
-
-    newDeviceMatrix[2][0] *= zScale;
-    newDeviceMatrix[2][1] *= zScale;
-    newDeviceMatrix[2][2] = (newDeviceMatrix[2][2] + newDeviceMatrix[3][2] * zOffset) * zScale;
-    newDeviceMatrix[2][3] = newDeviceMatrix[2][3] * zScale + newDeviceMatrix[3][3] * zOffset;
-
-    perspectiveProjection.deviceMatrix = newDeviceMatrix;
-
-    perspectiveProjection.dirty = false;
-    perspectiveProjection.deviceDirty = false;
+    t_stereoCameraFrame.ApplyTo(side, perspectiveProjection);
 
     writeMemory(projectionIn, &perspectiveProjection);
 }
@@ -392,10 +276,10 @@ void CemuHooks::hook_ModifyLightPrePassProjectionMatrix(PPCInterpreter_t* hCPU)
 void CemuHooks::hook_EndCameraSide(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    OpenXR::EyeSide side = hCPU->gpr[3] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    EyeSide side = hCPU->gpr[3] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
     // todo: sometimes this can deadlock apparently?
-    if (VRManager::instance().XR->GetRenderer()->IsInitialized() && side == OpenXR::EyeSide::RIGHT) {
+    if (GetHost().IsRendererInitialized() && side == EyeSide::RIGHT) {
         CemuHooks::m_heldWeaponsLastUpdate[0] = CemuHooks::m_heldWeaponsLastUpdate[0]++;
         CemuHooks::m_heldWeaponsLastUpdate[1] = CemuHooks::m_heldWeaponsLastUpdate[1]++;
         if (CemuHooks::m_heldWeaponsLastUpdate[0] >= 6) {
@@ -471,7 +355,10 @@ void CemuHooks::hook_CalculateModelOpacity(PPCInterpreter_t* hCPU) {
 
 std::string CemuHooks::s_currentEvent = {};
 CemuHooks::HybridEventSettings CemuHooks::s_currentEventSettings = {};
-std::unordered_map<std::string, CemuHooks::HybridEventSettings> CemuHooks::s_eventSettings = {};
+
+// entries in the graphic pack's table that differ from the table compiled into the layer
+static CutsceneSettings::Overrides s_eventSettingOverrides;
+static bool s_eventSettingsInitialized = false;
 
 constexpr CemuHooks::HybridEventSettings defaultFirstPersonSettings = {
     .firstPerson = true,
@@ -480,70 +367,37 @@ constexpr CemuHooks::HybridEventSettings defaultFirstPersonSettings = {
 };
 
 void CemuHooks::initCutsceneDefaultSettings(uint32_t ppc_TableOfCutsceneEventsSettingsOffset) {
-    if (!s_eventSettings.empty()) {
+    if (s_eventSettingsInitialized) {
         return;
     }
+    s_eventSettingsInitialized = true;
 
-    char* currPtr = reinterpret_cast<char*>(s_memoryBaseAddress + ppc_TableOfCutsceneEventsSettingsOffset);
-    while (true) {
-        const std::string line(currPtr);
-        if (line.empty()) {
-            break;
-        }
-        size_t commaPos = line.find(',');
-        if (commaPos != std::string::npos) {
-            HybridEventSettings entry = {};
-            std::string settingsStr = line.substr(commaPos + 1);
-            std::string eventName = line.substr(0, commaPos);
-            size_t pos = 0;
-            while ((pos = settingsStr.find(',')) != std::string::npos) {
-                std::string setting = settingsStr.substr(0, pos);
-                if (setting == "FP_ON") entry.firstPerson = true;
-                else if (setting == "FP_OFF")
-                    entry.firstPerson = false;
-                else if (setting == "HND_ON")
-                    entry.disablePlayerDrivenLinkHands = false;
-                else if (setting == "HND_OFF")
-                    entry.disablePlayerDrivenLinkHands = true;
-                else if (setting == "PAN_ON")
-                    entry.ignoreCameraRotation = false;
-                else if (setting == "PAN_OFF")
-                    entry.ignoreCameraRotation = true;
-                else if (setting == "CTRL_ON")
-                    entry.demoEnableCameraInput = false;
-                else if (setting == "CTRL_OFF")
-                    entry.demoEnableCameraInput = true;
-                else {
-                    Log::print<WARNING>("Unknown cutscene default setting: {}", setting);
-                }
-                settingsStr.erase(0, pos + 1);
-            }
-            // last setting
-            std::string setting = settingsStr;
-            if (setting == "FP_ON") entry.firstPerson = true;
-            else if (setting == "FP_OFF")
-                entry.firstPerson = false;
-            else if (setting == "HND_ON")
-                entry.disablePlayerDrivenLinkHands = false;
-            else if (setting == "HND_OFF")
-                entry.disablePlayerDrivenLinkHands = true;
-            else if (setting == "PAN_ON")
-                entry.ignoreCameraRotation = false;
-            else if (setting == "PAN_OFF")
-                entry.ignoreCameraRotation = true;
-            else if (setting == "CTRL_ON")
-                entry.demoEnableCameraInput = false;
-            else if (setting == "CTRL_OFF")
-                entry.demoEnableCameraInput = true;
-            else {
-                Log::print<WARNING>("Unknown cutscene default setting: {}", setting);
-            }
-            s_eventSettings.insert_or_assign(eventName, entry);
-        }
-        currPtr += line.length() + 1;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // the table is a list of strings that ends with an empty one, which is measured first so that it's read as a single range
+    const char* tableStart = reinterpret_cast<const char*>(s_memoryBaseAddress + ppc_TableOfCutsceneEventsSettingsOffset);
+    const char* tableEnd = tableStart;
+    while (*tableEnd != '\0') {
+        tableEnd += strlen(tableEnd) + 1;
     }
+    const char* table = (const char*)getMemoryRange(ppc_TableOfCutsceneEventsSettingsOffset, tableEnd - tableStart + 1);
+
+    // the table is compiled into the layer, so the one in the graphic pack only needs to be checked for entries the user changed
+    const size_t entryCount = CutsceneSettings::ReadOverrides(table, s_eventSettingOverrides, [](std::string_view setting) {
+        Log::print<WARNING>("Unknown cutscene default setting: {}", setting);
+    });
 
-    Log::print<VERBOSE>("Initialized cutscene default settings for {} events.", s_eventSettings.size());
+    const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+    Log::print<VERBOSE>("Initialized cutscene default settings for {} events ({} differ from the built-in table) in {:.3f} ms.", entryCount, s_eventSettingOverrides.size(), duration.count());
+}
+
+std::optional<CemuHooks::HybridEventSettings> CemuHooks::FindEventSettings(std::string_view eventName) {
+    if (!s_eventSettingOverrides.empty()) {
+        if (auto it = s_eventSettingOverrides.find(eventName); it != s_eventSettingOverrides.end()) {
+            return it->second;
+        }
+    }
+    return CutsceneSettings::FindDefault(eventName);
 }
 
 
@@ -556,16 +410,15 @@ void CemuHooks::hook_GetEventName(PPCInterpreter_t* hCPU) {
     uint32_t eventNamePtr = hCPU->gpr[4];
 
     if (isEventActive) {
-        std::string eventName = std::string((char*)s_memoryBaseAddress + eventNamePtr);
+        std::string_view eventName = getString(eventNamePtr);
         if (s_currentEvent == eventName) {
             return;
         }
         Log::print<INFO>("Event '{}' is now active.", eventName);
         s_currentEvent = eventName;
 
-        auto it = s_eventSettings.find(eventName);
-        if (it != s_eventSettings.end()) {
-            HybridEventSettings settings = it->second;
+        if (auto eventSettings = FindEventSettings(eventName); eventSettings.has_value()) {
+            HybridEventSettings settings = *eventSettings;
             Log::print<INFO>(" - First Person: {}", settings.firstPerson ? "ON" : "OFF");
             Log::print<INFO>(" - Ignore Camera Rotation: {}", settings.ignoreCameraRotation ? "ON" : "OFF");
             Log::print<INFO>(" - Disable Player-Driven Link Hands: {}", settings.disablePlayerDrivenLinkHands ? "ON" : "OFF");
@@ -593,17 +446,15 @@ void CemuHooks::hook_OverwriteCameraParam(PPCInterpreter_t* hCPU) {
 
     uint32_t actionPtr = hCPU->gpr[3];
     uint32_t destFloatPtr = hCPU->gpr[4];
-    const char* paramName = (const char*)(s_memoryBaseAddress + getMemory<BEType<uint32_t>>(hCPU->gpr[5]).getLE());
+    std::string_view paramName = getString(getMemory<BEType<uint32_t>>(hCPU->gpr[5]).getLE());
 
-    if (actionPtr == 0 || destFloatPtr == 0 || paramName == nullptr) {
+    if (actionPtr == 0 || destFloatPtr == 0) {
         hCPU->instructionPointer = orig_GetStaticParam_float_funcAddr;
         return;
     }
-    
-    std::string paramNameStr = paramName;
 
     hCPU->instructionPointer = hCPU->sprNew.LR;
-    if (paramNameStr == "JumpHeight") {
+    if (paramName == "JumpHeight") {
         // override jump height to 1.2 in first person mode to temporarily workaround the increased gravity effect
         uint32_t superLowAddress = 0x100C50D0; // points to 1.2
         writeMemoryBE(hCPU->gpr[4], &superLowAddress);
@@ -622,7 +473,7 @@ void CemuHooks::hook_OverwriteCameraParam(PPCInterpreter_t* hCPU) {
 void CemuHooks::hook_FixLadder(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    auto input = VRManager::instance().XR->m_input.load();
+    auto input = GetHost().GetInput();
 
     if (input.inGame.in_game && s_isLadderClimbing == 0) {
         return;
@@ -0,0 +1,75 @@
+#include "cemu_hooks.h"
+
+uint64_t CemuHooks::s_memoryBaseAddress = 0;
+HookHost* CemuHooks::s_host = nullptr;
+
+CemuExports CemuExports::FromCurrentProcess() {
+    CemuExports exports = {
+        .osLib_registerHLEFunction = (osLib_registerHLEFunctionPtr_t)Platform::GetProcessExport("osLib_registerHLEFunction"),
+        .memory_getBase = (memory_getBasePtr_t)Platform::GetProcessExport("memory_getBase"),
+        .gameMeta_getTitleId = (gameMeta_getTitleIdPtr_t)Platform::GetProcessExport("gameMeta_getTitleId")
+    };
+    checkAssert(exports.gameMeta_getTitleId != nullptr && exports.memory_getBase != nullptr && exports.osLib_registerHLEFunction != nullptr, "Failed to get function pointers of Cemu functions! Is this hook being used on Cemu?");
+    return exports;
+}
+
+CemuHooks::CemuHooks(HookHost& host, const CemuExports& exports): m_exports(exports) {
+    s_host = &host;
+
+    bool isSupportedTitleId = m_exports.gameMeta_getTitleId() == 0x00050000101C9300 || m_exports.gameMeta_getTitleId() == 0x00050000101C9400 || m_exports.gameMeta_getTitleId() == 0x00050000101C9500;
+    checkAssert(isSupportedTitleId, std::format("Expected title IDs for Breath of the Wild (00050000-101C9300, 00050000-101C9400 or 00050000-101C9500) but received {:16x}!", m_exports.gameMeta_getTitleId()).c_str());
+
+    s_memoryBaseAddress = (uint64_t)m_exports.memory_getBase();
+    checkAssert(s_memoryBaseAddress != 0, "Failed to get memory base address of Cemu process!");
+
+
+    registerHook<&hook_UpdateSettings>("hook_UpdateSettings");
+
+    // Actor Hooks
+    registerHook<&hook_UpdateActorList>("hook_UpdateActorList");
+    registerHook<&hook_CreateNewActor>("hook_CreateNewActor");
+
+    // Camera Hooks
+    registerHook<&hook_BeginCameraSide>("hook_BeginCameraSide");
+    registerHook<&hook_ModifyLightPrePassProjectionMatrix>("hook_ModifyLightPrePassProjectionMatrix");
+    registerHook<&hook_UpdateCameraForGameplay>("hook_UpdateCameraForGameplay");
+    registerHook<&hook_GetRenderCamera>("hook_GetRenderCamera");
+    registerHook<&hook_GetRenderProjection>("hook_GetRenderProjection");
+    registerHook<&hook_EndCameraSide>("hook_EndCameraSide");
+
+    registerHook<&hook_UseCameraDistance>("hook_UseCameraDistance");
+    registerHook<&hook_ReplaceCameraMode>("hook_ReplaceCameraMode");
+    registerHook<&hook_GetEventName>("hook_GetEventName");
+    registerHook<&hook_OverwriteCameraParam>("hook_OverwriteCameraParam");
+    registerHook<&hook_PlayerLadderFix>("hook_PlayerLadderFix");
+
+    // First-Person Model Hooks
+    registerHook<&hook_SetActorOpacity>("hook_SetActorOpacity");
+    registerHook<&hook_CalculateModelOpacity>("hook_CalculateModelOpacity");
+    registerHook<&hook_ModifyBoneMatrix>("hook_ModifyBoneMatrix");
+    registerHook<&hook_ChangeWeaponMtx>("hook_ChangeWeaponMtx");
+
+    // First-Person Weapon Hooks
+    registerHook<&hook_EquipWeapon>("hook_EquipWeapon");
+    registerHook<&hook_DropEquipment>("hook_DropEquipment");
+    registerHook<&hook_EnableWeaponAttackSensor>("hook_EnableWeaponAttackSensor");
+    registerHook<&hook_SetPlayerWeaponScale>("hook_SetPlayerWeaponScale");
+    registerHook<&hook_GetContactLayerOfAttack>("hook_GetContactLayerOfAttack");
+
+    // Input Hooks
+    registerHook<&hook_InjectXRInput>("hook_InjectXRInput");
+    registerHook<&hook_XRRumble_VPADControlMotor>("hook_XRRumble_VPADControlMotor");
+    registerHook<&hook_XRRumble_VPADStopMotor>("hook_XRRumble_VPADStopMotor");
+
+    // Logging/Debugging Hooks
+    registerHook<&hook_OSReportToConsole>("hook_OSReportToConsole");
+    registerHook<&hook_DropWeaponLogging>("hook_DropWeaponLogging");
+    registerHook<&hook_ModifyHandModelAccessSearch>("hook_ModifyHandModelAccessSearch");
+    registerHook<&hook_CreateNewScreen>("hook_CreateNewScreen");
+    registerHook<&hook_RouteActorJob>("hook_RouteActorJob");
+    registerHook<&hook_FixLadder>("hook_FixLadder");
+}
+
+CemuHooks::~CemuHooks() {
+    s_host = nullptr;
+}
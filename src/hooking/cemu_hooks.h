@@ -1,79 +1,23 @@
 #pragma once
-#include "entity_debugger.h"
+#include "actor_registry.h"
+#include "actor_types.h"
+#include "hook_host.h"
+#include "screen_tracker.h"
+#include "hook_profiler.h"
+#include "event_settings.h"
 
 
+// The HLE hooks that the graphic pack calls into. The hooks only access the game through guest memory and everything else through
+// the HookHost, so they don't depend on Cemu or the layer and can also run against a GuestArena (see tools/hook_replay).
 class CemuHooks {
 public:
-    CemuHooks() {
-        m_cemuHandle = GetModuleHandleA(NULL);
-        checkAssert(m_cemuHandle != NULL, "Failed to get handle of Cemu process which is required for interfacing with Cemu!");
-
-        gameMeta_getTitleId = (gameMeta_getTitleIdPtr_t)GetProcAddress(m_cemuHandle, "gameMeta_getTitleId");
-        memory_getBase = (memory_getBasePtr_t)GetProcAddress(m_cemuHandle, "memory_getBase");
-        osLib_registerHLEFunction = (osLib_registerHLEFunctionPtr_t)GetProcAddress(m_cemuHandle, "osLib_registerHLEFunction");
-        checkAssert(gameMeta_getTitleId != nullptr && memory_getBase != nullptr && osLib_registerHLEFunction != nullptr, "Failed to get function pointers of Cemu functions! Is this hook being used on Cemu?");
-
-        bool isSupportedTitleId = gameMeta_getTitleId() == 0x00050000101C9300 || gameMeta_getTitleId() == 0x00050000101C9400 || gameMeta_getTitleId() == 0x00050000101C9500;
-        checkAssert(isSupportedTitleId, std::format("Expected title IDs for Breath of the Wild (00050000-101C9300, 00050000-101C9400 or 00050000-101C9500) but received {:16x}!", gameMeta_getTitleId()).c_str());
-
-        s_memoryBaseAddress = (uint64_t)memory_getBase();
-        checkAssert(s_memoryBaseAddress != 0, "Failed to get memory base address of Cemu process!");
-
-
-        osLib_registerHLEFunction("coreinit", "hook_UpdateSettings", &hook_UpdateSettings);
-
-        // Actor Hooks
-        osLib_registerHLEFunction("coreinit", "hook_UpdateActorList", &hook_UpdateActorList);
-        osLib_registerHLEFunction("coreinit", "hook_CreateNewActor", &hook_CreateNewActor);
-
-        // Camera Hooks
-        osLib_registerHLEFunction("coreinit", "hook_BeginCameraSide", &hook_BeginCameraSide);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyLightPrePassProjectionMatrix", &hook_ModifyLightPrePassProjectionMatrix);
-        osLib_registerHLEFunction("coreinit", "hook_UpdateCameraForGameplay", &hook_UpdateCameraForGameplay);
-        osLib_registerHLEFunction("coreinit", "hook_GetRenderCamera", &hook_GetRenderCamera);
-        osLib_registerHLEFunction("coreinit", "hook_GetRenderProjection", &hook_GetRenderProjection);
-        osLib_registerHLEFunction("coreinit", "hook_EndCameraSide", &hook_EndCameraSide);
-
-        osLib_registerHLEFunction("coreinit", "hook_UseCameraDistance", &hook_UseCameraDistance);
-        osLib_registerHLEFunction("coreinit", "hook_ReplaceCameraMode", &hook_ReplaceCameraMode);
-        osLib_registerHLEFunction("coreinit", "hook_GetEventName", &hook_GetEventName);
-        osLib_registerHLEFunction("coreinit", "hook_OverwriteCameraParam", &hook_OverwriteCameraParam);
-        osLib_registerHLEFunction("coreinit", "hook_PlayerLadderFix", &hook_PlayerLadderFix);
-
-        // First-Person Model Hooks
-        osLib_registerHLEFunction("coreinit", "hook_SetActorOpacity", &hook_SetActorOpacity);
-        osLib_registerHLEFunction("coreinit", "hook_CalculateModelOpacity", &hook_CalculateModelOpacity);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyBoneMatrix", &hook_ModifyBoneMatrix);
-        osLib_registerHLEFunction("coreinit", "hook_ChangeWeaponMtx", &hook_ChangeWeaponMtx);
-
-        // First-Person Weapon Hooks
-        osLib_registerHLEFunction("coreinit", "hook_EquipWeapon", &hook_EquipWeapon);
-        osLib_registerHLEFunction("coreinit", "hook_DropEquipment", &hook_DropEquipment);
-        osLib_registerHLEFunction("coreinit", "hook_EnableWeaponAttackSensor", &hook_EnableWeaponAttackSensor);
-        osLib_registerHLEFunction("coreinit", "hook_SetPlayerWeaponScale", &hook_SetPlayerWeaponScale);
-        osLib_registerHLEFunction("coreinit", "hook_GetContactLayerOfAttack", &hook_GetContactLayerOfAttack);
-
-        // Input Hooks
-        osLib_registerHLEFunction("coreinit", "hook_InjectXRInput", &hook_InjectXRInput);
-        osLib_registerHLEFunction("coreinit", "hook_XRRumble_VPADControlMotor", &hook_XRRumble_VPADControlMotor);
-        osLib_registerHLEFunction("coreinit", "hook_XRRumble_VPADStopMotor", &hook_XRRumble_VPADStopMotor);
-
-        // Logging/Debugging Hooks
-        osLib_registerHLEFunction("coreinit", "hook_OSReportToConsole", &hook_OSReportToConsole);
-        osLib_registerHLEFunction("coreinit", "hook_DropWeaponLogging", &hook_DropWeaponLogging);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyHandModelAccessSearch", &hook_ModifyHandModelAccessSearch);
-        osLib_registerHLEFunction("coreinit", "hook_CreateNewScreen", &hook_CreateNewScreen);
-        osLib_registerHLEFunction("coreinit", "hook_RouteActorJob", &hook_RouteActorJob);
-        osLib_registerHLEFunction("coreinit", "hook_FixLadder", &hook_FixLadder);
-    };
-    ~CemuHooks() {
-        FreeLibrary(m_cemuHandle);
-    };
+    CemuHooks(HookHost& host, const CemuExports& exports);
+    ~CemuHooks();
 
     static data_VRSettingsIn GetSettings();
-    static uint64_t GetMemoryBaseAddress() { return s_memoryBaseAddress; }    
+    static uint64_t GetMemoryBaseAddress() { return s_memoryBaseAddress; }
+    static HookHost& GetHost() { return *s_host; }
 
-    std::unique_ptr<class EntityDebugger> m_entityDebugger;
     static std::array<class WeaponMotionAnalyser, 2> m_motionAnalyzers;
     static std::array<uint32_t, 2> m_heldWeapons;
     static std::array<uint32_t, 2> m_heldWeaponsLastUpdate;
@@ -83,27 +27,26 @@ public:
     static glm::fvec3 s_playerPos;
     static glm::mat4 s_lastCameraMtx;
 
-    // If the user is unable to control the camera, we can guess that they're in a cutscene
-    struct HybridEventSettings {
-        bool firstPerson;                  // use Link's perspective, ignore the animated event camera
-        bool disablePlayerDrivenLinkHands; // let event control the hands instead of the VR controllers
-        bool ignoreCameraRotation;         // some events will pan the camera, but in first-person it should usually be ignored to avoid nausea. Doors opening is okay, but panning down to a chest is not.
-        bool demoEnableCameraInput;        // there's already events that allow user camera control. This isn't used or overwritten atm.
-    };
+    // resolves the type of an actor through its vtable, only comparing names for vtables that weren't seen yet
+    static ActorClass GetActorClass(uint32_t actorPtr);
+    // the actors that were added, removed or replaced since the last call, for the entity debugger
+    static void CollectActorDiff(ActorRegistry::Diff& diff);
+
+    using HybridEventSettings = ::HybridEventSettings;
 
     static uint32_t GetFramesSinceLastCameraUpdate() { return s_framesSinceLastCameraUpdate.load(); }
     static bool IsInGame() {
         // todo: check if 3 frames is the right threshold
-        return GetFramesSinceLastCameraUpdate() <= 4 && !IsScreenOpen(ScreenId::PauseMenuInfo_00);
+        return GetFramesSinceLastCameraUpdate() <= 4 && !s_pauseMenuOpen.load(std::memory_order_relaxed);
     }
     static bool IsShowingMenu() {
-        return !IsInGame() || IsScreenOpen(ScreenId::ShopBG_00) || IsScreenOpen(ScreenId::MessageDialog);
+        return !IsInGame() || s_openMenuScreens.load(std::memory_order_relaxed) != 0;
     }
 
     static std::string s_currentEvent;
     static HybridEventSettings s_currentEventSettings;
-    static std::unordered_map<std::string, HybridEventSettings> s_eventSettings;
     static void initCutsceneDefaultSettings(uint32_t ppc_TableOfCutsceneEventsSettingsOffset);
+    static std::optional<HybridEventSettings> FindEventSettings(std::string_view eventName);
 
     static bool HasActiveCutscene() {
         return !s_currentEvent.empty();
@@ -179,16 +122,28 @@ public:
     static void DrawDebugOverlays();
 
 private:
-    HMODULE m_cemuHandle;
-
-    osLib_registerHLEFunctionPtr_t osLib_registerHLEFunction;
-    memory_getBasePtr_t memory_getBase;
-    gameMeta_getTitleIdPtr_t gameMeta_getTitleId;
+    CemuExports m_exports;
+
+    template <HookProfiler::HookFunction Hook>
+    void registerHook(const char* name) {
+        HookProfiler::Register<Hook>(name);
+#ifdef BETTERVR_HOOK_PROFILER
+        m_exports.osLib_registerHLEFunction("coreinit", name, &HookProfiler::Profiled<Hook>);
+#else
+        m_exports.osLib_registerHLEFunction("coreinit", name, &HookProfiler::Captured<Hook>);
+#endif
+    }
 
     static uint64_t s_memoryBaseAddress;
+    static HookHost* s_host;
     static std::atomic_uint32_t s_framesSinceLastCameraUpdate;
+    static ActorTypeCache s_actorTypes;
+    static ScreenTracker s_screenTracker;
+    // only updated when the screen tracker reports that one of these screens was opened or closed
+    static std::atomic_bool s_pauseMenuOpen;
+    static std::atomic_uint32_t s_openMenuScreens;
 
-    static bool IsScreenOpen(ScreenId screen);
+    static void OnScreenEvents(std::span<const ScreenTracker::ScreenEvent> events);
     static void hook_UpdateSettings(PPCInterpreter_t* hCPU);
 
     // Actor Hooks
@@ -238,17 +193,26 @@ private:
 public:
     template <typename T>
     static void writeMemoryBE(uint64_t offset, T* valuePtr) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, sizeof(T), true);
+        }
         *valuePtr = swapEndianness(*valuePtr);
         memcpy((void*)(s_memoryBaseAddress + offset), (void*)valuePtr, sizeof(T));
     }
 
     template <typename T>
     static void writeMemory(uint64_t offset, T* valuePtr) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, sizeof(T), true);
+        }
         memcpy((void*)(s_memoryBaseAddress + offset), (void*)valuePtr, sizeof(T));
     }
 
     template <typename T>
     static void readMemoryBE(uint64_t offset, T* resultPtr) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, sizeof(T), false);
+        }
         uint64_t memoryAddress = s_memoryBaseAddress + offset;
         memcpy(resultPtr, (void*)memoryAddress, sizeof(T));
         *resultPtr = swapEndianness(*resultPtr);
@@ -256,10 +220,38 @@ public:
 
     template <typename T>
     static void readMemory(uint64_t offset, T* resultPtr) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, sizeof(T), false);
+        }
         uint64_t memoryAddress = s_memoryBaseAddress + offset;
         memcpy(resultPtr, (void*)memoryAddress, sizeof(T));
     }
 
+    static void readMemoryBytes(uint64_t offset, void* buffer, size_t size) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, size, false);
+        }
+        memcpy(buffer, (void*)(s_memoryBaseAddress + offset), size);
+    }
+
+    // reads a null-terminated string in place, which stops after maxLength characters if there's no terminator before that
+    static std::string_view getString(uint64_t offset, size_t maxLength = 0x100) {
+        const char* str = (const char*)(s_memoryBaseAddress + offset);
+        const size_t length = strnlen(str, maxLength);
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, std::min(length + 1, maxLength), false);
+        }
+        return std::string_view(str, length);
+    }
+
+    // for reading larger structures in place instead of copying them, the whole range counts as read
+    static const uint8_t* getMemoryRange(uint64_t offset, size_t size) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            HookCapture::OnAccess(offset, size, false);
+        }
+        return (const uint8_t*)(s_memoryBaseAddress + offset);
+    }
+
     template <typename T>
     static auto getMemory(uint64_t offset) {
         if constexpr (is_BEType_v<T>) {
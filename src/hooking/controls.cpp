@@ -1,5 +1,5 @@
 #include "cemu_hooks.h"
-#include "../instance.h"
+#include "rumble.h"
 
 enum VPADButtons : uint32_t {
     VPAD_BUTTON_A                 = 0x8000,
@@ -108,16 +108,17 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
     uint32_t vpadStatusOffset = hCPU->gpr[4];
     VPADStatus vpadStatus = {};
 
-    auto* renderer = VRManager::instance().XR->GetRenderer();
+    HookHost& host = GetHost();
     // todo: revert this to unblock gamepad input
-    if (!(renderer && renderer->m_imguiOverlay && renderer->m_imguiOverlay->ShouldBlockGameInput())) {
+    if (!host.ShouldBlockGameInput()) {
         readMemory(vpadStatusOffset, &vpadStatus);
     }
 
-    OpenXR::InputState inputs = VRManager::instance().XR->m_input.load();
+    InputState inputs = host.GetInput();
+    host.OnInputUsed();
     inputs.inGame.drop_weapon[0] = inputs.inGame.drop_weapon[1] = false;
     // fetch game state
-    auto gameState = VRManager::instance().XR->m_gameState.load();
+    auto gameState = host.GetGameState();
     gameState.in_game = inputs.inGame.in_game;
 
     // buttons
@@ -131,7 +132,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
     bool rightHandCloseEnoughFromHead = false;
 
     // fetching motion states for gesture based inputs
-    const auto headset = VRManager::instance().XR->GetRenderer()->GetMiddlePose();
+    const auto headset = host.GetMiddlePose();
     if (headset.has_value()) {
         const auto headsetMtx = headset.value();
         const auto headsetPosition = glm::fvec3(headsetMtx[3]);
@@ -247,7 +248,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
 
         if (leftHandCloseEnoughFromHead && leftHandBehindHead)
         {
-            VRManager::instance().XR->GetRumbleManager()->startSimpleRumble(true, 0.01f, 0.05f, 0.1f);
+            host.GetRumbleManager()->startSimpleRumble(true, 0.01f, 0.05f, 0.1f);
             //Throw weapon left hand
             if (inputs.inGame.grabState[0].wasDownLastFrame)
                 newXRBtnHold |= VPAD_BUTTON_R;
@@ -275,7 +276,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
         }
         
         if (rightHandCloseEnoughFromHead && rightHandBehindHead) {
-            VRManager::instance().XR->GetRumbleManager()->startSimpleRumble(false, 0.01f, 0.05f, 0.1f);
+            host.GetRumbleManager()->startSimpleRumble(false, 0.01f, 0.05f, 0.1f);
             //Throw weapon right hand
             if (inputs.inGame.grabState[1].wasDownLastFrame)
                 newXRBtnHold |= VPAD_BUTTON_R;
@@ -330,10 +331,10 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
             return glm::angleAxis(euler.y, glm::vec3(0, 1, 0));
         };
 
-        glm::fquat controllerRotation = ToGLM(inputs.inGame.poseLocation[OpenXR::EyeSide::LEFT].pose.orientation);
+        glm::fquat controllerRotation = ToGLM(inputs.inGame.poseLocation[EyeSide::LEFT].pose.orientation);
         glm::fquat controllerYawRotation = isolateYaw(controllerRotation);
 
-        glm::fquat moveRotation = inputs.inGame.pose[OpenXR::EyeSide::LEFT].isActive ? glm::inverse(VRManager::instance().XR->m_inputCameraRotation.load() * controllerYawRotation) : glm::identity<glm::fquat>();
+        glm::fquat moveRotation = inputs.inGame.pose[EyeSide::LEFT].isActive ? glm::inverse(host.GetInputCameraRotation() * controllerYawRotation) : glm::identity<glm::fquat>();
 
         glm::vec3 localMoveVec(leftStickSource.currentState.x, 0.0f, leftStickSource.currentState.y);
 
@@ -408,8 +409,8 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
 
     // set previous game states
     gameState.was_in_game = gameState.in_game;
-    VRManager::instance().XR->m_gameState.store(gameState);
-    VRManager::instance().XR->m_input.store(inputs);
+    host.SetGameState(gameState);
+    host.SetInput(inputs);
 }
 
 
@@ -435,11 +436,11 @@ void CemuHooks::hook_CreateNewActor(PPCInterpreter_t* hCPU) {
     // }
     //
     // // test if controller is connected
-    // if (inputs.inGame.grab[OpenXR::EyeSide::LEFT].currentState == XR_TRUE && inputs.inGame.grab[OpenXR::EyeSide::LEFT].changedSinceLastSync == XR_TRUE) {
+    // if (inputs.inGame.grab[EyeSide::LEFT].currentState == XR_TRUE && inputs.inGame.grab[EyeSide::LEFT].changedSinceLastSync == XR_TRUE) {
     //     Log::print("Trying to spawn new thing!");
     //     hCPU->gpr[3] = 1;
     // }
-    // else if (inputs.inGame.grab[OpenXR::EyeSide::RIGHT].currentState == XR_TRUE && inputs.inGame.grab[OpenXR::EyeSide::RIGHT].changedSinceLastSync == XR_TRUE) {
+    // else if (inputs.inGame.grab[EyeSide::RIGHT].currentState == XR_TRUE && inputs.inGame.grab[EyeSide::RIGHT].changedSinceLastSync == XR_TRUE) {
     //     Log::print("Trying to spawn new thing!");
     //     hCPU->gpr[3] = 1;
     // }
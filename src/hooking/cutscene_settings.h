@@ -0,0 +1,130 @@
+#pragma once
+#include "event_settings.h"
+#include "utils/name_set.h"
+
+// generated from the graphic pack's patch_Settings_Cutscenes.asm by CMake
+#include "cutscene_settings_table.h"
+
+namespace CutsceneSettings {
+    // applies a single flag from a table entry, returns false for unknown flags
+    constexpr bool ApplyFlag(std::string_view flag, HybridEventSettings& settings) {
+        if (flag == "FP_ON")
+            settings.firstPerson = true;
+        else if (flag == "FP_OFF")
+            settings.firstPerson = false;
+        else if (flag == "HND_ON")
+            settings.disablePlayerDrivenLinkHands = false;
+        else if (flag == "HND_OFF")
+            settings.disablePlayerDrivenLinkHands = true;
+        else if (flag == "PAN_ON")
+            settings.ignoreCameraRotation = false;
+        else if (flag == "PAN_OFF")
+            settings.ignoreCameraRotation = true;
+        else if (flag == "CTRL_ON")
+            settings.demoEnableCameraInput = false;
+        else if (flag == "CTRL_OFF")
+            settings.demoEnableCameraInput = true;
+        else
+            return false;
+        return true;
+    }
+
+    // splits an "<eventName>,<flag>,<flag>..." entry, calling onUnknownFlag for flags that aren't recognized
+    template <typename F>
+    constexpr std::string_view ParseEntry(std::string_view entry, HybridEventSettings& settings, F&& onUnknownFlag) {
+        const size_t commaPos = entry.find(',');
+        std::string_view eventName = entry.substr(0, commaPos);
+        settings = {};
+
+        std::string_view flags = commaPos == std::string_view::npos ? std::string_view() : entry.substr(commaPos + 1);
+        while (!flags.empty()) {
+            const size_t nextComma = flags.find(',');
+            std::string_view flag = flags.substr(0, nextComma);
+            if (!ApplyFlag(flag, settings)) {
+                onUnknownFlag(flag);
+            }
+            flags = nextComma == std::string_view::npos ? std::string_view() : flags.substr(nextComma + 1);
+        }
+        return eventName;
+    }
+
+    inline constexpr size_t ENTRY_COUNT = CUTSCENE_SETTINGS_TABLE.size();
+
+    struct ParsedTable {
+        std::array<std::string_view, ENTRY_COUNT> eventNames;
+        std::array<HybridEventSettings, ENTRY_COUNT> settings;
+    };
+
+    consteval ParsedTable ParseTable() {
+        ParsedTable table = {};
+        for (size_t i = 0; i < ENTRY_COUNT; i++) {
+            table.eventNames[i] = ParseEntry(CUTSCENE_SETTINGS_TABLE[i], table.settings[i], [](std::string_view) { throw "Unknown flag in the cutscene settings table"; });
+        }
+        return table;
+    }
+
+    inline constexpr ParsedTable PARSED_TABLE = ParseTable();
+    inline constexpr const std::array<std::string_view, ENTRY_COUNT>& EVENT_NAME_LIST = PARSED_TABLE.eventNames;
+    inline constexpr const std::array<HybridEventSettings, ENTRY_COUNT>& EVENT_SETTINGS = PARSED_TABLE.settings;
+    inline constexpr NameSet EVENT_NAMES = PARSED_TABLE.eventNames;
+
+    // settings from the compiled table, without any of the user's overrides
+    constexpr std::optional<HybridEventSettings> FindDefault(std::string_view eventName) {
+        if (int32_t idx = EVENT_NAMES.find(eventName); idx != -1) {
+            return EVENT_SETTINGS[idx];
+        }
+        return std::nullopt;
+    }
+
+    struct EventNameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view eventName) const { return std::hash<std::string_view>{}(eventName); }
+    };
+
+    // entries in the graphic pack's table that differ from the compiled table, or std::nullopt if they were removed
+    using Overrides = std::unordered_map<std::string, std::optional<HybridEventSettings>, EventNameHash, std::equal_to<>>;
+
+    // reads the graphic pack's table, which is a list of null-terminated entries that ends with an empty string,
+    // and replaces the overrides with the entries that the user changed, returns the number of entries in the table
+    template <typename F>
+    size_t ReadOverrides(const char* table, Overrides& overrides, F&& onUnknownFlag) {
+        overrides.clear();
+        std::array<bool, ENTRY_COUNT> foundInTable = {};
+        size_t entryCount = 0;
+
+        const char* currPtr = table;
+        while (true) {
+            const std::string_view line(currPtr);
+            if (line.empty()) {
+                break;
+            }
+            currPtr += line.length() + 1;
+
+            if (!line.contains(',')) {
+                continue;
+            }
+
+            HybridEventSettings entry = {};
+            std::string_view eventName = ParseEntry(line, entry, onUnknownFlag);
+            entryCount++;
+
+            if (int32_t idx = EVENT_NAMES.find(eventName); idx != -1) {
+                foundInTable[idx] = true;
+                if (EVENT_SETTINGS[idx] == entry) {
+                    if (auto it = overrides.find(eventName); it != overrides.end()) {
+                        overrides.erase(it);
+                    }
+                    continue;
+                }
+            }
+            overrides.insert_or_assign(std::string(eventName), entry);
+        }
+
+        for (size_t i = 0; i < ENTRY_COUNT; i++) {
+            if (!foundInTable[i]) {
+                overrides.try_emplace(std::string(EVENT_NAME_LIST[i]), std::nullopt);
+            }
+        }
+        return entryCount;
+    }
+}
@@ -7,86 +7,44 @@
 
 #include "implot3d_internal.h"
 
-std::mutex g_actorListMutex;
-std::unordered_map<uint32_t, std::pair<std::string, uint32_t>> s_knownActors;
-glm::fvec3 CemuHooks::s_playerPos = {};
-uint32_t CemuHooks::s_playerMtxAddress = 0;
-uint32_t CemuHooks::s_cameraMtxAddress = 0;
-
-void CemuHooks::hook_UpdateActorList(PPCInterpreter_t* hCPU) {
-    hCPU->instructionPointer = hCPU->sprNew.LR;
+// ksys::phys::RigidBodyFromShape::create to create a RigidBody from a shape
+// use Actor::getRigidBodyByName
 
-    std::scoped_lock lock(g_actorListMutex);
+ActorRegistry::Diff s_actorDiff;
+// the actors that are shown in the debugger, which only changes by the diffs that the registry reports
+std::unordered_map<uint32_t, ActorRegistry::Change> s_debuggedActors;
 
-    // r7 holds actor list size
-    // r5 holds current actor index
-    // r6 holds current actor* list entry
+void EntityDebugger::UpdateEntityMemory() {
+    CemuHooks::CollectActorDiff(s_actorDiff);
 
-    // clear actor list when reiterating actor list again
-    if (hCPU->gpr[5] == 0) {
-        s_knownActors.clear();
+    // remove actors that the game stopped iterating over
+    for (const auto& actor : s_actorDiff.removed) {
+        s_debuggedActors.erase(actor.id);
+        RemoveEntity(actor.id);
     }
 
-    uint32_t actorLinkPtr = hCPU->gpr[6] + offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, c_str);
-    uint32_t actorNamePtr = 0;
-    readMemoryBE(actorLinkPtr, &actorNamePtr);
-    if (actorNamePtr == 0)
-        return;
-
-    char* actorName = (char*)s_memoryBaseAddress + actorNamePtr;
-
-    if (actorName[0] != '\0') {
-        // Log::print("Updating actor list [{}/{}] {:08x} - {}", hCPU->gpr[5], hCPU->gpr[7], hCPU->gpr[6], actorName);
-        uint32_t actorId = hCPU->gpr[6] + stringToHash(actorName);
-        s_knownActors.emplace(actorId, std::make_pair(actorName, hCPU->gpr[6]));
+    // a different actor took the place of an old one, which gets re-added below under its new id
+    for (const auto& actor : s_actorDiff.updated) {
+        s_debuggedActors.erase(actor.previousId);
+        RemoveEntity(actor.previousId);
+        s_debuggedActors.emplace(actor.id, actor);
     }
 
-    // if (strcmp(actorName, "Weapon_Sword_056") == 0) {
-    //     // Log::print("Updating actor list [{}/{}] {:08x} - {}", hCPU->gpr[5], hCPU->gpr[7], hCPU->gpr[6], actorName);
-    //     // float velocityY = 0.0f;
-    //     // readMemoryBE(hCPU->gpr[6] + offsetof(ActorWiiU, velocity.y), &velocityY);
-    //     // velocityY = velocityY * 1.5f;
-    //     // writeMemoryBE(hCPU->gpr[6] + offsetof(ActorWiiU, velocity.y), &velocityY);
-    //     s_currActorPtrs.emplace_back(hCPU->gpr[6]);
-    // }
-     if (strcmp(actorName, "GameROMPlayer") == 0) {
-         BEMatrix34 mtx = {};
-         uint32_t actorMtxPtr = hCPU->gpr[6] + offsetof(ActorWiiU, mtx);
-         readMemory(actorMtxPtr, &mtx);
-         s_playerPos = mtx.getPos().getLE();
-         s_playerMtxAddress = actorMtxPtr;
-         s_playerAddress = hCPU->gpr[6];
-         //uint32_t vtableAddr = getMemory<BEType<uint32_t>>(hCPU->gpr[6] + offsetof(ActorWiiU, vtable)).getLE();
-         //Log::print<INFO>("VTABLE = {:08X}", vtableAddr);
-     }
-     else if (strcmp(actorName, "GameRomCamera") == 0) {
-         uint32_t actorMtxPtr = hCPU->gpr[6] + offsetof(ActorWiiU, mtx);
-         s_cameraMtxAddress = actorMtxPtr;
-     }
-}
-
-// ksys::phys::RigidBodyFromShape::create to create a RigidBody from a shape
-// use Actor::getRigidBodyByName
-
-std::unordered_map<uint32_t, std::pair<std::string, uint32_t>> s_alreadyAddedActors;
-
-void EntityDebugger::UpdateEntityMemory() {
-    std::scoped_lock lock(g_actorListMutex);
-
-    // remove actors in s_alreadyAddedActors that are no longer in s_knownActors
-    for (const auto& hash : s_alreadyAddedActors | std::views::keys) {
-        if (!s_knownActors.contains(hash)) {
-            RemoveEntity(hash);
-        }
+    for (const auto& actor : s_actorDiff.added) {
+        s_debuggedActors.emplace(actor.id, actor);
     }
 
-    s_alreadyAddedActors = s_knownActors;
+    auto forEachLiveActor = [&](auto&& callback) {
+        for (const auto& actor : s_debuggedActors | std::views::values) {
+            callback(actor);
+        }
+    };
 
     // find the current player (GameROMPlayer)
     BEMatrix34 playerPos = {};
-    for (const auto& actorData : s_knownActors | std::views::values) {
-        if (actorData.first == "GameROMPlayer") {
-            CemuHooks::readMemory(actorData.second + offsetof(ActorWiiU, mtx), &playerPos);
+    forEachLiveActor([&](const ActorRegistry::Change& actorData) {
+        if (actorData.type == ActorClass::PLAYER) {
+            CemuHooks::readMemory(actorData.ptr + offsetof(ActorWiiU, mtx), &playerPos);
             glm::fvec3 newPlayerPos = playerPos.getPos().getLE();
             if (glm::distance(newPlayerPos, m_playerPos) > 25.0f) {
                 m_resetPlot = true;
@@ -133,29 +91,30 @@ void EntityDebugger::UpdateEntityMemory() {
             //     writeMemory(actorData.second + offsetof(ActorWiiU, opacityOrDoFlushOpacityToGPU)-2, &opacityOrDoFlushOpacityToGPU);
             // }
         }
-        else if (actorData.first == "GameRomCamera") {
-            CemuHooks::readMemory(actorData.second + offsetof(ActorWiiU, mtx), &playerPos);
+        else if (actorData.type == ActorClass::CAMERA) {
+            CemuHooks::readMemory(actorData.ptr + offsetof(ActorWiiU, mtx), &playerPos);
             glm::fvec3 newPlayerPos = playerPos.getPos().getLE();
         }
-        else if (actorData.first.starts_with("Weapon_Sword")) {
+        else if (actorData.name.starts_with("Weapon_Sword")) {
             // BEType<float> modelOpacity = 1.0f;
             // writeMemory(actorData.second + offsetof(ActorWiiU, modelOpacity), &modelOpacity);
             // uint8_t opacityOrDoFlushOpacityToGPU = 1;
             // writeMemory(actorData.second + offsetof(ActorWiiU, opacityOrDoFlushOpacityToGPU), &opacityOrDoFlushOpacityToGPU);
         }
-    }
+    });
 
-    // add actors that aren't in the overlay already
-    for (auto& [actorId, actorInfo] : s_knownActors) {
-        uint32_t actorPtr = actorInfo.second;
-        const std::string& actorName = actorInfo.first;
+    // add new actors to the overlay and refresh the ones that are already in it
+    forEachLiveActor([&](const ActorRegistry::Change& actorInfo) {
+        uint32_t actorId = actorInfo.id;
+        uint32_t actorPtr = actorInfo.ptr;
+        std::string_view actorName = actorInfo.name;
 
-        auto addField = [&]<typename T>(const std::string& name, uint32_t offset) -> void {
+        auto addField = [&]<typename T>(std::string_view name, uint32_t offset) -> void {
             uint32_t address = actorPtr + offset;
             AddOrUpdateEntity(actorId, actorName, name, address, CemuHooks::getMemory<T>(address), true);
         };
 
-        auto addMemoryRange = [&](const std::string& name, const uint32_t addressPtr, const uint32_t size) -> void {
+        auto addMemoryRange = [&](std::string_view name, const uint32_t addressPtr, const uint32_t size) -> void {
             uint32_t address = 0;
             if (CemuHooks::readMemoryBE(addressPtr, &address); address != 0) {
                 AddOrUpdateEntity(actorId, actorName, name, address, MemoryRange{ address, address + size, std::make_unique<MemoryEditor>() }, true);
@@ -223,7 +182,7 @@ void EntityDebugger::UpdateEntityMemory() {
         addMemoryRange("chemicals", actorPtr + offsetof(ActorWiiU, chemicalsPtr), 0x64);
         addMemoryRange("reactions", actorPtr + offsetof(ActorWiiU, reactionsPtr), 0x0C);
         // addField.operator()<float>("lodDrawDistanceMultiplier", offsetof(ActorWiiU, lodDrawDistanceMultiplier));
-    }
+    });
 
     // other systems might've added memory to the overlay, so hence this is a separate loop
     for (auto& entity : m_entities | std::views::values) {
@@ -302,6 +261,144 @@ void EntityDebugger::DrawEntityInspector() {
 
     ImGui::BeginChild("ScrollArea", ImVec2(0, 0));
 
+    if (ImGui::CollapsingHeader("Logging")) {
+        for (LogType type : Log::ALL_LOG_TYPES) {
+            if (type == ERROR || type == WARNING) {
+                continue;
+            }
+            bool enabled = Log::isLogTypeEnabled(type);
+            if (ImGui::Checkbox(std::format("Log {}", Log::getLogTypeName(type)).c_str(), &enabled)) {
+                Log::setLogTypeEnabled(type, enabled);
+            }
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Hook Capture")) {
+        static int captureFrames = HookCapture::DEFAULT_FRAME_COUNT;
+        if (HookCapture::IsCapturing()) {
+            if (ImGui::Button("Stop Capture")) {
+                HookCapture::Stop();
+            }
+            ImGui::SameLine();
+            ImGui::Text("Capturing hook calls, %u frames left", HookCapture::GetRemainingFrames());
+        }
+        else {
+            if (ImGui::Button("Capture Hook Calls")) {
+                HookCapture::Start((uint32_t)captureFrames);
+            }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100.0f);
+            if (ImGui::InputInt("Frames", &captureFrames)) {
+                captureFrames = std::clamp(captureFrames, 1, 100000);
+            }
+        }
+    }
+
+#ifdef BETTERVR_HOOK_PROFILER
+    if (ImGui::CollapsingHeader("Hook Profiler")) {
+        HookProfiler::DrawTable();
+    }
+#endif
+
+    if (RND_Renderer* renderer = VRManager::instance().XR->GetRenderer(); renderer != nullptr && ImGui::CollapsingHeader("Frame Times")) {
+        FrameTimeStats& frameTimeStats = renderer->GetFrameTimeStats();
+        bool writeCsv = frameTimeStats.IsWritingCsv();
+        if (ImGui::Checkbox("Write Frame Time CSV", &writeCsv)) {
+            if (writeCsv) {
+                frameTimeStats.StartCsv();
+            }
+            else {
+                frameTimeStats.StopCsv();
+            }
+        }
+        ImGui::Text("F3 Overlay Window:");
+        for (uint32_t seconds : FrameTimeStats::WINDOW_SECONDS) {
+            ImGui::SameLine();
+            if (ImGui::RadioButton(std::format("{} s", seconds).c_str(), frameTimeStats.m_overlayWindowSeconds == seconds)) {
+                frameTimeStats.m_overlayWindowSeconds = seconds;
+            }
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Frame Timeline")) {
+        static int dumpSeconds = (int)FrameTimeline::DEFAULT_DUMP_DURATION.count();
+        bool enabled = FrameTimeline::IsEnabled();
+        if (ImGui::Checkbox("Record Frame Timeline", &enabled)) {
+            FrameTimeline::SetEnabled(enabled);
+        }
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!enabled);
+        if (ImGui::Button("Dump Chrome Trace")) {
+            FrameTimeline::Dump(std::chrono::seconds(dumpSeconds));
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.0f);
+        if (ImGui::InputInt("Seconds", &dumpSeconds)) {
+            dumpSeconds = std::clamp(dumpSeconds, 1, 60);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Metrics")) {
+        Metrics::Registry& metrics = Metrics::Registry::Get();
+        bool writeCsv = metrics.IsWritingCsv();
+        if (ImGui::Checkbox("Write Metrics CSV", &writeCsv)) {
+            if (writeCsv) {
+                metrics.StartCsv();
+            }
+            else {
+                metrics.StopCsv();
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset Metrics")) {
+            metrics.Reset();
+        }
+
+        if (ImGui::BeginTable("Metrics", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Name");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableSetupColumn("Last Frame");
+            ImGui::TableSetupColumn("Mean / Value");
+            ImGui::TableSetupColumn("p50 / p99");
+            ImGui::TableHeadersRow();
+
+            metrics.ForEach([](const Metrics::MetricInfo& info, const Metrics::MetricSnapshot& snapshot) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(info.name.c_str());
+                switch (info.type) {
+                    case Metrics::MetricType::COUNTER: {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", snapshot.total);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", snapshot.lastFrame);
+                        break;
+                    }
+                    case Metrics::MetricType::GAUGE: {
+                        ImGui::TableNextColumn();
+                        ImGui::TableNextColumn();
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", snapshot.value);
+                        break;
+                    }
+                    case Metrics::MetricType::HISTOGRAM: {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", snapshot.total);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", snapshot.lastFrame);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", snapshot.total > 0 ? snapshot.value / (double)snapshot.total : 0.0);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f / %.3f", snapshot.GetPercentile(info, 0.5), snapshot.GetPercentile(info, 0.99));
+                        break;
+                    }
+                }
+            });
+            ImGui::EndTable();
+        }
+    }
+
     if (ImGui::CollapsingHeader("World Space Inspector")) {
         ImGui::Checkbox("Disable Points For Entities", &m_disablePoints);
         ImGui::Checkbox("Disable Text For Entities", &m_disableTexts);
@@ -480,15 +577,18 @@ void EntityDebugger::DrawEntityInspector() {
     ImGui::End();
 }
 
-void EntityDebugger::AddOrUpdateEntity(uint32_t actorId, const std::string& entityName, const std::string& valueName, uint32_t address, ValueVariant&& value, bool isEntity) {
-    const auto& [entityIt, _] = m_entities.try_emplace(actorId, Entity{ entityName, isEntity, 0.0f, {}, {}, {}, {} });
+void EntityDebugger::AddOrUpdateEntity(uint32_t actorId, std::string_view entityName, std::string_view valueName, uint32_t address, ValueVariant&& value, bool isEntity) {
+    auto entityIt = m_entities.find(actorId);
+    if (entityIt == m_entities.end()) {
+        entityIt = m_entities.emplace(actorId, Entity{ std::string(entityName), isEntity, 0.0f, {}, {}, {}, {} }).first;
+    }
 
     const auto& valueIt = std::ranges::find_if(entityIt->second.values, [&](EntityValue& val) {
         return val.value_name == valueName;
     });
 
     if (valueIt == entityIt->second.values.end()) {
-        entityIt->second.values.emplace_back(valueName, false, false, address, std::move(value));
+        entityIt->second.values.emplace_back(std::string(valueName), false, false, address, std::move(value));
     }
     else if (!valueIt->frozen && !std::holds_alternative<MemoryRange>(value)) {
         valueIt->value = std::move(value);
@@ -13,7 +13,7 @@ using ValueVariant = std::variant<BEType<uint32_t>, BEType<int32_t>, BEType<uint
 
 class EntityDebugger {
 public:
-    void AddOrUpdateEntity(uint32_t actorId, const std::string& entityName, const std::string& valueName, uint32_t address, ValueVariant&& value, bool isEntity = false);
+    void AddOrUpdateEntity(uint32_t actorId, std::string_view entityName, std::string_view valueName, uint32_t address, ValueVariant&& value, bool isEntity = false);
     void SetPosition(uint32_t actorId, const BEVec3& ws_playerPos, const BEVec3& ws_entityPos);
     void SetRotation(uint32_t actorId, const glm::fquat rotation);
     void SetAABB(uint32_t actorId, glm::fvec3 min, glm::fvec3 max);
@@ -0,0 +1,11 @@
+#pragma once
+
+// If the user is unable to control the camera, we can guess that they're in a cutscene
+struct HybridEventSettings {
+    bool firstPerson;                  // use Link's perspective, ignore the animated event camera
+    bool disablePlayerDrivenLinkHands; // let event control the hands instead of the VR controllers
+    bool ignoreCameraRotation;         // some events will pan the camera, but in first-person it should usually be ignored to avoid nausea. Doors opening is okay, but panning down to a chest is not.
+    bool demoEnableCameraInput;        // there's already events that allow user camera control. This isn't used or overwritten atm.
+
+    bool operator==(const HybridEventSettings&) const = default;
+};
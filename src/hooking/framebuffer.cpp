@@ -62,6 +62,9 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkCommandBufferDispatc
         const long frameIdx = pColor->float32[3] < 0.5f ? 0 : 1;
         checkAssert(captureIdx == 0 || captureIdx == 2, "Invalid capture index!");
 
+        static constexpr std::array<std::array<const char*, 2>, 2> CAPTURE_SPAN_NAMES = {{ { "Capture 3D Left", "Capture 3D Right" }, { "Capture 2D Left", "Capture 2D Right" } }};
+        FrameTimeline::Scope timelineScope(CAPTURE_SPAN_NAMES[captureIdx == 0 ? 0 : 1][side]);
+
         Log::print<RENDERING>("[{}] Clearing color image for {} layer for {} side", frameIdx, captureIdx == 0 ? "3D" : "2D", side == OpenXR::EyeSide::LEFT ? "left" : "right");
 
         auto* renderer = VRManager::instance().XR->GetRenderer();
@@ -91,7 +94,7 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkCommandBufferDispatc
                     Log::print<INFO>("Found rendering resolution {}x{} @ {} using capture #{}", it->second.first.width, it->second.first.height, it->second.second, captureIdx);
                     imguiOverlay = std::make_unique<RND_Renderer::ImGuiOverlay>(commandBuffer, it->second.first.width, it->second.first.height, VK_FORMAT_A2B10G10R10_UNORM_PACK32);
                     if (CemuHooks::GetSettings().ShowDebugOverlay()) {
-                        VRManager::instance().Hooks->m_entityDebugger = std::make_unique<EntityDebugger>();
+                        VRManager::instance().Debugger = std::make_unique<EntityDebugger>();
                     }
                 }
                 else {
@@ -259,6 +262,8 @@ void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkCommandBuffer
         const uint32_t frameCounter = pDepthStencil->stencil;
         checkAssert(frameCounter == 0 || frameCounter == 1, "Invalid frame counter for depth clear!");
 
+        FrameTimeline::Scope timelineScope(side == OpenXR::EyeSide::LEFT ? "Capture Depth Left" : "Capture Depth Right");
+
         auto& layer3D = VRManager::instance().XR->GetRenderer()->m_layer3D;
         auto& layer2D = VRManager::instance().XR->GetRenderer()->m_layer2D;
 
@@ -329,6 +334,13 @@ void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkCommandBuffer
 }
 
 VkResult VkDeviceOverrides::QueueSubmit(const vkroots::VkQueueDispatch& pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) {
+    BETTERVR_COUNTER(s_queueSubmits, "vulkan.queue_submits");
+    BETTERVR_COUNTER(s_patchedQueueSubmits, "vulkan.queue_submits_with_copies");
+    BETTERVR_COUNTER(s_queueSubmitFailures, "vulkan.queue_submit_failures");
+    BETTERVR_HISTOGRAM(s_queueSubmitTime, "vulkan.queue_submit_ms", 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.0);
+    Metrics::ScopedTimer timer(s_queueSubmitTime);
+    s_queueSubmits.Add();
+
     VkResult result = VK_SUCCESS;
     
     size_t activeCopyCount;
@@ -341,6 +353,9 @@ VkResult VkDeviceOverrides::QueueSubmit(const vkroots::VkQueueDispatch& pDispatc
         result = pDispatch.QueueSubmit(queue, submitCount, pSubmits, fence);
     }
     else {
+        // only the submits that the copies are injected into, since Cemu submits many times per frame
+        FrameTimeline::Scope timelineScope("QueueSubmit with copies");
+        s_patchedQueueSubmits.Add();
         struct ModifiedSubmitInfo_t {
             VkSubmitInfo submitInfoCopy; // Shadow copy of VkSubmitInfo
             std::vector<VkSemaphore> waitSemaphores;
@@ -439,6 +454,7 @@ VkResult VkDeviceOverrides::QueueSubmit(const vkroots::VkQueueDispatch& pDispatc
     }
 
     if (result != VK_SUCCESS) {
+        s_queueSubmitFailures.Add();
         Log::print<ERROR>("QueueSubmit failed with error {}", result);
     }
 
@@ -450,6 +466,7 @@ VkResult VkDeviceOverrides::QueuePresentKHR(const vkroots::VkQueueDispatch& pDis
 
     auto* renderer = VRManager::instance().XR->GetRenderer();
     if (renderer && renderer->m_layer3D && renderer->m_layer2D && renderer->m_imguiOverlay) {
+        renderer->GetFrameLatency().OnPresent(VRManager::instance().XR->GetCurrentXrTime());
         if (renderer->IsInitialized()) {
             renderer->EndFrame();
         }
@@ -0,0 +1,74 @@
+#pragma once
+
+// A stand-in for Cemu's guest memory, so that the hooks can run outside of Cemu: 4 GiB of address space like the Wii U's, which
+// CemuHooks uses as the memory base so that guest addresses are offsets into it like they are into Cemu's memory.
+// Pages only take up memory once they're written to, everything else reads as zero.
+class GuestArena {
+public:
+    static constexpr uint64_t SIZE = 1ull << 32;
+    // synthetic structures are allocated from here, above the game's code and its static data
+    static constexpr uint32_t HEAP_START = 0x40000000;
+
+    GuestArena() {
+        m_base = (uint8_t*)Platform::AllocateVirtualMemory(SIZE);
+        checkAssert(m_base != nullptr, "Failed to reserve the address space for the guest memory!");
+    }
+    ~GuestArena() {
+        Platform::FreeVirtualMemory(m_base, SIZE);
+    }
+    GuestArena(const GuestArena&) = delete;
+    GuestArena& operator=(const GuestArena&) = delete;
+
+    uint8_t* GetBase() const { return m_base; }
+
+    void Write(uint32_t address, const void* data, size_t size) {
+        memcpy(m_base + address, data, size);
+    }
+
+    void Read(uint32_t address, void* data, size_t size) const {
+        memcpy(data, m_base + address, size);
+    }
+
+    // the value is copied as it is like CemuHooks::writeMemory does, so guest structures have to use the BEType wrappers
+    template <typename T>
+    void WriteValue(uint32_t address, const T& value) {
+        Write(address, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T ReadValue(uint32_t address) const {
+        T value;
+        Read(address, &value, sizeof(T));
+        return value;
+    }
+
+    // writes the string with its null terminator
+    void WriteString(uint32_t address, std::string_view str) {
+        Write(address, str.data(), str.size());
+        m_base[address + str.size()] = '\0';
+    }
+
+    uint32_t Allocate(uint32_t size, uint32_t alignment = 0x10) {
+        const uint32_t address = (m_nextAllocation + alignment - 1) & ~(alignment - 1);
+        checkAssert((uint64_t)address + size <= SIZE, "Ran out of guest memory!");
+        m_nextAllocation = address + size;
+        return address;
+    }
+
+    uint32_t AllocateString(std::string_view str) {
+        const uint32_t address = Allocate((uint32_t)str.size() + 1, 4);
+        WriteString(address, str);
+        return address;
+    }
+
+    template <typename T>
+    uint32_t AllocateValue(const T& value) {
+        const uint32_t address = Allocate(sizeof(T), std::max<uint32_t>(alignof(T), 4));
+        WriteValue(address, value);
+        return address;
+    }
+
+private:
+    uint8_t* m_base = nullptr;
+    uint32_t m_nextAllocation = HEAP_START;
+};
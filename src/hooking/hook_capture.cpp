@@ -0,0 +1,203 @@
+#include "cemu_hooks.h"
+#include "hook_capture.h"
+
+std::atomic_bool HookCapture::s_capturing = false;
+std::atomic_uint32_t HookCapture::s_remainingFrames = 0;
+thread_local HookCapture::CallState HookCapture::t_call;
+
+std::mutex HookCapture::s_fileMutex;
+std::ofstream HookCapture::s_file;
+uint32_t HookCapture::s_frameIndex = 0;
+std::vector<bool> HookCapture::s_namedHooks;
+std::unordered_map<uint32_t, size_t> HookCapture::s_storedPageHashes;
+std::array<uint64_t, 3> HookCapture::s_lastXrStateVersion = {};
+uint64_t HookCapture::s_callCount = 0;
+
+template <typename T>
+static void WriteValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool HookCapture::Start(uint32_t frameCount) {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_hooks_{:%Y%m%d_%H%M%S}{}", now, FILE_EXTENSION);
+
+    std::scoped_lock lock(s_fileMutex);
+    if (s_file.is_open()) {
+        return false;
+    }
+    s_file.open(fileName, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!s_file.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to capture the hook calls to", fileName);
+        return false;
+    }
+
+    WriteValue(s_file, Header{});
+    s_frameIndex = 0;
+    s_callCount = 0;
+    s_namedHooks.clear();
+    s_storedPageHashes.clear();
+    s_lastXrStateVersion = {};
+    s_remainingFrames.store(frameCount);
+    s_capturing.store(true);
+    Log::print<INFO>("Capturing the hook calls of the next {} frames to {}", frameCount, fileName);
+    return true;
+}
+
+void HookCapture::Stop() {
+    s_capturing.store(false);
+
+    std::scoped_lock lock(s_fileMutex);
+    if (!s_file.is_open()) {
+        return;
+    }
+    const uint64_t fileSize = (uint64_t)s_file.tellp();
+    s_file.close();
+    s_remainingFrames.store(0);
+    Log::print<INFO>("Captured {} hook calls over {} frames ({:.1f} MiB, {} unique pages)", s_callCount, s_frameIndex, (double)fileSize / (1024.0 * 1024.0), s_storedPageHashes.size());
+}
+
+void HookCapture::BeginCall(uint32_t hookId, const char* hookName, const PPCInterpreter_t* hCPU) {
+    t_call.active = true;
+    t_call.hookId = hookId;
+    t_call.hookName = hookName;
+    t_call.before = *hCPU;
+    t_call.pages.clear();
+    t_call.pageContents.clear();
+    t_call.writes.clear();
+}
+
+void HookCapture::OnAccess(uint64_t offset, size_t size, bool isWrite) {
+    // accesses from outside of a hook, like the debugger reading the actors, aren't part of any call
+    if (!t_call.active || size == 0) {
+        return;
+    }
+
+    // store every page the first time it's touched, so the capture shows the memory like it was before the hook changed it
+    const uint64_t memoryBase = CemuHooks::GetMemoryBaseAddress();
+    for (uint64_t page = offset / PAGE_SIZE; page <= (offset + size - 1) / PAGE_SIZE; page++) {
+        const uint32_t pageAddress = (uint32_t)(page * PAGE_SIZE);
+        if (std::ranges::find(t_call.pages, pageAddress) != t_call.pages.end()) {
+            continue;
+        }
+        t_call.pages.emplace_back(pageAddress);
+        const uint8_t* pageData = reinterpret_cast<const uint8_t*>(memoryBase + pageAddress);
+        t_call.pageContents.insert(t_call.pageContents.end(), pageData, pageData + PAGE_SIZE);
+    }
+
+    if (isWrite) {
+        t_call.writes.emplace_back((uint32_t)offset, (uint32_t)size);
+    }
+}
+
+void HookCapture::EndCall(const PPCInterpreter_t* hCPU) {
+    if (!t_call.active) {
+        return;
+    }
+    t_call.active = false;
+
+    std::scoped_lock lock(s_fileMutex);
+    if (!s_file.is_open()) {
+        return;
+    }
+
+    if (s_namedHooks.size() <= t_call.hookId) {
+        s_namedHooks.resize(t_call.hookId + 1, false);
+    }
+    if (!s_namedHooks[t_call.hookId]) {
+        s_namedHooks[t_call.hookId] = true;
+        const std::string_view name = t_call.hookName;
+        WriteRecordType(RecordType::HOOK);
+        WriteValue(s_file, t_call.hookId);
+        WriteValue(s_file, (uint16_t)name.size());
+        s_file.write(name.data(), (std::streamsize)name.size());
+    }
+
+    WriteXrStateIfChanged();
+
+    WriteRecordType(RecordType::CALL);
+    WriteValue(s_file, CallHeader{
+        .hookId = t_call.hookId,
+        .threadId = Platform::GetCurrentThreadId(),
+        .before = t_call.before,
+        .after = *hCPU,
+        .pageCount = (uint32_t)t_call.pages.size(),
+        .writeCount = (uint32_t)t_call.writes.size()
+    });
+
+    for (size_t i = 0; i < t_call.pages.size(); i++) {
+        const char* pageData = reinterpret_cast<const char*>(t_call.pageContents.data() + i * PAGE_SIZE);
+        const size_t hash = std::hash<std::string_view>()(std::string_view(pageData, PAGE_SIZE));
+
+        auto [it, inserted] = s_storedPageHashes.try_emplace(t_call.pages[i], hash);
+        const bool store = inserted || it->second != hash;
+        it->second = hash;
+
+        WriteValue(s_file, t_call.pages[i]);
+        WriteValue(s_file, (uint8_t)(store ? 1 : 0));
+        if (store) {
+            s_file.write(pageData, PAGE_SIZE);
+        }
+    }
+
+    const uint64_t memoryBase = CemuHooks::GetMemoryBaseAddress();
+    for (const auto& [address, size] : t_call.writes) {
+        WriteValue(s_file, address);
+        WriteValue(s_file, size);
+        s_file.write(reinterpret_cast<const char*>(memoryBase + address), size);
+    }
+    s_callCount++;
+}
+
+void HookCapture::EndFrame() {
+    static bool checkedEnv = false;
+    if (!checkedEnv) {
+        checkedEnv = true;
+        if (const char* value = std::getenv("BETTERVR_HOOK_CAPTURE_FRAMES"); value != nullptr && std::atoi(value) > 0) {
+            Start((uint32_t)std::atoi(value));
+            return;
+        }
+    }
+
+    if (!IsCapturing()) {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(s_fileMutex);
+        if (s_file.is_open()) {
+            WriteRecordType(RecordType::FRAME);
+            WriteValue(s_file, s_frameIndex);
+            s_frameIndex++;
+        }
+    }
+
+    if (s_remainingFrames.fetch_sub(1) <= 1) {
+        Stop();
+    }
+}
+
+void HookCapture::WriteRecordType(RecordType type) {
+    WriteValue(s_file, type);
+}
+
+void HookCapture::WriteXrStateIfChanged() {
+    // the input state and the views are what the hooks read from OpenXR, anything else comes from guest memory
+    static_assert(std::is_trivially_copyable_v<InputState>, "InputState has to be trivially copyable to be captured");
+    const HookHost& host = CemuHooks::GetHost();
+    const InputState input = host.GetInput();
+    const std::optional<std::array<XrView, 2>> views = host.GetPoses();
+
+    // both only change once per frame, so comparing when they were updated is enough
+    const std::array<uint64_t, 3> stateVersion = { (uint64_t)input.inGame.inputTime, (uint64_t)input.inMenu.inputTime, host.GetViewsGeneration() };
+    if (stateVersion == s_lastXrStateVersion) {
+        return;
+    }
+    s_lastXrStateVersion = stateVersion;
+
+    WriteRecordType(RecordType::XR_STATE);
+    WriteValue(s_file, (uint32_t)sizeof(input));
+    WriteValue(s_file, input);
+    WriteValue(s_file, (uint8_t)(views.has_value() ? 1 : 0));
+    WriteValue(s_file, views.value_or(std::array<XrView, 2>{}));
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+// Records every HLE hook call over a number of frames into a .bvrhc file: the registers before and after the call, the guest memory
+// pages it touched through the CemuHooks memory helpers, the bytes it wrote and the controller and headset state it ran with.
+// The hook calls are captured by HookProfiler::Profiled or HookProfiler::Captured, which every hook is registered through.
+// Captures can be inspected with tools/hook_capture_report and replayed through the hooks with tools/hook_replay, which loads the
+// pages into a GuestArena and runs the hooks against a HookHost that plays back the captured controller and headset state.
+//
+// A capture is a Header followed by records that each start with a RecordType byte, everything is little-endian and packed:
+//   HOOK:     uint32 hookId, uint16 nameLength, name (before the first call of a hook)
+//   FRAME:    uint32 frameIndex (after every frame)
+//   XR_STATE: uint32 size, the raw InputState, uint8 hasViews, XrView[2] (before a call if the state changed)
+//   CALL:     CallHeader, then pageCount times: uint32 address, uint8 stored, PAGE_SIZE bytes if stored is set,
+//             then writeCount times: uint32 address, uint32 size, the written bytes as they were after the call
+// Pages are only stored if their contents changed since the last time they were stored, otherwise the last stored copy still applies.
+class HookCapture {
+public:
+    static constexpr std::array<char, 4> MAGIC = { 'B', 'V', 'H', 'C' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr std::string_view FILE_EXTENSION = ".bvrhc";
+    static constexpr uint32_t PAGE_SIZE = 0x1000;
+    static constexpr uint32_t DEFAULT_FRAME_COUNT = 300;
+
+    enum class RecordType : uint8_t {
+        HOOK,
+        FRAME,
+        XR_STATE,
+        CALL
+    };
+
+#pragma pack(push, 1)
+    struct Header {
+        std::array<char, 4> magic = MAGIC;
+        uint32_t version = VERSION;
+        uint32_t pageSize = PAGE_SIZE;
+        uint32_t registersSize = sizeof(PPCInterpreter_t);
+    };
+
+    struct CallHeader {
+        uint32_t hookId;
+        uint32_t threadId;
+        PPCInterpreter_t before;
+        PPCInterpreter_t after;
+        uint32_t pageCount;
+        uint32_t writeCount;
+    };
+#pragma pack(pop)
+
+    // writes to BetterVR_hooks_[time].bvrhc, returns false if the file couldn't be created
+    static bool Start(uint32_t frameCount);
+    static void Stop();
+    static bool IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+    static uint32_t GetRemainingFrames() { return s_remainingFrames.load(); }
+
+    // called by HookProfiler::Profiled and HookProfiler::Captured around every hook call
+    static void BeginCall(uint32_t hookId, const char* hookName, const PPCInterpreter_t* hCPU);
+    static void EndCall(const PPCInterpreter_t* hCPU);
+
+    // called by the CemuHooks memory helpers right before the guest memory is accessed
+    static void OnAccess(uint64_t offset, size_t size, bool isWrite);
+
+    // called once per frame by the renderer, which also stops the capture once enough frames were recorded
+    static void EndFrame();
+
+private:
+    struct CallState {
+        bool active = false;
+        uint32_t hookId = 0;
+        const char* hookName = nullptr;
+        PPCInterpreter_t before;
+        std::vector<uint32_t> pages;
+        std::vector<uint8_t> pageContents; // PAGE_SIZE bytes per page, as they were when the page was first touched
+        std::vector<std::pair<uint32_t, uint32_t>> writes;
+    };
+
+    static void WriteRecordType(RecordType type);
+    static void WriteXrStateIfChanged();
+
+    static std::atomic_bool s_capturing;
+    static std::atomic_uint32_t s_remainingFrames;
+    static thread_local CallState t_call;
+
+    // only used while holding s_fileMutex
+    static std::mutex s_fileMutex;
+    static std::ofstream s_file;
+    static uint32_t s_frameIndex;
+    static std::vector<bool> s_namedHooks;
+    static std::unordered_map<uint32_t, size_t> s_storedPageHashes;
+    static std::array<uint64_t, 3> s_lastXrStateVersion;
+    static uint64_t s_callCount;
+};
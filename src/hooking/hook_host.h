@@ -0,0 +1,56 @@
+#pragma once
+
+#include "input_state.h"
+
+class RumbleManager;
+
+// Everything the hooks need from outside of guest memory: the controller state, the headset views and the per-frame bookkeeping.
+// The layer implements it on top of its OpenXR session and renderer (see VRHookHost), the offline tools and tests implement it with
+// recorded or synthetic state, so that the same hooks can run on Linux without Cemu, the game or a headset.
+class HookHost {
+public:
+    // what the hooks remember about a frame the game is rendering, so that the work for both eyes only happens once
+    struct FrameState {
+        std::array<bool, 2> ranMotionAnalysis = { false, false };
+        bool solvedPlayerPose = false;
+    };
+
+    virtual ~HookHost() = default;
+
+    virtual InputState GetInput() const = 0;
+    virtual void SetInput(const InputState& input) = 0;
+    virtual GameState GetGameState() const = 0;
+    virtual void SetGameState(const GameState& gameState) = 0;
+    virtual glm::fquat GetInputCameraRotation() const = 0;
+    // called after the input was read for the game, for the input-to-photon latency
+    virtual void OnInputUsed() = 0;
+    // whether an overlay like the debugger takes the gamepad input instead of the game
+    virtual bool ShouldBlockGameInput() const = 0;
+
+    virtual bool HasRenderer() const = 0;
+    virtual bool IsRendererInitialized() const = 0;
+    // incremented every time new views are located, so that the views only have to be copied when this changes
+    virtual uint64_t GetViewsGeneration() const = 0;
+    virtual std::optional<std::array<XrView, 2>> GetPoses() const = 0;
+    // the game passes its frame counter to the hooks, which is used to index the frames that the renderer keeps
+    virtual FrameState& GetFrameState(uint32_t frameCounter) = 0;
+
+    virtual RumbleManager* GetRumbleManager() = 0;
+    // called once per frame from the settings hook, which is the only hook that runs when the debugger can read the actors
+    virtual void UpdateEntityDebugger() = 0;
+
+    std::optional<glm::fmat4> GetMiddlePose() const {
+        return GetMiddlePose(GetPoses());
+    }
+
+    // the pose halfway between both eyes
+    static std::optional<glm::fmat4> GetMiddlePose(const std::optional<std::array<XrView, 2>>& views) {
+        if (!views.has_value()) return std::nullopt;
+        const XrPosef& leftPose = views->at(EyeSide::LEFT).pose;
+        const XrPosef& rightPose = views->at(EyeSide::RIGHT).pose;
+        glm::fvec3 middlePos = (ToGLM(leftPose.position) + ToGLM(rightPose.position)) * 0.5f;
+        glm::quat middleOri = glm::slerp(ToGLM(leftPose.orientation), ToGLM(rightPose.orientation), 0.5f);
+
+        return ToMat4(middlePos, middleOri);
+    }
+};
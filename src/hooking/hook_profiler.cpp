@@ -0,0 +1,223 @@
+#include "hook_profiler.h"
+
+std::array<HookProfiler::HookInfo, HookProfiler::MAX_HOOKS> HookProfiler::s_hooks;
+uint32_t HookProfiler::s_hookCount = 0;
+double HookProfiler::s_microsecondsPerTick = 0.0;
+
+std::atomic_bool HookProfiler::s_tracing = false;
+std::atomic_size_t HookProfiler::s_traceEventCount = 0;
+uint64_t HookProfiler::s_traceStart = 0;
+std::mutex HookProfiler::s_traceBuffersMutex;
+std::vector<std::unique_ptr<HookProfiler::TraceBuffer>> HookProfiler::s_traceBuffers;
+thread_local HookProfiler::TraceBuffer* HookProfiler::t_traceBuffer = nullptr;
+
+// the TSC runs at a fixed rate on any CPU that's recent enough to run Cemu, so it only has to be measured once
+static double MeasureMicrosecondsPerTick() {
+    const auto clockStart = std::chrono::steady_clock::now();
+    const uint64_t tscStart = Platform::ReadTimestampCounter();
+    while (std::chrono::steady_clock::now() - clockStart < std::chrono::milliseconds(5)) {
+    }
+    const auto clockEnd = std::chrono::steady_clock::now();
+    const uint64_t tscEnd = Platform::ReadTimestampCounter();
+    return std::chrono::duration<double, std::micro>(clockEnd - clockStart).count() / (double)(tscEnd - tscStart);
+}
+
+uint32_t HookProfiler::Register(const char* name) {
+    if (s_microsecondsPerTick == 0.0) {
+        s_microsecondsPerTick = MeasureMicrosecondsPerTick();
+        Log::print<INFO>("Measured the TSC frequency for the hook profiler at {:.0f} MHz", 1.0 / s_microsecondsPerTick);
+    }
+
+    // CemuHooks can be constructed more than once (e.g. by the replay tool), which keeps the statistics of the hooks
+    for (uint32_t hookId = 0; hookId < s_hookCount; hookId++) {
+        if (s_hooks[hookId].name == name) {
+            return hookId;
+        }
+    }
+
+    checkAssert(s_hookCount < MAX_HOOKS, "Too many hooks were registered, increase HookProfiler::MAX_HOOKS!");
+    const uint32_t hookId = s_hookCount++;
+    s_hooks[hookId].name = name;
+    s_hooks[hookId].durations = std::make_unique<Metrics::Histogram>(std::format("hooks.{}_us", name), std::initializer_list<double>{ 0.5, 1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0 });
+    return hookId;
+}
+
+void HookProfiler::AddTraceEvent(uint32_t hookId, uint64_t start, uint64_t end) {
+    if (s_traceEventCount.fetch_add(1, std::memory_order_relaxed) >= MAX_TRACE_EVENTS) {
+        return;
+    }
+
+    if (t_traceBuffer == nullptr) {
+        std::scoped_lock lock(s_traceBuffersMutex);
+        t_traceBuffer = s_traceBuffers.emplace_back(std::make_unique<TraceBuffer>()).get();
+        t_traceBuffer->threadId = Platform::GetCurrentThreadId();
+    }
+
+    // only contended while the trace is being written
+    std::scoped_lock lock(t_traceBuffer->mutex);
+    t_traceBuffer->events.emplace_back(TraceEvent{ hookId, start, end });
+}
+
+void HookProfiler::StartTrace() {
+    std::scoped_lock lock(s_traceBuffersMutex);
+    for (auto& buffer : s_traceBuffers) {
+        std::scoped_lock bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+    s_traceEventCount.store(0);
+    s_traceStart = Platform::ReadTimestampCounter();
+    s_tracing.store(true);
+}
+
+void HookProfiler::StopTrace() {
+    s_tracing.store(false);
+
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_hooks_{:%Y%m%d_%H%M%S}.json", now);
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to write the hook trace to", fileName);
+        return;
+    }
+
+    size_t eventCount = 0;
+    file << "{\"traceEvents\":[\n";
+    std::scoped_lock lock(s_traceBuffersMutex);
+    for (auto& buffer : s_traceBuffers) {
+        std::scoped_lock bufferLock(buffer->mutex);
+        for (const TraceEvent& event : buffer->events) {
+            // events from before the trace was started could've been added while the buffers were cleared
+            if (event.start < s_traceStart) {
+                continue;
+            }
+            file << std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}\n",
+                eventCount == 0 ? "" : ",", s_hooks[event.hookId].name, buffer->threadId,
+                (double)(event.start - s_traceStart) * s_microsecondsPerTick, (double)(event.end - event.start) * s_microsecondsPerTick
+            );
+            eventCount++;
+        }
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+    }
+    file << "]}\n";
+
+    if (s_traceEventCount.load() > MAX_TRACE_EVENTS) {
+        Log::print<WARNING>("The hook trace only contains the first {} hook calls", MAX_TRACE_EVENTS);
+    }
+    Log::print<INFO>("Wrote {} hook calls to {}", eventCount, fileName);
+}
+
+void HookProfiler::ExportCsv() {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_hooks_{:%Y%m%d_%H%M%S}.csv", now);
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to write the hook statistics to", fileName);
+        return;
+    }
+
+    file << "hook,calls,calls_last_frame,us_last_frame,total_ms,mean_us,p50_us,p99_us\n";
+    for (uint32_t i = 0; i < s_hookCount; i++) {
+        const auto [info, snapshot] = s_hooks[i].durations->GetSnapshot();
+        file << std::format("{},{},{},{:.3f},{:.3f},{:.3f},{},{}\n",
+            s_hooks[i].name, snapshot.total, snapshot.lastFrame, snapshot.lastFrameValue, snapshot.value / 1000.0,
+            snapshot.total > 0 ? snapshot.value / (double)snapshot.total : 0.0, snapshot.GetPercentile(info, 0.5), snapshot.GetPercentile(info, 0.99)
+        );
+    }
+    Log::print<INFO>("Wrote the hook statistics to {}", fileName);
+}
+
+void HookProfiler::DrawTable() {
+    if (ImGui::Button("Export CSV")) {
+        ExportCsv();
+    }
+    ImGui::SameLine();
+    if (IsTracing()) {
+        if (ImGui::Button("Stop Chrome Trace")) {
+            StopTrace();
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu calls recorded", std::min(s_traceEventCount.load(), MAX_TRACE_EVENTS));
+    }
+    else if (ImGui::Button("Start Chrome Trace")) {
+        StartTrace();
+    }
+
+    struct Row {
+        const char* name;
+        uint64_t calls;
+        uint64_t callsLastFrame;
+        double usLastFrame;
+        double meanUs;
+        double p50Us;
+        double p99Us;
+    };
+    std::vector<Row> rows;
+    rows.reserve(s_hookCount);
+    for (uint32_t i = 0; i < s_hookCount; i++) {
+        const auto [info, snapshot] = s_hooks[i].durations->GetSnapshot();
+        rows.emplace_back(Row{
+            .name = s_hooks[i].name.c_str(),
+            .calls = snapshot.total,
+            .callsLastFrame = snapshot.lastFrame,
+            .usLastFrame = snapshot.lastFrameValue,
+            .meanUs = snapshot.total > 0 ? snapshot.value / (double)snapshot.total : 0.0,
+            .p50Us = snapshot.GetPercentile(info, 0.5),
+            .p99Us = snapshot.GetPercentile(info, 0.99)
+        });
+    }
+
+    constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_SizingStretchProp;
+    if (!ImGui::BeginTable("Hook Profiler", 7, tableFlags)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Hook");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Calls/Frame");
+    ImGui::TableSetupColumn("us/Frame", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Mean us");
+    ImGui::TableSetupColumn("p50 us");
+    ImGui::TableSetupColumn("p99 us");
+    ImGui::TableHeadersRow();
+
+    if (const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs != nullptr && sortSpecs->SpecsCount > 0) {
+        const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+        const auto getKey = [&spec](const Row& row) -> double {
+            switch (spec.ColumnIndex) {
+                case 1: return (double)row.calls;
+                case 2: return (double)row.callsLastFrame;
+                case 3: return row.usLastFrame;
+                case 4: return row.meanUs;
+                case 5: return row.p50Us;
+                case 6: return row.p99Us;
+                default: return 0.0;
+            }
+        };
+        std::ranges::stable_sort(rows, [&](const Row& a, const Row& b) {
+            if (spec.ColumnIndex == 0) {
+                const int cmp = strcmp(a.name, b.name);
+                return spec.SortDirection == ImGuiSortDirection_Ascending ? cmp < 0 : cmp > 0;
+            }
+            return spec.SortDirection == ImGuiSortDirection_Ascending ? getKey(a) < getKey(b) : getKey(a) > getKey(b);
+        });
+    }
+
+    for (const Row& row : rows) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(row.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", row.calls);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", row.callsLastFrame);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", row.usLastFrame);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", row.meanUs);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", row.p50Us);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", row.p99Us);
+    }
+    ImGui::EndTable();
+}
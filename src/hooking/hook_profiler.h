@@ -0,0 +1,106 @@
+#pragma once
+
+#include "hook_capture.h"
+
+// Times every HLE hook call, so that the debugger window can show which hooks take up the most CPU time each frame.
+// CemuHooks registers its hooks through HookProfiler::Profiled<hook> when BETTERVR_HOOK_PROFILER is defined,
+// which reads the TSC before and after the call and adds the duration to a per-thread histogram of that hook.
+// Otherwise they're registered through HookProfiler::Captured<hook>, which only checks whether a HookCapture is running.
+// The hook calls can also be recorded as a Chrome trace (chrome://tracing or ui.perfetto.dev) to see when they happen,
+// and they're added to the FrameTimeline while it's enabled to see them next to the rest of the frame.
+class HookProfiler {
+public:
+    using HookFunction = void (*)(PPCInterpreter_t*);
+
+    static constexpr size_t MAX_HOOKS = 64;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    template <HookFunction Hook>
+    static void Register(const char* name) {
+        s_hookIds<Hook> = Register(name);
+    }
+
+    template <HookFunction Hook>
+    static void Profiled(PPCInterpreter_t* hCPU) {
+        // captured calls aren't timed since the capture itself is much slower than most hooks
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            Capture<Hook>(hCPU);
+            return;
+        }
+        const uint64_t start = Platform::ReadTimestampCounter();
+        Hook(hCPU);
+        Record(s_hookIds<Hook>, start, Platform::ReadTimestampCounter());
+    }
+
+    template <HookFunction Hook>
+    static void Captured(PPCInterpreter_t* hCPU) {
+        if (HookCapture::IsCapturing()) [[unlikely]] {
+            Capture<Hook>(hCPU);
+            return;
+        }
+        Hook(hCPU);
+    }
+
+    static void StartTrace();
+    // writes the recorded hook calls to BetterVR_hooks_[time].json
+    static void StopTrace();
+    static bool IsTracing() { return s_tracing.load(std::memory_order_relaxed); }
+
+    // writes the current statistics of every hook to BetterVR_hooks_[time].csv
+    static void ExportCsv();
+
+    static void DrawTable();
+
+private:
+    struct HookInfo {
+        std::string name;
+        std::unique_ptr<Metrics::Histogram> durations; // in microseconds
+    };
+
+    struct TraceEvent {
+        uint32_t hookId;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    struct TraceBuffer {
+        std::mutex mutex;
+        uint32_t threadId = 0;
+        std::vector<TraceEvent> events;
+    };
+
+    static uint32_t Register(const char* name);
+
+    template <HookFunction Hook>
+    static void Capture(PPCInterpreter_t* hCPU) {
+        HookCapture::BeginCall(s_hookIds<Hook>, s_hooks[s_hookIds<Hook>].name.c_str(), hCPU);
+        Hook(hCPU);
+        HookCapture::EndCall(hCPU);
+    }
+
+    static void Record(uint32_t hookId, uint64_t start, uint64_t end) {
+        s_hooks[hookId].durations->Record((double)(end - start) * s_microsecondsPerTick);
+        if (s_tracing.load(std::memory_order_relaxed)) [[unlikely]] {
+            AddTraceEvent(hookId, start, end);
+        }
+        if (FrameTimeline::IsEnabled()) [[unlikely]] {
+            FrameTimeline::Record(s_hooks[hookId].name.c_str(), start, end);
+        }
+    }
+
+    static void AddTraceEvent(uint32_t hookId, uint64_t start, uint64_t end);
+
+    template <HookFunction Hook>
+    static inline uint32_t s_hookIds = 0;
+
+    static std::array<HookInfo, MAX_HOOKS> s_hooks;
+    static uint32_t s_hookCount;
+    static double s_microsecondsPerTick;
+
+    static std::atomic_bool s_tracing;
+    static std::atomic_size_t s_traceEventCount;
+    static uint64_t s_traceStart;
+    static std::mutex s_traceBuffersMutex;
+    static std::vector<std::unique_ptr<TraceBuffer>> s_traceBuffers;
+    static thread_local TraceBuffer* t_traceBuffer;
+};
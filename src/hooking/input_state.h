@@ -0,0 +1,89 @@
+#pragma once
+
+#include "utils/button_state.h"
+
+// The controller state that OpenXR updates every frame and the hooks read, kept apart from the OpenXR session so that the hooks can
+// also be built and run without one.
+enum EyeSide : uint8_t {
+    LEFT = 0,
+    RIGHT = 1
+};
+
+template <>
+struct std::formatter<EyeSide> : std::formatter<string> {
+    auto format(const EyeSide side, std::format_context& ctx) const {
+        return std::format_to(ctx.out(), "{}", side == EyeSide::LEFT ? "LEFT" : "RIGHT");
+    }
+};
+
+union InputState {
+    struct InGame {
+        bool in_game = true;
+        XrTime inputTime;
+        std::optional<EyeSide> lastPickupSide = std::nullopt;
+
+        // shared
+        XrActionStateBoolean mapAndInventory;
+
+        XrActionStateBoolean leftTrigger;
+        XrActionStateBoolean rightTrigger;
+
+        // unique
+        XrActionStateVector2f camera;
+        XrActionStateVector2f move;
+
+        XrActionStateBoolean jump;
+        XrActionStateBoolean crouch;
+        XrActionStateBoolean run;
+        XrActionStateBoolean attack;
+        XrActionStateBoolean useRune;
+        XrActionStateBoolean throwWeapon;
+        XrActionStateBoolean cancel;
+        XrActionStateBoolean interact;
+        std::array<XrActionStateFloat, 2> grab;
+        std::array<bool, 2> drop_weapon; // LEFT/RIGHT
+
+        using ButtonState = ::ButtonState;
+        std::array<ButtonState, 2> grabState; // LEFT/RIGHT
+        ButtonState runState;
+        ButtonState mapAndInventoryState;
+        std::array<XrActionStatePose, 2> pose;
+        std::array<XrSpaceLocation, 2> poseLocation;
+        std::array<XrSpaceVelocity, 2> poseVelocity;
+        // todo: remove relative controller positions if it turns out to be unnecessary
+        std::array<XrSpaceLocation, 2> hmdRelativePoseLocation;
+    } inGame;
+    struct InMenu {
+        bool in_game = false;
+        XrTime inputTime;
+        std::optional<EyeSide> lastPickupSide = std::nullopt;
+
+        // shared
+        XrActionStateBoolean mapAndInventory;
+
+        XrActionStateBoolean leftTrigger;
+        XrActionStateBoolean rightTrigger;
+
+        // unique
+        XrActionStateVector2f scroll;
+        XrActionStateVector2f navigate;
+
+        XrActionStateBoolean select;
+        XrActionStateBoolean back;
+        XrActionStateBoolean sort;
+        XrActionStateBoolean hold;
+
+        XrActionStateBoolean leftGrip;
+        XrActionStateBoolean rightGrip;
+    } inMenu;
+};
+
+struct GameState {
+    bool in_game = false;
+    bool was_in_game = false;
+    bool map_open = false;
+    bool prevent_menu_inputs = false;
+    std::chrono::steady_clock::time_point prevent_menu_time;
+    bool prevent_grab_inputs = false;
+    std::chrono::steady_clock::time_point prevent_grab_time;
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include "utils/rigid_pose.h"
+#include <filesystem>
+#include <fstream>
+
+// Recordings of the controller samples that are fed into WeaponMotionAnalyser::Update, so that the attack detection can be replayed
+// and tuned without a headset (see tools/motion_replay). A trace file is a Header followed by tightly packed Samples.
+namespace MotionTrace {
+    inline constexpr std::array<char, 4> MAGIC = { 'B', 'V', 'M', 'T' };
+    inline constexpr uint32_t VERSION = 1;
+    inline constexpr std::string_view FILE_EXTENSION = ".bvrmt";
+
+#pragma pack(push, 1)
+    struct Sample {
+        int64_t time; // XrTime of the input, in nanoseconds
+        uint8_t hand; // index into CemuHooks::m_motionAnalyzers
+        uint8_t weaponType;
+        uint16_t reserved;
+        XrPosef handPose;
+        XrVector3f linearVelocity;
+        XrVector3f angularVelocity;
+        XrPosef headsetPose;
+    };
+    static_assert(sizeof(Sample) == 92, "MotionTrace::Sample size mismatch");
+
+    struct Header {
+        std::array<char, 4> magic = MAGIC;
+        uint32_t version = VERSION;
+        uint32_t sampleSize = sizeof(Sample);
+    };
+    static_assert(sizeof(Header) == 12, "MotionTrace::Header size mismatch");
+#pragma pack(pop)
+
+    inline XrSpaceLocation GetHandLocation(const Sample& sample) {
+        XrSpaceLocation location = { XR_TYPE_SPACE_LOCATION };
+        location.locationFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+        location.pose = sample.handPose;
+        return location;
+    }
+
+    inline XrSpaceVelocity GetHandVelocity(const Sample& sample) {
+        XrSpaceVelocity velocity = { XR_TYPE_SPACE_VELOCITY };
+        velocity.velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+        velocity.linearVelocity = sample.linearVelocity;
+        velocity.angularVelocity = sample.angularVelocity;
+        return velocity;
+    }
+
+    inline glm::fmat4 GetHeadsetMatrix(const Sample& sample) {
+        const XrQuaternionf& q = sample.headsetPose.orientation;
+        const XrVector3f& p = sample.headsetPose.position;
+        return RigidPose(glm::fquat(q.w, q.x, q.y, q.z), glm::fvec3(p.x, p.y, p.z)).ToMatrix();
+    }
+
+    // returns nothing if the file can't be opened or wasn't written by a compatible recorder
+    inline std::optional<std::vector<Sample>> Read(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+
+        const std::streamsize fileSize = file.tellg();
+        file.seekg(0);
+
+        Header header = {};
+        if (fileSize < (std::streamsize)sizeof(Header) || !file.read((char*)&header, sizeof(Header))) {
+            return std::nullopt;
+        }
+        if (header.magic != MAGIC || header.version != VERSION || header.sampleSize != sizeof(Sample)) {
+            return std::nullopt;
+        }
+
+        // a recording that was cut off while writing still has all of its complete samples
+        std::vector<Sample> samples((fileSize - sizeof(Header)) / sizeof(Sample));
+        if (!file.read((char*)samples.data(), samples.size() * sizeof(Sample))) {
+            return std::nullopt;
+        }
+        return samples;
+    }
+
+    // Appends samples to a trace file. Samples are buffered and written in batches, since Record is called from the weapon hook every frame.
+    class Writer {
+    public:
+        static constexpr size_t FLUSH_SAMPLES = 256;
+
+        ~Writer() { Close(); }
+
+        bool Open(const std::filesystem::path& path) {
+            std::lock_guard lock(m_mutex);
+            CloseLocked();
+
+            m_file.open(path, std::ios::binary | std::ios::trunc);
+            if (!m_file.is_open()) {
+                return false;
+            }
+            const Header header = {};
+            m_file.write((const char*)&header, sizeof(header));
+            m_path = path;
+            m_sampleCount = 0;
+            m_pending.reserve(FLUSH_SAMPLES);
+            return true;
+        }
+
+        void Close() {
+            std::lock_guard lock(m_mutex);
+            CloseLocked();
+        }
+
+        bool IsOpen() const {
+            std::lock_guard lock(m_mutex);
+            return m_file.is_open();
+        }
+
+        void Record(uint8_t hand, uint32_t weaponType, const XrSpaceLocation& handLocation, const XrSpaceVelocity& handVelocity, const glm::fmat4& headsetMtx, XrTime inputTime) {
+            std::lock_guard lock(m_mutex);
+            if (!m_file.is_open()) {
+                return;
+            }
+
+            const RigidPose headsetPose(headsetMtx);
+            m_pending.emplace_back(Sample{
+                .time = inputTime,
+                .hand = hand,
+                .weaponType = (uint8_t)weaponType,
+                .reserved = 0,
+                .handPose = handLocation.pose,
+                .linearVelocity = handVelocity.linearVelocity,
+                .angularVelocity = handVelocity.angularVelocity,
+                .headsetPose = {
+                    .orientation = { headsetPose.rotation.x, headsetPose.rotation.y, headsetPose.rotation.z, headsetPose.rotation.w },
+                    .position = { headsetPose.position.x, headsetPose.position.y, headsetPose.position.z }
+                }
+            });
+            m_sampleCount++;
+
+            if (m_pending.size() >= FLUSH_SAMPLES) {
+                FlushLocked();
+            }
+        }
+
+        uint64_t GetSampleCount() const {
+            std::lock_guard lock(m_mutex);
+            return m_sampleCount;
+        }
+
+        std::filesystem::path GetPath() const {
+            std::lock_guard lock(m_mutex);
+            return m_path;
+        }
+
+    private:
+        void FlushLocked() {
+            m_file.write((const char*)m_pending.data(), m_pending.size() * sizeof(Sample));
+            m_file.flush();
+            m_pending.clear();
+        }
+
+        void CloseLocked() {
+            if (m_file.is_open()) {
+                FlushLocked();
+                m_file.close();
+            }
+        }
+
+        mutable std::mutex m_mutex;
+        std::ofstream m_file;
+        std::filesystem::path m_path;
+        std::vector<Sample> m_pending;
+        uint64_t m_sampleCount = 0;
+    };
+}
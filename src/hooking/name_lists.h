@@ -0,0 +1,168 @@
+#pragma once
+#include "utils/name_set.h"
+
+// The actor, job and bone names that the hooks look names up in. Each list is kept next to the NameSet that's built from it,
+// so that the tests can check every name and its near misses against the same sets that the hooks use.
+namespace NameLists {
+    // items that hook_ChangeWeaponMtx never drops from the player's hands
+    inline constexpr auto NON_DROPPABLE_ITEM_NAMES = std::to_array<std::string_view>({
+        "AncientArrow",
+        "Animal_Insect_A",
+        "Animal_Insect_B",
+        "Animal_Insect_F",
+        "Animal_Insect_H",
+        "Animal_Insect_M",
+        "Animal_Insect_S",
+        "Animal_Insect_X",
+        "Armor_Default_Extra_00",
+        "Armor_Default_Extra_01",
+        "bj_SupportApp_Wind",
+        "BombArrow_A",
+        "BrightArrow",
+        "BrightArrowTP",
+        "CarryBox",
+        "Dm_Npc_Gerudo_HeroSoul_Kago",
+        "Dm_Npc_Goron_HeroSoul_Kago",
+        "Dm_Npc_RevivalFairy",
+        "Dm_Npc_Rito_HeroSoul_Kago",
+        "Dm_Npc_Zora_HeroSoul_Kago",
+        "ElectricArrow",
+        "Explode",
+        "FireArrow",
+        "FireRodLv1Fire",
+        "FireRodLv2Fire",
+        "FireRodLv2FireChild",
+        "GameRomHorseReins_01",
+        "GameRomHorseReins_02",
+        "GameRomHorseReins_03",
+        "GameRomHorseReins_04",
+        "GameRomHorseReins_05",
+        "GameRomHorseReins_10",
+        "GameRomHorseSaddle_01",
+        "GameRomHorseSaddle_02",
+        "GameRomHorseSaddle_03",
+        "GameRomHorseSaddle_04",
+        "GameRomHorseSaddle_05",
+        "GameRomHorseSaddle_10",
+        "GameROMPlayer",
+        "Get_TwnObj_DLC_MemorialPicture_A_01",
+        "IceArrow",
+        "IceRodLv1Ice",
+        "IceRodLv2Ice",
+        "Item_Conductor",
+        "Item_CookSet",
+        "Item_Magnetglove",
+        "Item_Material_01",
+        "Item_Material_03",
+        "Item_Material_07",
+        "Item_Ore_F",
+        "KeySmall",
+        "NormalArrow",
+        "Obj_Armor_115_Head",
+        "Obj_DLC_HeroSeal_Gerudo",
+        "Obj_DLC_HeroSeal_Goron",
+        "Obj_DLC_HeroSeal_Rito",
+        "Obj_DLC_HeroSeal_Zora",
+        "Obj_DLC_HeroSoul_Gerudo",
+        "Obj_DLC_HeroSoul_Goron",
+        "Obj_DLC_HeroSoul_Rito",
+        "Obj_DLC_HeroSoul_Zora",
+        "Obj_DRStone_A_01",
+        "Obj_DRStone_Get",
+        "Obj_DungeonClearSeal",
+        "Obj_HeartUtuwa_A_01",
+        "Obj_HeroSoul_Gerudo",
+        "Obj_HeroSoul_Goron",
+        "Obj_HeroSoul_Rito",
+        "Obj_HeroSoul_Zora",
+        "Obj_IceMakerBlock",
+        "Obj_KorokNuts",
+        "Obj_Maracas",
+        "Obj_ProofBook",
+        "Obj_ProofGiantKiller",
+        "Obj_ProofGolemKiller",
+        "Obj_ProofKorok",
+        "Obj_ProofSandwormKiller",
+        "Obj_StaminaUtuwa_A_01",
+        "Obj_WarpDLC",
+        "PlayerStole2",
+        "PlayerStole2_Vagrant",
+        "Weapon_Bow_071",
+        "Weapon_Sword_056",
+        "Weapon_Sword_070",
+        "Weapon_Sword_080",
+        "Weapon_Sword_081",
+        "Weapon_Sword_502"
+    });
+    inline constexpr NameSet NON_DROPPABLE_ITEMS = NON_DROPPABLE_ITEM_NAMES;
+
+    inline bool IsDroppable(std::string_view actorName) {
+        if (NON_DROPPABLE_ITEMS.contains(actorName)) {
+            return false;
+        }
+
+        // prevent dropping arrows
+        if (actorName.contains("Arrow")) {
+            return false;
+        }
+
+        return true;
+    }
+
+    // the jobs that hook_RouteActorJob splits between the two camera sides, the order has to match the names in ACTOR_JOB_NAME_LIST
+    enum class ActorJob : int32_t {
+        UNKNOWN = -1,
+        JOB0_1,
+        JOB0_2,
+        JOB1_1,
+        JOB1_2,
+        JOB2_1_RAGDOLL_RELATED,
+        JOB2_2,
+        JOB4,
+    };
+
+    inline constexpr auto ACTOR_JOB_NAME_LIST = std::to_array<std::string_view>({
+        "job0_1",
+        "job0_2",
+        "job1_1",
+        "job1_2",
+        "job2_1_ragdoll_related",
+        "job2_2",
+        "job4",
+    });
+    inline constexpr NameSet ACTOR_JOB_NAMES = ACTOR_JOB_NAME_LIST;
+
+    inline ActorJob FindActorJob(std::string_view jobName) {
+        return (ActorJob)ACTOR_JOB_NAMES.find(jobName);
+    }
+
+    // bones of the player's head that are shrunk in first person, along with every bone that starts with one of the prefixes
+    inline constexpr auto FACE_BONE_NAME_LIST = std::to_array<std::string_view>({
+        "Nose",
+        "Ponytail_A_1",
+        "Neck",
+        "Head",
+    });
+    inline constexpr NameSet FACE_BONE_NAMES = FACE_BONE_NAME_LIST;
+
+    inline constexpr std::array<std::string_view, 6> FACE_BONE_PREFIXES = {
+        "Eye" /*lid*/,
+        "Cheek",
+        "Lip",
+        "Hair",
+        "Teeth_",
+        "Chin",
+    };
+
+    inline bool IsFaceBone(std::string_view boneName) {
+        if (FACE_BONE_NAMES.contains(boneName)) {
+            return true;
+        }
+        for (const auto& prefix : FACE_BONE_PREFIXES) {
+            if (boneName.starts_with(prefix)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "cemu_hooks.h"
+#include "guest_arena.h"
+#include "rumble.h"
+
+// A HookHost without a headset, whose controller and headset state is set by the caller, for running the hooks in the tools and tests.
+class OfflineHookHost : public HookHost {
+public:
+    class NullHapticsSink : public HapticsSink {
+    public:
+        void Apply(Hand hand, float frequency, float amplitude, std::optional<std::chrono::nanoseconds> duration) override {}
+        void Stop(Hand hand) override {}
+    };
+
+    OfflineHookHost(): m_rumbleManager(std::make_unique<NullHapticsSink>()) {}
+
+    InputState GetInput() const override { return m_input; }
+    void SetInput(const InputState& input) override { m_input = input; }
+    GameState GetGameState() const override { return m_gameState; }
+    void SetGameState(const GameState& gameState) override { m_gameState = gameState; }
+    glm::fquat GetInputCameraRotation() const override { return glm::identity<glm::fquat>(); }
+    void OnInputUsed() override { m_frameLatency.OnInputUsed(); }
+    bool ShouldBlockGameInput() const override { return false; }
+
+    bool HasRenderer() const override { return true; }
+    bool IsRendererInitialized() const override { return true; }
+    uint64_t GetViewsGeneration() const override { return m_viewsGeneration; }
+    std::optional<std::array<XrView, 2>> GetPoses() const override { return m_views; }
+
+    // the renderer keeps two frames that the game alternates between, and resets a frame once it was presented
+    FrameState& GetFrameState(uint32_t frameCounter) override {
+        const uint32_t frameIdx = frameCounter & 1;
+        if (m_staleFrames[frameIdx]) {
+            m_frames[frameIdx] = {};
+            m_staleFrames[frameIdx] = false;
+        }
+        return m_frames[frameIdx];
+    }
+
+    RumbleManager* GetRumbleManager() override { return &m_rumbleManager; }
+    void UpdateEntityDebugger() override {}
+
+    void SetViews(const std::optional<std::array<XrView, 2>>& views) {
+        m_views = views;
+        m_viewsGeneration++;
+    }
+
+    // both frames are reset the next time that the hooks use them, since it's not known which one would've been presented
+    void EndFrame() {
+        m_staleFrames = { true, true };
+    }
+
+    // the hooks report which input they used to it, like they do to the renderer's
+    FrameLatency& GetFrameLatency() { return m_frameLatency; }
+
+private:
+    InputState m_input = {};
+    GameState m_gameState = {};
+    std::optional<std::array<XrView, 2>> m_views;
+    uint64_t m_viewsGeneration = 0;
+    std::array<FrameState, 2> m_frames = {};
+    std::array<bool, 2> m_staleFrames = { false, false };
+    RumbleManager m_rumbleManager;
+    FrameLatency m_frameLatency;
+};
+
+// Registers the hooks like Cemu would, with a GuestArena as the guest memory and an OfflineHookHost, so that they can be called by name.
+// CemuHooks keeps its state in static members, so there can only be one of these at a time.
+class OfflineHooks {
+public:
+    OfflineHooks() {
+        checkAssert(s_current == nullptr, "Only one OfflineHooks instance can exist at a time!");
+        s_current = this;
+        m_hooks = std::make_unique<CemuHooks>(m_host, CemuExports{
+            .osLib_registerHLEFunction = [](const char* libraryName, const char* functionName, void (*osFunction)(PPCInterpreter_t* hCPU)) {
+                s_current->m_registeredHooks.emplace(functionName, osFunction);
+            },
+            .memory_getBase = []() -> void* {
+                return s_current->m_arena.GetBase();
+            },
+            // the hooks don't depend on the region, any of the supported title IDs works
+            .gameMeta_getTitleId = []() -> uint64_t {
+                return 0x00050000101C9400;
+            }
+        });
+    }
+    ~OfflineHooks() {
+        m_hooks.reset();
+        s_current = nullptr;
+    }
+    OfflineHooks(const OfflineHooks&) = delete;
+    OfflineHooks& operator=(const OfflineHooks&) = delete;
+
+    GuestArena& GetArena() { return m_arena; }
+    OfflineHookHost& GetHost() { return m_host; }
+
+    // the function that CemuHooks registered under the name, which goes through the hook profiler if it's enabled
+    HookProfiler::HookFunction Find(const std::string& name) const {
+        auto it = m_registeredHooks.find(name);
+        return it != m_registeredHooks.end() ? it->second : nullptr;
+    }
+
+    void Call(const std::string& name, PPCInterpreter_t& hCPU) const {
+        HookProfiler::HookFunction hook = Find(name);
+        checkAssert(hook != nullptr, std::format("{} isn't registered by CemuHooks!", name).c_str());
+        hook(&hCPU);
+    }
+
+private:
+    static inline OfflineHooks* s_current = nullptr;
+
+    GuestArena m_arena;
+    OfflineHookHost m_host;
+    std::unordered_map<std::string, HookProfiler::HookFunction> m_registeredHooks;
+    std::unique_ptr<CemuHooks> m_hooks;
+};
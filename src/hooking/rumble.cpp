@@ -1,6 +1,5 @@
 #include "rumble.h"
 #include "cemu_hooks.h"
-#include "instance.h"
 
 
 void CemuHooks::hook_XRRumble_VPADControlMotor(PPCInterpreter_t* hCPU) {
@@ -10,9 +9,16 @@ void CemuHooks::hook_XRRumble_VPADControlMotor(PPCInterpreter_t* hCPU) {
     uint32_t patternPtr = hCPU->gpr[4];
     uint8_t length = hCPU->gpr[5];
 
-    uint8_t* pattern = (uint8_t*)(s_memoryBaseAddress + patternPtr);
+    if (patternPtr == 0) {
+        GetHost().GetRumbleManager()->stopMotor();
+        return;
+    }
 
-    VRManager::instance().XR->GetRumbleManager()->controlMotor(pattern, length);
+    // the pattern is a bitfield with a length in bits, so it's never more than 32 bytes
+    std::array<uint8_t, 32> pattern = {};
+    readMemoryBytes(patternPtr, pattern.data(), (length + 7) / 8);
+
+    GetHost().GetRumbleManager()->controlMotor(pattern.data(), length);
 }
 
 void CemuHooks::hook_XRRumble_VPADStopMotor(PPCInterpreter_t* hCPU) {
@@ -20,5 +26,5 @@ void CemuHooks::hook_XRRumble_VPADStopMotor(PPCInterpreter_t* hCPU) {
 
     uint32_t channel = hCPU->gpr[3];
 
-    VRManager::instance().XR->GetRumbleManager()->stopMotor();
+    GetHost().GetRumbleManager()->stopMotor();
 }
\ No newline at end of file
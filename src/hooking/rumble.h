@@ -1,187 +1,304 @@
 #pragma once
 
-#include "cemu_hooks.h"
+#include "utils/spsc_ring.h"
 
+// Receives the output of the RumbleManager, which the layer forwards to the haptic action of the controllers.
+// Only called from the rumble thread.
+class HapticsSink {
+public:
+    enum class Hand : uint8_t {
+        LEFT,
+        RIGHT,
+        BOTH
+    };
+
+    virtual ~HapticsSink() = default;
+
+    // vibrates until the duration is over, or until Stop is called if there's no duration
+    virtual void Apply(Hand hand, float frequency, float amplitude, std::optional<std::chrono::nanoseconds> duration) = 0;
+    virtual void Stop(Hand hand) = 0;
+};
+
+// Plays the game's gamepad rumble patterns and the mod's own short pulses on the controllers.
+// The game thread only pushes commands into a ring, and the rumble thread sleeps until the next time the output changes,
+// so it's parked completely while nothing is rumbling. The output of both hands is combined into as few haptic calls as possible.
 class RumbleManager {
 public:
-    RumbleManager(XrSession session, XrAction haptic_action, XrPath subaction_path = XR_NULL_PATH) : m_session(session), m_haptic_action(haptic_action), m_subaction_path(subaction_path) {
+    // every bit of a gamepad rumble pattern is played for one frame at 60 FPS
+    static constexpr std::chrono::nanoseconds PATTERN_STEP = std::chrono::nanoseconds(std::chrono::seconds(1)) / 60;
+    static constexpr size_t MAX_PATTERN_STEPS = 60; // has to fit in the 64 bits of RumbleCommand::steps
+    static constexpr size_t MAX_QUEUED_PATTERNS = 5;
+
+    explicit RumbleManager(std::unique_ptr<HapticsSink> sink) : m_sink(std::move(sink)) {
         m_update_thread = std::thread(&RumbleManager::update_thread, this);
     }
 
     ~RumbleManager() {
         m_shutdown.store(true);
+        wake();
         if (m_update_thread.joinable()) {
             m_update_thread.join();
         }
     }
 
-    void initializeXrPaths(XrInstance instance)
-    {
-        xrStringToPath(instance, "/user/hand/left", &m_handSubactionPaths[0]);
-        xrStringToPath(instance, "/user/hand/right", &m_handSubactionPaths[1]);
-    }
-
     // pattern: uint8_t* rumble pattern
     // length: length in bits
     void controlMotor(uint8_t* pattern, uint8_t length) {
-        length = std::min<uint8_t>(length, 120);
+        length = std::min<uint8_t>(length, MAX_PATTERN_STEPS * 2);
 
-        if (length == 0) {
+        if (pattern == nullptr || length == 0) {
             stopMotor();
             return;
         }
 
-        push_rumble(pattern, length);
+        // every step of the pattern is stored as two bits, and the motor is on if either of them is set
+        RumbleCommand command = { .type = RumbleCommand::Type::PATTERN };
+        for (int bit = 0; bit < length; bit += 2) {
+            if ((pattern[bit / 8] & (3 << (bit % 8))) != 0) {
+                command.steps |= 1ull << command.stepCount;
+            }
+            command.stepCount++;
+        }
+        push_command(command);
     }
 
+    // stops the pattern and the pulses of both hands
     void stopMotor() {
-        std::scoped_lock lock(m_rumble_mutex);
-        while (!m_rumble_queue.empty()) {
-            m_rumble_queue.pop();
-        }
-        m_parser = 0;
-        m_current_rumbling = false;
-        stop_haptic();
+        push_command({ .type = RumbleCommand::Type::STOP });
     }
 
     void startSimpleRumble(bool leftHand, double duration, float frequency, float amplitude) {
-
-
         // duration is in seconds
-        XrHapticVibration vibration = {};
-        vibration.type = XR_TYPE_HAPTIC_VIBRATION;
-        vibration.next = nullptr;
-        vibration.duration = (XrDuration)(duration * 1e9);;
-        vibration.frequency = frequency;
-        vibration.amplitude = amplitude;
-
-        XrHapticActionInfo haptic_info = {};
-        haptic_info.type = XR_TYPE_HAPTIC_ACTION_INFO;
-        haptic_info.next = nullptr;
-        haptic_info.action = m_haptic_action;
-        haptic_info.subactionPath = m_handSubactionPaths[leftHand ? 0 : 1];
-
-        checkXRResult(xrApplyHapticFeedback(m_session, &haptic_info, (const XrHapticBaseHeader*)&vibration), "Failed to start rumble");
+        push_command({
+            .type = RumbleCommand::Type::PULSE,
+            .hand = (uint8_t)(leftHand ? 0 : 1),
+            .frequency = frequency,
+            .amplitude = amplitude,
+            .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(duration))
+        });
     }
 
+    uint64_t GetWakeCount() const { return m_wakeCount.load(std::memory_order_relaxed); }
+    uint64_t GetHapticCallCount() const { return m_hapticCallCount.load(std::memory_order_relaxed); }
+
 private:
-    bool push_rumble(uint8_t* pattern, uint8_t length) {
-        if (pattern == nullptr || length == 0) {
-            stopMotor();
-            return true;
-        }
+    using clock = std::chrono::steady_clock;
 
-        std::scoped_lock lock(m_rumble_mutex);
-        if (m_rumble_queue.size() >= 5) {
-            return false;
-        }
+    struct RumbleCommand {
+        enum class Type : uint8_t {
+            PATTERN,
+            STOP,
+            PULSE
+        };
+
+        Type type = Type::STOP;
+        uint8_t hand = 0;
+        uint8_t stepCount = 0;
+        uint64_t steps = 0; // bit i is set if the motor is on during step i
+        float frequency = XR_FREQUENCY_UNSPECIFIED;
+        float amplitude = 0.0f;
+        std::chrono::nanoseconds duration = {};
+    };
 
-        std::vector<bool> bitset;
-        int len = length;
-        int byte_idx = 0;
-        while (len > 0) {
-            uint8_t p = pattern[byte_idx];
-            for (int j = 0; j < 8 && j < len; j += 2) {
-                bool set = (p & (3 << j)) != 0;
-                bitset.push_back(set);
+    struct HapticOutput {
+        bool active = false;
+        float frequency = XR_FREQUENCY_UNSPECIFIED;
+        float amplitude = 0.0f;
+        std::optional<clock::time_point> end; // empty while it should rumble until it's stopped
+
+        bool operator==(const HapticOutput&) const = default;
+    };
+
+    struct Pulse {
+        float frequency = XR_FREQUENCY_UNSPECIFIED;
+        float amplitude = 0.0f;
+        clock::time_point end = {};
+    };
+
+    void push_command(const RumbleCommand& command) {
+        {
+            // the ring only supports a single producer, but the game can call this from multiple PPC threads
+            std::unique_lock lock(m_producer_mutex);
+            if (!try_push_command(command, lock)) {
+                return;
             }
-            ++byte_idx;
-            len -= 8;
         }
+        wake();
+    }
 
-        m_rumble_queue.emplace(std::move(bitset));
-        return true;
+    // the only place that pushes into m_commands, the lock has to be a lock on m_producer_mutex
+    bool try_push_command(const RumbleCommand& command, const std::unique_lock<std::mutex>& producerLock) {
+        checkAssert(producerLock.owns_lock() && producerLock.mutex() == &m_producer_mutex, "Rumble commands have to be pushed while holding the producer lock");
+        return m_commands.TryPush(command);
     }
 
-    void update_thread() {
-        using clock = std::chrono::steady_clock;
-        const auto period = std::chrono::milliseconds(1000 / 60);
+    void wake() {
+        {
+            // only notify once until the rumble thread has woken up, so a burst of commands results in a single wake
+            std::scoped_lock lock(m_wake_mutex);
+            if (m_wakePending) {
+                return;
+            }
+            m_wakePending = true;
+        }
+        m_wake_condition.notify_one();
+    }
 
-        auto next_tick = clock::now();
+    void update_thread() {
+        std::unique_lock lock(m_wake_mutex);
         while (!m_shutdown.load(std::memory_order_relaxed)) {
-            {
-                std::unique_lock lock(m_rumble_mutex);
-                if (m_rumble_queue.empty()) {
-                    if (m_current_rumbling) {
-                        stop_haptic();
-                        m_current_rumbling = false;
-                    }
-                    m_parser = 0;
-                }
-                else {
-                    const auto& current_pattern = m_rumble_queue.front();
-                    bool should_rumble = current_pattern[m_parser];
-                    if (should_rumble != m_current_rumbling) {
-                        if (should_rumble) {
-                            apply_haptic_infinite();
-                        }
-                        else {
-                            stop_haptic();
-                        }
-                        m_current_rumbling = should_rumble;
+            m_wakePending = false;
+            lock.unlock();
+            m_wakeCount.fetch_add(1, std::memory_order_relaxed);
+
+            const clock::time_point now = clock::now();
+            read_commands(now);
+            const std::optional<clock::time_point> nextEdge = update_output(now);
+
+            // sleep until the pattern changes, or until there are new commands if nothing is playing
+            lock.lock();
+            if (nextEdge.has_value()) {
+                m_wake_condition.wait_until(lock, nextEdge.value(), [this] { return m_wakePending; });
+            }
+            else {
+                m_wake_condition.wait(lock, [this] { return m_wakePending; });
+            }
+        }
+    }
+
+    void read_commands(clock::time_point now) {
+        RumbleCommand command;
+        while (m_commands.TryPop(command)) {
+            switch (command.type) {
+                case RumbleCommand::Type::PATTERN: {
+                    if (m_patternCount >= MAX_QUEUED_PATTERNS) {
+                        break;
                     }
-                    ++m_parser;
-                    if (m_parser >= current_pattern.size()) {
-                        m_rumble_queue.pop();
-                        m_parser = 0;
+                    if (m_patternCount == 0) {
+                        m_patternStart = now;
                     }
+                    m_patterns[(m_patternFront + m_patternCount) % MAX_QUEUED_PATTERNS] = command;
+                    m_patternCount++;
+                    break;
+                }
+                case RumbleCommand::Type::STOP: {
+                    m_patternCount = 0;
+                    m_pulses = {};
+                    m_stopRequested = true;
+                    break;
+                }
+                case RumbleCommand::Type::PULSE: {
+                    m_pulses[command.hand] = Pulse{
+                        .frequency = command.frequency,
+                        .amplitude = command.amplitude,
+                        .end = now + command.duration
+                    };
+                    break;
                 }
             }
-            next_tick += period;
-            std::this_thread::sleep_until(next_tick);
         }
     }
 
-void apply_haptic_infinite() {
-        XrHapticVibration vibration = {};
-        vibration.type = XR_TYPE_HAPTIC_VIBRATION;
-        vibration.next = nullptr;
-        vibration.duration = XR_INFINITE_DURATION;
-        vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
-        vibration.amplitude = 1.0f;
+    // applies the output both hands should have right now, and returns when it changes next if a pattern is playing
+    std::optional<clock::time_point> update_output(clock::time_point now) {
+        // skip the patterns that finished while sleeping, each one starts where the previous one ended
+        while (m_patternCount > 0) {
+            const clock::time_point patternEnd = m_patternStart + PATTERN_STEP * m_patterns[m_patternFront].stepCount;
+            if (now < patternEnd) {
+                break;
+            }
+            m_patternFront = (m_patternFront + 1) % MAX_QUEUED_PATTERNS;
+            m_patternCount--;
+            m_patternStart = patternEnd;
+        }
 
-        XrHapticActionInfo haptic_info = {};
-        haptic_info.type = XR_TYPE_HAPTIC_ACTION_INFO;
-        haptic_info.next = nullptr;
-        haptic_info.action = m_haptic_action;
-        haptic_info.subactionPath = m_subaction_path;
+        bool patternActive = false;
+        std::optional<clock::time_point> nextEdge;
+        if (m_patternCount > 0) {
+            const RumbleCommand& pattern = m_patterns[m_patternFront];
+            const uint32_t step = (uint32_t)((now - m_patternStart) / PATTERN_STEP);
+            patternActive = (pattern.steps >> step) & 1;
 
-        checkXRResult(xrApplyHapticFeedback(m_session, &haptic_info, (const XrHapticBaseHeader*)&vibration), "Failed to start rumble");
+            // find the next step that's different from the current one using the bits after it
+            const uint64_t stepMask = (1ull << pattern.stepCount) - 1;
+            const uint64_t changedSteps = (patternActive ? ~pattern.steps : pattern.steps) & stepMask & (~0ull << (step + 1));
+            const uint32_t nextStep = changedSteps != 0 ? (uint32_t)std::countr_zero(changedSteps) : pattern.stepCount;
+            nextEdge = m_patternStart + PATTERN_STEP * nextStep;
+        }
 
-        m_haptic_start_time = std::chrono::steady_clock::now();
-        m_haptic_active = true;
-    }
+        // a stop always reaches the runtime, even if nothing is known to be playing
+        if (m_stopRequested) {
+            m_stopRequested = false;
+            m_hapticCallCount.fetch_add(1, std::memory_order_relaxed);
+            m_sink->Stop(HapticsSink::Hand::BOTH);
+            m_appliedOutputs = {};
+        }
 
-    void stop_haptic() {
-        XrHapticActionInfo haptic_info = {};
-        haptic_info.type = XR_TYPE_HAPTIC_ACTION_INFO;
-        haptic_info.next = nullptr;
-        haptic_info.action = m_haptic_action;
-        haptic_info.subactionPath = m_subaction_path;
+        std::array<HapticOutput, 2> outputs;
+        for (size_t hand = 0; hand < outputs.size(); hand++) {
+            // the runtime stops pulses by itself once their duration is over
+            if (m_appliedOutputs[hand].end.has_value() && m_appliedOutputs[hand].end.value() <= now) {
+                m_appliedOutputs[hand] = {};
+            }
 
-        checkXRResult(xrStopHapticFeedback(m_session, &haptic_info), "Failed to stop rumble");
+            // the gamepad pattern rumbles both hands at full strength, which overrides any pulses
+            if (patternActive) {
+                outputs[hand] = { .active = true, .frequency = XR_FREQUENCY_UNSPECIFIED, .amplitude = 1.0f };
+            }
+            else if (m_pulses[hand].end > now) {
+                outputs[hand] = { .active = true, .frequency = m_pulses[hand].frequency, .amplitude = m_pulses[hand].amplitude, .end = m_pulses[hand].end };
+            }
+        }
 
-        if (m_haptic_active) {
-            auto end_time = std::chrono::steady_clock::now();
-            auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - m_haptic_start_time).count();
-            //Log::print("Stopping controller (haptic duration: {} ms)", duration_ms);
-            m_haptic_active = false;
+        const bool leftChanged = outputs[0] != m_appliedOutputs[0];
+        const bool rightChanged = outputs[1] != m_appliedOutputs[1];
+        if (leftChanged && rightChanged && outputs[0] == outputs[1]) {
+            apply_output(HapticsSink::Hand::BOTH, outputs[0], now);
+        }
+        else {
+            if (leftChanged) apply_output(HapticsSink::Hand::LEFT, outputs[0], now);
+            if (rightChanged) apply_output(HapticsSink::Hand::RIGHT, outputs[1], now);
         }
+        m_appliedOutputs = outputs;
+        return nextEdge;
     }
 
-    XrInstance m_instance;
-    XrSession m_session;
-    XrAction m_haptic_action;
-    XrPath m_subaction_path;
-    XrPath m_handSubactionPaths[2];
-
-    std::queue<std::vector<bool>> m_rumble_queue;
-    std::mutex m_rumble_mutex;
-    size_t m_parser = 0;
-    bool m_current_rumbling = false;
-    std::atomic<bool> m_shutdown{ false };
-    std::thread m_update_thread;
+    void apply_output(HapticsSink::Hand hand, const HapticOutput& output, clock::time_point now) {
+        m_hapticCallCount.fetch_add(1, std::memory_order_relaxed);
+        if (!output.active) {
+            m_sink->Stop(hand);
+            return;
+        }
 
-    std::chrono::steady_clock::time_point m_haptic_start_time{};
-    bool m_haptic_active = false;
-};
\ No newline at end of file
+        std::optional<std::chrono::nanoseconds> duration;
+        if (output.end.has_value()) {
+            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(output.end.value() - now);
+        }
+        m_sink->Apply(hand, output.frequency, output.amplitude, duration);
+    }
+
+    std::unique_ptr<HapticsSink> m_sink;
+
+    // shared between the game threads and the rumble thread
+    // the VPAD hooks and startSimpleRumble all produce commands, so pushes are serialized by m_producer_mutex (see try_push_command)
+    // to keep the ring single producer, only the rumble thread pops
+    SpscRing<RumbleCommand, 64> m_commands;
+    std::mutex m_producer_mutex;
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake_condition;
+    bool m_wakePending = false;
+    std::atomic_bool m_shutdown = false;
+    std::atomic_uint64_t m_wakeCount = 0;
+    std::atomic_uint64_t m_hapticCallCount = 0;
+
+    // only used by the rumble thread
+    std::array<RumbleCommand, MAX_QUEUED_PATTERNS> m_patterns = {};
+    size_t m_patternFront = 0;
+    size_t m_patternCount = 0;
+    clock::time_point m_patternStart = {};
+    std::array<Pulse, 2> m_pulses = {};
+    std::array<HapticOutput, 2> m_appliedOutputs = {};
+    bool m_stopRequested = false;
+
+    std::thread m_update_thread;
+};
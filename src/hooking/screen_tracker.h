@@ -0,0 +1,85 @@
+#pragma once
+
+// Snapshot of which screens (menus, dialogs, HUD elements) the game has open.
+// The screen manager is scanned once per frame and the result is published as a bitset, so checking a screen is a single atomic load
+// instead of following three guest pointers. Each scan also produces the list of screens that were opened or closed since the last one.
+class ScreenTracker {
+public:
+    static constexpr uint32_t SCREEN_COUNT = std::to_underlying(ScreenId::ScreenId_END) + 1;
+    using ScreenSet = std::bitset<SCREEN_COUNT>;
+
+    struct ScreenEvent {
+        ScreenId screen;
+        bool opened;
+    };
+
+    // reads the screen manager's screen pointer table from guest memory, only meant to be called from a single thread
+    void Scan(uint64_t memoryBaseAddress) {
+        Scan([memoryBaseAddress](uint32_t address, void* buffer, size_t size) {
+            memcpy(buffer, (void*)(memoryBaseAddress + address), size);
+        });
+    }
+
+    // same as above, but reads guest memory through readGuest(address, buffer, size) so the caller can track the accesses
+    template <typename ReadFn>
+    void Scan(ReadFn&& readGuest) {
+        auto readGuestU32 = [&](uint32_t address) -> uint32_t {
+            m_guestReads++;
+            uint32_t value;
+            readGuest(address, &value, sizeof(value));
+            return swapEndianness(value);
+        };
+
+        ScreenSet openScreens;
+        if (uint32_t screenManagerInstance = readGuestU32(SCREEN_MANAGER_INSTANCE_ADDR); screenManagerInstance != 0) {
+            uint32_t screenPtrs = readGuestU32(screenManagerInstance + 0x18);
+
+            // the pointers are only compared against null, so there's no need to swap their endianness
+            std::array<uint32_t, SCREEN_COUNT> screens;
+            readGuest(screenPtrs, screens.data(), sizeof(screens));
+            m_guestReads++;
+
+            for (uint32_t i = 0; i < SCREEN_COUNT; i++) {
+                openScreens[i] = screens[i] != 0;
+            }
+        }
+
+        m_events.clear();
+        ScreenSet changed = openScreens ^ m_openScreens;
+        for (uint32_t i = 0; changed.any() && i < SCREEN_COUNT; i++) {
+            if (changed[i]) {
+                m_events.emplace_back((ScreenId)i, openScreens[i]);
+                changed[i] = false;
+            }
+        }
+
+        m_openScreens = openScreens;
+        for (uint32_t word = 0; word < m_publishedWords.size(); word++) {
+            m_publishedWords[word].store(((openScreens >> (word * 64)) & ScreenSet(~0ull)).to_ullong(), std::memory_order_relaxed);
+        }
+        m_scanCount++;
+    }
+
+    // safe to call from any thread
+    bool IsOpen(ScreenId screen) const {
+        const uint32_t idx = std::to_underlying(screen);
+        return (m_publishedWords[idx / 64].load(std::memory_order_relaxed) >> (idx % 64)) & 1;
+    }
+
+    // only valid on the thread that calls Scan
+    const ScreenSet& GetOpenScreens() const { return m_openScreens; }
+    const std::vector<ScreenEvent>& GetEvents() const { return m_events; }
+
+    uint64_t GetGuestReadCount() const { return m_guestReads; }
+    uint64_t GetScanCount() const { return m_scanCount; }
+
+private:
+    static constexpr uint32_t SCREEN_MANAGER_INSTANCE_ADDR = 0x1047E650;
+
+    ScreenSet m_openScreens;
+    std::vector<ScreenEvent> m_events;
+    std::array<std::atomic_uint64_t, (SCREEN_COUNT + 63) / 64> m_publishedWords = {};
+
+    uint64_t m_guestReads = 0;
+    uint64_t m_scanCount = 0;
+};
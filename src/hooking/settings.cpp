@@ -1,25 +1,51 @@
 #include "cemu_hooks.h"
-#include "instance.h"
-#include "hooking/entity_debugger.h"
+#include "name_lists.h"
+
+using NameLists::ActorJob;
 
 std::mutex g_settingsMutex;
 data_VRSettingsIn g_settings = {};
 
-uint64_t CemuHooks::s_memoryBaseAddress = 0;
 std::atomic_uint32_t CemuHooks::s_framesSinceLastCameraUpdate = 0;
 
 
-bool CemuHooks::IsScreenOpen(ScreenId screen) {
-    uint32_t screenManagerInstance = getMemory<BEType<uint32_t>>(0x1047E650).getLE();
-    if (screenManagerInstance != 0) {
-        uint32_t screenBools = getMemory<BEType<uint32_t>>(screenManagerInstance + 0x18).getLE();
-        uint32_t screenPtr = getMemory<BEType<uint32_t>>(screenBools + (std::to_underlying(screen) * 4)).getLE();
-        return screenPtr != 0;
+ScreenTracker CemuHooks::s_screenTracker;
+std::atomic_bool CemuHooks::s_pauseMenuOpen = false;
+std::atomic_uint32_t CemuHooks::s_openMenuScreens = 0;
+
+void CemuHooks::OnScreenEvents(std::span<const ScreenTracker::ScreenEvent> events) {
+    // the tracker only reports screens whose state changed, so the opens and closes of a screen always alternate
+    for (const auto& event : events) {
+        switch (event.screen) {
+            case ScreenId::PauseMenuInfo_00:
+                s_pauseMenuOpen.store(event.opened, std::memory_order_relaxed);
+                break;
+            case ScreenId::ShopBG_00:
+            case ScreenId::MessageDialog:
+                if (event.opened) s_openMenuScreens.fetch_add(1, std::memory_order_relaxed);
+                else s_openMenuScreens.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            default:
+                break;
+        }
     }
-    return false;
-}
 
-std::unordered_set<ScreenId> prevEnabledScreens = {};
+#ifdef _DEBUG
+    bool printedSeparator = false;
+    for (const auto& event : events) {
+        if (event.opened) {
+            if (!printedSeparator) {
+                Log::print<INFO>("---------");
+                printedSeparator = true;
+            }
+            Log::print<INFO>("Screen {} is ON", ScreenIdToString(event.screen));
+        }
+        else {
+            Log::print<INFO>("Screen {} is OFF", ScreenIdToString(event.screen));
+        }
+    }
+#endif
+}
 
 void CemuHooks::hook_UpdateSettings(PPCInterpreter_t* hCPU) {
     // Log::print("Updated settings!");
@@ -29,39 +55,21 @@ void CemuHooks::hook_UpdateSettings(PPCInterpreter_t* hCPU) {
     uint32_t ppc_tableOfCutsceneEventSettings = hCPU->gpr[6];
     data_VRSettingsIn settings = {};
 
-    if (auto& debugger = VRManager::instance().Hooks->m_entityDebugger) {
-        debugger->UpdateEntityMemory();
-    }
+    GetHost().UpdateEntityDebugger();
 
     readMemory(ppc_settingsOffset, &settings);
 
+    s_screenTracker.Scan([](uint32_t address, void* buffer, size_t size) { readMemoryBytes(address, buffer, size); });
+    if (!s_screenTracker.GetEvents().empty()) {
+        OnScreenEvents(s_screenTracker.GetEvents());
+    }
+
     std::lock_guard lock(g_settingsMutex);
     g_settings = settings;
     ++s_framesSinceLastCameraUpdate;
 
-#ifdef _DEBUG
-    constexpr uint32_t maxScreenIdx = std::to_underlying(ScreenId::ScreenId_END);
-    std::unordered_set<ScreenId> currentEnabledScreens;
-    for (uint32_t i = 0; i < maxScreenIdx; i++) {
-        ScreenId id = (ScreenId)i;
-        bool hasScreen = IsScreenOpen(id);
-
-        if (hasScreen) {            
-
-            if (!prevEnabledScreens.contains(id)) {
-                if (currentEnabledScreens.empty()) {
-                    Log::print<INFO>("---------");
-                }
-                Log::print<INFO>("Screen {} is ON", ScreenIdToString((ScreenId)i));
-            }
-            currentEnabledScreens.emplace(id);
-        }
-        else if (prevEnabledScreens.contains(id)) {
-            Log::print<INFO>("Screen {} is OFF", ScreenIdToString((ScreenId)i));
-        }
-    }
-    prevEnabledScreens = currentEnabledScreens;
-#endif
+    BETTERVR_GAUGE(s_framesSinceCameraUpdate, "hooks.frames_since_camera_update");
+    s_framesSinceCameraUpdate.Set((double)s_framesSinceLastCameraUpdate.load());
 
     static bool logSettings = true;
     if (logSettings) {
@@ -73,7 +81,15 @@ void CemuHooks::hook_UpdateSettings(PPCInterpreter_t* hCPU) {
 }
 
 data_VRSettingsIn CemuHooks::GetSettings() {
-    std::lock_guard lock(g_settingsMutex);
+    BETTERVR_COUNTER(s_settingsReads, "settings.reads");
+    BETTERVR_COUNTER(s_settingsContentions, "settings.lock_contentions");
+    s_settingsReads.Add();
+
+    std::unique_lock lock(g_settingsMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        s_settingsContentions.Add();
+        lock.lock();
+    }
     return g_settings;
 }
 
@@ -85,16 +101,14 @@ void CemuHooks::hook_OSReportToConsole(PPCInterpreter_t* hCPU) {
     if (strPtr == 0) {
         return;
     }
-    char* str = (char*)(s_memoryBaseAddress + strPtr);
-    if (str == nullptr) {
-        return;
-    }
-    if (str[0] != '\0') {
-        Log::print<PPC>(str);
+    std::string_view str = getString(strPtr, 0x1000);
+    if (!str.empty()) {
+        Log::print<PPC>("{}", str);
     }
 }
 
 constexpr uint32_t playerVtable = 0x101E5FFC;
+
 void CemuHooks::hook_RouteActorJob(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
@@ -102,11 +116,10 @@ void CemuHooks::hook_RouteActorJob(PPCInterpreter_t* hCPU) {
     uint32_t jobName = hCPU->gpr[4];
     uint32_t side = hCPU->gpr[5]; // 0 = left, 1 = right
 
-    std::string jobNameStr = std::string((char*)(s_memoryBaseAddress + jobName));
+    std::string_view jobNameStr = getString(jobName, 32);
+    const ActorJob job = NameLists::FindActorJob(jobNameStr);
 
-    ActorWiiU actor;
-    readMemory(actorPtr, &actor);
-    std::string actorName = actor.name.getLE();
+    bool isPlayer = GetActorClass(actorPtr) == ActorClass::PLAYER;
 
 #define SKIP_ON_LEFT_SIDE if (side == 0) { hCPU->gpr[3] = 1; }
 #define SKIP_ON_RIGHT_SIDE if (side == 1) { hCPU->gpr[3] = 1; }
@@ -114,60 +127,48 @@ void CemuHooks::hook_RouteActorJob(PPCInterpreter_t* hCPU) {
 #define USE_ALTERED_PATH_ON_RIGHT_SIDE if (side == 1) { hCPU->gpr[3] = 2; }
 
     hCPU->gpr[3] = 0;
-    if (actorName == "GameROMPlayer") {
-        if (jobNameStr == "job0_1") {
-            // this only runs the climbing portion of this actor job on the left eye's side
-            // so that later jobs on the left side can use the state set by this portion of code
-            USE_ALTERED_PATH_ON_LEFT_SIDE
-        }
-        else if (jobNameStr == "job0_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_1") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_1_ragdoll_related") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job4") {
-            SKIP_ON_RIGHT_SIDE
+    if (isPlayer) {
+        switch (job) {
+            case ActorJob::JOB0_1:
+                // this only runs the climbing portion of this actor job on the left eye's side
+                // so that later jobs on the left side can use the state set by this portion of code
+                USE_ALTERED_PATH_ON_LEFT_SIDE
+                break;
+            case ActorJob::JOB0_2:
+            case ActorJob::JOB1_1:
+            case ActorJob::JOB1_2:
+            case ActorJob::JOB2_1_RAGDOLL_RELATED:
+            case ActorJob::JOB2_2:
+            case ActorJob::JOB4:
+                SKIP_ON_RIGHT_SIDE
+                break;
+            default:
+                break;
         }
     }
     else {
-        if (jobNameStr == "job0_1") {
-            SKIP_ON_LEFT_SIDE
-        }
-        else if (jobNameStr == "job0_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_1") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_1_ragdoll_related") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job4") {
-            SKIP_ON_RIGHT_SIDE
+        switch (job) {
+            case ActorJob::JOB0_1:
+                SKIP_ON_LEFT_SIDE
+                break;
+            case ActorJob::JOB0_2:
+            case ActorJob::JOB1_1:
+            case ActorJob::JOB1_2:
+            case ActorJob::JOB2_1_RAGDOLL_RELATED:
+            case ActorJob::JOB2_2:
+            case ActorJob::JOB4:
+                SKIP_ON_RIGHT_SIDE
+                break;
+            default:
+                break;
         }
     }
 
     if (hCPU->gpr[3] == 0) {
-        //Log::print<INFO>("[{}] Ran {}", actorName, jobNameStr);
+        //Log::print<INFO>("[{}] Ran {}", isPlayer ? "GameROMPlayer" : "Actor", jobNameStr);
     }
     else if (hCPU->gpr[3] == 2) {
-        //Log::print<INFO>("[{}] Ran ALTERED VERSION of {}", actorName, jobNameStr);
+        //Log::print<INFO>("[{}] Ran ALTERED VERSION of {}", isPlayer ? "GameROMPlayer" : "Actor", jobNameStr);
     }
 
 
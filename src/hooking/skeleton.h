@@ -0,0 +1,174 @@
+#pragma once
+#include "hooking/skeleton_data.h"
+#include "utils/rigid_pose.h"
+
+// The bone hierarchy is stored as parallel arrays where every parent comes before its children.
+// World matrices are then updated in a single linear pass, and only bones below a changed local matrix get recalculated.
+class Skeleton {
+public:
+    void Load(std::span<const SkeletonData::BoneData> bones, int32_t (*findBone)(std::string_view)) {
+        m_findBone = findBone;
+        m_parentIndices.clear();
+        m_localPositions.clear();
+        m_localMatrices.clear();
+        m_worldMatrices.clear();
+        m_dirty.clear();
+
+        for (const auto& bone : bones) {
+            const glm::vec3 pos = glm::make_vec3(bone.position.data());
+            const glm::vec3 rotEuler = glm::make_vec3(bone.rotationEuler.data());
+            m_parentIndices.emplace_back(bone.parentIndex);
+            m_localPositions.emplace_back(pos);
+            m_localMatrices.emplace_back(glm::translate(glm::identity<glm::mat4>(), pos) * glm::eulerAngleZYX(rotEuler.x, rotEuler.y, rotEuler.z));
+            m_worldMatrices.emplace_back(1.0f);
+            m_dirty.emplace_back(true);
+        }
+
+        m_anyDirty = true;
+        UpdateWorldMatrices();
+    }
+
+    void UpdateWorldMatrices() {
+        if (!m_anyDirty) return;
+
+        for (size_t i = 0; i < m_parentIndices.size(); i++) {
+            const int parentIndex = m_parentIndices[i];
+            if (parentIndex == -1) {
+                if (m_dirty[i]) {
+                    m_worldMatrices[i] = m_localMatrices[i];
+                }
+                continue;
+            }
+
+            // a bone needs updating when its own or any of its ancestors' matrices changed
+            m_dirty[i] |= m_dirty[parentIndex];
+            if (m_dirty[i]) {
+                m_worldMatrices[i] = MultiplyAffine(m_worldMatrices[parentIndex], m_localMatrices[i]);
+            }
+        }
+
+        std::fill(m_dirty.begin(), m_dirty.end(), false);
+        m_anyDirty = false;
+    }
+
+    glm::mat4 CalculateLocalMatrixFromWorld(int boneIndex, const glm::mat4& targetWorldMatrix) const {
+        if (boneIndex < 0 || boneIndex >= m_parentIndices.size()) return glm::identity<glm::mat4>();
+
+        const int parentIndex = m_parentIndices[boneIndex];
+        if (parentIndex == -1) {
+            return targetWorldMatrix;
+        }
+
+        const glm::mat4 parentWorldMatrix = glm::mat4(m_worldMatrices[parentIndex]);
+        return InverseRigid(parentWorldMatrix) * targetWorldMatrix;
+    }
+
+    void SolveTwoBoneIK(int rootIdx, int midIdx, int endIdx, const glm::vec3& targetPos, const glm::vec3& poleVector, float boneForwardSign) {
+        if (rootIdx < 0 || rootIdx >= m_parentIndices.size() ||
+            midIdx < 0 || midIdx >= m_parentIndices.size() ||
+            endIdx < 0 || endIdx >= m_parentIndices.size()) {
+            return;
+        }
+
+        // get parent world matrix (clavicle)
+        glm::mat4 parentWorld = glm::identity<glm::mat4>();
+        if (m_parentIndices[rootIdx] != -1) {
+            parentWorld = glm::mat4(m_worldMatrices[m_parentIndices[rootIdx]]);
+        }
+
+        glm::vec3 rootPos = glm::vec3(parentWorld * glm::vec4(m_localPositions[rootIdx], 1.0f));
+
+        // get lengths
+        float l1 = glm::length(m_localPositions[midIdx]);
+        float l2 = glm::length(m_localPositions[endIdx]);
+
+        // solve IK
+        glm::vec3 dir = targetPos - rootPos;
+        float dist = glm::length(dir);
+
+        // clamp distance
+        float epsilon = 0.001f;
+        dist = glm::clamp(dist, epsilon, l1 + l2 - epsilon);
+
+        // law of cosines for angle at shoulder (alpha)
+        float cosAlpha = (l1 * l1 + dist * dist - l2 * l2) / (2 * l1 * dist);
+        float alpha = glm::acos(glm::clamp(cosAlpha, -1.0f, 1.0f));
+
+        // plane construction
+        glm::vec3 dirNorm = glm::normalize(dir);
+        glm::vec3 planeNormal = glm::normalize(glm::cross(dirNorm, poleVector));
+        glm::vec3 ortho = glm::normalize(glm::cross(planeNormal, dirNorm));
+
+        // arm 1 direction (world)
+        glm::vec3 arm1Dir = glm::normalize(dirNorm * cos(alpha) + ortho * sin(alpha));
+
+        // arm 2 direction (world)
+        glm::vec3 elbowPos = rootPos + arm1Dir * l1;
+        glm::vec3 arm2Dir = glm::normalize(targetPos - elbowPos);
+
+        // construct rotation matrices
+        glm::vec3 x1 = arm1Dir * boneForwardSign;
+        glm::vec3 z1 = planeNormal;
+        glm::vec3 y1 = glm::cross(z1, x1);
+        glm::mat3 rot1World = glm::mat3(x1, y1, z1);
+
+        glm::vec3 x2 = arm2Dir * boneForwardSign;
+        glm::vec3 z2 = planeNormal;
+        glm::vec3 y2 = glm::cross(z2, x2);
+        glm::mat3 rot2World = glm::mat3(x2, y2, z2);
+
+        // convert to local space
+        glm::mat4 arm1Local = InverseRigid(parentWorld) * glm::mat4(rot1World);
+        arm1Local[3] = glm::vec4(m_localPositions[rootIdx], 1.0f); // restore translation
+
+        glm::mat4 arm1World = parentWorld * arm1Local;
+        glm::mat4 arm2Local = InverseRigid(arm1World) * glm::mat4(rot2World);
+        arm2Local[3] = glm::vec4(m_localPositions[midIdx], 1.0f); // restore translation
+
+        // update skeleton
+        SetLocalMatrix(rootIdx, glm::mat4x3(arm1Local));
+        SetLocalMatrix(midIdx, glm::mat4x3(arm2Local));
+        UpdateWorldMatrices();
+    }
+
+    int GetBoneIndex(std::string_view name) const {
+        return m_findBone ? m_findBone(name) : -1;
+    }
+
+    size_t GetBoneCount() const {
+        return m_parentIndices.size();
+    }
+
+    int GetParentIndex(int index) const { return m_parentIndices[index]; }
+    const glm::vec3& GetLocalPos(int index) const { return m_localPositions[index]; }
+    const glm::mat4x3& GetLocalMatrix(int index) const { return m_localMatrices[index]; }
+
+    // only up to date after UpdateWorldMatrices
+    const glm::mat4x3& GetWorldMatrix(int index) const { return m_worldMatrices[index]; }
+
+    void SetLocalMatrix(int index, const glm::mat4x3& localMatrix) {
+        m_localMatrices[index] = localMatrix;
+        m_dirty[index] = true;
+        m_anyDirty = true;
+    }
+
+private:
+    // multiplies two affine transforms, skipping the implicit (0, 0, 0, 1) bottom row
+    static glm::mat4x3 MultiplyAffine(const glm::mat4x3& a, const glm::mat4x3& b) {
+        glm::mat4x3 result;
+        for (int i = 0; i < 4; i++) {
+            result[i] = a[0] * b[i].x + a[1] * b[i].y + a[2] * b[i].z;
+        }
+        result[3] += a[3];
+        return result;
+    }
+
+    int32_t (*m_findBone)(std::string_view) = nullptr;
+
+    std::vector<int> m_parentIndices;
+    std::vector<glm::vec3> m_localPositions;
+    std::vector<glm::mat4x3> m_localMatrices;
+    std::vector<glm::mat4x3> m_worldMatrices;
+    std::vector<uint8_t> m_dirty;
+    bool m_anyDirty = false;
+};
@@ -0,0 +1,208 @@
+#pragma once
+#include "utils/name_set.h"
+
+// generated by CMake from the .skeleton files in resources/skeletons
+#include "skeleton_sources.h"
+
+// Bone hierarchies that are parsed from the .skeleton data files while compiling.
+// Every line of a file is "<bone> | <x y z> | <rotation>", indented below its parent bone. Lines starting with # are comments.
+namespace SkeletonData {
+    struct BoneData {
+        std::string_view name;
+        int32_t parentIndex = -1;
+        std::array<float, 3> position = {};
+        std::array<float, 3> rotationEuler = {}; // in radians
+    };
+
+    constexpr std::string_view Trim(std::string_view str) {
+        while (!str.empty() && (str.front() == ' ' || str.front() == '\t' || str.front() == '\r')) str.remove_prefix(1);
+        while (!str.empty() && (str.back() == ' ' || str.back() == '\t' || str.back() == '\r')) str.remove_suffix(1);
+        return str;
+    }
+
+    // 128-bit unsigned integer for the exact decimal to float conversion, which only needs shifts, comparisons and subtraction
+    struct UInt128 {
+        uint64_t hi = 0;
+        uint64_t lo = 0;
+
+        constexpr UInt128 operator<<(uint32_t shift) const {
+            if (shift == 0) return *this;
+            if (shift >= 64) return { lo << (shift - 64), 0 };
+            return { (hi << shift) | (lo >> (64 - shift)), lo << shift };
+        }
+        constexpr UInt128 operator-(const UInt128& other) const {
+            return { hi - other.hi - (lo < other.lo ? 1 : 0), lo - other.lo };
+        }
+        constexpr auto operator<=>(const UInt128& other) const = default;
+    };
+
+    // parses a plain decimal number like "-0.00002", which is all the data files use
+    // the result is the float that's nearest to the exact decimal value, like strtof, since going through a double first
+    // would round twice and can end up one bit off
+    constexpr float ParseFloat(std::string_view str) {
+        bool negative = false;
+        if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+            negative = str.front() == '-';
+            str.remove_prefix(1);
+        }
+
+        uint64_t mantissa = 0;
+        uint64_t scale = 1;
+        uint32_t digits = 0;
+        uint32_t significantDigits = 0;
+        uint32_t fractionDigits = 0;
+        bool hasDecimalPoint = false;
+        for (char c : str) {
+            if (c == '.' && !hasDecimalPoint) {
+                hasDecimalPoint = true;
+            }
+            else if (c >= '0' && c <= '9') {
+                // both the digits and the power of ten have to fit in 64 bits
+                digits++;
+                if ((mantissa != 0 || c != '0') && ++significantDigits > 19) {
+                    throw "Too many digits in a number in skeleton data";
+                }
+                if (hasDecimalPoint && ++fractionDigits > 19) {
+                    throw "Too many digits in a number in skeleton data";
+                }
+                mantissa = mantissa * 10 + (c - '0');
+                if (hasDecimalPoint) scale *= 10;
+            }
+            else {
+                throw "Invalid number in skeleton data";
+            }
+        }
+        if (digits == 0) {
+            throw "Invalid number in skeleton data";
+        }
+        if (mantissa == 0) {
+            return negative ? -0.0f : 0.0f;
+        }
+
+        // find the exponent where mantissa / scale = quotient * 2^exponent with a 24-bit quotient, which is a float's precision
+        int32_t exponent = (int32_t)std::bit_width(mantissa) - (int32_t)std::bit_width(scale) - 24;
+        UInt128 numerator;
+        UInt128 denominator;
+        uint64_t quotient = 0;
+        while (true) {
+            numerator = UInt128{ 0, mantissa } << (uint32_t)std::max(0, -exponent);
+            denominator = UInt128{ 0, scale } << (uint32_t)std::max(0, exponent);
+
+            // the quotient has at most 26 bits since the exponent is only off by one or two
+            quotient = 0;
+            for (int32_t bit = 25; bit >= 0; bit--) {
+                if (const UInt128 shifted = denominator << (uint32_t)bit; numerator >= shifted) {
+                    numerator = numerator - shifted;
+                    quotient |= 1ull << bit;
+                }
+            }
+
+            if (quotient >= (1ull << 24)) exponent++;
+            else if (quotient < (1ull << 23)) exponent--;
+            else break;
+        }
+
+        // round half to even using the remainder
+        const UInt128 twiceRemainder = numerator << 1;
+        if (twiceRemainder > denominator || (twiceRemainder == denominator && (quotient & 1) != 0)) {
+            quotient++;
+        }
+
+        // scaling by powers of two is exact, the data files don't get anywhere near the denormals
+        float value = (float)quotient;
+        for (; exponent > 0; exponent--) value *= 2.0f;
+        for (; exponent < 0; exponent++) value *= 0.5f;
+        return negative ? -value : value;
+    }
+
+    constexpr std::array<float, 3> ParseVec3(std::string_view str) {
+        std::array<float, 3> result = {};
+        str = Trim(str);
+        for (size_t i = 0; i < 3; i++) {
+            const size_t end = str.find(' ');
+            if ((end == std::string_view::npos) != (i == 2)) {
+                throw "Expected three numbers in skeleton data";
+            }
+            result[i] = ParseFloat(str.substr(0, end));
+            str = end == std::string_view::npos ? std::string_view() : Trim(str.substr(end));
+        }
+        return result;
+    }
+
+    // calls onBone(indent, line) for every line that describes a bone
+    template <typename F>
+    constexpr void ForEachBoneLine(std::string_view text, F&& onBone) {
+        while (!text.empty()) {
+            const size_t lineEnd = text.find('\n');
+            std::string_view line = text.substr(0, lineEnd);
+            text = lineEnd == std::string_view::npos ? std::string_view() : text.substr(lineEnd + 1);
+
+            const size_t indent = line.find_first_not_of(' ');
+            if (indent == std::string_view::npos) continue;
+
+            std::string_view content = Trim(line.substr(indent));
+            if (content.empty() || content.front() == '#') continue;
+            onBone(indent, content);
+        }
+    }
+
+    constexpr size_t CountBones(std::string_view text) {
+        size_t count = 0;
+        ForEachBoneLine(text, [&](size_t, std::string_view) { count++; });
+        return count;
+    }
+
+    template <size_t N>
+    consteval std::array<BoneData, N> ParseBones(std::string_view text) {
+        std::array<BoneData, N> bones = {};
+
+        // the indentation and index of every bone that's still open to children
+        std::array<std::pair<size_t, int32_t>, N> parentStack = {};
+        size_t parentStackSize = 0;
+
+        int32_t boneIdx = 0;
+        ForEachBoneLine(text, [&](size_t indent, std::string_view content) {
+            const size_t p1 = content.find('|');
+            const size_t p2 = content.find('|', p1 + 1);
+            if (p1 == std::string_view::npos || p2 == std::string_view::npos) {
+                throw "Expected a line with the format <bone> | <position> | <rotation> in skeleton data";
+            }
+
+            while (parentStackSize > 0 && parentStack[parentStackSize - 1].first >= indent) {
+                parentStackSize--;
+            }
+
+            // bones are stored in the order they're listed, so a parent always precedes its children
+            BoneData& bone = bones[boneIdx];
+            bone.name = Trim(content.substr(0, p1));
+            bone.parentIndex = parentStackSize > 0 ? parentStack[parentStackSize - 1].second : -1;
+            bone.position = ParseVec3(content.substr(p1 + 1, p2 - p1 - 1));
+            bone.rotationEuler = ParseVec3(content.substr(p2 + 1));
+
+            parentStack[parentStackSize++] = { indent, boneIdx };
+            boneIdx++;
+        });
+        return bones;
+    }
+
+    template <size_t N>
+    consteval std::array<std::string_view, N> GetBoneNames(const std::array<BoneData, N>& bones) {
+        std::array<std::string_view, N> names = {};
+        for (size_t i = 0; i < N; i++) {
+            names[i] = bones[i].name;
+        }
+        return names;
+    }
+
+    // a skeleton that's compiled from one of the data files in SkeletonSources
+    template <const std::string_view& Source>
+    struct CompiledSkeleton {
+        static constexpr size_t BONE_COUNT = CountBones(Source);
+        static constexpr std::array<BoneData, BONE_COUNT> BONES = ParseBones<BONE_COUNT>(Source);
+        static constexpr NameSet<BONE_COUNT> BONE_NAMES = GetBoneNames(BONES);
+
+        static int32_t FindBone(std::string_view name) {
+            return BONE_NAMES.find(name);
+        }
+    };
+}
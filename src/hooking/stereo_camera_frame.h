@@ -0,0 +1,176 @@
+#pragma once
+#include "utils/rigid_pose.h"
+
+// Per-eye camera data that only depends on the OpenXR views, so it only has to be recalculated when the renderer locates new views.
+// The game requests projections many times per eye (layers, shadows, the light prepass), which now only need a lookup and a copy.
+// It isn't thread safe, since even looking up a projection can replace one, so each thread that uses it needs its own.
+class StereoCameraFrame {
+public:
+    static constexpr size_t PROJECTION_VARIANTS = 4;
+
+    struct Projection {
+        float zNear = 0.0f;
+        float zFar = 0.0f;
+        float deviceZScale = 0.0f;
+        float deviceZOffset = 0.0f;
+        BEMatrix44 matrix;
+        BEMatrix44 deviceMatrix;
+    };
+
+    struct Eye {
+        XrFovf fov = {};
+        RigidPose pose;
+
+        // tangents of the fov angles, which is all that's needed to build a projection for any near and far plane
+        float tanLeft = 0.0f;
+        float tanRight = 0.0f;
+        float tanDown = 0.0f;
+        float tanUp = 0.0f;
+
+        BEType<float> aspect;
+        BEType<float> fovY;
+        BEType<float> fovYSin;
+        BEType<float> fovYCos;
+        BEType<float> fovYTan;
+        BEVec2 offset;
+
+        // projections for the near/far planes and device z ranges that were requested with these views
+        std::array<Projection, PROJECTION_VARIANTS> projections;
+        uint32_t projectionCount = 0;
+        uint32_t nextProjection = 0;
+    };
+
+    // recalculates both eyes if the renderer located new views since the last call, returns false if there are no views yet
+    // the renderer only has to provide GetViewsGeneration() and GetPoses(), so that this can be tested without a headset
+    template <typename Renderer>
+    bool Sync(const Renderer& renderer) {
+        const uint64_t viewsGeneration = renderer.GetViewsGeneration();
+        if (m_valid && viewsGeneration == m_viewsGeneration) {
+            return true;
+        }
+
+        const auto views = renderer.GetPoses();
+        if (!views.has_value()) {
+            m_valid = false;
+            return false;
+        }
+
+        for (size_t side = 0; side < m_eyes.size(); side++) {
+            UpdateEye(m_eyes[side], views.value()[side]);
+        }
+        m_viewsGeneration = viewsGeneration;
+        m_valid = true;
+        m_syncCount++;
+        return true;
+    }
+
+    const Eye& GetEye(size_t side) const { return m_eyes[side]; }
+
+    const Projection& GetProjection(size_t side, float zNear, float zFar, float deviceZScale, float deviceZOffset) {
+        Eye& eye = m_eyes[side];
+        for (uint32_t i = 0; i < eye.projectionCount; i++) {
+            const Projection& projection = eye.projections[i];
+            if (projection.zNear == zNear && projection.zFar == zFar && projection.deviceZScale == deviceZScale && projection.deviceZOffset == deviceZOffset) {
+                return projection;
+            }
+        }
+
+        Projection& projection = eye.projections[eye.nextProjection];
+        eye.nextProjection = (eye.nextProjection + 1) % PROJECTION_VARIANTS;
+        eye.projectionCount = std::min<uint32_t>(eye.projectionCount + 1, PROJECTION_VARIANTS);
+        BuildProjection(eye, zNear, zFar, deviceZScale, deviceZOffset, projection);
+        m_projectionBuildCount++;
+        return projection;
+    }
+
+    // overwrites the fov and matrices of a sead::PerspectiveProjection, using its own near/far planes and device z range
+    void ApplyTo(size_t side, BESeadPerspectiveProjection& perspectiveProjection) {
+        const Eye& eye = m_eyes[side];
+        perspectiveProjection.aspect = eye.aspect;
+        perspectiveProjection.fovYRadiansOrAngle = eye.fovY;
+        perspectiveProjection.fovySin = eye.fovYSin;
+        perspectiveProjection.fovyCos = eye.fovYCos;
+        perspectiveProjection.fovyTan = eye.fovYTan;
+        perspectiveProjection.offset = eye.offset;
+
+        const Projection& projection = GetProjection(side, perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), perspectiveProjection.deviceZScale.getLE(), perspectiveProjection.deviceZOffset.getLE());
+        perspectiveProjection.matrix = projection.matrix;
+        perspectiveProjection.deviceMatrix = projection.deviceMatrix;
+
+        perspectiveProjection.dirty = false;
+        perspectiveProjection.deviceDirty = false;
+    }
+
+    uint64_t GetSyncCount() const { return m_syncCount; }
+    uint64_t GetProjectionBuildCount() const { return m_projectionBuildCount; }
+
+private:
+    static void UpdateEye(Eye& eye, const XrView& view) {
+        const XrFovf& fov = view.fov;
+        eye.fov = fov;
+        eye.pose = RigidPose(ToGLM(view.pose.orientation), ToGLM(view.pose.position));
+
+        eye.tanLeft = tanf(fov.angleLeft);
+        eye.tanRight = tanf(fov.angleRight);
+        eye.tanDown = tanf(fov.angleDown);
+        eye.tanUp = tanf(fov.angleUp);
+
+        float totalHorizontalFov = fov.angleRight - fov.angleLeft;
+        float totalVerticalFov = fov.angleUp - fov.angleDown;
+        float halfAngle = totalVerticalFov * 0.5f;
+
+        eye.aspect = totalHorizontalFov / totalVerticalFov;
+        eye.fovY = totalVerticalFov;
+        eye.fovYSin = sinf(halfAngle);
+        eye.fovYCos = cosf(halfAngle);
+        eye.fovYTan = tanf(halfAngle);
+        eye.offset = BEVec2((fov.angleRight + fov.angleLeft) / 2.0f, (fov.angleUp + fov.angleDown) / 2.0f);
+
+        eye.projectionCount = 0;
+        eye.nextProjection = 0;
+    }
+
+    // https://github.com/KhronosGroup/OpenXR-SDK/blob/858912260ca616f4c23f7fb61c89228c353eb124/src/common/xr_linear.h#L564C1-L632C2
+    // https://github.com/aboood40091/sead/blob/45b629fb032d88b828600a1b787729f2d398f19d/engine/library/modules/src/gfx/seadProjection.cpp#L166
+    static void BuildProjection(const Eye& eye, float nearZ, float farZ, float zScale, float zOffset, Projection& projection) {
+        float l = eye.tanLeft * nearZ;
+        float r = eye.tanRight * nearZ;
+        float b = eye.tanDown * nearZ;
+        float t = eye.tanUp * nearZ;
+
+        float invW = 1.0f / (r - l);
+        float invH = 1.0f / (t - b);
+        float invD = 1.0f / (farZ - nearZ);
+
+        glm::fmat4 dst = {};
+        dst[0][0] = 2.0f * nearZ * invW;
+        dst[1][1] = 2.0f * nearZ * invH;
+        dst[0][2] = (r + l) * invW;
+        dst[1][2] = (t + b) * invH;
+        dst[2][2] = -(farZ + nearZ) * invD;
+        dst[2][3] = -(2.0f * farZ * nearZ) * invD;
+        dst[3][2] = -1.0f;
+        dst[3][3] = 0.0f;
+
+        // calculate device matrix
+        glm::fmat4 deviceDst = dst;
+        deviceDst[2][0] *= zScale;
+        deviceDst[2][1] *= zScale;
+        deviceDst[2][2] = (deviceDst[2][2] + deviceDst[3][2] * zOffset) * zScale;
+        deviceDst[2][3] = deviceDst[2][3] * zScale + deviceDst[3][3] * zOffset;
+
+        projection.zNear = nearZ;
+        projection.zFar = farZ;
+        projection.deviceZScale = zScale;
+        projection.deviceZOffset = zOffset;
+        projection.matrix = dst;
+        projection.deviceMatrix = deviceDst;
+    }
+
+    std::array<Eye, 2> m_eyes;
+    uint64_t m_viewsGeneration = 0;
+    bool m_valid = false;
+
+    uint64_t m_syncCount = 0;
+    uint64_t m_projectionBuildCount = 0;
+};
@@ -0,0 +1,67 @@
+#include "vr_hook_host.h"
+#include "instance.h"
+
+InputState VRHookHost::GetInput() const {
+    return m_xr.m_input.load();
+}
+
+void VRHookHost::SetInput(const InputState& input) {
+    m_xr.m_input.store(input);
+}
+
+GameState VRHookHost::GetGameState() const {
+    return m_xr.m_gameState.load();
+}
+
+void VRHookHost::SetGameState(const GameState& gameState) {
+    m_xr.m_gameState.store(gameState);
+}
+
+glm::fquat VRHookHost::GetInputCameraRotation() const {
+    return m_xr.m_inputCameraRotation.load();
+}
+
+void VRHookHost::OnInputUsed() {
+    if (RND_Renderer* renderer = m_xr.GetRenderer()) {
+        renderer->GetFrameLatency().OnInputUsed();
+    }
+}
+
+bool VRHookHost::ShouldBlockGameInput() const {
+    RND_Renderer* renderer = m_xr.GetRenderer();
+    return renderer && renderer->m_imguiOverlay && renderer->m_imguiOverlay->ShouldBlockGameInput();
+}
+
+bool VRHookHost::HasRenderer() const {
+    return m_xr.GetRenderer() != nullptr;
+}
+
+bool VRHookHost::IsRendererInitialized() const {
+    RND_Renderer* renderer = m_xr.GetRenderer();
+    return renderer != nullptr && renderer->IsInitialized();
+}
+
+uint64_t VRHookHost::GetViewsGeneration() const {
+    RND_Renderer* renderer = m_xr.GetRenderer();
+    return renderer != nullptr ? renderer->GetViewsGeneration() : 0;
+}
+
+std::optional<std::array<XrView, 2>> VRHookHost::GetPoses() const {
+    RND_Renderer* renderer = m_xr.GetRenderer();
+    return renderer != nullptr ? renderer->GetPoses() : std::nullopt;
+}
+
+HookHost::FrameState& VRHookHost::GetFrameState(uint32_t frameCounter) {
+    RND_Renderer* renderer = m_xr.GetRenderer();
+    return renderer != nullptr ? renderer->GetFrame(frameCounter).hookState : m_fallbackFrameState;
+}
+
+RumbleManager* VRHookHost::GetRumbleManager() {
+    return m_xr.GetRumbleManager();
+}
+
+void VRHookHost::UpdateEntityDebugger() {
+    if (auto& debugger = VRManager::instance().Debugger) {
+        debugger->UpdateEntityMemory();
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "hooking/hook_host.h"
+
+class OpenXR;
+
+// The HookHost of the layer, which hands the hooks the state of the OpenXR session and the frames of its renderer.
+// The renderer is only created once the game renders its first frame, until then the hooks see no views and a default frame.
+class VRHookHost : public HookHost {
+public:
+    explicit VRHookHost(OpenXR& xr): m_xr(xr) {}
+
+    InputState GetInput() const override;
+    void SetInput(const InputState& input) override;
+    GameState GetGameState() const override;
+    void SetGameState(const GameState& gameState) override;
+    glm::fquat GetInputCameraRotation() const override;
+    void OnInputUsed() override;
+    bool ShouldBlockGameInput() const override;
+
+    bool HasRenderer() const override;
+    bool IsRendererInitialized() const override;
+    uint64_t GetViewsGeneration() const override;
+    std::optional<std::array<XrView, 2>> GetPoses() const override;
+    FrameState& GetFrameState(uint32_t frameCounter) override;
+
+    RumbleManager* GetRumbleManager() override;
+    void UpdateEntityDebugger() override;
+
+private:
+    OpenXR& m_xr;
+    // used before the renderer exists, which only happens for hooks that run before the game's first frame
+    FrameState m_fallbackFrameState;
+};
@@ -1,12 +1,29 @@
-#include "instance.h"
 #include "cemu_hooks.h"
+#include "rumble.h"
 #include "weapon.h"
+#include "motion_trace.h"
+#include "name_lists.h"
 
 
 std::array<WeaponMotionAnalyser, 2> CemuHooks::m_motionAnalyzers = {};
 std::array<uint32_t, 2> CemuHooks::m_heldWeapons = { 0, 0 };
 std::array<uint32_t, 2> CemuHooks::m_heldWeaponsLastUpdate = { 0, 0 };
 
+// recording of the samples that are fed into the motion analysers, which can be replayed with tools/motion_replay
+// started from the weapon motion debugger, or for the whole session with BETTERVR_RECORD_MOTION_TRACE=1
+static MotionTrace::Writer s_motionTrace;
+
+static void StartMotionTrace() {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_motion_{:%Y%m%d_%H%M%S}{}", now, MotionTrace::FILE_EXTENSION);
+    if (s_motionTrace.Open(fileName)) {
+        Log::print<INFO>("Recording controller motion to {}", fileName);
+    }
+    else {
+        Log::print<WARNING>("Couldn't open {} to record the controller motion", fileName);
+    }
+}
+
 std::array s_cameraRotations = {
     glm::identity<glm::fquat>(),
     glm::identity<glm::fquat>()
@@ -16,111 +33,6 @@ std::array s_cameraPositions = {
     glm::fvec3(0.0f)
 };
 
-static bool isDroppable(std::string actorName) {
-    static const std::string_view nonDroppableItems[] = {
-        "AncientArrow",
-        "Animal_Insect_A",
-        "Animal_Insect_B",
-        "Animal_Insect_F",
-        "Animal_Insect_H",
-        "Animal_Insect_M",
-        "Animal_Insect_S",
-        "Animal_Insect_X",
-        "Armor_Default_Extra_00",
-        "Armor_Default_Extra_01",
-        "bj_SupportApp_Wind",
-        "BombArrow_A",
-        "BrightArrow",
-        "BrightArrowTP",
-        "CarryBox",
-        "Dm_Npc_Gerudo_HeroSoul_Kago",
-        "Dm_Npc_Goron_HeroSoul_Kago",
-        "Dm_Npc_RevivalFairy",
-        "Dm_Npc_Rito_HeroSoul_Kago",
-        "Dm_Npc_Zora_HeroSoul_Kago",
-        "ElectricArrow",
-        "Explode",
-        "FireArrow",
-        "FireRodLv1Fire",
-        "FireRodLv2Fire",
-        "FireRodLv2FireChild",
-        "GameRomHorseReins_01",
-        "GameRomHorseReins_02",
-        "GameRomHorseReins_03",
-        "GameRomHorseReins_04",
-        "GameRomHorseReins_05",
-        "GameRomHorseReins_10",
-        "GameRomHorseSaddle_01",
-        "GameRomHorseSaddle_02",
-        "GameRomHorseSaddle_03",
-        "GameRomHorseSaddle_04",
-        "GameRomHorseSaddle_05",
-        "GameRomHorseSaddle_10",
-        "GameROMPlayer",
-        "Get_TwnObj_DLC_MemorialPicture_A_01",
-        "IceArrow",
-        "IceRodLv1Ice",
-        "IceRodLv2Ice",
-        "Item_Conductor",
-        "Item_CookSet",
-        "Item_Magnetglove",
-        "Item_Material_01",
-        "Item_Material_03",
-        "Item_Material_07",
-        "Item_Ore_F",
-        "KeySmall",
-        "NormalArrow",
-        "Obj_Armor_115_Head",
-        "Obj_DLC_HeroSeal_Gerudo",
-        "Obj_DLC_HeroSeal_Goron",
-        "Obj_DLC_HeroSeal_Rito",
-        "Obj_DLC_HeroSeal_Zora",
-        "Obj_DLC_HeroSoul_Gerudo",
-        "Obj_DLC_HeroSoul_Goron",
-        "Obj_DLC_HeroSoul_Rito",
-        "Obj_DLC_HeroSoul_Zora",
-        "Obj_DRStone_A_01",
-        "Obj_DRStone_Get",
-        "Obj_DungeonClearSeal",
-        "Obj_HeartUtuwa_A_01",
-        "Obj_HeroSoul_Gerudo",
-        "Obj_HeroSoul_Goron",
-        "Obj_HeroSoul_Rito",
-        "Obj_HeroSoul_Zora",
-        "Obj_IceMakerBlock",
-        "Obj_KorokNuts",
-        "Obj_Maracas",
-        "Obj_ProofBook",
-        "Obj_ProofGiantKiller",
-        "Obj_ProofGolemKiller",
-        "Obj_ProofKorok",
-        "Obj_ProofSandwormKiller",
-        "Obj_StaminaUtuwa_A_01",
-        "Obj_WarpDLC",
-        "PlayerStole2",
-        "PlayerStole2_Vagrant",
-        "Weapon_Bow_071",
-        "Weapon_Sword_056",
-        "Weapon_Sword_070",
-        "Weapon_Sword_080",
-        "Weapon_Sword_081",
-        "Weapon_Sword_502"
-    };
-
-    for (const auto& item : nonDroppableItems) {
-        if (actorName == item) {
-            return false;
-        }
-    }
-
-    // prevent dropping arrows
-    if (actorName.contains("Arrow")) {
-        return false;
-    }
-
-    return true;
-}
-
 void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
@@ -148,8 +60,6 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
     uint32_t targetActorPtr = hCPU->gpr[8]; // weapon that's being held
     uint32_t cameraPtr = hCPU->gpr[10];
 
-    sead::FixedSafeString40 actorName = getMemory<sead::FixedSafeString40>(actorPtr + offsetof(ActorWiiU, name));
-
     // todo: remove this?
     BESeadLookAtCamera camera = {};
     readMemory(cameraPtr, &camera);
@@ -162,14 +72,14 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
     // read bone name
     if (boneNamePtr == 0)
         return;
-    char* boneName = (char*)s_memoryBaseAddress + boneNamePtr;
+    std::string_view boneName = getString(boneNamePtr, 64);
 
     // real logic
-    bool isHeldByPlayer = actorName.getLE() == "GameROMPlayer";
-    bool isLeftHandWeapon = strcmp(boneName, "Weapon_L") == 0;
-    bool isRightHandWeapon = strcmp(boneName, "Weapon_R") == 0;
-    if (!actorName.getLE().empty() && boneName[0] != '\0' && isHeldByPlayer && (isLeftHandWeapon || isRightHandWeapon)) {
-        OpenXR::EyeSide side = isLeftHandWeapon ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    bool isHeldByPlayer = GetActorClass(actorPtr) == ActorClass::PLAYER;
+    bool isLeftHandWeapon = boneName == "Weapon_L";
+    bool isRightHandWeapon = boneName == "Weapon_R";
+    if (!boneName.empty() && isHeldByPlayer && (isLeftHandWeapon || isRightHandWeapon)) {
+        EyeSide side = isLeftHandWeapon ? EyeSide::LEFT : EyeSide::RIGHT;
 
         m_heldWeapons[side] = targetActorPtr;
         m_heldWeaponsLastUpdate[side] = 0;
@@ -202,10 +112,10 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
         readMemory(targetActorPtr, &targetActor);
 
         // check if weapon is held and if the grip button is held, drop it
-        auto input = VRManager::instance().XR->m_input.load();
+        auto input = GetHost().GetInput();
         auto dropSide = input.inGame.drop_weapon[side];
 
-        if (input.inGame.in_game && dropSide && isDroppable(targetActor.name.getLE())) {
+        if (input.inGame.in_game && dropSide && NameLists::IsDroppable(targetActor.name.getLE())) {
             Log::print<INFO>("Dropping weapon {} with type of {} due to double press on grab button", targetActor.name.getLE().c_str(), (uint32_t)targetActor.type.getLE());
             hCPU->gpr[11] = 1;
             hCPU->gpr[9] = 1;
@@ -232,7 +142,7 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
 void CemuHooks::hook_CreateNewScreen(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    const char* screenName = (const char*)(s_memoryBaseAddress + hCPU->gpr[7]);
+    std::string_view screenName = getString(hCPU->gpr[7]);
     ScreenId screenId = (ScreenId)hCPU->gpr[5];
     Log::print<CONTROLS>("Creating new screen \"{}\" with ID {:08X}...", screenName, std::to_underlying(screenId));
 
@@ -259,7 +169,7 @@ void CemuHooks::hook_DropEquipment(PPCInterpreter_t* hCPU) {
     readMemory(weaponPtr, &weapon);
 
     //// check if weapon is held and if the grip button is held, drop it
-    //auto input = VRManager::instance().XR->m_input.load();
+    //auto input = GetHost().GetInput();
     //if (input.inGame.in_game && isHeldByPlayer && input.inGame.grab[heldIndex].currentState) {
     //    // if the weapon is held by the player and the grip button is pressed, drop it
     //    //Log::print("!! Dropping weapon {} because grip button is pressed", weapon.name.getLE());
@@ -282,7 +192,7 @@ void CemuHooks::hook_GetContactLayerOfAttack(PPCInterpreter_t* hCPU) {
 
     uint32_t originalContactLayerPtr = hCPU->gpr[5];
     uint32_t originalContactLayer = getMemory<uint32_t>(originalContactLayerPtr).getLE();
-    const char* originalContactLayerStr = (const char*)(s_memoryBaseAddress + originalContactLayer);
+    std::string_view originalContactLayerStr = getString(originalContactLayer);
 
     uint32_t contactLayerValue = hCPU->gpr[3];
 
@@ -336,7 +246,8 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
         return;
     }
 
-    auto& currFrame = VRManager::instance().XR->GetRenderer()->GetFrame(frameCounter);
+    HookHost& host = GetHost();
+    auto& currFrame = host.GetFrameState(frameCounter);
     if (currFrame.ranMotionAnalysis[heldIndex]) {
         Log::print<CONTROLS>("Skipping motion analysis for {}: already ran this frame", heldIndex);
         return;
@@ -348,14 +259,27 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
 
     //Log::print("!! Running weapon analysis for {}", heldIndex);
 
-    auto state = VRManager::instance().XR->m_input.load();
-    auto headset = VRManager::instance().XR->GetRenderer()->GetMiddlePose();
+    auto state = host.GetInput();
+    auto headset = host.GetMiddlePose();
     if (!headset.has_value()) {
         return;
     }
 
+    static bool checkedMotionTraceEnv = false;
+    if (!checkedMotionTraceEnv) {
+        checkedMotionTraceEnv = true;
+        if (const char* value = std::getenv("BETTERVR_RECORD_MOTION_TRACE"); value != nullptr && value[0] != '\0' && value[0] != '0') {
+            StartMotionTrace();
+        }
+    }
+    s_motionTrace.Record((uint8_t)heldIndex, weaponType, state.inGame.poseLocation[heldIndex], state.inGame.poseVelocity[heldIndex], headset.value(), state.inGame.inputTime);
+
     m_motionAnalyzers[heldIndex].ResetIfWeaponTypeChanged(weaponType);
-    m_motionAnalyzers[heldIndex].Update(state.inGame.poseLocation[heldIndex], state.inGame.poseVelocity[heldIndex], headset.value(), state.inGame.inputTime);
+    {
+        BETTERVR_HISTOGRAM(s_motionUpdateTime, "weapon.motion_update_ms", 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25);
+        Metrics::ScopedTimer timer(s_motionUpdateTime);
+        m_motionAnalyzers[heldIndex].Update(state.inGame.poseLocation[heldIndex], state.inGame.poseVelocity[heldIndex], headset.value(), state.inGame.inputTime);
+    }
 
     // Use the analysed motion to determine whether the weapon is swinging or stabbing, and whether the attackSensor should be active this frame
     bool CHEAT_alwaysEnableWeaponCollision = false;
@@ -390,7 +314,7 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
         if (rumbleVelocity <= 0.0f) {
             rumbleVelocity = 0.0f;
         }
-        VRManager::instance().XR->GetRumbleManager()->startSimpleRumble(!heldIndex, 0.1f, 0.5f * rumbleVelocity, 0.7f * rumbleVelocity);
+        host.GetRumbleManager()->startSimpleRumble(!heldIndex, 0.1f, 0.5f * rumbleVelocity, 0.7f * rumbleVelocity);
     }
 }
 
@@ -416,7 +340,7 @@ void CemuHooks::hook_SetPlayerWeaponScale(PPCInterpreter_t* hCPU) {
 void CemuHooks::hook_EquipWeapon(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    auto input = VRManager::instance().XR->m_input.load();
+    auto input = GetHost().GetInput();
     // Check both hands for a short press to pick up weapon
     for (int side = 0; side < 2; ++side) {
         auto& grabState = input.inGame.grabState[side];
@@ -448,7 +372,7 @@ void CemuHooks::hook_DropWeaponLogging(PPCInterpreter_t* hCPU) {
     readMemoryBE(actorLinkPtr, &actorNamePtr);
     if (actorNamePtr == 0)
         return;
-    char* actorName = (char*)s_memoryBaseAddress + actorNamePtr;
+    std::string_view actorName = getString(actorNamePtr);
 
     uint32_t weaponIdx = hCPU->gpr[4];
     BEVec3 position;
@@ -469,17 +393,29 @@ void CemuHooks::hook_ModifyHandModelAccessSearch(PPCInterpreter_t* hCPU) {
     }
 #ifdef _DEBUG
     // r3 holds the address of the string to search for
-    const char* actorName = (const char*)(s_memoryBaseAddress + hCPU->gpr[3]);
+    std::string_view actorName = getString(hCPU->gpr[3]);
 
-    if (actorName != nullptr) {
-        // Weapon_R is presumably his right hand bone name
-        Log::print<CONTROLS>("Searching for model handle using {}", actorName);
-    }
+    // Weapon_R is presumably his right hand bone name
+    Log::print<CONTROLS>("Searching for model handle using {}", actorName);
 #endif
 }
 
 void CemuHooks::DrawDebugOverlays() {
     if (ImGui::Begin("Weapon Motion Debugger")) {
+        bool recordMotionTrace = s_motionTrace.IsOpen();
+        if (ImGui::Checkbox("Record Motion Trace", &recordMotionTrace)) {
+            if (recordMotionTrace) {
+                StartMotionTrace();
+            }
+            else {
+                s_motionTrace.Close();
+            }
+        }
+        if (recordMotionTrace) {
+            ImGui::SameLine();
+            ImGui::Text("%llu samples to %s", (unsigned long long)s_motionTrace.GetSampleCount(), s_motionTrace.GetPath().string().c_str());
+        }
+
         for (auto it = m_motionAnalyzers.rbegin(); it != m_motionAnalyzers.rend(); ++it) {
             ImGui::PushID(&(*it));
             ImGui::BeginGroup();
@@ -1,6 +1,8 @@
+#pragma once
+#include "utils/time_window.h"
+
 // some ideas for improvements:
 // - movement inaccuracy for more difficulty
-// - good-samples based on time instead of samples
 // - rotate sword 90 deg around z
 // - add a cooldown to attacks
 //     - add penalty to attacking within cooldown
@@ -12,22 +14,23 @@ enum class AttackType {
 };
 
 
-struct DebugSample {
-    XrTime time; // should be an epoch time
-    glm::fvec3 position;
-    glm::fquat rotation;
-    glm::fvec3 linearVelocity;
-    glm::fvec3 angularVelocity;
-
-
-    AttackType debug_attackType;
-    bool debug_expVelocityLengthEnabled;
+// ring buffer of controller samples where every field is stored in its own array
+// the controller space velocities are stored as they're calculated, so reading the history never has to rotate anything again
+template <size_t N>
+struct MotionHistory {
+    alignas(16) std::array<XrTime, N> time = {}; // should be an epoch time
+    alignas(16) std::array<glm::fvec3, N> position = {};
+    alignas(16) std::array<glm::fquat, N> rotation = {};
+    alignas(16) std::array<glm::fvec3, N> linearVelocity = {};
+    alignas(16) std::array<glm::fvec3, N> angularVelocity = {};
+    alignas(16) std::array<glm::fvec3, N> localLinearVelocity = {};
+    alignas(16) std::array<glm::fvec3, N> localAngularVelocity = {};
+    alignas(16) std::array<glm::fvec3, N> localLinearAcceleration = {};
 
-    glm::fvec3 rotLinearAccel;
+    std::array<AttackType, N> debug_attackType = {};
+    std::array<bool, N> debug_expVelocityLengthEnabled = {};
 
-    glm::fvec3 rotatedVelocity() const { return glm::inverse(rotation) * linearVelocity; }
-    glm::fvec3 rotatedAngularVelocity() const { return glm::inverse(rotation) * angularVelocity; }
-    glm::fvec3 rotatedLinearVelocity() const { return glm::inverse(rotation) * linearVelocity; }
+    void Clear() { *this = {}; }
 };
 
 struct WeaponProfile {
@@ -70,34 +73,66 @@ struct SpearProfile : WeaponProfile {
     }
 };
 
+// the tuning that the swords and spears are played with
+struct MeleeProfile : SpearProfile {
+    MeleeProfile() {
+        stab_SpeedThreshold = 0.05f;
+        stab_AccThreshold = 5.0f;
+        stab_LinearSteadinessThreshold = glm::cos(glm::pi<float>() / 4.5); // 15 deg accuracy cone
+        stab_AngularSteadinessThreshold = 4.5; // [rad/s]
+        stab_travelDistance = 0.15f;
+        slash_SpeedThreshold = 1.0f;
+        slash_AccThreshold = 20.0f;
+        slash_AccDriftThreshold = 10.0f; // use [rad/s^2]
+        slash_travelAngle = glm::pi<float>() / 6;
+    }
+};
+
 class WeaponMotionAnalyser {
 public:
     WeaponMotionAnalyser() = default;
 
-    static constexpr int MAX_SAMPLES = 90;
-    static constexpr int BAD_SAMPLES_BUFFER = 1;
-    static constexpr std::chrono::nanoseconds GOOD_SAMPLES_BEFORE_GOOD_STAB = std::chrono::milliseconds(4);
+    static constexpr int MAX_SAMPLES = 90; // only used for the debug plots
+
+    // the detection windows are durations instead of sample counts, so that it behaves the same at any game or input rate
+    static constexpr XrTime DERIVATIVE_WINDOW = std::chrono::nanoseconds(std::chrono::milliseconds(30)).count(); // a single frame at 30 FPS
+    static constexpr XrTime ATTACK_CONFIRM_TIME = std::chrono::nanoseconds(std::chrono::milliseconds(30)).count(); // how long a motion has to look like an attack before it's locked
+    static constexpr XrTime BAD_MOTION_GRACE_TIME = 0; // how long a locked attack can be unsteady before it's cancelled
+    static constexpr XrTime ATTACK_STRENGTH_RAMP_TIME = std::chrono::nanoseconds(std::chrono::milliseconds(166)).count();
+    static constexpr XrTime RANGE_WINDOW = std::chrono::nanoseconds(std::chrono::seconds(2)).count();
 
     static constexpr float HAND_VELOCITY_LENGTH_THRESHOLD = 2.0f;
 
     static constexpr float dist_threshold = 0.6f; // max distance from head to consider attack
-    XrTime COOLDOWN_TIME = int(1e9*2.0f); // 0.5 s in nano seconds
-
-    WeaponProfile profile = SpearProfile();
+    XrTime COOLDOWN_TIME = 0; // TODO: DIFFERENT COOLDOWN FOR STABS AND SWINGS
+
+    WeaponProfile profile = GetProfile(LargeSword);
+
+    // the tuning of every weapon type, indexed by WeaponType
+    // todo: tune the weapon types separately, bows and shields are never analysed so they just use the melee tuning
+    static inline const std::array<WeaponProfile, UnknownWeapon + 1> PROFILES = {
+        MeleeProfile(), // SmallSword
+        MeleeProfile(), // LargeSword
+        MeleeProfile(), // Spear
+        MeleeProfile(), // Bow
+        MeleeProfile(), // Shield
+        MeleeProfile(), // UnknownWeapon
+    };
+
+    // the tuning that's used for a weapon type, which is only looked up when the held weapon type changes
+    static const WeaponProfile& GetProfile(WeaponType weaponType) {
+        return PROFILES[std::min(weaponType, UnknownWeapon)];
+    }
 
     // New member variables for angular velocity plot
     glm::fvec3 m_lastPlottedAngularVelocity = {0.0f, 0.0f, 0.0f};
     bool m_hasValidLastPlottedAngularVelocity = false;
     static constexpr float ANGULAR_VELOCITY_THRESHOLD = 0.1f;
     float max_range = 0.0f;
-    glm::fvec3 prev_lin_vel = glm::fvec3(0.0f);
-    glm::fvec3 prev_ang_vel = glm::fvec3(.0f);
     XrTime prev_sample = 0;
 
     XrTime time_since_last_attack[2] = { 0, 0 }; // Time elapsed since last attack
 
-    glm::fvec3 prev_AngularVelocity = glm::fvec3();
-
     bool handVelocityToggled = false;
     float handVelocityLength = 0.0f;
 
@@ -116,21 +151,20 @@ public:
         handVelocityLength = glm::length(linearVelocity);
         handVelocityToggled = handVelocityLength >= HAND_VELOCITY_LENGTH_THRESHOLD;
 
-        m_rollingSamples[m_rollingSamplesIt] = {
-            .time = inputTime,
-            .position = position,
-            .rotation = rotation,
-            .linearVelocity = linearVelocity,
-            .angularVelocity = angularVelocity, // angular velocity in world space
-            .debug_attackType = AttackType::None,
-            .debug_expVelocityLengthEnabled = handVelocityToggled
-        };
+        m_history.time[m_rollingSamplesIt] = inputTime;
+        m_history.position[m_rollingSamplesIt] = position;
+        m_history.rotation[m_rollingSamplesIt] = rotation;
+        m_history.linearVelocity[m_rollingSamplesIt] = linearVelocity;
+        m_history.angularVelocity[m_rollingSamplesIt] = angularVelocity; // angular velocity in world space
+        m_history.debug_attackType[m_rollingSamplesIt] = AttackType::None;
+        m_history.debug_expVelocityLengthEnabled[m_rollingSamplesIt] = handVelocityToggled;
         m_lastSampleIdx = m_rollingSamplesIt;
         m_rollingSamplesIt = (m_rollingSamplesIt + 1) % MAX_SAMPLES;
 
-        // Determine max range from hand positions
+        // Determine max range from hand positions over the last few seconds
         float curr_distance = glm::distance(position, headsetPostion);
-        max_range = glm::max(max_range, dist_threshold*curr_distance); // maximum reached value currently (decreased using factor 'dist_threshold' to avoid outliers)
+        m_rangeWindow.Push(inputTime, dist_threshold*curr_distance);
+        max_range = m_rangeWindow.Get(); // maximum reached value currently (decreased using factor 'dist_threshold' to avoid outliers)
         //Log::print("!! range: {}/{}", curr_distance, max_range);
 
         // ----- Find if rotation is towards center of view -----
@@ -141,62 +175,58 @@ public:
 
         //Log::print("!! is_attacking: );
         // ---- Find local velocities & accelerations -----
-        const glm::fvec3 localLinearVelocity = glm::inverse(rotation) * linearVelocity;
-        float dt = (float)(inputTime - prev_sample) / 1000000000.0f;
-        const glm::fvec3 localLinearAcceleration = (localLinearVelocity - prev_lin_vel) / glm::fvec3(dt); // TODO: add stab_acc threshold | Make stab continue as long as velocity follows acceleration (<0)
-
-        // ---- find angular velocity drift ----
-        // Log::print<CONTROLS>("angvel: {} \n prev_av: {}\ndt: {}\n dot: {}\nacos: {}", angularVelocity, prev_AngularVelocity, dt, glm::dot(angularVelocity, prev_AngularVelocity), acos(glm::dot(angularVelocity, prev_AngularVelocity)));
+        const glm::fquat invRotation = glm::conjugate(rotation);
+        const glm::fvec3 localLinearVelocity = invRotation * linearVelocity;
+        m_localLinearVelocityWindow.Push(inputTime, localLinearVelocity);
+        const glm::fvec3 localLinearAcceleration = m_localLinearVelocityWindow.GetDerivative(); // TODO: add stab_acc threshold | Make stab continue as long as velocity follows acceleration (<0)
 
-        float angular_drift = acos(glm::dot(glm::normalize(angularVelocity), glm::normalize(prev_AngularVelocity)))/dt; // Angular velocity drift (defined as the angular velocity of the rotating angular velocity i.e. how much rad/s the orthogonal vector of rotation moves)
-
-        m_rollingSamples[m_lastSampleIdx].rotLinearAccel = localLinearAcceleration;
+        m_history.localLinearVelocity[m_lastSampleIdx] = localLinearVelocity;
+        m_history.localLinearAcceleration[m_lastSampleIdx] = localLinearAcceleration;
 
 
 
         //Log::print("!! Acc: {} {} {}", localLinearAcceleration.x, localLinearAcceleration.y, localLinearAcceleration.z);
 
         // For virtual desktop via steam vr -> use inv(rotation) * angular velocity
-        const glm::fvec3 localAngularVelocity = m_rollingSamples[m_lastSampleIdx].rotatedAngularVelocity(); //glm::inverse(rotation) * angularVelocity;
+        const glm::fvec3 localAngularVelocity = invRotation * angularVelocity;
+        m_history.localAngularVelocity[m_lastSampleIdx] = localAngularVelocity;
 
         
         // --- Get approximation of angular acceleration over xy plane ---
         glm::fvec3 flat_ang_vel = localAngularVelocity - (glm::fvec3(.0, .0, localAngularVelocity.z)); // Get rotation vector over xy plane
-        float flat_ang_acc = (glm::length(flat_ang_vel) - glm::length(prev_ang_vel))/dt;
-
-        prev_ang_vel = flat_ang_vel;
+        m_flatAngularSpeedWindow.Push(inputTime, glm::length(flat_ang_vel));
+        float flat_ang_acc = m_flatAngularSpeedWindow.GetDerivative();
         
         //Log::print("!! position_world: {}", position);
         //Log::print("!! v_local: {}", localLinearVelocity);
-        profile.stab_SpeedThreshold = 0.05f;
-        profile.stab_AccThreshold = 5.0f;
-        profile.stab_LinearSteadinessThreshold = glm::cos(glm::pi<float>() / 4.5); // 15 deg accuracy cone
-        profile.stab_AngularSteadinessThreshold = 4.5; // [rad/s]
-        profile.stab_travelDistance = 0.15f;
-        profile.slash_SpeedThreshold = 1.0f;
-        profile.slash_AccThreshold = 20.0f;
-        profile.slash_AccDriftThreshold = 10.0f; // use [rad/s^2]
-        COOLDOWN_TIME = 0.0f*1e9; // TODO: DIFFERENT COOLDOWN FOR STABS AND SWINGS
-
         //Log::print("!! steadiness: {} / {}", glm::normalize(localAngularVelocity).y, profile.slash_SteadinessThreshold);
-        profile.slash_travelAngle = glm::pi<float>() / 6;
+
         // Detect velocity threshold -> set attack type if not in attack & store original angle/position
         AttackType prev_attack = m_lockedAttackType;
 
-        detect_attack_type(localLinearVelocity, localLinearAcceleration, localAngularVelocity, flat_ang_acc, position, rotation, swing_is_forwards);
+        detect_attack_type(localLinearVelocity, localLinearAcceleration, localAngularVelocity, flat_ang_acc, position, rotation, swing_is_forwards, inputTime);
 
         // Log::print("!! attack_state: {}", (int)m_lockedAttackType);
 
+        // ---- find angular velocity drift ----
+        m_angularVelocityWindow.Push(inputTime, angularVelocity);
+        // only slashes check it, so the acos is skipped otherwise
+        float angular_drift = 0.0f;
+        if (m_lockedAttackType == AttackType::Slash && m_angularVelocityWindow.GetSpan() > 0.0f) {
+            const glm::fvec3 prev_AngularVelocity = m_angularVelocityWindow.Front().value;
+            angular_drift = acos(glm::dot(glm::normalize(angularVelocity), glm::normalize(prev_AngularVelocity)))/m_angularVelocityWindow.GetSpan(); // Angular velocity drift (defined as the angular velocity of the rotating angular velocity i.e. how much rad/s the orthogonal vector of rotation moves)
+        }
+
         // Check if attack falls within weaponprofile velocity & angle margins -> if not cancel attack & go back to checking for attack
-        check_attack_steadiness(localLinearVelocity, localAngularVelocity, angular_drift);
-        //Log::print("!! m_badSampleCtr: {}", m_badSampleCtr);
+        check_attack_steadiness(localLinearVelocity, localAngularVelocity, angular_drift, inputTime);
+        //Log::print("!! m_badMotionStart: {}", m_badMotionStart.has_value());
 
         // Check if delta_angle/delta_translation is enough to enable attack mode
         set_attack_activity(rotation, position);
 
-        // Log::print("!! AttackType: {} - IsAttacking = {} - bad_samples: {} - v_world: ({}): ", (int)m_lockedAttackType, IsAttacking() ? "true": "false", m_badSampleCtr, localLinearVelocity);
+        // Log::print("!! AttackType: {} - IsAttacking = {} - bad_samples: {} - v_world: ({}): ", (int)m_lockedAttackType, IsAttacking() ? "true": "false", m_badMotionStart.has_value(), localLinearVelocity);
 
-        m_rollingSamples[m_lastSampleIdx].debug_attackType = IsAttacking() ? m_lockedAttackType: AttackType::None;
+        m_history.debug_attackType[m_lastSampleIdx] = IsAttacking() ? m_lockedAttackType: AttackType::None;
 
         // Log::print<CONTROLS>("{}", time_since_last_attack);
         // time since last attack update
@@ -210,12 +240,10 @@ public:
             time_since_last_attack[static_cast<int>(m_lockedAttackType) - 1] = 0; // reset timer for this attack type
         }
 
-        prev_AngularVelocity = angularVelocity;
-        prev_lin_vel = localLinearVelocity;
         prev_sample = inputTime;
     }
 
-    void detect_attack_type(const glm::fvec3 localLinearVelocity, const glm::fvec3 localLinearAcceleration, const glm::fvec3 localAngularVelocity, const float flag_ang_acc, const glm::fvec3 position, const glm::fquat rotation, const bool swing_is_forward) {
+    void detect_attack_type(const glm::fvec3 localLinearVelocity, const glm::fvec3 localLinearAcceleration, const glm::fvec3 localAngularVelocity, const float flag_ang_acc, const glm::fvec3 position, const glm::fquat rotation, const bool swing_is_forward, const XrTime inputTime) {
         // Log::print<CONTROLS>("[WeaponMotionAnalyser] Detecting attack type with linear velocity: {}, attack type = {}, active: {}", localLinearVelocity, static_cast<int>(m_lockedAttackType), static_cast<int>(m_attackActivity));
 
         if (m_lockedAttackType == AttackType::None) {
@@ -228,16 +256,19 @@ public:
             if (abs(localAngularVelocity).x < profile.stab_AngularSteadinessThreshold && abs(localAngularVelocity).y < profile.stab_AngularSteadinessThreshold && abs(-stab_ang.z) > profile.stab_LinearSteadinessThreshold && -localLinearAcceleration.z > profile.stab_AccThreshold) {
                 if (time_since_last_attack[int(AttackType::Stab)-1] >= COOLDOWN_TIME) {
                     // Log::print<CONTROLS>("Failed due to: {}", );
-                    m_lockedPosition = position;
-                    m_goodStabSampleCtr++;
+                    // the travel is measured from where the motion started, not from the sample that confirmed it, which is later at lower rates
+                    if (!m_goodStabStart.has_value()) {
+                        m_goodStabStart = inputTime;
+                        m_lockedPosition = position;
+                    }
                     Log::print<CONTROLS>("Stab detect attack");
-                    if (m_goodStabSampleCtr > 1) {
+                    if (inputTime - m_goodStabStart.value() >= ATTACK_CONFIRM_TIME) {
                         m_lockedAttackType = AttackType::Stab;
                     }
                 };
                 
             }else {
-                m_goodStabSampleCtr = 0;
+                m_goodStabStart.reset();
             }
             if (flag_ang_acc > profile.slash_AccThreshold && !swing_is_forward) {
                 Log::print<CONTROLS>("Slash detected but not forward");
@@ -246,33 +277,37 @@ public:
                 if (time_since_last_attack[int(AttackType::Slash)-1] >= COOLDOWN_TIME) {
                     // Log::print<CONTROLS>("cooldown currently: {}/{}", time_since_last_attack[int(AttackType::Slash) - 1], COOLDOWN_TIME);
 
-                    m_goodSwingSampleCtr++;
-                    m_lockedAngle = rotation * glm::fvec3(0.0f, 0.0f, 1.0f); // store z-axis
+                    if (!m_goodSwingStart.has_value()) {
+                        m_goodSwingStart = inputTime;
+                        m_lockedAngle = rotation * glm::fvec3(0.0f, 0.0f, 1.0f); // store z-axis
+                    }
                     Log::print<CONTROLS>("slash attack detected");
-                    if (m_goodSwingSampleCtr > 1) {
+                    if (inputTime - m_goodSwingStart.value() >= ATTACK_CONFIRM_TIME) {
                         m_lockedAttackType = AttackType::Slash;
                         //Log::print<CONTROLS>("Initiate swing");
                     }
                 }
             }
             else {
-                m_goodSwingSampleCtr = 0;
+                m_goodSwingStart.reset();
             }
         }
     }
 
-    void check_attack_steadiness(const glm::fvec3 localLinearVelocity, const glm::fvec3 localAngularVelocity, const float angular_drift) {
+    void check_attack_steadiness(const glm::fvec3 localLinearVelocity, const glm::fvec3 localAngularVelocity, const float angular_drift, const XrTime inputTime) {
         // check steadiness condition for attack types
         switch (m_lockedAttackType) {
             case AttackType::None: { 
-                //m_badSampleCtr = 0;
+                //m_badMotionStart.reset();
                 return;
             }
             case AttackType::Stab: {
                 glm::fvec3 stab_ang = glm::normalize(localLinearVelocity);
 
                 if (abs(stab_ang.z) < profile.stab_LinearSteadinessThreshold || -localLinearVelocity.z < profile.stab_SpeedThreshold || glm::length(glm::fvec3(localAngularVelocity.x, localAngularVelocity.y, 0.0)) > profile.stab_AngularSteadinessThreshold || abs(localAngularVelocity).x > profile.stab_AngularSteadinessThreshold) {
-                    m_badSampleCtr++;
+                    if (!m_badMotionStart.has_value()) {
+                        m_badMotionStart = inputTime;
+                    }
                     bool speed_issue = abs(stab_ang.z) < profile.stab_LinearSteadinessThreshold && abs(localAngularVelocity).x > profile.stab_AngularSteadinessThreshold && abs(localAngularVelocity).x > profile.stab_AngularSteadinessThreshold;
                     // Log::print<CONTROLS>("Failed due to {}", speed_issue ? "Speed is too low" : "Steadiness is too shit");
                     //if (speed_issue) {
@@ -280,7 +315,7 @@ public:
                     //}
                 }
                 else {
-                    m_badSampleCtr = 0;
+                    m_badMotionStart.reset();
                     //Log::print<CONTROLS>("Speed is {}", -localLinearVelocity);
                 }
                 break;
@@ -300,18 +335,20 @@ public:
                         Log::print<CONTROLS>("[FAIL]: Angular velocity: {}/{}", glm::length(glm::fvec3(localAngularVelocity.x, localAngularVelocity.y, 0.0f)), profile.slash_SpeedThreshold);
                     }
                     
-                    m_badSampleCtr++;
+                    if (!m_badMotionStart.has_value()) {
+                        m_badMotionStart = inputTime;
+                    }
                 }
                 else {
-                    m_badSampleCtr  = 0;
+                    m_badMotionStart.reset();
                 }
                 break;
             }
         }
         
-        // Remove attack type if too many bad samples
-        if (m_badSampleCtr >= BAD_SAMPLES_BUFFER) {
-            m_badSampleCtr = 0;
+        // Remove attack type if the motion has been bad for too long
+        if (m_badMotionStart.has_value() && inputTime - m_badMotionStart.value() >= BAD_MOTION_GRACE_TIME) {
+            m_badMotionStart.reset();
             //Log::print<CONTROLS>("removed attack due to bad samples");
             m_lockedAttackType = AttackType::None;
         }
@@ -358,6 +395,10 @@ public:
         // return m_lockedAttackType != AttackType::None;
     }
 
+    AttackType GetAttackType() const {
+        return m_lockedAttackType;
+    }
+
     bool IsHitboxEnabled() const {
         return m_isHitboxEnabled;
     }
@@ -366,44 +407,36 @@ public:
         m_isHitboxEnabled = enabled;
     }
 
-    float GetAttackImpulse() const {
-        if (m_lockedAttackType == AttackType::Slash) {
-            return std::clamp((float)m_goodSwingSampleCtr / 5.0f, 0.0f, 1.0f);
-        }
-        else if (m_lockedAttackType == AttackType::Stab) {
-            return std::clamp((float)m_goodStabSampleCtr / 5.0f, 0.0f, 1.0f);
-        }
-        return 0.0f;
-    }
-
-    float GetAttackDamage() const {
-        if (m_lockedAttackType == AttackType::Slash) {
-            return std::clamp((float)m_goodSwingSampleCtr / 5.0f, 0.0f, 1.0f);
-        }
-        else if (m_lockedAttackType == AttackType::Stab) {
-            return std::clamp((float)m_goodStabSampleCtr / 5.0f, 0.0f, 1.0f);
+    // how long the motion has looked like the locked attack, relative to ATTACK_STRENGTH_RAMP_TIME
+    float GetAttackStrength() const {
+        const std::optional<XrTime>& goodStart = m_lockedAttackType == AttackType::Slash ? m_goodSwingStart : m_goodStabStart;
+        if (m_lockedAttackType == AttackType::None || !goodStart.has_value()) {
+            return 0.0f;
         }
-        return 0.0f;
+        return std::clamp((float)(prev_sample - goodStart.value()) / (float)ATTACK_STRENGTH_RAMP_TIME, 0.0f, 1.0f);
     }
 
     void ResetSwing() {
-        m_goodSwingSampleCtr = 0;
-        m_badSwingSampleCtr = 0;
+        m_goodSwingStart.reset();
         if (m_lockedAttackType == AttackType::Slash) {
             m_lockedAttackType = AttackType::None;
         }
     }
 
     void ResetStab() {
-        m_goodStabSampleCtr = 0;
-        m_badStabSampleCtr = 0;
+        m_goodStabStart.reset();
         if (m_lockedAttackType == AttackType::Stab) {
             m_lockedAttackType = AttackType::None;
         }
     }
 
     void Reset() {
-        m_rollingSamples.fill({});
+        m_history.Clear();
+        m_localLinearVelocityWindow.Clear();
+        m_flatAngularSpeedWindow.Clear();
+        m_angularVelocityWindow.Clear();
+        m_rangeWindow.Clear();
+        m_badMotionStart.reset();
         ResetSwing();
         ResetStab();
     }
@@ -411,6 +444,7 @@ public:
     void ResetIfWeaponTypeChanged(WeaponType weaponType) {
         if (m_weaponType != weaponType) {
             m_weaponType = weaponType;
+            profile = GetProfile(weaponType);
             Reset();
         }
     }
@@ -420,7 +454,7 @@ public:
         ImGui::TextColored(ImVec4(1, 1, 0, 1), "Weapon Motion Debugger");
         ImGui::Text("Weapon Type: %d", static_cast<int>(m_weaponType));
         ImGui::Text("Sample %d / %d", m_lastSampleIdx, MAX_SAMPLES);
-        ImGui::Text("Bad samples: %d   Good samples: %d", m_badSwingSampleCtr, m_goodSwingSampleCtr);
+        ImGui::Text("Good swing: %.0f ms   Good stab: %.0f ms", GetGoodMotionMs(m_goodSwingStart), GetGoodMotionMs(m_goodStabStart));
 
         const auto oldestIdx = [this](uint32_t j) { return (m_lastSampleIdx + j) % MAX_SAMPLES; };
 
@@ -459,11 +493,12 @@ public:
         float xMin = FLT_MAX, xMax = -FLT_MAX, yMin = FLT_MAX, yMax = -FLT_MAX, zMin = FLT_MAX, zMax = -FLT_MAX;
 
         for (uint32_t j = 0; j < MAX_SAMPLES; ++j) {
-            const auto& s = m_rollingSamples[oldestIdx(j)];
+            const uint32_t idx = oldestIdx(j);
+            const glm::fvec3& position = m_history.position[idx];
 
-            posX[j] = s.position.x;
-            posY[j] = s.position.z; // swap Y/Z for nicer view
-            posZ[j] = s.position.y;
+            posX[j] = position.x;
+            posY[j] = position.z; // swap Y/Z for nicer view
+            posZ[j] = position.y;
 
             xMin = std::min(xMin, posX[j]);
             xMax = std::max(xMax, posX[j]);
@@ -472,7 +507,7 @@ public:
             zMin = std::min(zMin, posZ[j]);
             zMax = std::max(zMax, posZ[j]);
 
-            const auto av = s.rotatedAngularVelocity() * 0.05f;
+            const auto av = m_history.localAngularVelocity[idx] * 0.05f;
 
             velLineX[j * 2] = posX[j];
             velLineX[j * 2 + 1] = posX[j] + av.x;
@@ -500,14 +535,15 @@ public:
         {
             std::array<float, MAX_SAMPLES> t{}, avX{}, avY{}, avZ{}, maskSlash{}, maskStab{}, velLengthTriggered{};
             for (uint32_t j = 0; j < MAX_SAMPLES; ++j) {
-                const auto& s = m_rollingSamples[oldestIdx(j)];
+                const uint32_t idx = oldestIdx(j);
+                const glm::fvec3& localAngularVelocity = m_history.localAngularVelocity[idx];
                 t[j] = static_cast<float>(j);
-                avX[j] = s.rotatedAngularVelocity().x;
-                avY[j] = s.rotatedAngularVelocity().y;
-                avZ[j] = s.rotatedAngularVelocity().z;
-                maskSlash[j] = (s.debug_attackType == AttackType::Slash) ? 100.0f : -100.0f;
-                maskStab[j] = (s.debug_attackType == AttackType::Stab) ? 100.0f : -100.0f;
-                velLengthTriggered[j] = s.debug_expVelocityLengthEnabled ? 100.0f : -100.0f;
+                avX[j] = localAngularVelocity.x;
+                avY[j] = localAngularVelocity.y;
+                avZ[j] = localAngularVelocity.z;
+                maskSlash[j] = (m_history.debug_attackType[idx] == AttackType::Slash) ? 100.0f : -100.0f;
+                maskStab[j] = (m_history.debug_attackType[idx] == AttackType::Stab) ? 100.0f : -100.0f;
+                velLengthTriggered[j] = m_history.debug_expVelocityLengthEnabled[idx] ? 100.0f : -100.0f;
             }
 
             if (ImPlot::BeginPlot("Weapon Steadiness", { 0, 300 }, ImPlotFlags_NoTitle)) {
@@ -535,14 +571,15 @@ public:
             std::array<float, MAX_SAMPLES> t{}, avX{}, avY{}, avZ{}, avddX{}, maskSlash{}, maskStab{};
             XrTime prevDelta = 0;
             for (uint32_t j = 0; j < MAX_SAMPLES; ++j) {
-                const auto& s = m_rollingSamples[oldestIdx(j)];
+                const uint32_t idx = oldestIdx(j);
+                const glm::fvec3& localLinearVelocity = m_history.localLinearVelocity[idx];
                 t[j] = static_cast<float>(j);
-                avX[j] = s.rotatedLinearVelocity().x;
-                avddX[j] = s.rotLinearAccel.x;
-                avY[j] = s.rotatedLinearVelocity().y;
-                avZ[j] = s.rotatedLinearVelocity().z;
-                maskSlash[j] = (s.debug_attackType == AttackType::Slash) ? 100.0f : -100.0f;
-                maskStab[j] = (s.debug_attackType == AttackType::Stab) ? 100.0f : -100.0f;
+                avX[j] = localLinearVelocity.x;
+                avddX[j] = m_history.localLinearAcceleration[idx].x;
+                avY[j] = localLinearVelocity.y;
+                avZ[j] = localLinearVelocity.z;
+                maskSlash[j] = (m_history.debug_attackType[idx] == AttackType::Slash) ? 100.0f : -100.0f;
+                maskStab[j] = (m_history.debug_attackType[idx] == AttackType::Stab) ? 100.0f : -100.0f;
             }
 
             if (ImPlot::BeginPlot("Controller Linear Velocity", { 0, 300 }, ImPlotFlags_NoTitle)) {
@@ -571,8 +608,8 @@ public:
         glm::vec3& lastLinDir = m_debugLastLinDir;
         bool& linValid = m_debugLinValid;
 
-        const glm::vec3 currAng = m_rollingSamples[m_lastSampleIdx].rotatedAngularVelocity();
-        const glm::vec3 currLin = glm::inverse(m_rollingSamples[m_lastSampleIdx].rotation) * m_rollingSamples[m_lastSampleIdx].linearVelocity;
+        const glm::vec3 currAng = m_history.localAngularVelocity[m_lastSampleIdx];
+        const glm::vec3 currLin = m_history.localLinearVelocity[m_lastSampleIdx];
 
         drawSnapshot("AngVel Snapshot", currAng, lastAngDir, angValid, 1.5f, ImVec4(1, 0, 0, 1), ImVec4(0.4f, 0.7f, 1, 0.25f));
         drawSnapshot("LinVel Snapshot", currLin, lastLinDir, linValid, 1.5f, ImVec4(0, 1, 0, 1), ImVec4(1, 0.7f, 0.2f, 0.25f));
@@ -580,22 +617,30 @@ public:
 
 private:
     WeaponType m_weaponType = LargeSword;
-    WeaponProfile m_profile = {};
 
-    std::array<DebugSample, MAX_SAMPLES> m_rollingSamples = {};
+    MotionHistory<MAX_SAMPLES> m_history = {};
     uint32_t m_lastSampleIdx = 0;
     uint32_t m_rollingSamplesIt = 0;
 
-    uint32_t m_goodSwingSampleCtr = 0;
-    uint32_t m_badSwingSampleCtr = 0;
+    TimeWindow<glm::fvec3> m_localLinearVelocityWindow{ DERIVATIVE_WINDOW };
+    TimeWindow<float> m_flatAngularSpeedWindow{ DERIVATIVE_WINDOW };
+    TimeWindow<glm::fvec3> m_angularVelocityWindow{ DERIVATIVE_WINDOW };
+    WindowedMax<float> m_rangeWindow{ RANGE_WINDOW };
+
+    // when the current run of good or bad samples started
+    std::optional<XrTime> m_goodSwingStart;
+    std::optional<XrTime> m_goodStabStart;
+    std::optional<XrTime> m_badMotionStart;
+
     bool m_attackActivity = false;
     bool m_isHitboxEnabled = false;
-    uint32_t m_badSampleCtr = 0;
     AttackType m_lockedAttackType = AttackType::None;
     glm::fvec3 m_lockedPosition = {};
     glm::fvec3 m_lockedAngle = {};
-    uint32_t m_goodStabSampleCtr = 0;
-    uint32_t m_badStabSampleCtr = 0;
+
+    float GetGoodMotionMs(const std::optional<XrTime>& goodStart) const {
+        return goodStart.has_value() ? (float)(prev_sample - goodStart.value()) / 1000000.0f : 0.0f;
+    }
 
     mutable glm::vec3 m_debugLastAngDir = {1, 0, 0};
     mutable bool m_debugAngValid = false;
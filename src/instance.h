@@ -3,6 +3,8 @@
 #include <pch.h>
 
 #include "hooking/cemu_hooks.h"
+#include "hooking/entity_debugger.h"
+#include "hooking/vr_hook_host.h"
 #include "rendering/d3d12.h"
 #include "rendering/openxr.h"
 #include "rendering/renderer.h"
@@ -32,13 +34,16 @@ public:
         d3d12Binding.queue = D3D12->GetCommandQueue();
         XR->CreateSession(d3d12Binding);
         XR->CreateActions();
-        Hooks = std::make_unique<CemuHooks>();
+        Host = std::make_unique<VRHookHost>(*XR);
+        Hooks = std::make_unique<CemuHooks>(*Host, CemuExports::FromCurrentProcess());
     }
 
     std::unique_ptr<OpenXR> XR;
     std::unique_ptr<RND_D3D12> D3D12;
     std::unique_ptr<RND_Vulkan> VK;
+    std::unique_ptr<VRHookHost> Host;
     std::unique_ptr<CemuHooks> Hooks;
+    std::unique_ptr<EntityDebugger> Debugger;
 
     uint32_t vkVersion = 0;
 
@@ -50,6 +55,8 @@ private:
 
     ~VRManager() {
         // note: OpenXR gets to remove its swapchains first before D3D12 gets destroyed, so reverse that order
+        Hooks.reset();
+        Host.reset();
         VK.reset();
         XR.reset();
         D3D12.reset();
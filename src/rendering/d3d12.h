@@ -24,7 +24,10 @@ public:
         HANDLE waitEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
         checkAssert(waitEvent != NULL, "Failed to create upload event!");
         checkHResult(m_fence->SetEventOnCompletion(1, waitEvent), "Failed to set event completion for end-of-frame waiting!");
-        WaitForSingleObject(waitEvent, INFINITE);
+        {
+            FrameTimeline::Scope timelineScope("D3D12 End Of Frame Fence Wait");
+            WaitForSingleObject(waitEvent, INFINITE);
+        }
 
         // Reset allocator after queue is finished
         m_allocator->Reset();
@@ -102,6 +105,7 @@ public:
 
                 if (this->m_blockFence->GetCompletedValue() < 1) {
                     this->m_blockFence->SetEventOnCompletion(1, waitEvent);
+                    FrameTimeline::Scope timelineScope("D3D12 Command Fence Wait");
                     WaitForSingleObject(waitEvent, INFINITE);
                 }
                 CloseHandle(waitEvent);
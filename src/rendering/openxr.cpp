@@ -157,6 +157,19 @@ OpenXR::~OpenXR() {
     }
 }
 
+XrTime OpenXR::GetCurrentXrTime() const {
+    if (func_xrConvertWin32PerformanceCounterToTimeKHR == nullptr) {
+        return 0;
+    }
+    LARGE_INTEGER performanceCounter;
+    QueryPerformanceCounter(&performanceCounter);
+    XrTime time = 0;
+    if (XR_FAILED(func_xrConvertWin32PerformanceCounterToTimeKHR(m_instance, &performanceCounter, &time))) {
+        return 0;
+    }
+    return time;
+}
+
 std::array<XrViewConfigurationView, 2> OpenXR::GetViewConfigurations() {
     uint32_t eyeViewsConfigurationCount = 0;
     checkXRResult(xrEnumerateViewConfigurationViews(m_instance, m_systemId, XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, 0, &eyeViewsConfigurationCount, nullptr), "Can't get number of individual views for stereo view available");
@@ -194,6 +207,39 @@ void OpenXR::CreateSession(const XrGraphicsBindingD3D12KHR& d3d12Binding) {
     checkXRResult(xrCreateReferenceSpace(m_session, &headSpaceCreateInfo, &m_headSpace), "Failed to create reference space for head!");
 }
 
+// plays the output of the RumbleManager on the rumble action of the controllers
+class OpenXRHapticsSink : public HapticsSink {
+public:
+    OpenXRHapticsSink(XrSession session, XrAction hapticAction, std::array<XrPath, 2> handPaths) : m_session(session), m_hapticAction(hapticAction), m_handPaths(handPaths) {}
+
+    void Apply(Hand hand, float frequency, float amplitude, std::optional<std::chrono::nanoseconds> duration) override {
+        XrHapticVibration vibration = { XR_TYPE_HAPTIC_VIBRATION };
+        vibration.duration = duration.has_value() ? (XrDuration)duration->count() : XR_INFINITE_DURATION;
+        vibration.frequency = frequency;
+        vibration.amplitude = amplitude;
+
+        const XrHapticActionInfo hapticInfo = GetActionInfo(hand);
+        checkXRResult(xrApplyHapticFeedback(m_session, &hapticInfo, (const XrHapticBaseHeader*)&vibration), "Failed to start rumble");
+    }
+
+    void Stop(Hand hand) override {
+        const XrHapticActionInfo hapticInfo = GetActionInfo(hand);
+        checkXRResult(xrStopHapticFeedback(m_session, &hapticInfo), "Failed to stop rumble");
+    }
+
+private:
+    XrHapticActionInfo GetActionInfo(Hand hand) const {
+        XrHapticActionInfo hapticInfo = { XR_TYPE_HAPTIC_ACTION_INFO };
+        hapticInfo.action = m_hapticAction;
+        hapticInfo.subactionPath = hand == Hand::BOTH ? XR_NULL_PATH : m_handPaths[std::to_underlying(hand)];
+        return hapticInfo;
+    }
+
+    XrSession m_session;
+    XrAction m_hapticAction;
+    std::array<XrPath, 2> m_handPaths;
+};
+
 void OpenXR::CreateActions() {
     Log::print<INFO>("Creating the OpenXR actions...");
 
@@ -402,64 +448,7 @@ void OpenXR::CreateActions() {
     }
 
     // initialize rumble manager
-    m_rumbleManager = std::make_unique<RumbleManager>(m_session, m_rumbleAction);
-    m_rumbleManager.get()->initializeXrPaths(m_instance);
-}
-
-void CheckButtonState(bool buttonPressed, ButtonState& buttonState) {
-    // Button state logic
-    buttonState.resetFrameFlags();
-
-    // detect long, short and double presses
-    constexpr std::chrono::milliseconds longPressThreshold{ 250 };
-    constexpr std::chrono::milliseconds doublePressWindow{ 150 };
-
-    const bool down = buttonPressed;
-    const auto now = std::chrono::steady_clock::now();
-
-    // rising edge
-    if (down && !buttonState.wasDownLastFrame) {
-        buttonState.pressStartTime = now;
-        buttonState.longFired = false;
-
-        if (buttonState.waitingForSecond) // second press started in time to double
-        {
-            buttonState.waitingForSecond = false;
-            buttonState.longFired = true;
-            buttonState.lastEvent = ButtonState::Event::DoublePress;
-        }
-    }
-
-    // pressed state
-    if (down) {
-        //will need to check if that cause issues elsewhere. Allows to keep LongPress event while button is pressed.
-        if (/*!buttonState.longFired &&*/ (now - buttonState.pressStartTime) >= longPressThreshold) {
-            //buttonState.longFired = true;
-            buttonState.lastEvent = ButtonState::Event::LongPress;
-        }
-    }
-
-    // falling edge
-    if (!down && buttonState.wasDownLastFrame) {
-        if (!buttonState.longFired) // ignore if we already counted a long press
-        {
-            buttonState.waitingForSecond = true; // open double-press timing window
-            buttonState.lastReleaseTime = now;
-        }
-        else {
-            // long press path finished
-            buttonState.longFired = false;
-        }
-    }
-
-    // register short press since the double press timing window has expired nor was a long press registered
-    if (buttonState.waitingForSecond && !down && (now - buttonState.lastReleaseTime) > doublePressWindow) {
-        buttonState.waitingForSecond = false;
-        buttonState.lastEvent = ButtonState::Event::ShortPress;
-    }
-
-    // store current down state for the next frame
-    buttonState.wasDownLastFrame = down;
+    m_rumbleManager = std::make_unique<RumbleManager>(std::make_unique<OpenXRHapticsSink>(m_session, m_rumbleAction, m_handPaths));
 }
 
 std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTime, glm::fquat controllerRotation, bool inMenu) {
@@ -469,6 +458,9 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
     syncInfo.countActiveActionSets = 1;
     syncInfo.activeActionSets = &activeActionSet;
     checkXRResult(xrSyncActions(m_session, &syncInfo), "Failed to sync actions!");
+    if (m_renderer) {
+        m_renderer->GetFrameLatency().OnInputPolled(GetCurrentXrTime());
+    }
 
     const float playerHeightOffsetMeters = CemuHooks::GetSettings().playerHeightSetting.getLE();
 
@@ -601,7 +593,7 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
             auto& buttonState = newState.inGame.grabState[side];
             if (action.isActive == XR_TRUE) {
                 auto buttonPressed = action.currentState > 0.75f;
-                CheckButtonState(buttonPressed, buttonState);
+                buttonState.Update(buttonPressed, std::chrono::steady_clock::now());
             }
         }
 
@@ -615,7 +607,7 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
         auto& mapAndInventoryButtonState = newState.inGame.mapAndInventoryState;
         if (mapAndInventoryAction.isActive == XR_TRUE) {
             auto buttonPressed = mapAndInventoryAction.currentState == XR_TRUE;
-            CheckButtonState(buttonPressed, mapAndInventoryButtonState);
+            mapAndInventoryButtonState.Update(buttonPressed, std::chrono::steady_clock::now());
         }
 
         //XrActionStateGetInfo getInventory = { XR_TYPE_ACTION_STATE_GET_INFO };
@@ -667,7 +659,7 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
         auto& runButtonState = newState.inGame.runState;
         if (runAction.isActive == XR_TRUE) {
             auto buttonPressed = runAction.currentState == XR_TRUE;
-            CheckButtonState(buttonPressed, runButtonState);
+            runButtonState.Update(buttonPressed, std::chrono::steady_clock::now());
         }
 
         XrActionStateGetInfo getAttackInfo = { XR_TYPE_ACTION_STATE_GET_INFO };
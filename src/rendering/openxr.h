@@ -1,5 +1,6 @@
 #pragma once
 
+#include "hooking/input_state.h"
 #include "hooking/rumble.h"
 
 class OpenXR {
@@ -9,10 +10,9 @@ public:
     OpenXR();
     ~OpenXR();
 
-    enum EyeSide : uint8_t {
-        LEFT = 0,
-        RIGHT = 1
-    };
+    using EyeSide = ::EyeSide;
+    using InputState = ::InputState;
+    using GameState = ::GameState;
 
     struct Capabilities {
         LUID adapter;
@@ -24,101 +24,10 @@ public:
         bool isMetaSimulator;
     } m_capabilities = {};
 
-    union InputState {
-        struct InGame {
-            bool in_game = true;
-            XrTime inputTime;
-            std::optional<EyeSide> lastPickupSide = std::nullopt;
-
-            // shared
-            XrActionStateBoolean mapAndInventory;
-
-            XrActionStateBoolean leftTrigger;
-            XrActionStateBoolean rightTrigger;
-
-            // unique
-            XrActionStateVector2f camera;
-            XrActionStateVector2f move;
-
-            XrActionStateBoolean jump;
-            XrActionStateBoolean crouch;
-            XrActionStateBoolean run;
-            XrActionStateBoolean attack;
-            XrActionStateBoolean useRune;
-            XrActionStateBoolean throwWeapon;
-            XrActionStateBoolean cancel;
-            XrActionStateBoolean interact;
-            std::array<XrActionStateFloat, 2> grab;
-            std::array<bool, 2> drop_weapon; // LEFT/RIGHT
-
-            struct ButtonState {
-                enum class Event {
-                    None,
-                    ShortPress,
-                    LongPress,
-                    DoublePress
-                };
-
-                bool wasDownLastFrame = false;
-                bool longFired = false;
-                bool waitingForSecond = false;
-                std::chrono::steady_clock::time_point pressStartTime;
-                std::chrono::steady_clock::time_point lastReleaseTime;
-
-                Event lastEvent = Event::None;
-
-                void resetFrameFlags() { lastEvent = Event::None; }
-                void resetButtonState() {
-                    wasDownLastFrame = false;
-                    longFired = false;
-                    waitingForSecond = false;
-                }
-            };
-            std::array<ButtonState, 2> grabState; // LEFT/RIGHT
-            ButtonState runState;
-            ButtonState mapAndInventoryState;
-            std::array<XrActionStatePose, 2> pose;
-            std::array<XrSpaceLocation, 2> poseLocation;
-            std::array<XrSpaceVelocity, 2> poseVelocity;
-            // todo: remove relative controller positions if it turns out to be unnecessary
-            std::array<XrSpaceLocation, 2> hmdRelativePoseLocation;
-        } inGame;
-        struct InMenu {
-            bool in_game = false;
-            XrTime inputTime;
-            std::optional<EyeSide> lastPickupSide = std::nullopt;
-
-            // shared
-            XrActionStateBoolean mapAndInventory;
-
-            XrActionStateBoolean leftTrigger;
-            XrActionStateBoolean rightTrigger;
-
-            // unique
-            XrActionStateVector2f scroll;
-            XrActionStateVector2f navigate;
-
-            XrActionStateBoolean select;
-            XrActionStateBoolean back;
-            XrActionStateBoolean sort;
-            XrActionStateBoolean hold;
-
-            XrActionStateBoolean leftGrip;
-            XrActionStateBoolean rightGrip;
-        } inMenu;
-    };
     std::atomic<InputState> m_input = InputState{};
     std::atomic<glm::fquat> m_inputCameraRotation = glm::identity<glm::fquat>();
 
-    struct GameState {
-        bool in_game = false;
-        bool was_in_game = false;
-        bool map_open = false;
-        bool prevent_menu_inputs = false;
-        std::chrono::steady_clock::time_point prevent_menu_time;
-        bool prevent_grab_inputs = false;
-        std::chrono::steady_clock::time_point prevent_grab_time;
-    } gameState ;
+    GameState gameState;
 
     std::atomic<GameState> m_gameState{};
 
@@ -127,6 +36,8 @@ public:
     std::array<XrViewConfigurationView, 2> GetViewConfigurations();
     std::optional<XrSpaceLocation> UpdateSpaces(XrTime predictedDisplayTime);
     std::optional<InputState> UpdateActions(XrTime predictedFrameTime, glm::fquat controllerRotation, bool inMenu);
+    // returns 0 if the runtime doesn't support XR_KHR_win32_convert_performance_counter_time
+    XrTime GetCurrentXrTime() const;
    
     void ProcessEvents();
 
@@ -202,12 +113,3 @@ private:
     PFN_xrCreateDebugUtilsMessengerEXT func_xrCreateDebugUtilsMessengerEXT = nullptr;
     PFN_xrDestroyDebugUtilsMessengerEXT func_xrDestroyDebugUtilsMessengerEXT = nullptr;
 };
-using ButtonState = OpenXR::InputState::InGame::ButtonState;
-using EyeSide = OpenXR::EyeSide;
-
-template <>
-struct std::formatter<EyeSide> : std::formatter<string> {
-    auto format(const EyeSide side, std::format_context& ctx) const {
-        return std::format_to(ctx.out(), "{}", side == EyeSide::LEFT ? "LEFT" : "RIGHT");
-    }
-};
\ No newline at end of file
@@ -30,7 +30,10 @@ void RND_Renderer::StartFrame() {
 
     XrFrameWaitInfo waitFrameInfo = { XR_TYPE_FRAME_WAIT_INFO };
     auto waitStart = std::chrono::high_resolution_clock::now();
-    checkXRResult(xrWaitFrame(m_session, &waitFrameInfo, &m_frameState), "Failed to wait for next frame!");
+    {
+        FrameTimeline::Scope timelineScope("xrWaitFrame");
+        checkXRResult(xrWaitFrame(m_session, &waitFrameInfo, &m_frameState), "Failed to wait for next frame!");
+    }
     m_lastWaitTimeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
 
     // Runtime predicted cadence
@@ -50,10 +53,16 @@ void RND_Renderer::StartFrame() {
     m_frameStartTime = std::chrono::high_resolution_clock::now();
 
     XrFrameBeginInfo beginFrameInfo = { XR_TYPE_FRAME_BEGIN_INFO };
-    checkXRResult(xrBeginFrame(m_session, &beginFrameInfo), "Couldn't begin OpenXR frame!");
+    {
+        FrameTimeline::Scope timelineScope("xrBeginFrame");
+        checkXRResult(xrBeginFrame(m_session, &beginFrameInfo), "Couldn't begin OpenXR frame!");
+    }
 
     VRManager::instance().D3D12->StartFrame();
-    this->UpdateViews(m_frameState.predictedDisplayTime);
+    {
+        FrameTimeline::Scope timelineScope("UpdateViews");
+        this->UpdateViews(m_frameState.predictedDisplayTime);
+    }
 
     // todo: update this as late as possible
     //VRManager::instance()->XR->UpdateSpaces(m_frameState.predictedDisplayTime);
@@ -62,14 +71,18 @@ void RND_Renderer::StartFrame() {
     auto headsetRotation = VRManager::instance().XR->GetRenderer()->GetMiddlePose();
     if (headsetRotation.has_value()) {
         // todo: update this as late as possible
+        FrameTimeline::Scope timelineScope("UpdateActions");
         VRManager::instance().XR->UpdateActions(m_frameState.predictedDisplayTime, headsetRotation.value(), VRManager::instance().Hooks->IsShowingMenu());
     }
 }
 
 
 void RND_Renderer::EndFrame() {
-    static uint32_t s_endFrameCount = 0;
-    s_endFrameCount++;
+    BETTERVR_COUNTER(s_endFrames, "xr.end_frames");
+    BETTERVR_COUNTER(s_endFrameFailures, "xr.end_frame_failures");
+    BETTERVR_GAUGE(s_frameWorkTime, "xr.frame_work_ms");
+    BETTERVR_HISTOGRAM(s_endFrameTime, "xr.end_frame_ms", 0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0);
+    const uint64_t endFrameCount = s_endFrames.Add();
 
     std::vector<XrCompositionLayerBaseHeader*> compositionLayers;
 
@@ -80,6 +93,7 @@ void RND_Renderer::EndFrame() {
     std::vector<XrCompositionLayerQuad> layer2DQuads;
 
     long frameIdx = -1;
+    FrameLatency::FrameTags latencyTags;
     if (m_renderFrames[0].Is3DComplete() && m_renderFrames[0].Is2DComplete()) {
         frameIdx = 0;
     }
@@ -96,6 +110,7 @@ void RND_Renderer::EndFrame() {
     if (frameIdx != -1) {
         if (m_layer3D) {
             if (m_renderFrames[frameIdx].Is3DComplete()) {
+                FrameTimeline::Scope timelineScope("Layer3D");
                 m_layer3D->StartRendering();
                 m_layer3D->Render(OpenXR::EyeSide::LEFT, frameIdx);
                 m_layer3D->Render(OpenXR::EyeSide::RIGHT, frameIdx);
@@ -117,6 +132,7 @@ void RND_Renderer::EndFrame() {
         }
 
         if (m_layer2D) {
+            FrameTimeline::Scope timelineScope("Layer2D");
             m_layer2D->StartRendering();
             m_layer2D->Render(frameIdx);
             layer2DQuads = m_layer2D->FinishRendering(m_frameState.predictedDisplayTime, frameIdx);
@@ -126,10 +142,14 @@ void RND_Renderer::EndFrame() {
             }
         }
 
+        // the frame's times are kept for its latencies, since resetting it clears them
+        m_frameLatency.TagPresent(m_renderFrames[frameIdx].latencyTags);
+        latencyTags = m_renderFrames[frameIdx].latencyTags;
         m_renderFrames[frameIdx].Reset();
     }
 
     m_lastFrameWorkTimeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_frameStartTime).count();
+    s_frameWorkTime.Set(m_lastFrameWorkTimeMs);
 
     XrFrameEndInfo frameEndInfo = { XR_TYPE_FRAME_END_INFO };
     frameEndInfo.displayTime = m_frameState.predictedDisplayTime;
@@ -137,19 +157,41 @@ void RND_Renderer::EndFrame() {
     frameEndInfo.layerCount = (uint32_t)compositionLayers.size();
     frameEndInfo.layers = compositionLayers.data();
 
-    if (s_endFrameCount % 500 == 0) {
+    if (endFrameCount % 500 == 0) {
         Log::print<INTEROP>("EndFrame #{}: frameIdx={}, layers={}, 3D={}, 2D={}",
-            s_endFrameCount, frameIdx, compositionLayers.size(),
+            endFrameCount, frameIdx, compositionLayers.size(),
             (frameIdx != -1 && m_renderFrames[frameIdx].presented3D) ? "yes" : "no",
             m_presented2DLastFrame ? "yes" : "no");
     }
 
-    XrResult xrResult = xrEndFrame(m_session, &frameEndInfo);
+    XrResult xrResult;
+    {
+        Metrics::ScopedTimer timer(s_endFrameTime);
+        FrameTimeline::Scope timelineScope("xrEndFrame");
+        xrResult = xrEndFrame(m_session, &frameEndInfo);
+    }
     if (XR_FAILED(xrResult)) {
-        Log::print<ERROR>("xrEndFrame #{} FAILED with result {}", s_endFrameCount, (int)xrResult);
+        s_endFrameFailures.Add();
+        Log::print<ERROR>("xrEndFrame #{} FAILED with result {}", endFrameCount, (int)xrResult);
     }
 
+    // latencies only make sense for frames that showed something new, the head pose only matters if the 3D layer was shown
+    const FrameLatency::Timestamps latency = FrameLatency::GetTimestamps(latencyTags, frameEndInfo.displayTime);
+    const bool presentedNewFrame = frameIdx != -1 && XR_SUCCEEDED(xrResult);
+    const bool presented3D = presentedNewFrame && m_renderFrames[frameIdx].presented3D;
+    m_frameTimeStats.Record({
+        m_lastFrameWorkTimeMs,
+        m_lastFrameTimeMs,
+        m_lastWaitTimeMs,
+        m_lastOverheadMs,
+        presented3D ? latency.GetMotionToPhotonMs() : std::nullopt,
+        presentedNewFrame ? latency.GetInputToPhotonMs() : std::nullopt,
+        presentedNewFrame ? latency.GetPresentToPhotonMs() : std::nullopt
+    }, m_predictedDisplayPeriodMs);
+
     VRManager::instance().D3D12->EndFrame();
+    Metrics::Registry::Get().EndFrame();
+    HookCapture::EndFrame();
 }
 
 RND_Renderer::Layer3D::Layer3D(VkExtent2D inputRes, VkExtent2D outputRes) {
@@ -210,17 +252,19 @@ RND_Renderer::Layer3D::~Layer3D() {
 }
 
 SharedTexture* RND_Renderer::Layer3D::CopyColorToLayer(OpenXR::EyeSide side, VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx) {
-    static uint32_t s_copyCount = 0;
+    BETTERVR_COUNTER(s_copies, "render.layer3d_copies");
+    BETTERVR_COUNTER(s_srcImageChanges, "render.layer3d_src_image_changes");
     static VkImage s_lastSrcImage = VK_NULL_HANDLE;
-    s_copyCount++;
+    const uint64_t copyCount = s_copies.Add();
 
     if (s_lastSrcImage != VK_NULL_HANDLE && s_lastSrcImage != image) {
-        Log::print<WARNING>("Layer3D srcImage changed: {} -> {} at copy #{}", (void*)s_lastSrcImage, (void*)image, s_copyCount);
+        s_srcImageChanges.Add();
+        Log::print<WARNING>("Layer3D srcImage changed: {} -> {} at copy #{}", (void*)s_lastSrcImage, (void*)image, copyCount);
     }
     s_lastSrcImage = image;
 
-    if (s_copyCount % 100 == 0) {
-        Log::print<INTEROP>("Layer3D::CopyColorToLayer #{} - side={}, frameIdx={}, srcImage={}", s_copyCount, side == OpenXR::EyeSide::LEFT ? "L" : "R", frameIdx, (void*)image);
+    if (copyCount % 100 == 0) {
+        Log::print<INTEROP>("Layer3D::CopyColorToLayer #{} - side={}, frameIdx={}, srcImage={}", copyCount, side == OpenXR::EyeSide::LEFT ? "L" : "R", frameIdx, (void*)image);
     }
 
     m_currentFrameIdx = frameIdx;
@@ -257,6 +301,8 @@ std::optional<std::array<XrView, 2>> RND_Renderer::UpdateViews(XrTime predictedD
     }
 
     m_currViews = newViews;
+    m_frameLatency.OnViewsLocated(VRManager::instance().XR->GetCurrentXrTime());
+    ++m_viewsGeneration;
     return m_currViews;
 }
 
@@ -418,10 +464,10 @@ RND_Renderer::Layer2D::~Layer2D() {
 }
 
 SharedTexture* RND_Renderer::Layer2D::CopyColorToLayer(VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx) {
-    static uint32_t s_copyCount = 0;
-    s_copyCount++;
-    if (s_copyCount % 100 == 0) {
-        Log::print<INTEROP>("Layer2D::CopyColorToLayer #{} - frameIdx={}, srcImage={}", s_copyCount, frameIdx, (void*)image);
+    BETTERVR_COUNTER(s_copies, "render.layer2d_copies");
+    const uint64_t copyCount = s_copies.Add();
+    if (copyCount % 100 == 0) {
+        Log::print<INTEROP>("Layer2D::CopyColorToLayer #{} - frameIdx={}, srcImage={}", copyCount, frameIdx, (void*)image);
     }
 
     m_currentFrameIdx = frameIdx;
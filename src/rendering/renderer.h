@@ -3,6 +3,7 @@
 #include "pch.h"
 #include "d3d12.h"
 #include "openxr.h"
+#include "hooking/hook_host.h"
 #include "swapchain.h"
 #include "texture.h"
 
@@ -15,6 +16,7 @@ public:
 
     struct RenderFrame {
         std::optional<std::array<XrView, 2>> views;
+        FrameLatency::FrameTags latencyTags; // when the views, the input and the present of the frame happened, for its latencies
         std::atomic_bool copiedColor[2] = { false, false };
         std::atomic_bool copiedDepth[2] = { false, false };
         std::atomic_bool copied2D = false;
@@ -29,21 +31,21 @@ public:
         VkDescriptorSet hudWithoutAlphaFramebufferDS = VK_NULL_HANDLE;
         float mainFramebufferAspectRatio = 1.0f;
 
-        bool ranMotionAnalysis[2] = { false, false };
+        HookHost::FrameState hookState;
 
         bool Is3DComplete() const { return copiedColor[0] && copiedColor[1] && copiedDepth[0] && copiedDepth[1]; }
         bool Is2DComplete() const { return copied2D; }
 
         void Reset() {
             views = std::nullopt;
+            latencyTags = {};
             copiedColor[0] = false;
             copiedColor[1] = false;
             copiedDepth[0] = false;
             copiedDepth[1] = false;
             copied2D = false;
 
-            ranMotionAnalysis[0] = false;
-            ranMotionAnalysis[1] = false;
+            hookState = {};
         }
     };
 
@@ -74,15 +76,12 @@ public:
         });
     };
     
+    // incremented every time new views are located
+    uint64_t GetViewsGeneration() const { return m_viewsGeneration; }
+
     std::optional<glm::fmat4> GetMiddlePose(long frameIdx = -1) const {
         const auto& views = (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) ? m_renderFrames[frameIdx].views : m_currViews;
-        if (!views.has_value()) return std::nullopt;
-        const XrPosef& leftPose = views->at(OpenXR::EyeSide::LEFT).pose;
-        const XrPosef& rightPose = views->at(OpenXR::EyeSide::RIGHT).pose;
-        glm::fvec3 middlePos = (ToGLM(leftPose.position) + ToGLM(rightPose.position)) * 0.5f;
-        glm::quat middleOri = glm::slerp(ToGLM(leftPose.orientation), ToGLM(rightPose.orientation), 0.5f);
-
-        return ToMat4(middlePos, middleOri);
+        return HookHost::GetMiddlePose(views);
     };
 
     double GetLastFrameWorkTimeMs() const { return m_lastFrameWorkTimeMs; }
@@ -90,19 +89,22 @@ public:
     double GetLastFrameTimeMs() const { return m_lastFrameTimeMs; }
     double GetPredictedDisplayPeriodMs() const { return m_predictedDisplayPeriodMs; }
     double GetLastOverheadMs() const { return m_lastOverheadMs; }
+    FrameTimeStats& GetFrameTimeStats() { return m_frameTimeStats; }
+    FrameLatency& GetFrameLatency() { return m_frameLatency; }
 
     void On3DColorCopied(OpenXR::EyeSide side, long frameIdx) {
         m_renderFrames[frameIdx].copiedColor[side] = true;
-        if (!m_renderFrames[frameIdx].views.has_value()) m_renderFrames[frameIdx].views = m_currViews;
+        CaptureViews(m_renderFrames[frameIdx]);
     }
 
     void On3DDepthCopied(OpenXR::EyeSide side, long frameIdx) {
         m_renderFrames[frameIdx].copiedDepth[side] = true;
-        if (!m_renderFrames[frameIdx].views.has_value()) m_renderFrames[frameIdx].views = m_currViews;
+        CaptureViews(m_renderFrames[frameIdx]);
     }
 
     void On2DCopied(long frameIdx) {
         m_renderFrames[frameIdx].copied2D = true;
+        m_frameLatency.TagInput(m_renderFrames[frameIdx].latencyTags);
     }
 
     RenderFrame& GetFrame(long frameIdx) { return m_renderFrames[frameIdx]; }
@@ -189,6 +191,7 @@ public:
 
         uint8_t m_showAppMS = 0;
         bool m_wasF3Pressed = false;
+        bool m_wasF4Pressed = false;
     };
 
     std::unique_ptr<Layer3D> m_layer3D;
@@ -206,9 +209,18 @@ public:
     }
 
 protected:
+    // the frame keeps the views that the game rendered it with, even if newer views get located before it's submitted
+    void CaptureViews(RenderFrame& frame) {
+        if (frame.views.has_value()) return;
+        frame.views = m_currViews;
+        m_frameLatency.TagViews(frame.latencyTags);
+        m_frameLatency.TagInput(frame.latencyTags);
+    }
+
     XrSession m_session;
     XrFrameState m_frameState = { XR_TYPE_FRAME_STATE };
     std::optional<std::array<XrView, 2>> m_currViews;
+    std::atomic_uint64_t m_viewsGeneration = 0;
     std::array<RenderFrame, 2> m_renderFrames;
 
     std::atomic_bool m_isInitialized = false;
@@ -226,4 +238,7 @@ protected:
     double m_lastFrameTimeMs = 0.0;
     double m_predictedDisplayPeriodMs = 0.0;
     double m_lastOverheadMs = 0.0;
+
+    FrameTimeStats m_frameTimeStats;
+    FrameLatency m_frameLatency;
 };
@@ -263,10 +263,10 @@ void Texture::d3d12SignalFence(uint64_t value) {
     // Check current fence value before signaling
     uint64_t currentValue = m_d3d12Fence->GetCompletedValue();
 
-    static uint32_t s_d3d12SignalCount = 0;
-    s_d3d12SignalCount++;
-    if (s_d3d12SignalCount % 500 == 0) {
-        Log::print<INTEROP>("D3D12 Signal #{}: texture={}, current={}, signaling to {}", s_d3d12SignalCount, (void*)this, currentValue, value);
+    BETTERVR_COUNTER(s_d3d12Signals, "interop.d3d12_signals");
+    const uint64_t signalCount = s_d3d12Signals.Add();
+    if (signalCount % 500 == 0) {
+        Log::print<INTEROP>("D3D12 Signal #{}: texture={}, current={}, signaling to {}", signalCount, (void*)this, currentValue, value);
     }
 
     SetLastSignalledValue(value);
@@ -276,16 +276,17 @@ void Texture::d3d12SignalFence(uint64_t value) {
 void Texture::d3d12WaitForFence(uint64_t value) {
     uint64_t currentValue = m_d3d12Fence->GetCompletedValue();
 
-    static uint32_t s_d3d12WaitCount = 0;
-    s_d3d12WaitCount++;
-    if (s_d3d12WaitCount % 500 == 0) {
-        Log::print<INTEROP>("D3D12 Wait #{}: texture={}, current={}, waiting for {}", s_d3d12WaitCount, (void*)this, currentValue, value);
+    BETTERVR_COUNTER(s_d3d12Waits, "interop.d3d12_waits");
+    const uint64_t waitCount = s_d3d12Waits.Add();
+    if (waitCount % 500 == 0) {
+        Log::print<INTEROP>("D3D12 Wait #{}: texture={}, current={}, waiting for {}", waitCount, (void*)this, currentValue, value);
     }
     if (currentValue == UINT64_MAX) {
         Log::print<ERROR>("D3D12 fence in ERROR state! texture={}", (void*)this);
     }
 
     SetLastAwaitedValue(value);
+    FrameTimeline::Scope timelineScope("D3D12 Queue Fence Wait");
     checkHResult(VRManager::instance().D3D12->GetCommandQueue()->Wait(m_d3d12Fence.Get(), value), "D3D12 Wait FAILED!");
 }
 
@@ -398,23 +399,23 @@ SharedTexture::~SharedTexture() {
 }
 
 void SharedTexture::CopyFromVkImage(VkCommandBuffer cmdBuffer, VkImage srcImage) {
-    static uint32_t s_copyCount = 0;
-    s_copyCount++;
+    BETTERVR_COUNTER(s_copies, "interop.vk_image_copies");
+    const uint64_t copyCount = s_copies.Add();
 
     auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
 
     if (srcImage == VK_NULL_HANDLE) {
-        Log::print<ERROR>("CopyFromVkImage #{}: srcImage is NULL!", s_copyCount);
+        Log::print<ERROR>("CopyFromVkImage #{}: srcImage is NULL!", copyCount);
         return;
     }
     if (this->m_vkImage == VK_NULL_HANDLE) {
-        Log::print<ERROR>("CopyFromVkImage #{}: destination m_vkImage is NULL!", s_copyCount);
+        Log::print<ERROR>("CopyFromVkImage #{}: destination m_vkImage is NULL!", copyCount);
         return;
     }
 
-    if (s_copyCount % 500 == 0) {
+    if (copyCount % 500 == 0) {
         auto desc = this->m_d3d12Texture->GetDesc();
-        Log::print<INTEROP>("CopyFromVkImage #{}: src={}, dst={}, size={}x{}", s_copyCount, (void*)srcImage, (void*)this->m_vkImage, desc.Width, desc.Height);
+        Log::print<INTEROP>("CopyFromVkImage #{}: src={}, dst={}, size={}x{}", copyCount, (void*)srcImage, (void*)this->m_vkImage, desc.Width, desc.Height);
     }
 
     VkImageAspectFlags aspectMask = GetAspectMask();
@@ -74,10 +74,10 @@ public:
 protected:
     void SetLastSignalledValue(uint64_t value) {
         // Track signal/wait pattern for debugging
-        static uint32_t s_signalCount = 0;
-        s_signalCount++;
-        if (s_signalCount % 500 == 0 || m_fenceLastSignaledValue == value) {
-            Log::print<INTEROP>("Semaphore signal #{}: texture={}, value {} -> {} (last waited={})", s_signalCount, (void*)this, m_fenceLastSignaledValue, value, m_fenceLastAwaitedValue);
+        BETTERVR_COUNTER(s_signals, "interop.fence_signals");
+        const uint64_t signalCount = s_signals.Add();
+        if (signalCount % 500 == 0 || m_fenceLastSignaledValue == value) {
+            Log::print<INTEROP>("Semaphore signal #{}: texture={}, value {} -> {} (last waited={})", signalCount, (void*)this, m_fenceLastSignaledValue, value, m_fenceLastAwaitedValue);
         }
         if (m_fenceLastSignaledValue == value && value != 0) {
             Log::print<WARNING>("Double signal detected! texture={}, value={}", (void*)this, value);
@@ -85,10 +85,10 @@ protected:
         m_fenceLastSignaledValue = value;
     }
     void SetLastAwaitedValue(uint64_t value) {
-        static uint32_t s_waitCount = 0;
-        s_waitCount++;
-        if (s_waitCount % 500 == 0 || m_fenceLastAwaitedValue == value) {
-            Log::print<INTEROP>("Semaphore wait #{}: texture={}, value {} -> {} (last signaled={})", s_waitCount, (void*)this, m_fenceLastAwaitedValue, value, m_fenceLastSignaledValue);
+        BETTERVR_COUNTER(s_waits, "interop.fence_waits");
+        const uint64_t waitCount = s_waits.Add();
+        if (waitCount % 500 == 0 || m_fenceLastAwaitedValue == value) {
+            Log::print<INTEROP>("Semaphore wait #{}: texture={}, value {} -> {} (last signaled={})", waitCount, (void*)this, m_fenceLastAwaitedValue, value, m_fenceLastSignaledValue);
         }
         if (m_fenceLastAwaitedValue == value && value != 0) {
             Log::print<WARNING>("Double wait detected! texture={}, value={}", (void*)this, value);
@@ -366,6 +366,39 @@ void DrawFPSOverlay(RND_Renderer* renderer) {
 
             ImPlot::EndPlot();
         }
+
+        // --- 6. Percentiles ---
+        // the average above hides stutters, so show how slow the slowest frames were
+        FrameTimeStats& frameTimeStats = renderer->GetFrameTimeStats();
+        const FrameTimeStats::Summary summary = frameTimeStats.GetSummary(frameTimeStats.m_overlayWindowSeconds);
+        ImGui::Text("Last %u seconds: %llu frames, %llu missed (%.1f%%)", summary.seconds, summary.frames, summary.missedFrames,
+            summary.frames > 0 ? (double)summary.missedFrames / (double)summary.frames * 100.0 : 0.0);
+        if (ImGui::BeginTable("##FrameTimePercentiles", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("ms");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableHeadersRow();
+            constexpr std::array<const char*, FrameTimeStats::SERIES_COUNT> rowNames = { "Cemu", "OpenXR", "Wait", "Overhead", "Motion-to-photon", "Input-to-photon", "Present-to-photon" };
+            for (size_t i = 0; i < FrameTimeStats::SERIES_COUNT; i++) {
+                const FrameTimeStats::SeriesSummary& series = summary.series[i];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(rowNames[i]);
+                for (double ms : { series.p50Ms, series.p95Ms, series.p99Ms, series.maxMs }) {
+                    ImGui::TableNextColumn();
+                    // the latencies need a runtime that can convert its timestamps
+                    if (series.samples == 0) {
+                        ImGui::TextUnformatted("-");
+                    }
+                    else {
+                        ImGui::Text("%.2f", ms);
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
     }
     ImGui::End();
 }
@@ -478,8 +511,8 @@ void RND_Renderer::ImGuiOverlay::BeginFrame(long frameIdx, bool renderBackground
         //}
     }
 
-    if (VRManager::instance().Hooks->m_entityDebugger) {
-        VRManager::instance().Hooks->m_entityDebugger->DrawEntityInspector();
+    if (VRManager::instance().Debugger) {
+        VRManager::instance().Debugger->DrawEntityInspector();
         VRManager::instance().Hooks->DrawDebugOverlays();
     }
 
@@ -556,11 +589,17 @@ void RND_Renderer::ImGuiOverlay::Update() {
     }
     m_wasF3Pressed = isF3Pressed;
 
+    bool isF4Pressed = GetKeyState(VK_F4) & 0x8000;
+    if (isF4Pressed && !m_wasF4Pressed) {
+        FrameTimeline::OnHotkey();
+    }
+    m_wasF4Pressed = isF4Pressed;
+
     ImGui::GetIO().AddFocusEvent(isWindowFocused);
     ImGui::GetIO().AddMousePosEvent((float)p.x, (float)p.y);
 
-    if (VRManager::instance().Hooks->m_entityDebugger && isWindowFocused) {
-        VRManager::instance().Hooks->m_entityDebugger->UpdateKeyboardControls();
+    if (VRManager::instance().Debugger && isWindowFocused) {
+        VRManager::instance().Debugger->UpdateKeyboardControls();
     }
 }
 
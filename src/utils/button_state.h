@@ -0,0 +1,78 @@
+#pragma once
+
+// Turns the down state of a button, sampled once per input update, into short, long and double presses.
+struct ButtonState {
+    enum class Event {
+        None,
+        ShortPress,
+        LongPress,
+        DoublePress
+    };
+
+    static constexpr std::chrono::milliseconds LONG_PRESS_THRESHOLD{ 250 };
+    static constexpr std::chrono::milliseconds DOUBLE_PRESS_WINDOW{ 150 };
+
+    bool wasDownLastFrame = false;
+    bool longFired = false;
+    bool waitingForSecond = false;
+    std::chrono::steady_clock::time_point pressStartTime;
+    std::chrono::steady_clock::time_point lastReleaseTime;
+
+    Event lastEvent = Event::None;
+
+    void resetFrameFlags() { lastEvent = Event::None; }
+    void resetButtonState() {
+        wasDownLastFrame = false;
+        longFired = false;
+        waitingForSecond = false;
+    }
+
+    // detect long, short and double presses
+    void Update(bool down, std::chrono::steady_clock::time_point now) {
+        resetFrameFlags();
+
+        // rising edge
+        if (down && !wasDownLastFrame) {
+            pressStartTime = now;
+            longFired = false;
+
+            if (waitingForSecond) // second press started in time to double
+            {
+                waitingForSecond = false;
+                longFired = true;
+                lastEvent = Event::DoublePress;
+            }
+        }
+
+        // pressed state
+        if (down) {
+            //will need to check if that cause issues elsewhere. Allows to keep LongPress event while button is pressed.
+            if (/*!longFired &&*/ (now - pressStartTime) >= LONG_PRESS_THRESHOLD) {
+                //longFired = true;
+                lastEvent = Event::LongPress;
+            }
+        }
+
+        // falling edge
+        if (!down && wasDownLastFrame) {
+            if (!longFired) // ignore if we already counted a long press
+            {
+                waitingForSecond = true; // open double-press timing window
+                lastReleaseTime = now;
+            }
+            else {
+                // long press path finished
+                longFired = false;
+            }
+        }
+
+        // register short press since the double press timing window has expired nor was a long press registered
+        if (waitingForSecond && !down && (now - lastReleaseTime) > DOUBLE_PRESS_WINDOW) {
+            waitingForSecond = false;
+            lastEvent = Event::ShortPress;
+        }
+
+        // store current down state for the next frame
+        wasDownLastFrame = down;
+    }
+};
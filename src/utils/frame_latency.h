@@ -0,0 +1,69 @@
+#pragma once
+
+// Keeps track of how old the head pose and the controller input were when the frame that used them gets displayed.
+// The renderer and the hooks report when the views were located, when the input was synced and which input the game used.
+// Every frame is tagged with the times of what it was made with, since the next frame can already use newer views and input
+// before it's submitted, and turns them into latencies against the predictedDisplayTime that it's submitted with.
+// All times are XrTime (nanoseconds on the runtime's clock), where 0 means that the time isn't known.
+class FrameLatency {
+public:
+    struct Timestamps {
+        XrTime poseLocateTime = 0; // when the views that the frame was rendered with were located
+        XrTime inputPollTime = 0;  // when the input that hook_InjectXRInput last used was synced
+        XrTime presentTime = 0;    // when Cemu last presented its flat screen image
+        XrTime displayTime = 0;    // the predictedDisplayTime that the frame was submitted with
+
+        // returns nullopt if either time is unknown, or if the event somehow happened after the frame was displayed
+        static std::optional<double> GetLatencyMs(XrTime eventTime, XrTime displayTime) {
+            if (eventTime == 0 || displayTime == 0 || eventTime > displayTime) {
+                return std::nullopt;
+            }
+            return (double)(displayTime - eventTime) / 1e6;
+        }
+
+        std::optional<double> GetMotionToPhotonMs() const { return GetLatencyMs(poseLocateTime, displayTime); }
+        std::optional<double> GetInputToPhotonMs() const { return GetLatencyMs(inputPollTime, displayTime); }
+        std::optional<double> GetPresentToPhotonMs() const { return GetLatencyMs(presentTime, displayTime); }
+    };
+
+    // the times that a frame was made with, which it keeps until it's submitted
+    struct FrameTags {
+        XrTime viewsLocateTime = 0; // when the views that the frame was rendered with were located
+        XrTime inputPollTime = 0;   // when the input that the game made the frame with was synced
+        XrTime presentTime = 0;     // when Cemu presented the frame
+    };
+
+    void OnViewsLocated(XrTime time) { m_locatedViewsTime.store(time, std::memory_order_relaxed); }
+    XrTime GetViewsLocateTime() const { return m_locatedViewsTime.load(std::memory_order_relaxed); }
+
+    void OnInputPolled(XrTime time) { m_polledInputTime.store(time, std::memory_order_relaxed); }
+    void OnInputUsed() { m_usedInputTime.store(m_polledInputTime.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+    void OnPresent(XrTime time) { m_presentTime.store(time, std::memory_order_relaxed); }
+
+    // called when the frame captures the views that it's rendered with
+    void TagViews(FrameTags& tags) const { tags.viewsLocateTime = GetViewsLocateTime(); }
+    // the game read its input before it started copying the frame, so the first copy of a frame tags it with the input it used
+    void TagInput(FrameTags& tags) const {
+        if (tags.inputPollTime == 0) {
+            tags.inputPollTime = m_usedInputTime.load(std::memory_order_relaxed);
+        }
+    }
+    // Cemu presents right before the frame is submitted
+    void TagPresent(FrameTags& tags) const { tags.presentTime = m_presentTime.load(std::memory_order_relaxed); }
+
+    static Timestamps GetTimestamps(const FrameTags& tags, XrTime displayTime) {
+        return {
+            .poseLocateTime = tags.viewsLocateTime,
+            .inputPollTime = tags.inputPollTime,
+            .presentTime = tags.presentTime,
+            .displayTime = displayTime
+        };
+    }
+
+private:
+    std::atomic<XrTime> m_locatedViewsTime = 0;
+    std::atomic<XrTime> m_polledInputTime = 0;
+    std::atomic<XrTime> m_usedInputTime = 0;
+    std::atomic<XrTime> m_presentTime = 0;
+};
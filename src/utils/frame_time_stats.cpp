@@ -0,0 +1,108 @@
+#include "frame_time_stats.h"
+
+void FrameTimeStats::Record(const std::array<std::optional<double>, SERIES_COUNT>& timesMs, double displayPeriodMs) {
+    if (!m_checkedCsvEnv) {
+        m_checkedCsvEnv = true;
+        if (const char* value = std::getenv("BETTERVR_FRAME_TIMES_CSV"); value != nullptr && value[0] != '\0' && value[0] != '0') {
+            StartCsv();
+        }
+    }
+
+    const int64_t secondIndex = GetSecondIndex(std::chrono::steady_clock::now());
+
+    std::scoped_lock lock(m_mutex);
+    if (secondIndex != m_currentSecond) {
+        if (m_currentSecond != -1 && m_csvFile.is_open()) {
+            WriteCsv(m_seconds[m_currentSecond % m_seconds.size()]);
+        }
+        m_currentSecond = secondIndex;
+
+        Second& second = m_seconds[secondIndex % m_seconds.size()];
+        second.index = secondIndex;
+        second.frames = 0;
+        second.missedFrames = 0;
+        for (Histogram& histogram : second.histograms) {
+            histogram.Clear();
+        }
+    }
+
+    Second& second = m_seconds[secondIndex % m_seconds.size()];
+    second.frames++;
+    if (displayPeriodMs > 0.0 && timesMs[(size_t)Series::XR].value_or(0.0) > displayPeriodMs * 1.5) {
+        second.missedFrames++;
+    }
+    for (size_t i = 0; i < SERIES_COUNT; i++) {
+        if (timesMs[i].has_value()) {
+            second.histograms[i].Record(timesMs[i].value());
+        }
+    }
+}
+
+FrameTimeStats::Summary FrameTimeStats::GetSummary(uint32_t windowSeconds) {
+    windowSeconds = std::clamp<uint32_t>(windowSeconds, 1, MAX_WINDOW_SECONDS);
+    const int64_t currentSecond = GetSecondIndex(std::chrono::steady_clock::now());
+
+    Summary summary;
+    std::array<Histogram, SERIES_COUNT> histograms;
+
+    std::scoped_lock lock(m_mutex);
+    for (const Second& second : m_seconds) {
+        if (second.index < currentSecond - (int64_t)windowSeconds || second.index >= currentSecond || second.frames == 0) {
+            continue;
+        }
+        summary.seconds++;
+        summary.frames += second.frames;
+        summary.missedFrames += second.missedFrames;
+        for (size_t i = 0; i < SERIES_COUNT; i++) {
+            histograms[i].Add(second.histograms[i]);
+        }
+    }
+
+    for (size_t i = 0; i < SERIES_COUNT; i++) {
+        summary.series[i] = {
+            .samples = histograms[i].GetCount(),
+            .p50Ms = histograms[i].GetPercentileMs(0.5),
+            .p95Ms = histograms[i].GetPercentileMs(0.95),
+            .p99Ms = histograms[i].GetPercentileMs(0.99),
+            .maxMs = histograms[i].GetMaxMs()
+        };
+    }
+    return summary;
+}
+
+bool FrameTimeStats::StartCsv() {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_frametimes_{:%Y%m%d_%H%M%S}.csv", now);
+
+    std::scoped_lock lock(m_mutex);
+    m_csvFile.close();
+    m_csvFile.open(fileName, std::ios::out | std::ios::trunc);
+    if (!m_csvFile.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to write the frame times to", fileName);
+        return false;
+    }
+    Log::print<INFO>("Writing frame times to {}", fileName);
+
+    m_csvFile << "time_s,series,frames,missed_frames,samples,p50_ms,p95_ms,p99_ms,max_ms\n";
+    m_csvStartSecond = GetSecondIndex(std::chrono::steady_clock::now());
+    return true;
+}
+
+void FrameTimeStats::StopCsv() {
+    std::scoped_lock lock(m_mutex);
+    m_csvFile.close();
+}
+
+void FrameTimeStats::WriteCsv(const Second& second) {
+    // the second in which the CSV was started is only partially included
+    if (second.index <= m_csvStartSecond) {
+        return;
+    }
+    for (size_t i = 0; i < SERIES_COUNT; i++) {
+        const Histogram& histogram = second.histograms[i];
+        m_csvFile << std::format("{},{},{},{},{},{:.3f},{:.3f},{:.3f},{:.3f}\n",
+            second.index - m_csvStartSecond, SERIES_NAMES[i], second.frames, second.missedFrames, histogram.GetCount(),
+            histogram.GetPercentileMs(0.5), histogram.GetPercentileMs(0.95), histogram.GetPercentileMs(0.99), histogram.GetMaxMs()
+        );
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+// Percentiles of the frame timings and latencies over the last seconds, so that the FPS overlay can show stutters that an average hides.
+// Every second gets its own set of histograms in a fixed ring, and a window is the sum of the histograms of its seconds,
+// so the memory use doesn't depend on the frame rate and old seconds fall out of the window without any bookkeeping.
+class FrameTimeStats {
+public:
+    enum class Series : uint8_t {
+        CEMU,              // time from xrBeginFrame until the frame was submitted with xrEndFrame
+        XR,                // time between the predicted display times of two frames
+        WAIT,              // time spent in xrWaitFrame
+        OVERHEAD,          // how much longer a frame took than the display period
+        MOTION_TO_PHOTON,  // from locating the views that the game rendered with until the frame is displayed
+        INPUT_TO_PHOTON,   // from syncing the input that the game used until the frame is displayed
+        PRESENT_TO_PHOTON, // from Cemu presenting its frame until the frame is displayed
+        COUNT
+    };
+    static constexpr size_t SERIES_COUNT = (size_t)Series::COUNT;
+    static constexpr std::array<const char*, SERIES_COUNT> SERIES_NAMES = { "cemu", "xr", "wait", "overhead", "motion_to_photon", "input_to_photon", "present_to_photon" };
+
+    static constexpr std::array<uint32_t, 3> WINDOW_SECONDS = { 1, 10, 60 };
+    static constexpr uint32_t MAX_WINDOW_SECONDS = 60;
+
+    // Log-linear buckets like an HDR histogram: values below 2^SUB_BUCKET_BITS microseconds get a bucket each,
+    // every power of two above that is split into 2^SUB_BUCKET_BITS buckets, so a percentile is at most ~3% too high.
+    class Histogram {
+    public:
+        static constexpr uint32_t SUB_BUCKET_BITS = 5;
+        static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+        static constexpr uint32_t MAX_MICROSECONDS = (1 << 21) - 1; // anything slower than ~2 seconds ends up in the last bucket
+        static constexpr uint32_t BUCKET_COUNT = (std::bit_width(MAX_MICROSECONDS) - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+        static uint32_t GetBucketIndex(uint32_t microseconds) {
+            microseconds = std::min(microseconds, MAX_MICROSECONDS);
+            if (microseconds < SUB_BUCKET_COUNT) {
+                return microseconds;
+            }
+            const uint32_t shift = (uint32_t)std::bit_width(microseconds) - 1 - SUB_BUCKET_BITS;
+            return (shift + 1) * SUB_BUCKET_COUNT + (microseconds >> shift) - SUB_BUCKET_COUNT;
+        }
+
+        // the highest value that ends up in the bucket, in microseconds
+        static uint32_t GetBucketUpperBound(uint32_t index) {
+            if (index < SUB_BUCKET_COUNT) {
+                return index;
+            }
+            const uint32_t shift = index / SUB_BUCKET_COUNT - 1;
+            const uint32_t subBucket = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+            return ((subBucket + 1) << shift) - 1;
+        }
+
+        void Record(double ms) {
+            const uint32_t microseconds = ms <= 0.0 ? 0 : (uint32_t)std::min(ms * 1000.0, (double)MAX_MICROSECONDS);
+            m_buckets[GetBucketIndex(microseconds)]++;
+            m_count++;
+            m_maxMs = std::max(m_maxMs, ms);
+        }
+
+        void Add(const Histogram& other) {
+            for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+                m_buckets[i] += other.m_buckets[i];
+            }
+            m_count += other.m_count;
+            m_maxMs = std::max(m_maxMs, other.m_maxMs);
+        }
+
+        void Clear() {
+            m_buckets.fill(0);
+            m_count = 0;
+            m_maxMs = 0.0;
+        }
+
+        uint64_t GetCount() const { return m_count; }
+        double GetMaxMs() const { return m_maxMs; }
+
+        // returns the upper bound of the bucket that the percentile (0.0 to 1.0) falls in, capped by the exact maximum
+        double GetPercentileMs(double percentile) const {
+            if (m_count == 0) {
+                return 0.0;
+            }
+            const uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile * (double)m_count));
+            uint64_t count = 0;
+            for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+                count += m_buckets[i];
+                if (count >= target) {
+                    return std::min((double)GetBucketUpperBound(i) / 1000.0, m_maxMs);
+                }
+            }
+            return m_maxMs;
+        }
+
+    private:
+        std::array<uint32_t, BUCKET_COUNT> m_buckets = {};
+        uint64_t m_count = 0;
+        double m_maxMs = 0.0;
+    };
+
+    struct SeriesSummary {
+        uint64_t samples = 0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Summary {
+        uint32_t seconds = 0; // how many seconds with frames the window contains, which is less than requested right after starting
+        uint64_t frames = 0;
+        uint64_t missedFrames = 0;
+        std::array<SeriesSummary, SERIES_COUNT> series = {};
+    };
+
+    // a frame counts as missed if it took more than one and a half display periods, which means the runtime had to reproject it,
+    // series without a value, like the latencies while the runtime can't convert timestamps, aren't recorded for that frame
+    void Record(const std::array<std::optional<double>, SERIES_COUNT>& timesMs, double displayPeriodMs);
+
+    // summarizes the last windowSeconds seconds that were completed, so the numbers only change once per second
+    Summary GetSummary(uint32_t windowSeconds);
+
+    // writes the summary of every completed second to BetterVR_frametimes_[time].csv
+    bool StartCsv();
+    void StopCsv();
+    bool IsWritingCsv() {
+        std::scoped_lock lock(m_mutex);
+        return m_csvFile.is_open();
+    }
+
+    // the window that the FPS overlay shows, selected in the debugger window since the overlay doesn't take any input
+    uint32_t m_overlayWindowSeconds = WINDOW_SECONDS[1];
+
+private:
+    struct Second {
+        int64_t index = -1;
+        uint64_t frames = 0;
+        uint64_t missedFrames = 0;
+        std::array<Histogram, SERIES_COUNT> histograms;
+    };
+
+    static int64_t GetSecondIndex(std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+
+    void WriteCsv(const Second& second);
+
+    std::mutex m_mutex;
+    // one more than the longest window, since the current second isn't complete yet
+    std::array<Second, MAX_WINDOW_SECONDS + 1> m_seconds;
+    int64_t m_currentSecond = -1;
+
+    bool m_checkedCsvEnv = false;
+    std::ofstream m_csvFile;
+    int64_t m_csvStartSecond = 0;
+};
@@ -0,0 +1,128 @@
+#include "frame_timeline.h"
+
+std::atomic_bool FrameTimeline::s_enabled = std::getenv("BETTERVR_FRAME_TIMELINE") != nullptr;
+std::atomic_uint64_t FrameTimeline::s_nextSequence = 0;
+std::array<FrameTimeline::Span, FrameTimeline::CAPACITY> FrameTimeline::s_spans;
+thread_local uint32_t FrameTimeline::t_threadId = 0;
+
+// the TSC runs at a fixed rate on any CPU that's recent enough to run Cemu, so it only has to be measured once
+static double MeasureNanosecondsPerTick() {
+    const auto clockStart = std::chrono::steady_clock::now();
+    const uint64_t tscStart = Platform::ReadTimestampCounter();
+    while (std::chrono::steady_clock::now() - clockStart < std::chrono::milliseconds(5)) {
+    }
+    const auto clockEnd = std::chrono::steady_clock::now();
+    const uint64_t tscEnd = Platform::ReadTimestampCounter();
+    return std::chrono::duration<double, std::nano>(clockEnd - clockStart).count() / (double)(tscEnd - tscStart);
+}
+
+static double GetNanosecondsPerTick() {
+    static const double nanosecondsPerTick = MeasureNanosecondsPerTick();
+    return nanosecondsPerTick;
+}
+
+void FrameTimeline::SetEnabled(bool enabled) {
+    if (s_enabled.exchange(enabled) != enabled) {
+        Log::print<INFO>("{} the frame timeline", enabled ? "Enabled" : "Disabled");
+    }
+}
+
+void FrameTimeline::Record(const char* name, uint64_t start, uint64_t end) {
+    if (t_threadId == 0) [[unlikely]] {
+        t_threadId = Platform::GetCurrentThreadId();
+    }
+
+    const uint64_t sequence = s_nextSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+    Span& span = s_spans[sequence & (CAPACITY - 1)];
+    span.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    span.name.store(name, std::memory_order_relaxed);
+    span.start.store(start, std::memory_order_relaxed);
+    span.end.store(end, std::memory_order_relaxed);
+    span.threadId.store(t_threadId, std::memory_order_relaxed);
+    span.sequence.store(sequence, std::memory_order_release);
+}
+
+std::vector<FrameTimeline::DumpedSpan> FrameTimeline::Collect(std::chrono::nanoseconds duration, bool* coversDuration) {
+    const double nanosecondsPerTick = GetNanosecondsPerTick();
+
+    const uint64_t dumpTime = Now();
+    const uint64_t cutoff = dumpTime - std::min<uint64_t>((uint64_t)((double)duration.count() / nanosecondsPerTick), dumpTime);
+    const uint64_t lastSequence = s_nextSequence.load(std::memory_order_acquire);
+    bool reachedCutoff = lastSequence <= CAPACITY;
+    std::vector<DumpedSpan> spans;
+    for (uint64_t sequence = lastSequence > CAPACITY ? lastSequence - CAPACITY + 1 : 1; sequence <= lastSequence; sequence++) {
+        const Span& span = s_spans[sequence & (CAPACITY - 1)];
+        if (span.sequence.load(std::memory_order_acquire) != sequence) {
+            continue;
+        }
+        DumpedSpan dumped = {
+            .name = span.name.load(std::memory_order_relaxed),
+            .start = span.start.load(std::memory_order_relaxed),
+            .end = span.end.load(std::memory_order_relaxed),
+            .threadId = span.threadId.load(std::memory_order_relaxed)
+        };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // skip slots that were overwritten while they were read
+        if (span.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        if (dumped.end < cutoff) {
+            reachedCutoff = true;
+            continue;
+        }
+        spans.emplace_back(dumped);
+    }
+
+    if (coversDuration != nullptr) {
+        *coversDuration = reachedCutoff;
+    }
+    return spans;
+}
+
+void FrameTimeline::WriteChromeTrace(std::ostream& out, std::span<const DumpedSpan> spans) {
+    const double nanosecondsPerTick = GetNanosecondsPerTick();
+
+    const uint64_t firstStart = spans.empty() ? 0 : std::ranges::min(spans, {}, &DumpedSpan::start).start;
+    out << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < spans.size(); i++) {
+        const DumpedSpan& span = spans[i];
+        out << std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}\n",
+            i == 0 ? "" : ",", span.name, span.threadId, (double)(span.start - firstStart) * nanosecondsPerTick / 1000.0, (double)(span.end - span.start) * nanosecondsPerTick / 1000.0
+        );
+    }
+    out << "]}\n";
+}
+
+void FrameTimeline::Dump(std::chrono::nanoseconds duration) {
+    // copy the spans first, since the ring keeps being written to while the file is written
+    bool coversDuration = false;
+    const std::vector<DumpedSpan> spans = Collect(duration, &coversDuration);
+    if (spans.empty()) {
+        Log::print<WARNING>("The frame timeline is empty, enable it first and dump it once the stutter happened");
+        return;
+    }
+    if (!coversDuration) {
+        Log::print<WARNING>("The frame timeline only holds the last {} spans, which is less than {} seconds", CAPACITY, std::chrono::duration_cast<std::chrono::seconds>(duration).count());
+    }
+
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_timeline_{:%Y%m%d_%H%M%S}.json", now);
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to write the frame timeline to", fileName);
+        return;
+    }
+
+    WriteChromeTrace(file, spans);
+    Log::print<INFO>("Wrote {} spans of the frame timeline to {}", spans.size(), fileName);
+}
+
+void FrameTimeline::OnHotkey() {
+    if (!IsEnabled()) {
+        SetEnabled(true);
+        Log::print<INFO>("Press F4 again to dump the last {} seconds of the frame timeline", DEFAULT_DUMP_DURATION.count());
+        return;
+    }
+    Dump(DEFAULT_DUMP_DURATION);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// Records when each step of a frame ran (waiting on OpenXR, capturing the eyes, submitting, the D3D12 fence waits, the HLE hooks, ...)
+// into a fixed-size ring that keeps overwriting the oldest spans, so the last few seconds before a stutter can be dumped afterwards
+// as a Chrome trace (chrome://tracing or ui.perfetto.dev).
+//
+// Recording a span is two TSC reads, one atomic increment and a few stores into the ring, and it's only a single relaxed load while
+// the timeline is disabled. The HLE hooks reuse the TSC reads of HookProfiler, so they only pay for the stores. It's enabled with BETTERVR_FRAME_TIMELINE=1, from the debugger window or by pressing F4 once.
+class FrameTimeline {
+public:
+    static constexpr size_t CAPACITY = 1 << 18;
+    static constexpr std::chrono::seconds DEFAULT_DUMP_DURATION = std::chrono::seconds(5);
+
+    // names have to outlive the timeline, so use string literals or the names of the registered hooks
+    class Scope {
+    public:
+        explicit Scope(const char* name) : m_name(name), m_start(IsEnabled() ? Now() : 0) {}
+        ~Scope() {
+            if (m_start != 0) {
+                Record(m_name, m_start, Now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_start;
+    };
+
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // in TSC ticks, like the timestamps that HookProfiler reads
+    static uint64_t Now() {
+        return Platform::ReadTimestampCounter();
+    }
+
+    // start and end are TSC ticks
+    static void Record(const char* name, uint64_t start, uint64_t end);
+
+    struct DumpedSpan {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+        uint32_t threadId;
+    };
+
+    // copies the spans that ended during the last duration out of the ring, oldest first
+    // coversDuration is false if the ring was overwritten too often to still hold all of them
+    static std::vector<DumpedSpan> Collect(std::chrono::nanoseconds duration, bool* coversDuration = nullptr);
+
+    // writes the spans as the events of a Chrome trace, relative to the earliest start
+    static void WriteChromeTrace(std::ostream& out, std::span<const DumpedSpan> spans);
+
+    // writes the spans that ended during the last duration to BetterVR_timeline_[time].json
+    static void Dump(std::chrono::nanoseconds duration);
+
+    // enables the timeline on the first press and dumps it on every press after that
+    static void OnHotkey();
+
+private:
+    // every field is atomic so that a dump can read the ring while it's being written to, the sequence
+    // is stored last and tells which write the slot belongs to, so that half-written slots are skipped
+    struct Span {
+        std::atomic<const char*> name = nullptr;
+        std::atomic_uint64_t start = 0;
+        std::atomic_uint64_t end = 0;
+        std::atomic_uint32_t threadId = 0;
+        std::atomic_uint64_t sequence = 0;
+    };
+
+    static std::atomic_bool s_enabled;
+    static std::atomic_uint64_t s_nextSequence;
+    static std::array<Span, CAPACITY> s_spans; // zero-initialized, so its pages aren't used until the timeline is enabled
+    static thread_local uint32_t t_threadId;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+// Formatters and result checks for the Vulkan and D3D12 types, which only the layer itself can include
+
+template <>
+struct std::formatter<VkResult> : std::formatter<string> {
+    auto format(const VkResult format, std::format_context& ctx) const {
+        return std::format_to(ctx.out(), "{} ({})", std::to_underlying(format), vkroots::helpers::enumString(format));
+    }
+};
+
+template <>
+struct std::formatter<VkFormat> : std::formatter<string> {
+    auto format(const VkFormat format, std::format_context& ctx) const {
+        return std::format_to(ctx.out(), "{} ({})", std::to_underlying(format), vkroots::helpers::enumString(format));
+    }
+};
+
+template <>
+struct std::formatter<DXGI_FORMAT> : std::formatter<string> {
+    auto format(const DXGI_FORMAT format, std::format_context& ctx) const {
+        std::format_to(ctx.out(), "{}", std::to_underlying(format));
+        switch (format) {
+            case DXGI_FORMAT_UNKNOWN: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_UNKNOWN)");
+            }
+            case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)");
+            }
+            case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)");
+            }
+            case DXGI_FORMAT_D32_FLOAT: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_D32_FLOAT)");
+            }
+            case DXGI_FORMAT_D16_UNORM: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_D16_UNORM)");
+            }
+            case DXGI_FORMAT_R32G32B32_TYPELESS: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_R32G32B32_TYPELESS)");
+            }
+            case DXGI_FORMAT_D24_UNORM_S8_UINT: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_D24_UNORM_S8_UINT)");
+            }
+            case DXGI_FORMAT_D32_FLOAT_S8X24_UINT: {
+                return std::format_to(ctx.out(), " (DXGI_FORMAT_D32_FLOAT_S8X24_UINT)");
+            }
+        }
+    }
+};
+
+template <>
+struct std::formatter<D3D_FEATURE_LEVEL> : std::formatter<string> {
+    auto format(const D3D_FEATURE_LEVEL featureLevel, std::format_context& ctx) const {
+        switch (featureLevel) {
+            case D3D_FEATURE_LEVEL_1_0_CORE:
+                return std::format_to(ctx.out(), "1.0");
+            case D3D_FEATURE_LEVEL_9_1:
+                return std::format_to(ctx.out(), "9.1");
+            case D3D_FEATURE_LEVEL_9_2:
+                return std::format_to(ctx.out(), "9.2");
+            case D3D_FEATURE_LEVEL_9_3:
+                return std::format_to(ctx.out(), "9.3");
+            case D3D_FEATURE_LEVEL_10_0:
+                return std::format_to(ctx.out(), "10.0");
+            case D3D_FEATURE_LEVEL_10_1:
+                return std::format_to(ctx.out(), "10.1");
+            case D3D_FEATURE_LEVEL_11_0:
+                return std::format_to(ctx.out(), "11.0");
+            case D3D_FEATURE_LEVEL_11_1:
+                return std::format_to(ctx.out(), "11.1");
+            case D3D_FEATURE_LEVEL_12_0:
+                return std::format_to(ctx.out(), "12.0");
+            case D3D_FEATURE_LEVEL_12_1:
+                return std::format_to(ctx.out(), "12.1");
+            default:
+                break;
+        }
+        return std::format_to(ctx.out(), "{:X}", std::to_underlying(featureLevel));
+    }
+};
+
+static void checkHResult(const HRESULT result, const char* errorMessage) {
+    if (FAILED(result)) {
+        if (errorMessage == nullptr) {
+            Log::print<ERROR>("[Error] An unknown error (result was {}) has occurred!", result);
+            Log::flush();
+#ifdef _DEBUG
+            __debugbreak();
+#endif
+            MessageBoxA(NULL, std::format("An unknown error {} has occurred which caused a fatal crash!", result).c_str(), "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            throw std::runtime_error("Unidentified error occurred!");
+        }
+        else {
+            Log::print<ERROR>("Error {}: {}", result, errorMessage);
+            Log::flush();
+#ifdef _DEBUG
+            __debugbreak();
+#endif
+            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            throw std::runtime_error(errorMessage);
+        }
+    }
+}
+
+static void checkVkResult(const VkResult result, const char* errorMessage) {
+    if (result != VK_SUCCESS) {
+        if (errorMessage == nullptr) {
+            Log::print<ERROR>("An unknown error (result was {}) has occurred!", (std::underlying_type_t<VkResult>)result);
+            Log::flush();
+#ifdef _DEBUG
+            __debugbreak();
+#endif
+            MessageBoxA(NULL, std::format("An unknown error {} has occurred which caused a fatal crash!", (std::underlying_type_t<VkResult>)result).c_str(), "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            throw std::runtime_error("Unidentified error occurred!");
+        }
+        else {
+            Log::print<ERROR>("Error {}: {}", (std::underlying_type_t<VkResult>)result, errorMessage);
+            Log::flush();
+#ifdef _DEBUG
+            __debugbreak();
+#endif
+            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            throw std::runtime_error(errorMessage);
+        }
+    }
+}
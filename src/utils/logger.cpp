@@ -1,55 +1,181 @@
 #include "logger.h"
+#include "spsc_ring.h"
 
-HANDLE Log::consoleHandle = NULL;
-double Log::timeFrequency = 0.0f;
 std::ofstream Log::logFile;
 std::mutex Log::logMutex;
+Log::OutputFn Log::outputOverride = nullptr;
+#ifdef _DEBUG
+std::atomic_uint32_t Log::enabledLogTypes = Log::getLogTypeBit(INFO) | Log::getLogTypeBit(VERBOSE);
+#else
+std::atomic_uint32_t Log::enabledLogTypes = Log::getLogTypeBit(INFO);
+#endif
 
-static void LogSystemHardwareInfo() {
-    int cpuInfo[4] = {0, 0, 0, 0};
-    __cpuid(cpuInfo, 0x80000000);
-    const unsigned int maxExId = static_cast<unsigned int>(cpuInfo[0]);
-
-    std::string cpuBrand;
-    if (maxExId >= 0x80000004) {
-        char brand[49] = {};
-        __cpuid(reinterpret_cast<int*>(brand + 0), 0x80000002);
-        __cpuid(reinterpret_cast<int*>(brand + 16), 0x80000003);
-        __cpuid(reinterpret_cast<int*>(brand + 32), 0x80000004);
-        cpuBrand = brand;
-        while (!cpuBrand.empty() && cpuBrand.front() == ' ') cpuBrand.erase(cpuBrand.begin());
-        while (!cpuBrand.empty() && cpuBrand.back() == ' ') cpuBrand.pop_back();
-        if (!cpuBrand.empty()) {
-            Log::print<INFO>("CPU: {}", cpuBrand.c_str());
+// Every thread that logs gets its own queue, so logging only costs copying the arguments and never waits on another thread.
+// The logging thread formats the messages of all queues in the order they were logged and writes them in batches.
+static constexpr size_t LOG_QUEUE_CAPACITY = 256;
+static constexpr std::chrono::milliseconds LOG_FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+struct LogQueue {
+    SpscRing<Log::Entry, LOG_QUEUE_CAPACITY> entries;
+    std::atomic_bool threadExited = false;
+};
+
+static std::mutex s_queuesMutex;
+static std::vector<std::shared_ptr<LogQueue>> s_queues;
+static std::atomic_bool s_running = false;
+static std::atomic_uint32_t s_generation = 0;
+static std::atomic_uint64_t s_sequence = 0;
+
+static std::thread s_writerThread;
+static std::mutex s_wakeMutex;
+static std::condition_variable s_wakeCondition;
+static std::atomic_bool s_wakePending = false;
+
+// only used while holding logMutex
+static std::vector<Log::Entry> s_batch;
+static std::string s_batchText;
+static uint64_t s_nextSequence = 0;
+
+struct ThreadLogQueue {
+    std::shared_ptr<LogQueue> queue;
+    uint32_t generation = 0;
+
+    ~ThreadLogQueue() {
+        if (queue) {
+            queue->threadExited.store(true);
         }
     }
+};
+
+static thread_local ThreadLogQueue t_logQueue;
+
+static LogQueue* GetThreadLogQueue() {
+    // the queues are recreated if the logger was restarted since this thread last logged something
+    const uint32_t generation = s_generation.load(std::memory_order_acquire);
+    if (!t_logQueue.queue || t_logQueue.generation != generation) {
+        t_logQueue.queue = std::make_shared<LogQueue>();
+        t_logQueue.generation = generation;
+        std::scoped_lock lock(s_queuesMutex);
+        s_queues.emplace_back(t_logQueue.queue);
+    }
+    return t_logQueue.queue.get();
+}
+
+static void WakeLogWriter() {
+    // messages that are logged while the logging thread is about to sleep are picked up by the next periodic flush instead
+    if (!s_wakePending.exchange(true)) {
+        s_wakeCondition.notify_one();
+    }
+}
+
+// pops the queued messages of every thread into s_batch, sorted in the order they were logged
+// s_batch can still contain messages that were held back by the previous batch, which are sorted in with the new ones
+static void DrainLogQueues() {
+    std::scoped_lock lock(s_queuesMutex);
+    Log::Entry entry;
+    for (auto& queue : s_queues) {
+        while (queue->entries.TryPop(entry)) {
+            s_batch.emplace_back(entry);
+        }
+    }
+    std::erase_if(s_queues, [](const std::shared_ptr<LogQueue>& queue) {
+        return queue->threadExited.load() && queue->entries.IsEmpty();
+    });
+    std::ranges::sort(s_batch, {}, &Log::Entry::sequence);
+}
+
+// a thread can be interrupted after taking its sequence number but before its message is queued, so the messages after such a gap
+// are held back until the missing one arrives, unless writeHeldBack is set because nothing is going to be logged anymore.
+// A message that only arrives after a flush already wrote past its number is written right away, since nothing waits for it anymore.
+static void FormatLogBatch(bool writeHeldBack) {
+    size_t count = 0;
+    for (; count < s_batch.size(); count++) {
+        const Log::Entry& entry = s_batch[count];
+        if (entry.sequence > s_nextSequence && !writeHeldBack) {
+            break;
+        }
+        s_nextSequence = std::max(s_nextSequence, entry.sequence + 1);
 
-    MEMORYSTATUSEX statex{};
-    statex.dwLength = sizeof(statex);
-    if (GlobalMemoryStatusEx(&statex)) {
-        const double totalGiB = double(statex.ullTotalPhys) / (1024.0 * 1024.0 * 1024.0);
+        if (entry.formatFn == nullptr) {
+            s_batchText.append((const char*)entry.args.data(), entry.argsSize);
+        }
+        else {
+            s_batchText.append(entry.formatFn(entry.format, entry.args.data()));
+        }
+        s_batchText.push_back('\n');
+    }
+    s_batch.erase(s_batch.begin(), s_batch.begin() + count);
+}
+
+void Log::flushOnCrash() {
+    // the crash might've happened while writing the log, in which case it's better to lose the queued messages than to deadlock
+    std::unique_lock lock(logMutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        DrainLogQueues();
+        FormatLogBatch(true);
+        writeOutput(s_batchText);
+        s_batchText.clear();
+    }
+}
+
+static void LogSystemHardwareInfo() {
+    if (const std::string cpuName = Platform::GetCpuName(); !cpuName.empty()) {
+        Log::print<INFO>("CPU: {}", cpuName.c_str());
+    }
+
+    if (const uint64_t totalMemory = Platform::GetTotalMemory(); totalMemory != 0) {
+        const double totalGiB = double(totalMemory) / (1024.0 * 1024.0 * 1024.0);
         Log::print<INFO>("RAM: {:.2f} GiB", totalGiB);
     }
 }
 
 Log::Log() {
-    AllocConsole();
-    SetConsoleTitleA("BetterVR Debugging Console");
-    consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+    Platform::OpenConsole("BetterVR Debugging Console");
 #ifndef _DEBUG
     logFile.open("BetterVR.txt", std::ios::out | std::ios::trunc);
 #endif
+    s_generation.fetch_add(1, std::memory_order_release);
+    s_running.store(true, std::memory_order_release);
+    s_writerThread = std::thread(&Log::writerThread);
+    Platform::InstallCrashHandler(&Log::flushOnCrash);
+
     Log::print<INFO>("Successfully started BetterVR!");
-    LogSystemHardwareInfo();
 
-    LARGE_INTEGER timeLI;
-    QueryPerformanceFrequency(&timeLI);
-    timeFrequency = double(timeLI.QuadPart) / 1000.0;
+    if (const char* value = std::getenv("BETTERVR_LOG"); value != nullptr && value[0] != '\0') {
+        std::vector<std::string> invalidNames;
+        enabledLogTypes.store(parseLogTypeMask(value, enabledLogTypes.load(), &invalidNames));
+        for (const std::string& name : invalidNames) {
+            Log::print<WARNING>("Ignoring unknown log type \"{}\" in BETTERVR_LOG", name);
+        }
+
+        std::string enabledNames;
+        for (LogType type : ALL_LOG_TYPES) {
+            if (isLogTypeEnabled(type)) {
+                if (!enabledNames.empty()) {
+                    enabledNames += ", ";
+                }
+                enabledNames += getLogTypeName(type);
+            }
+        }
+        Log::print<INFO>("Enabled log types: {}", enabledNames);
+    }
+    LogSystemHardwareInfo();
 }
 
 Log::~Log() {
     Log::print<INFO>("Shutting down BetterVR debugging console...");
-    FreeConsole();
+    Platform::RemoveCrashHandler();
+    s_running.store(false, std::memory_order_release);
+    WakeLogWriter();
+    if (s_writerThread.joinable()) {
+        s_writerThread.join();
+    }
+    Log::flush();
+    {
+        std::scoped_lock lock(s_queuesMutex);
+        s_queues.clear();
+    }
+    Platform::CloseConsole();
 #ifndef _DEBUG
     if (logFile.is_open()) {
         logFile.close();
@@ -57,8 +183,132 @@ Log::~Log() {
 #endif
 }
 
-void Log::printTimeElapsed(const char* message_prefix, LARGE_INTEGER time) {
-    LARGE_INTEGER timeNow;
-    QueryPerformanceCounter(&timeNow);
-    Log::print<INFO>("{}: {} ms", message_prefix, double(time.QuadPart - timeNow.QuadPart) / timeFrequency);
-}
\ No newline at end of file
+void Log::printTimeElapsed(const char* message_prefix, std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    Log::print<INFO>("{}: {} ms", message_prefix, elapsed.count());
+}
+
+uint32_t Log::parseLogTypeMask(std::string_view list, uint32_t mask, std::vector<std::string>* invalidNames) {
+    for (auto part : std::views::split(list, ',')) {
+        std::string name;
+        for (char c : part) {
+            if (c != ' ' && c != '\t') {
+                name.push_back((char)std::tolower((unsigned char)c));
+            }
+        }
+        if (name.empty()) {
+            continue;
+        }
+
+        // a leading minus disables the log type instead
+        const bool enable = name[0] != '-';
+        if (name[0] == '-' || name[0] == '+') {
+            name.erase(0, 1);
+        }
+
+        uint32_t bits = 0;
+        if (name == "all") {
+            for (LogType type : ALL_LOG_TYPES) {
+                bits |= getLogTypeBit(type);
+            }
+        }
+        else {
+            for (LogType type : ALL_LOG_TYPES) {
+                if (name == getLogTypeName(type)) {
+                    bits = getLogTypeBit(type);
+                    break;
+                }
+            }
+        }
+
+        if (bits == 0) {
+            if (invalidNames != nullptr) {
+                invalidNames->emplace_back(name);
+            }
+            continue;
+        }
+        mask = enable ? (mask | bits) : (mask & ~bits);
+    }
+    return mask;
+}
+
+void Log::flush() {
+    std::scoped_lock lock(logMutex);
+    DrainLogQueues();
+    FormatLogBatch(true);
+    writeOutput(s_batchText);
+    s_batchText.clear();
+}
+
+bool Log::enqueue(Entry& entry) {
+    if (!s_running.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    LogQueue* queue = GetThreadLogQueue();
+    while (queue->entries.GetSize() >= LOG_QUEUE_CAPACITY) {
+        // wait for the logging thread to catch up instead of dropping messages
+        WakeLogWriter();
+        std::this_thread::yield();
+        if (!s_running.load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+
+    // the sequence number is only taken once there's room, since a message that waits with an old number would be written after
+    // the newer messages of other threads, and this thread is the only one that pushes into its queue so the push can't fail anymore
+    entry.sequence = s_sequence.fetch_add(1, std::memory_order_relaxed);
+    queue->entries.TryPush(entry);
+
+    if (queue->entries.GetSize() >= LOG_QUEUE_CAPACITY / 2) {
+        WakeLogWriter();
+    }
+    return true;
+}
+
+void Log::writeNow(const char* message) {
+    // everything that was queued before has to be written first to keep the messages in order
+    std::scoped_lock lock(logMutex);
+    DrainLogQueues();
+    FormatLogBatch(false);
+    s_batchText.append(message);
+    s_batchText.push_back('\n');
+    writeOutput(s_batchText);
+    s_batchText.clear();
+}
+
+void Log::writeOutput(const std::string& text) {
+    if (text.empty()) {
+        return;
+    }
+    if (outputOverride != nullptr) {
+        outputOverride(text);
+        return;
+    }
+
+#ifndef _DEBUG
+    if (logFile.is_open()) {
+        logFile << text;
+        logFile.flush();
+    }
+#endif
+
+    Platform::WriteToConsole(text);
+}
+
+void Log::writerThread() {
+    std::unique_lock lock(s_wakeMutex);
+    while (s_running.load(std::memory_order_acquire)) {
+        s_wakeCondition.wait_for(lock, LOG_FLUSH_INTERVAL, [] { return s_wakePending.load(); });
+        s_wakePending.store(false);
+        lock.unlock();
+        {
+            std::scoped_lock logLock(logMutex);
+            DrainLogQueues();
+            FormatLogBatch(false);
+            writeOutput(s_batchText);
+            s_batchText.clear();
+        }
+        lock.lock();
+    }
+}
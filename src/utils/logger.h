@@ -1,13 +1,5 @@
 #pragma once
-#include "vkroots.h"
-#include <fstream>
-
-template <>
-struct std::formatter<VkResult> : std::formatter<string> {
-    auto format(const VkResult format, std::format_context& ctx) const {
-        return std::format_to(ctx.out(), "{} ({})", std::to_underlying(format), vkroots::helpers::enumString(format));
-    }
-};
+#include "platform.h"
 
 template <>
 struct std::formatter<XrResult> : std::formatter<string> {
@@ -16,46 +8,6 @@ struct std::formatter<XrResult> : std::formatter<string> {
     }
 };
 
-template <>
-struct std::formatter<VkFormat> : std::formatter<string> {
-    auto format(const VkFormat format, std::format_context& ctx) const {
-        return std::format_to(ctx.out(), "{} ({})", std::to_underlying(format), vkroots::helpers::enumString(format));
-    }
-};
-
-template <>
-struct std::formatter<DXGI_FORMAT> : std::formatter<string> {
-    auto format(const DXGI_FORMAT format, std::format_context& ctx) const {
-        std::format_to(ctx.out(), "{}", std::to_underlying(format));
-        switch (format) {
-            case DXGI_FORMAT_UNKNOWN: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_UNKNOWN)");
-            }
-            case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)");
-            }
-            case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_B8G8R8A8_UNORM_SRGB)");
-            }
-            case DXGI_FORMAT_D32_FLOAT: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_D32_FLOAT)");
-            }
-            case DXGI_FORMAT_D16_UNORM: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_D16_UNORM)");
-            }
-            case DXGI_FORMAT_R32G32B32_TYPELESS: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_R32G32B32_TYPELESS)");
-            }
-            case DXGI_FORMAT_D24_UNORM_S8_UINT: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_D24_UNORM_S8_UINT)");
-            }
-            case DXGI_FORMAT_D32_FLOAT_S8X24_UINT: {
-                return std::format_to(ctx.out(), " (DXGI_FORMAT_D32_FLOAT_S8X24_UINT)");
-            }
-        }
-    }
-};
-
 template <>
 struct std::formatter<glm::fmat3> : std::formatter<string> {
     auto format(const glm::fmat3& mtx, std::format_context& ctx) const {
@@ -168,36 +120,6 @@ struct std::formatter<BESeadLookAtCamera> : std::formatter<string> {
 };
 
 
-template <>
-struct std::formatter<D3D_FEATURE_LEVEL> : std::formatter<string> {
-    auto format(const D3D_FEATURE_LEVEL featureLevel, std::format_context& ctx) const {
-        switch (featureLevel) {
-            case D3D_FEATURE_LEVEL_1_0_CORE:
-                return std::format_to(ctx.out(), "1.0");
-            case D3D_FEATURE_LEVEL_9_1:
-                return std::format_to(ctx.out(), "9.1");
-            case D3D_FEATURE_LEVEL_9_2:
-                return std::format_to(ctx.out(), "9.2");
-            case D3D_FEATURE_LEVEL_9_3:
-                return std::format_to(ctx.out(), "9.3");
-            case D3D_FEATURE_LEVEL_10_0:
-                return std::format_to(ctx.out(), "10.0");
-            case D3D_FEATURE_LEVEL_10_1:
-                return std::format_to(ctx.out(), "10.1");
-            case D3D_FEATURE_LEVEL_11_0:
-                return std::format_to(ctx.out(), "11.0");
-            case D3D_FEATURE_LEVEL_11_1:
-                return std::format_to(ctx.out(), "11.1");
-            case D3D_FEATURE_LEVEL_12_0:
-                return std::format_to(ctx.out(), "12.0");
-            case D3D_FEATURE_LEVEL_12_1:
-                return std::format_to(ctx.out(), "12.1");
-            default:
-                break;
-        }
-        return std::format_to(ctx.out(), "{:X}", std::to_underlying(featureLevel));
-    }
-};
 
 enum class LogType {
     // verbose logging types
@@ -224,136 +146,208 @@ public:
     Log();
     ~Log();
 
-    template <typename LogType L>
-    static inline bool consteval isLogTypeEnabled() {
-        if constexpr (L == ERROR) {
-            return true;
+    // a message in the queue of the thread that logged it
+    struct Entry {
+        static constexpr size_t MAX_ARGS_SIZE = 224;
+        using FormatFn = std::string(*)(const char* format, const std::byte* args);
+
+        uint64_t sequence = 0;
+        FormatFn formatFn = nullptr; // args contains the message itself if there's nothing to format
+        const char* format = nullptr;
+        uint32_t argsSize = 0;
+        std::array<std::byte, MAX_ARGS_SIZE> args;
+    };
+
+    static constexpr std::array ALL_LOG_TYPES = { RENDERING, INTEROP, CONTROLS, PPC, XR_DEBUGUTILS, INFO, WARNING, ERROR, VERBOSE };
+
+    static constexpr uint32_t getLogTypeBit(LogType type) {
+        return 1u << std::to_underlying(type);
+    }
+
+    static constexpr const char* getLogTypeName(LogType type) {
+        switch (type) {
+            case RENDERING: return "rendering";
+            case INTEROP: return "interop";
+            case CONTROLS: return "controls";
+            case PPC: return "ppc";
+            case XR_DEBUGUTILS: return "xr_debugutils";
+            case INFO: return "info";
+            case WARNING: return "warning";
+            case ERROR: return "error";
+            case VERBOSE: return "verbose";
         }
-        if constexpr (L == WARNING) {
+        return "unknown";
+    }
+
+    // errors and warnings are always logged, the other types can be toggled while the game is running
+    template <LogType L>
+    static inline bool isLogTypeEnabled() {
+        if constexpr (L == ERROR || L == WARNING) {
             return true;
         }
-        if constexpr (L == INFO) {
-            return true;
+        else {
+            return (enabledLogTypes.load(std::memory_order_relaxed) & getLogTypeBit(L)) != 0;
         }
-#if defined(_DEBUG)
-        if constexpr (L == VERBOSE) {
-            return true;
+    }
+
+    static bool isLogTypeEnabled(LogType type) {
+        return type == ERROR || type == WARNING || (enabledLogTypes.load(std::memory_order_relaxed) & getLogTypeBit(type)) != 0;
+    }
+
+    static void setLogTypeEnabled(LogType type, bool enabled) {
+        if (enabled) {
+            enabledLogTypes.fetch_or(getLogTypeBit(type), std::memory_order_relaxed);
+        }
+        else {
+            enabledLogTypes.fetch_and(~getLogTypeBit(type), std::memory_order_relaxed);
         }
-        //if constexpr (L == RENDERING) {
-        //    return true;
-        //}
-        //if constexpr (L == CONTROLS) {
-        //    return true;
-        //}
-        //if constexpr (L == PPC) {
-        //    return true;
-        //}
-#endif
-        return false;
     }
 
-    template <typename LogType L>
+    // applies a comma-separated list of log types to mask, like "controls,-info" or "all"
+    // returns the names that aren't log types through invalidNames
+    static uint32_t parseLogTypeMask(std::string_view list, uint32_t mask, std::vector<std::string>* invalidNames = nullptr);
+
+    template <LogType L>
     static inline void print(const char* message) {
-        if constexpr (!isLogTypeEnabled<L>()) {
+        if (!isLogTypeEnabled<L>()) {
             return;
         }
-        std::lock_guard<std::mutex> lock(logMutex);
-        std::string messageStr = std::string(message) + "\n";
 
-#ifndef _DEBUG
-        if (logFile.is_open()) {
-            logFile << messageStr;
-            logFile.flush();
+        // messages that don't fit in a queue entry are written right away instead
+        const size_t length = strlen(message);
+        if (length <= Entry::MAX_ARGS_SIZE) {
+            Entry entry;
+            memcpy(entry.args.data(), message, length);
+            entry.argsSize = (uint32_t)length;
+            if (enqueue(entry)) {
+                return;
+            }
         }
-#endif
-
-        DWORD charsWritten = 0;
-        WriteConsoleA(consoleHandle, messageStr.c_str(), (DWORD)messageStr.size(), &charsWritten, NULL);
-#ifdef _DEBUG
-        //std::string messageStr = std::string(message) + "\n";
-        //DWORD charsWritten = 0;
-        //WriteConsoleA(consoleHandle, messageStr.c_str(), (DWORD)messageStr.size(), &charsWritten, NULL);
-        OutputDebugStringA(messageStr.c_str());
-#else
-        std::cout << message << std::endl;
-#endif
+        writeNow(message);
     }
 
-    template <typename LogType L, class... Args>
+    // format has to be a string literal, since the message is only formatted later on the logging thread
+    template <LogType L, class... Args>
     static inline void print(const char* format, Args&&... args) {
-        if constexpr (!isLogTypeEnabled<L>()) {
+        if (!isLogTypeEnabled<L>()) {
             return;
         }
+
+        // only the arguments are copied into the queue, the formatting happens on the logging thread
+        if constexpr ((isDeferrableArg<std::decay_t<Args>>() && ...)) {
+            Entry entry;
+            size_t argsSize = 0;
+            if ((packArg(entry, argsSize, args) && ...)) {
+                entry.formatFn = &formatArgs<std::decay_t<Args>...>;
+                entry.format = format;
+                entry.argsSize = (uint32_t)argsSize;
+                if (enqueue(entry)) {
+                    return;
+                }
+            }
+        }
         Log::print<L>(std::vformat(format, std::make_format_args(args...)).c_str());
     }
 
-    static void printTimeElapsed(const char* message_prefix, LARGE_INTEGER time);
+    // writes all queued messages, used before showing a fatal error since the game might not survive it
+    static void flush();
+
+    static void printTimeElapsed(const char* message_prefix, std::chrono::steady_clock::time_point start);
+
+    // replaces the console and log file with onOutput, so that the tests can check what would've been written
+    using OutputFn = void(*)(const std::string& text);
+    static void setOutputOverride(OutputFn onOutput) { outputOverride = onOutput; }
 
 private:
-    static HANDLE consoleHandle;
-    static double timeFrequency;
-    static std::ofstream logFile;
-    static std::mutex logMutex;
-};
+    // strings are copied, anything else is copied as raw bytes if that's possible
+    template <class T>
+    static inline bool consteval isDeferrableArg() {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return true;
+        }
+        else {
+            return std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && (!std::is_pointer_v<T> || std::is_void_v<std::remove_pointer_t<T>>);
+        }
+    }
 
-static void checkXRResult(const XrResult result, const char* errorMessage) {
-    if (XR_FAILED(result)) {
-        if (errorMessage == nullptr) {
-            Log::print<ERROR>("An unknown error (result was {}) has occurred!", result);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, std::format("An unknown error {} has occurred which caused a fatal crash!", result).c_str(), "An error occurred!", MB_OK | MB_ICONERROR);
-            throw std::runtime_error("Unidentified error occurred!");
+    template <class T>
+    using StoredArg = std::conditional_t<std::is_convertible_v<const T&, std::string_view>, std::string_view, T>;
+
+    template <class T>
+    static inline bool packArg(Entry& entry, size_t& offset, const T& arg) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            const std::string_view str = arg;
+            const uint32_t length = (uint32_t)str.size();
+            if (offset + sizeof(length) + str.size() > Entry::MAX_ARGS_SIZE) {
+                return false;
+            }
+            memcpy(entry.args.data() + offset, &length, sizeof(length));
+            memcpy(entry.args.data() + offset + sizeof(length), str.data(), str.size());
+            offset += sizeof(length) + str.size();
         }
         else {
-            Log::print<ERROR>("Error {}: {}", result, errorMessage);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
-            throw std::runtime_error(errorMessage);
+            if (offset + sizeof(T) > Entry::MAX_ARGS_SIZE) {
+                return false;
+            }
+            memcpy(entry.args.data() + offset, &arg, sizeof(T));
+            offset += sizeof(T);
         }
+        return true;
     }
-}
 
-static void checkHResult(const HRESULT result, const char* errorMessage) {
-    if (FAILED(result)) {
-        if (errorMessage == nullptr) {
-            Log::print<ERROR>("[Error] An unknown error (result was {}) has occurred!", result);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, std::format("An unknown error {} has occurred which caused a fatal crash!", result).c_str(), "A fatal error occurred!", MB_OK | MB_ICONERROR);
-            throw std::runtime_error("Unidentified error occurred!");
+    template <class T>
+    static inline void unpackArg(T& value, const std::byte* args, size_t& offset) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            uint32_t length = 0;
+            memcpy(&length, args + offset, sizeof(length));
+            value = std::string_view((const char*)(args + offset + sizeof(length)), length);
+            offset += sizeof(length) + length;
         }
         else {
-            Log::print<ERROR>("Error {}: {}", result, errorMessage);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
-            throw std::runtime_error(errorMessage);
+            memcpy(&value, args + offset, sizeof(T));
+            offset += sizeof(T);
         }
     }
-}
 
-static void checkVkResult(const VkResult result, const char* errorMessage) {
-    if (result != VK_SUCCESS) {
+    template <class... Args>
+    static std::string formatArgs(const char* format, const std::byte* args) {
+        std::tuple<StoredArg<Args>...> values;
+        std::apply([&](auto&... value) {
+            size_t offset = 0;
+            (unpackArg(value, args, offset), ...);
+        }, values);
+        return std::apply([format](auto&... value) {
+            return std::vformat(format, std::make_format_args(value...));
+        }, values);
+    }
+
+    // returns false if the logging thread isn't running, in which case the message has to be written right away
+    static bool enqueue(Entry& entry);
+    static void writeNow(const char* message);
+    static void writeOutput(const std::string& text);
+    static void writerThread();
+    static void flushOnCrash();
+
+    static std::ofstream logFile;
+    static std::mutex logMutex;
+    static std::atomic_uint32_t enabledLogTypes;
+    static OutputFn outputOverride;
+};
+
+static void checkXRResult(const XrResult result, const char* errorMessage) {
+    if (XR_FAILED(result)) {
         if (errorMessage == nullptr) {
-            Log::print<ERROR>("An unknown error (result was {}) has occurred!", (std::underlying_type_t<VkResult>)result);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, std::format("An unknown error {} has occurred which caused a fatal crash!", (std::underlying_type_t<VkResult>)result).c_str(), "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            Log::print<ERROR>("An unknown error (result was {}) has occurred!", result);
+            Log::flush();
+            Platform::BreakIntoDebugger();
+            Platform::ShowFatalError(std::format("An unknown error {} has occurred which caused a fatal crash!", result).c_str(), "An error occurred!");
             throw std::runtime_error("Unidentified error occurred!");
         }
         else {
-            Log::print<ERROR>("Error {}: {}", (std::underlying_type_t<VkResult>)result, errorMessage);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            Log::print<ERROR>("Error {}: {}", result, errorMessage);
+            Log::flush();
+            Platform::BreakIntoDebugger();
+            Platform::ShowFatalError(errorMessage, "A fatal error occurred!");
             throw std::runtime_error(errorMessage);
         }
     }
@@ -363,18 +357,16 @@ static void checkAssert(const bool assert, const char* errorMessage) {
     if (!assert) {
         if (errorMessage == nullptr) {
             Log::print<ERROR>("Something unexpected happened that prevents further execution!");
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, "Something unexpected happened that prevents further execution!", "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            Log::flush();
+            Platform::BreakIntoDebugger();
+            Platform::ShowFatalError("Something unexpected happened that prevents further execution!", "A fatal error occurred!");
             throw std::runtime_error("Unexpected assertion occurred!");
         }
         else {
             Log::print<ERROR>("{}", errorMessage);
-#ifdef _DEBUG
-            __debugbreak();
-#endif
-            MessageBoxA(NULL, errorMessage, "A fatal error occurred!", MB_OK | MB_ICONERROR);
+            Log::flush();
+            Platform::BreakIntoDebugger();
+            Platform::ShowFatalError(errorMessage, "A fatal error occurred!");
             throw std::runtime_error(errorMessage);
         }
     }
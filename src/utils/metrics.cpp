@@ -0,0 +1,192 @@
+#include "metrics.h"
+
+namespace Metrics {
+
+double MetricSnapshot::GetPercentile(const MetricInfo& info, double percentile) const {
+    if (total == 0 || buckets.empty()) {
+        return 0.0;
+    }
+
+    const uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile * (double)total));
+    uint64_t count = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        count += buckets[i];
+        if (count >= target) {
+            return info.bucketBounds[std::min(i, info.bucketBounds.size() - 1)];
+        }
+    }
+    return info.bucketBounds.back();
+}
+
+uint32_t Registry::Add(std::string_view name, MetricType type, std::span<const double> bucketBounds) {
+    std::scoped_lock lock(m_mutex);
+    for (const MetricInfo& info : m_metrics) {
+        if (info.name == name && info.type == type) {
+            return info.firstSlot;
+        }
+    }
+
+    checkAssert(type != MetricType::HISTOGRAM || !bucketBounds.empty(), "Histograms need at least one bucket bound!");
+    const uint32_t slotCount = type == MetricType::HISTOGRAM ? (uint32_t)bucketBounds.size() + 2 : 1;
+    checkAssert(m_slotCount + slotCount <= MAX_SLOTS, "Too many metrics were registered, increase Metrics::MAX_SLOTS!");
+
+    m_metrics.emplace_back(MetricInfo{
+        .name = std::string(name),
+        .type = type,
+        .firstSlot = m_slotCount,
+        .bucketBounds = std::vector<double>(bucketBounds.begin(), bucketBounds.end())
+    });
+    m_snapshots.emplace_back();
+    m_slotCount += slotCount;
+
+    m_sortedMetrics.emplace_back(m_metrics.size() - 1);
+    std::ranges::sort(m_sortedMetrics, {}, [this](size_t idx) -> const std::string& { return m_metrics[idx].name; });
+    return m_metrics.back().firstSlot;
+}
+
+std::atomic_uint64_t* Registry::AddThread() {
+    std::scoped_lock lock(m_mutex);
+    return m_threads.emplace_back(std::make_unique<ThreadSlots>())->values.data();
+}
+
+void Registry::EndFrame() {
+    if (!m_checkedCsvEnv) {
+        m_checkedCsvEnv = true;
+        if (const char* value = std::getenv("BETTERVR_METRICS_CSV"); value != nullptr && value[0] != '\0' && value[0] != '0') {
+            StartCsv();
+        }
+    }
+
+    std::scoped_lock lock(m_mutex);
+
+    std::array<uint64_t, MAX_SLOTS> previousTotals;
+    std::copy_n(m_totals.begin(), m_slotCount, previousTotals.begin());
+
+    std::fill_n(m_totals.begin(), m_slotCount, 0);
+    for (const auto& thread : m_threads) {
+        for (uint32_t slot = 0; slot < m_slotCount; slot++) {
+            m_totals[slot] += thread->values[slot].load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t i = 0; i < m_metrics.size(); i++) {
+        const MetricInfo& info = m_metrics[i];
+        MetricSnapshot& snapshot = m_snapshots[i];
+        const uint32_t slot = info.firstSlot;
+
+        switch (info.type) {
+            case MetricType::COUNTER: {
+                snapshot.total = m_totals[slot] - m_resetTotals[slot];
+                snapshot.lastFrame = m_totals[slot] - previousTotals[slot];
+                break;
+            }
+            case MetricType::GAUGE: {
+                snapshot.value = std::bit_cast<double>(m_globalSlots[slot].load(std::memory_order_relaxed));
+                break;
+            }
+            case MetricType::HISTOGRAM: {
+                // the sum slot holds the bits of a double per thread, so it has to be summed up separately
+                const uint32_t sumSlot = slot + (uint32_t)info.bucketBounds.size() + 1;
+                double sum = 0.0;
+                for (const auto& thread : m_threads) {
+                    sum += std::bit_cast<double>(thread->values[sumSlot].load(std::memory_order_relaxed));
+                }
+                snapshot.value = sum - std::bit_cast<double>(m_resetTotals[sumSlot]);
+                snapshot.lastFrameValue = sum - std::bit_cast<double>(previousTotals[sumSlot]);
+
+                snapshot.buckets.resize(info.bucketBounds.size() + 1);
+                snapshot.total = 0;
+                snapshot.lastFrame = 0;
+                for (size_t bucket = 0; bucket < snapshot.buckets.size(); bucket++) {
+                    snapshot.buckets[bucket] = m_totals[slot + bucket] - m_resetTotals[slot + bucket];
+                    snapshot.total += snapshot.buckets[bucket];
+                    snapshot.lastFrame += m_totals[slot + bucket] - previousTotals[slot + bucket];
+                }
+                m_totals[sumSlot] = std::bit_cast<uint64_t>(sum);
+                break;
+            }
+        }
+    }
+
+    if (m_csvFile.is_open()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_lastCsvWrite >= CSV_INTERVAL) {
+            WriteCsv(now);
+        }
+    }
+}
+
+std::pair<MetricInfo, MetricSnapshot> Registry::GetSnapshot(uint32_t firstSlot) {
+    std::scoped_lock lock(m_mutex);
+    for (size_t i = 0; i < m_metrics.size(); i++) {
+        if (m_metrics[i].firstSlot == firstSlot) {
+            return { m_metrics[i], m_snapshots[i] };
+        }
+    }
+    return {};
+}
+
+void Registry::Reset() {
+    std::scoped_lock lock(m_mutex);
+    m_resetTotals = m_totals;
+    m_lastCsvTotals.assign(m_snapshots.size(), 0);
+}
+
+bool Registry::StartCsv() {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const std::string fileName = std::format("BetterVR_metrics_{:%Y%m%d_%H%M%S}.csv", now);
+
+    std::scoped_lock lock(m_mutex);
+    m_csvFile.close();
+    m_csvFile.open(fileName, std::ios::out | std::ios::trunc);
+    if (!m_csvFile.is_open()) {
+        Log::print<WARNING>("Couldn't open {} to write the metrics to", fileName);
+        return false;
+    }
+    Log::print<INFO>("Writing metrics to {}", fileName);
+
+    m_csvFile << "time_s,metric,type,total,per_second,value,p50,p99\n";
+    m_csvStart = std::chrono::steady_clock::now();
+    m_lastCsvWrite = m_csvStart;
+    m_lastCsvTotals.assign(m_snapshots.size(), 0);
+    for (size_t i = 0; i < m_snapshots.size(); i++) {
+        m_lastCsvTotals[i] = m_snapshots[i].total;
+    }
+    return true;
+}
+
+void Registry::StopCsv() {
+    std::scoped_lock lock(m_mutex);
+    m_csvFile.close();
+}
+
+void Registry::WriteCsv(std::chrono::steady_clock::time_point now) {
+    const double time = std::chrono::duration<double>(now - m_csvStart).count();
+    const double elapsed = std::chrono::duration<double>(now - m_lastCsvWrite).count();
+    m_lastCsvWrite = now;
+    m_lastCsvTotals.resize(m_snapshots.size(), 0);
+
+    for (size_t idx : m_sortedMetrics) {
+        const MetricInfo& info = m_metrics[idx];
+        const MetricSnapshot& snapshot = m_snapshots[idx];
+        const double perSecond = (double)(snapshot.total - m_lastCsvTotals[idx]) / elapsed;
+        m_lastCsvTotals[idx] = snapshot.total;
+
+        switch (info.type) {
+            case MetricType::COUNTER:
+                m_csvFile << std::format("{:.3f},{},counter,{},{:.2f},,,\n", time, info.name, snapshot.total, perSecond);
+                break;
+            case MetricType::GAUGE:
+                m_csvFile << std::format("{:.3f},{},gauge,,,{:.4f},,\n", time, info.name, snapshot.value);
+                break;
+            case MetricType::HISTOGRAM: {
+                const double mean = snapshot.total > 0 ? snapshot.value / (double)snapshot.total : 0.0;
+                m_csvFile << std::format("{:.3f},{},histogram,{},{:.2f},{:.4f},{},{}\n", time, info.name, snapshot.total, perSecond, mean, snapshot.GetPercentile(info, 0.5), snapshot.GetPercentile(info, 0.99));
+                break;
+            }
+        }
+    }
+    m_csvFile.flush();
+}
+
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+// Named counters, gauges and histograms that can be looked at in the BetterVR Debugger window or written to a CSV file.
+// Counters and histograms are stored per thread, so updating them is a plain add on memory that only the calling thread writes to.
+// The values of all threads are summed up once per frame by Metrics::Registry::EndFrame().
+namespace Metrics {
+    static constexpr size_t MAX_SLOTS = 1024;
+    static constexpr std::chrono::seconds CSV_INTERVAL = std::chrono::seconds(1);
+
+    enum class MetricType : uint8_t {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct MetricInfo {
+        std::string name;
+        MetricType type;
+        uint32_t firstSlot;
+        std::vector<double> bucketBounds; // upper bound of every histogram bucket, there's one more bucket for anything above the last one
+    };
+
+    struct MetricSnapshot {
+        uint64_t total = 0;     // counter total, or the number of histogram samples
+        uint64_t lastFrame = 0; // how much the total changed during the last frame
+        double value = 0.0;     // gauge value, or the sum of all histogram samples
+        double lastFrameValue = 0.0; // how much the sum of the histogram samples changed during the last frame
+        std::vector<uint64_t> buckets;
+
+        // estimated from the buckets, so it's the upper bound of the bucket that the percentile falls in
+        double GetPercentile(const MetricInfo& info, double percentile) const;
+    };
+
+    class Registry {
+    public:
+        static Registry& Get() {
+            static Registry registry;
+            return registry;
+        }
+
+        // returns the first slot of the metric, registering a metric with the same name and type again returns the same slots
+        uint32_t Add(std::string_view name, MetricType type, std::span<const double> bucketBounds = {});
+
+        std::atomic_uint64_t& GetThreadSlot(uint32_t slot) {
+            if (t_slots == nullptr) [[unlikely]] {
+                t_slots = AddThread();
+            }
+            return t_slots[slot];
+        }
+
+        std::atomic_uint64_t& GetGlobalSlot(uint32_t slot) {
+            return m_globalSlots[slot];
+        }
+
+        // sums up the values of all threads and writes them to the CSV file if it's time for that
+        void EndFrame();
+
+        // everything shown or written afterwards is counted from this point on
+        void Reset();
+
+        // writes every metric to BetterVR_metrics_[time].csv once every CSV_INTERVAL
+        bool StartCsv();
+        void StopCsv();
+        bool IsWritingCsv() const { return m_csvFile.is_open(); }
+
+        // returns the metric that starts at firstSlot and its last snapshot
+        std::pair<MetricInfo, MetricSnapshot> GetSnapshot(uint32_t firstSlot);
+
+        // calls callback(info, snapshot) for every metric, sorted by name
+        template <typename F>
+        void ForEach(F&& callback) {
+            std::scoped_lock lock(m_mutex);
+            for (size_t idx : m_sortedMetrics) {
+                callback(m_metrics[idx], m_snapshots[idx]);
+            }
+        }
+
+    private:
+        Registry() = default;
+
+        struct ThreadSlots {
+            std::array<std::atomic_uint64_t, MAX_SLOTS> values = {};
+        };
+
+        std::atomic_uint64_t* AddThread();
+        void WriteCsv(std::chrono::steady_clock::time_point now);
+
+        static inline thread_local std::atomic_uint64_t* t_slots = nullptr;
+
+        std::mutex m_mutex;
+        std::vector<MetricInfo> m_metrics;
+        std::vector<size_t> m_sortedMetrics;
+        std::vector<MetricSnapshot> m_snapshots;
+        uint32_t m_slotCount = 0;
+
+        // threads that exited are kept around, since their counts are still part of the totals
+        std::vector<std::unique_ptr<ThreadSlots>> m_threads;
+        std::array<std::atomic_uint64_t, MAX_SLOTS> m_globalSlots = {};
+        std::array<uint64_t, MAX_SLOTS> m_totals = {};
+        std::array<uint64_t, MAX_SLOTS> m_resetTotals = {};
+
+        bool m_checkedCsvEnv = false;
+        std::ofstream m_csvFile;
+        std::chrono::steady_clock::time_point m_csvStart;
+        std::chrono::steady_clock::time_point m_lastCsvWrite;
+        std::vector<uint64_t> m_lastCsvTotals;
+    };
+
+    class Counter {
+    public:
+        explicit Counter(std::string_view name) : m_slot(Registry::Get().Add(name, MetricType::COUNTER)) {}
+
+        // returns how much this thread added so far, which is handy to only log every Nth call
+        uint64_t Add(uint64_t amount = 1) const {
+            std::atomic_uint64_t& value = Registry::Get().GetThreadSlot(m_slot);
+            const uint64_t newValue = value.load(std::memory_order_relaxed) + amount;
+            value.store(newValue, std::memory_order_relaxed);
+            return newValue;
+        }
+
+    private:
+        uint32_t m_slot;
+    };
+
+    class Gauge {
+    public:
+        explicit Gauge(std::string_view name) : m_slot(Registry::Get().Add(name, MetricType::GAUGE)) {}
+
+        void Set(double value) const {
+            Registry::Get().GetGlobalSlot(m_slot).store(std::bit_cast<uint64_t>(value), std::memory_order_relaxed);
+        }
+
+    private:
+        uint32_t m_slot;
+    };
+
+    class Histogram {
+    public:
+        Histogram(std::string_view name, std::initializer_list<double> bucketBounds) : m_bucketBounds(bucketBounds), m_slot(Registry::Get().Add(name, MetricType::HISTOGRAM, m_bucketBounds)) {}
+
+        void Record(double value) const {
+            size_t bucket = 0;
+            while (bucket < m_bucketBounds.size() && value > m_bucketBounds[bucket]) {
+                bucket++;
+            }
+
+            Registry& registry = Registry::Get();
+            std::atomic_uint64_t& count = registry.GetThreadSlot(m_slot + (uint32_t)bucket);
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            // the sum is stored as the bits of a double in the slot after the buckets
+            std::atomic_uint64_t& sum = registry.GetThreadSlot(m_slot + (uint32_t)m_bucketBounds.size() + 1);
+            sum.store(std::bit_cast<uint64_t>(std::bit_cast<double>(sum.load(std::memory_order_relaxed)) + value), std::memory_order_relaxed);
+        }
+
+        std::pair<MetricInfo, MetricSnapshot> GetSnapshot() const {
+            return Registry::Get().GetSnapshot(m_slot);
+        }
+
+    private:
+        std::vector<double> m_bucketBounds;
+        uint32_t m_slot;
+    };
+
+    // measures the time until the end of the scope in milliseconds
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const Histogram& histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            m_histogram.Record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+    private:
+        const Histogram& m_histogram;
+        std::chrono::steady_clock::time_point m_start;
+    };
+}
+
+// registers the metric the first time the surrounding function runs
+#define BETTERVR_COUNTER(var, name) static const Metrics::Counter var(name)
+#define BETTERVR_GAUGE(var, name) static const Metrics::Gauge var(name)
+#define BETTERVR_HISTOGRAM(var, name, ...) static const Metrics::Histogram var(name, { __VA_ARGS__ })
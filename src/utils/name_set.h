@@ -0,0 +1,122 @@
+#pragma once
+
+// A fixed set of names with a minimal perfect hash that's generated at compile time.
+// Lookups hash the name twice and do a single string comparison, no matter how many names are in the set.
+// find() returns the index of the name in the list the set was created from, which can be used as a symbol for the name.
+//
+// The hash uses hash-and-displace: every name falls in a bucket, and each bucket stores the seed that places all of its names in
+// free slots of the table. Buckets with a single name store the slot directly.
+template <size_t N>
+class NameSet {
+    static_assert(N > 0, "NameSet needs at least one name");
+
+public:
+    consteval NameSet(const std::array<std::string_view, N>& names) {
+        // group the names by the bucket they hash to
+        std::array<uint32_t, BUCKETS + 1> bucketStart = {};
+        for (const auto& name : names) {
+            bucketStart[hash(name, 0) % BUCKETS + 1]++;
+        }
+        uint32_t largestBucket = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            largestBucket = std::max(largestBucket, bucketStart[i + 1]);
+            bucketStart[i + 1] += bucketStart[i];
+        }
+
+        std::array<uint32_t, N> bucketNames = {};
+        std::array<uint32_t, BUCKETS> bucketFill = {};
+        for (uint32_t i = 0; i < N; i++) {
+            uint32_t bucket = hash(names[i], 0) % BUCKETS;
+            bucketNames[bucketStart[bucket] + bucketFill[bucket]++] = i;
+        }
+
+        // place the largest buckets first while the table is still mostly empty
+        std::array<bool, N> slotUsed = {};
+        std::array<uint32_t, N> bucketSlots = {};
+        uint32_t nextFreeSlot = 0;
+        for (uint32_t bucketSize = largestBucket; bucketSize > 0; bucketSize--) {
+            for (uint32_t bucket = 0; bucket < BUCKETS; bucket++) {
+                if (bucketStart[bucket + 1] - bucketStart[bucket] != bucketSize)
+                    continue;
+
+                const uint32_t* members = &bucketNames[bucketStart[bucket]];
+                for (uint32_t i = 0; i < bucketSize; i++) {
+                    for (uint32_t j = i + 1; j < bucketSize; j++) {
+                        if (names[members[i]] == names[members[j]]) {
+                            throw "NameSet contains a duplicate name";
+                        }
+                    }
+                }
+
+                if (bucketSize == 1) {
+                    while (slotUsed[nextFreeSlot]) {
+                        nextFreeSlot++;
+                    }
+                    place(names, members[0], nextFreeSlot, slotUsed);
+                    m_displacements[bucket] = DIRECT_SLOT | nextFreeSlot;
+                    continue;
+                }
+
+                for (uint32_t seed = 1;; seed++) {
+                    if (seed > MAX_SEED) {
+                        throw "NameSet couldn't find a perfect hash for its names";
+                    }
+
+                    bool fits = true;
+                    for (uint32_t i = 0; i < bucketSize && fits; i++) {
+                        bucketSlots[i] = hash(names[members[i]], seed) % N;
+                        fits = !slotUsed[bucketSlots[i]];
+                        for (uint32_t j = 0; j < i && fits; j++) {
+                            fits = bucketSlots[j] != bucketSlots[i];
+                        }
+                    }
+
+                    if (fits) {
+                        for (uint32_t i = 0; i < bucketSize; i++) {
+                            place(names, members[i], bucketSlots[i], slotUsed);
+                        }
+                        m_displacements[bucket] = seed;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    constexpr int32_t find(std::string_view name) const {
+        const uint32_t displacement = m_displacements[hash(name, 0) % BUCKETS];
+        const uint32_t slot = (displacement & DIRECT_SLOT) ? (displacement & ~DIRECT_SLOT) : hash(name, displacement) % N;
+        return m_names[slot] == name ? (int32_t)m_indices[slot] : -1;
+    }
+
+    constexpr bool contains(std::string_view name) const {
+        return find(name) != -1;
+    }
+
+    static constexpr size_t size() { return N; }
+
+private:
+    static constexpr size_t BUCKETS = N / 2 + 1;
+    static constexpr uint32_t DIRECT_SLOT = 0x80000000;
+    static constexpr uint32_t MAX_SEED = 1 << 20;
+
+    // FNV-1a where the seed changes the offset basis
+    static constexpr uint32_t hash(std::string_view name, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ (seed * 0x9E3779B1u);
+        for (char c : name) {
+            hash ^= (uint8_t)c;
+            hash *= 16777619u;
+        }
+        return hash ^ (hash >> 15);
+    }
+
+    constexpr void place(const std::array<std::string_view, N>& names, size_t nameIdx, uint32_t slot, std::array<bool, N>& slotUsed) {
+        m_names[slot] = names[nameIdx];
+        m_indices[slot] = (uint16_t)nameIdx;
+        slotUsed[slot] = true;
+    }
+
+    std::array<std::string_view, N> m_names = {};
+    std::array<uint16_t, N> m_indices = {};
+    std::array<uint32_t, BUCKETS> m_displacements = {};
+};
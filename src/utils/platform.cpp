@@ -0,0 +1,213 @@
+#include "platform.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <intrin.h>
+
+namespace Platform {
+
+static HANDLE s_consoleHandle = NULL;
+static PVOID s_crashHandler = nullptr;
+static void (*s_onCrash)() = nullptr;
+
+void OpenConsole(const char* title) {
+    AllocConsole();
+    SetConsoleTitleA(title);
+    s_consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+}
+
+void CloseConsole() {
+    FreeConsole();
+    s_consoleHandle = NULL;
+}
+
+void WriteToConsole(const std::string& text) {
+    DWORD charsWritten = 0;
+    WriteConsoleA(s_consoleHandle, text.c_str(), (DWORD)text.size(), &charsWritten, NULL);
+#ifdef _DEBUG
+    OutputDebugStringA(text.c_str());
+#else
+    std::cout << text << std::flush;
+#endif
+}
+
+static LONG WINAPI HandleCrash(PEXCEPTION_POINTERS exceptionInfo) {
+    switch (exceptionInfo->ExceptionRecord->ExceptionCode) {
+        case EXCEPTION_ACCESS_VIOLATION:
+        case EXCEPTION_ILLEGAL_INSTRUCTION:
+        case EXCEPTION_INT_DIVIDE_BY_ZERO:
+        case EXCEPTION_PRIV_INSTRUCTION: {
+            if (s_onCrash != nullptr) {
+                s_onCrash();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void InstallCrashHandler(void (*onCrash)()) {
+    s_onCrash = onCrash;
+    s_crashHandler = AddVectoredExceptionHandler(0, &HandleCrash);
+}
+
+void RemoveCrashHandler() {
+    if (s_crashHandler != nullptr) {
+        RemoveVectoredExceptionHandler(s_crashHandler);
+        s_crashHandler = nullptr;
+    }
+}
+
+uint32_t GetCurrentThreadId() {
+    return (uint32_t)::GetCurrentThreadId();
+}
+
+void ShowFatalError(const char* message, const char* title) {
+    MessageBoxA(NULL, message, title, MB_OK | MB_ICONERROR);
+}
+
+void* AllocateVirtualMemory(size_t size) {
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void FreeVirtualMemory(void* memory, size_t size) {
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+void* GetProcessExport(const char* name) {
+    // the module handle of the executable doesn't have to be released
+    return (void*)GetProcAddress(GetModuleHandleA(NULL), name);
+}
+
+std::string GetCpuName() {
+    int cpuInfo[4] = {0, 0, 0, 0};
+    __cpuid(cpuInfo, 0x80000000);
+    const unsigned int maxExId = static_cast<unsigned int>(cpuInfo[0]);
+    if (maxExId < 0x80000004) {
+        return "";
+    }
+
+    char brand[49] = {};
+    __cpuid(reinterpret_cast<int*>(brand + 0), 0x80000002);
+    __cpuid(reinterpret_cast<int*>(brand + 16), 0x80000003);
+    __cpuid(reinterpret_cast<int*>(brand + 32), 0x80000004);
+    std::string cpuBrand = brand;
+    while (!cpuBrand.empty() && cpuBrand.front() == ' ') cpuBrand.erase(cpuBrand.begin());
+    while (!cpuBrand.empty() && cpuBrand.back() == ' ') cpuBrand.pop_back();
+    return cpuBrand;
+}
+
+uint64_t GetTotalMemory() {
+    MEMORYSTATUSEX statex{};
+    statex.dwLength = sizeof(statex);
+    if (!GlobalMemoryStatusEx(&statex)) {
+        return 0;
+    }
+    return statex.ullTotalPhys;
+}
+
+}
+
+#else
+#include <csignal>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Platform {
+
+static constexpr std::array CRASH_SIGNALS = { SIGSEGV, SIGILL, SIGFPE, SIGBUS };
+static std::array<struct sigaction, CRASH_SIGNALS.size()> s_previousActions;
+static bool s_crashHandlerInstalled = false;
+static void (*s_onCrash)() = nullptr;
+
+void OpenConsole(const char* title) {
+}
+
+void CloseConsole() {
+}
+
+void WriteToConsole(const std::string& text) {
+    std::cerr << text << std::flush;
+}
+
+static void HandleCrash(int signal) {
+    if (s_onCrash != nullptr) {
+        s_onCrash();
+    }
+    // SA_RESETHAND already restored the default action, so this crashes like it would have without the handler
+    std::raise(signal);
+}
+
+void InstallCrashHandler(void (*onCrash)()) {
+    s_onCrash = onCrash;
+
+    struct sigaction action = {};
+    action.sa_handler = &HandleCrash;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < CRASH_SIGNALS.size(); i++) {
+        sigaction(CRASH_SIGNALS[i], &action, &s_previousActions[i]);
+    }
+    s_crashHandlerInstalled = true;
+}
+
+void RemoveCrashHandler() {
+    if (!s_crashHandlerInstalled) {
+        return;
+    }
+    for (size_t i = 0; i < CRASH_SIGNALS.size(); i++) {
+        sigaction(CRASH_SIGNALS[i], &s_previousActions[i], nullptr);
+    }
+    s_crashHandlerInstalled = false;
+}
+
+uint32_t GetCurrentThreadId() {
+    return (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+void ShowFatalError(const char* message, const char* title) {
+}
+
+void* AllocateVirtualMemory(size_t size) {
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory != MAP_FAILED ? memory : nullptr;
+}
+
+void FreeVirtualMemory(void* memory, size_t size) {
+    munmap(memory, size);
+}
+
+void* GetProcessExport(const char* name) {
+    return dlsym(RTLD_DEFAULT, name);
+}
+
+std::string GetCpuName() {
+    std::ifstream cpuInfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuInfo, line)) {
+        if (line.starts_with("model name")) {
+            const size_t separator = line.find(':');
+            if (separator != std::string::npos && separator + 2 <= line.size()) {
+                return line.substr(separator + 2);
+            }
+        }
+    }
+    return "";
+}
+
+uint64_t GetTotalMemory() {
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return 0;
+    }
+    return (uint64_t)pages * (uint64_t)pageSize;
+}
+
+}
+#endif
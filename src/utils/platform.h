@@ -0,0 +1,43 @@
+#pragma once
+
+// The few things the logger and the other portable code need from the OS, implemented for Windows and POSIX in platform.cpp.
+// Anything else that's portable already goes through the standard library, like std::chrono for clocks and std::thread for threads.
+namespace Platform {
+
+// the console window that the log is written to, which only the layer opens
+void OpenConsole(const char* title);
+void CloseConsole();
+void WriteToConsole(const std::string& text);
+
+// calls onCrash when the process crashes from an access violation or similar, before the default crash handling runs
+void InstallCrashHandler(void (*onCrash)());
+void RemoveCrashHandler();
+
+uint32_t GetCurrentThreadId();
+
+// the TSC is much cheaper to read than std::chrono::steady_clock, but its rate has to be measured to convert it to a time
+inline uint64_t ReadTimestampCounter() {
+    return __rdtsc();
+}
+
+// shows a message box on Windows, everywhere else the message was already logged
+void ShowFatalError(const char* message, const char* title);
+
+inline void BreakIntoDebugger() {
+#if defined(_DEBUG) && defined(_WIN32)
+    __debugbreak();
+#endif
+}
+
+// reserves size bytes of zero-initialized, readable and writable memory that only takes up physical memory once it's touched
+void* AllocateVirtualMemory(size_t size);
+void FreeVirtualMemory(void* memory, size_t size);
+
+// looks up a function that the executable the process was started from exports, returns nullptr if it doesn't export it
+void* GetProcessExport(const char* name);
+
+std::string GetCpuName();
+// returns 0 if the amount of memory couldn't be determined
+uint64_t GetTotalMemory();
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// A rotation followed by a translation, which is what almost every transform in the hooks is (cameras, headset, controllers, bones).
+// Composing and inverting these only needs quaternion math, while a glm::mat4 inverse has to solve the general 4x4 case.
+// Only use this for transforms without scale or shear.
+struct RigidPose {
+    glm::fquat rotation = glm::identity<glm::fquat>();
+    glm::fvec3 position = glm::fvec3(0.0f);
+
+    RigidPose() = default;
+    RigidPose(const glm::fquat& rotation, const glm::fvec3& position) : rotation(rotation), position(position) {}
+
+    explicit RigidPose(const glm::fmat4& mtx) : rotation(glm::quat_cast(glm::fmat3(mtx))), position(mtx[3]) {}
+    explicit RigidPose(const glm::fmat4x3& mtx) : rotation(glm::quat_cast(glm::fmat3(mtx))), position(mtx[3]) {}
+
+    static RigidPose FromPosition(const glm::fvec3& position) { return { glm::identity<glm::fquat>(), position }; }
+    static RigidPose FromRotation(const glm::fquat& rotation) { return { rotation, glm::fvec3(0.0f) }; }
+
+    RigidPose operator*(const RigidPose& other) const {
+        return { rotation * other.rotation, position + rotation * other.position };
+    }
+
+    // the rotation is unit length, so inverting it is just its conjugate
+    RigidPose Inverse() const {
+        const glm::fquat invRotation = glm::conjugate(rotation);
+        return { invRotation, invRotation * -position };
+    }
+
+    glm::fvec3 TransformPoint(const glm::fvec3& point) const { return position + rotation * point; }
+    glm::fvec3 TransformDirection(const glm::fvec3& direction) const { return rotation * direction; }
+
+    glm::fmat4 ToMatrix() const {
+        glm::fmat4 mtx = glm::mat4_cast(rotation);
+        mtx[3] = glm::fvec4(position, 1.0f);
+        return mtx;
+    }
+
+    glm::fmat4x3 ToMatrix34() const {
+        return glm::fmat4x3(ToMatrix());
+    }
+
+    static RigidPose Slerp(const RigidPose& a, const RigidPose& b, float t) {
+        return { glm::slerp(a.rotation, b.rotation, t), glm::mix(a.position, b.position, t) };
+    }
+};
+
+// inverts a matrix that only holds a rotation and translation, by transposing the rotation and rotating the negated translation
+inline glm::fmat4 InverseRigid(const glm::fmat4& mtx) {
+    const glm::fmat3 invRotation = glm::transpose(glm::fmat3(mtx));
+    glm::fmat4 result = glm::fmat4(invRotation);
+    result[3] = glm::fvec4(invRotation * -glm::fvec3(mtx[3]), 1.0f);
+    return result;
+}
+
+// splits a rotation into a twist around the given (normalized) axis and the remaining swing, so that q = swing * twist
+inline std::pair<glm::fquat, glm::fquat> SwingTwist(const glm::fquat& q, const glm::fvec3& axis) {
+    const glm::fvec3 proj = axis * glm::dot(glm::fvec3(q.x, q.y, q.z), axis);
+    glm::fquat twist = glm::fquat(q.w, proj.x, proj.y, proj.z);
+
+    // the twist is undefined when the rotation is a half turn around an axis perpendicular to the twist axis
+    const float lenSq = glm::dot(twist, twist);
+    twist = lenSq > 0.000001f ? twist * (1.0f / sqrtf(lenSq)) : glm::identity<glm::fquat>();
+
+    return { q * glm::conjugate(twist), twist };
+}
+
+inline std::pair<glm::fquat, glm::fquat> SwingTwistY(const glm::fquat& q) {
+    return SwingTwist(q, glm::fvec3(0.0f, 1.0f, 0.0f));
+}
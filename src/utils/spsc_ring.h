@@ -0,0 +1,46 @@
+#pragma once
+
+// Fixed-size lock-free queue for exactly one producer thread and one consumer thread.
+// The indices only ever increase, and the capacity is a power of two so they can be wrapped with a mask.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity has to be a power of two");
+
+public:
+    // returns false if the ring is full
+    bool TryPush(const T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        m_items[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns false if the ring is empty
+    bool TryPop(T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = m_items[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+    // has to be called from the producer thread, otherwise the tail could already be past the head that was read
+    size_t GetSize() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    // the indices are on separate cache lines so that the two threads don't invalidate each other's line on every push and pop
+    alignas(64) std::atomic_size_t m_head = 0;
+    alignas(64) std::atomic_size_t m_tail = 0;
+    alignas(64) std::array<T, Capacity> m_items = {};
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+// Windows over samples that arrive at irregular times, so that a window covers the same duration at any input rate.
+// Pushing a sample is O(1) amortized, since every sample is only added and removed once.
+
+// Keeps the samples of the last `duration` nanoseconds, plus the newest sample that's older than that,
+// so that the window spans the full duration as soon as enough samples are available.
+template <typename T>
+class TimeWindow {
+public:
+    struct Sample {
+        XrTime time;
+        T value;
+    };
+
+    explicit TimeWindow(XrTime duration) : m_duration(duration) {}
+
+    void Push(XrTime time, const T& value) {
+        while (m_samples.size() >= 2 && time - m_samples[1].time >= m_duration) {
+            m_samples.pop_front();
+        }
+        m_samples.push_back({ time, value });
+    }
+
+    void Clear() { m_samples.clear(); }
+
+    bool IsEmpty() const { return m_samples.empty(); }
+    const Sample& Front() const { return m_samples.front(); }
+    const Sample& Back() const { return m_samples.back(); }
+
+    // time between the oldest and newest sample, in seconds
+    float GetSpan() const {
+        return m_samples.empty() ? 0.0f : (float)(m_samples.back().time - m_samples.front().time) / 1000000000.0f;
+    }
+
+    // rate of change per second between the start of the window and the newest sample, or zero if there's only one sample
+    T GetDerivative() const {
+        const float span = GetSpan();
+        if (span <= 0.0f) {
+            return T(0);
+        }
+        return (m_samples.back().value - m_samples.front().value) / span;
+    }
+
+private:
+    XrTime m_duration;
+    std::deque<Sample> m_samples;
+};
+
+// The extreme value of the samples from the last `duration` nanoseconds.
+// The deque is kept sorted by Compare, so values that can never become the extreme again are dropped right away.
+template <typename T, typename Compare>
+class MonotonicWindow {
+public:
+    explicit MonotonicWindow(XrTime duration) : m_duration(duration) {}
+
+    void Push(XrTime time, const T& value) {
+        while (!m_samples.empty() && !m_compare(m_samples.back().second, value)) {
+            m_samples.pop_back();
+        }
+        m_samples.emplace_back(time, value);
+        while (time - m_samples.front().first > m_duration) {
+            m_samples.pop_front();
+        }
+    }
+
+    void Clear() { m_samples.clear(); }
+
+    bool IsEmpty() const { return m_samples.empty(); }
+    const T& Get() const { return m_samples.front().second; }
+
+private:
+    XrTime m_duration;
+    Compare m_compare;
+    std::deque<std::pair<XrTime, T>> m_samples;
+};
+
+template <typename T>
+using WindowedMax = MonotonicWindow<T, std::greater<T>>;
+
+template <typename T>
+using WindowedMin = MonotonicWindow<T, std::less<T>>;
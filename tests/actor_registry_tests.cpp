@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include "hooking/actor_registry.h"
+
+// runs one pass of the game over its actor list, like hook_UpdateActorList does for every entry
+static void RunPass(ActorRegistry& registry, std::initializer_list<std::pair<uint32_t, const char*>> actors) {
+    registry.BeginPass();
+    for (const auto& [ptr, name] : actors) {
+        registry.Touch(ptr, name);
+    }
+    registry.EndPass();
+}
+
+// runs one pass the way the game calls hook_UpdateActorList, with the index and size of its list for every entry
+static void RunHookPass(ActorRegistry& registry, std::initializer_list<std::pair<uint32_t, const char*>> entries) {
+    uint32_t index = 0;
+    for (const auto& [ptr, name] : entries) {
+        registry.VisitListEntry(index++, (uint32_t)entries.size(), ptr, name);
+    }
+}
+
+TEST(ActorRegistryTest, TouchReturnsTheSameActorForTheSamePointer) {
+    ActorRegistry registry;
+    registry.BeginPass();
+    const ActorRegistry::Actor& player = registry.Touch(0x1000, "GameROMPlayer");
+    EXPECT_EQ(player.id, 0x1000 + stringToHash("GameROMPlayer"));
+    EXPECT_EQ(player.type, ActorClass::PLAYER);
+    EXPECT_EQ(registry.GetName(player.nameId), "GameROMPlayer");
+
+    registry.Touch(0x1000, "GameROMPlayer");
+    EXPECT_EQ(registry.GetCount(), 1u);
+    registry.EndPass();
+    ASSERT_NE(registry.Find(0x1000), nullptr);
+    EXPECT_EQ(registry.Find(0x2000), nullptr);
+}
+
+TEST(ActorRegistryTest, EndPassRemovesActorsWithoutAnyConsumer) {
+    ActorRegistry registry;
+    RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" }, { 0x3000, "Npc_Kakariko001" } });
+    EXPECT_EQ(registry.GetCount(), 3u);
+    EXPECT_EQ(registry.GetNameCount(), 3u);
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" } });
+    EXPECT_EQ(registry.GetCount(), 1u);
+    EXPECT_EQ(registry.GetNameCount(), 1u);
+    EXPECT_EQ(registry.Find(0x2000), nullptr);
+    EXPECT_EQ(registry.Find(0x3000), nullptr);
+}
+
+TEST(ActorRegistryTest, MemoryStaysBoundedWhileActorsComeAndGo) {
+    ActorRegistry registry;
+    for (uint32_t pass = 0; pass < 1000; pass++) {
+        registry.BeginPass();
+        registry.Touch(0x1000, "GameROMPlayer");
+        // every pass spawns an actor at a new address with a new name, while the previous one despawns
+        const std::string name = "Obj_Spawned_" + std::to_string(pass);
+        registry.Touch(0x10000 + pass * 0x10, name.c_str());
+        registry.EndPass();
+
+        ASSERT_EQ(registry.GetCount(), 2u);
+        ASSERT_EQ(registry.GetNameCount(), 2u);
+    }
+}
+
+TEST(ActorRegistryTest, UnfinishedPassIsEndedByTheNextOne) {
+    ActorRegistry registry;
+    RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" } });
+
+    // the list got shorter while it was iterated, so the last index was never reached
+    registry.BeginPass();
+    registry.Touch(0x1000, "GameROMPlayer");
+    registry.BeginPass();
+    registry.Touch(0x1000, "GameROMPlayer");
+    registry.EndPass();
+
+    EXPECT_EQ(registry.GetCount(), 1u);
+    EXPECT_EQ(registry.Find(0x2000), nullptr);
+}
+
+TEST(ActorRegistryTest, DiffOnlyReportsRealChanges) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" } });
+    registry.CollectDiff(diff);
+    EXPECT_EQ(diff.added.size(), 2u);
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_TRUE(diff.updated.empty());
+
+    // the same actors in every pass aren't a change
+    for (int i = 0; i < 10; i++) {
+        RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" } });
+    }
+    registry.CollectDiff(diff);
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_TRUE(diff.updated.empty());
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" } });
+    registry.CollectDiff(diff);
+    EXPECT_TRUE(diff.added.empty());
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0].id, 0x2000 + stringToHash("Enemy_Bokoblin_Junior"));
+    EXPECT_EQ(diff.removed[0].name, "Enemy_Bokoblin_Junior");
+    EXPECT_TRUE(diff.updated.empty());
+}
+
+TEST(ActorRegistryTest, DiffReportsActorsReplacedAtTheSameAddressAsUpdated) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunPass(registry, { { 0x2000, "Enemy_Bokoblin_Junior" } });
+    registry.CollectDiff(diff);
+
+    RunPass(registry, { { 0x2000, "Weapon_Sword_001" } });
+    // the consumer still knows the actor by its old name until it has applied the diff that reports the new one
+    EXPECT_EQ(registry.GetNameCount(), 2u);
+    registry.CollectDiff(diff);
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_TRUE(diff.removed.empty());
+    ASSERT_EQ(diff.updated.size(), 1u);
+    EXPECT_EQ(diff.updated[0].id, 0x2000 + stringToHash("Weapon_Sword_001"));
+    EXPECT_EQ(diff.updated[0].previousId, 0x2000 + stringToHash("Enemy_Bokoblin_Junior"));
+    EXPECT_EQ(diff.updated[0].type, ActorClass::WEAPON);
+
+    registry.CollectDiff(diff);
+    EXPECT_EQ(registry.GetNameCount(), 1u);
+}
+
+TEST(ActorRegistryTest, NamesOfRemovedActorsStayValidUntilTheNextDiff) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" } });
+    registry.CollectDiff(diff);
+    std::string_view removedName;
+    for (const auto& actor : diff.added) {
+        if (actor.ptr == 0x2000) {
+            removedName = actor.name;
+        }
+    }
+
+    // the game keeps spawning actors with new names after the consumer's actor was removed
+    RunPass(registry, { { 0x1000, "GameROMPlayer" } });
+    for (uint32_t i = 0; i < 100; i++) {
+        const std::string name = "Obj_Spawned_" + std::to_string(i);
+        RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x3000 + i * 0x10, name.c_str() } });
+    }
+    EXPECT_EQ(removedName, "Enemy_Bokoblin_Junior");
+
+    registry.CollectDiff(diff);
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0].name, "Enemy_Bokoblin_Junior");
+    EXPECT_EQ(removedName, "Enemy_Bokoblin_Junior");
+    EXPECT_EQ(registry.GetNameCount(), 3u);
+
+    registry.CollectDiff(diff);
+    EXPECT_EQ(registry.GetNameCount(), 2u);
+}
+
+TEST(ActorRegistryTest, HookPassesKeepTheLastActorOfTheList) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunHookPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" }, { 0x3000, "Npc_Kakariko001" } });
+    registry.CollectDiff(diff);
+    EXPECT_EQ(diff.added.size(), 3u);
+
+    // the last entry is touched before the pass ends, so it's never pruned and re-added
+    for (int i = 0; i < 10; i++) {
+        RunHookPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" }, { 0x3000, "Npc_Kakariko001" } });
+        ASSERT_NE(registry.Find(0x3000), nullptr);
+        registry.CollectDiff(diff);
+        EXPECT_TRUE(diff.added.empty()) << "pass " << i;
+        EXPECT_TRUE(diff.removed.empty()) << "pass " << i;
+        EXPECT_TRUE(diff.updated.empty()) << "pass " << i;
+    }
+    EXPECT_EQ(registry.GetCount(), 3u);
+}
+
+TEST(ActorRegistryTest, HookPassIsEndedByALastEntryWithoutAName) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunHookPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x2000, "Enemy_Bokoblin_Junior" } });
+    registry.CollectDiff(diff);
+
+    // entries without a name are skipped, but the last one still ends the pass and removes the actors it didn't see
+    RunHookPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x4000, nullptr } });
+    EXPECT_EQ(registry.GetCount(), 1u);
+    EXPECT_EQ(registry.Find(0x2000), nullptr);
+    EXPECT_EQ(registry.Find(0x4000), nullptr);
+
+    RunHookPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x4000, "" } });
+    registry.CollectDiff(diff);
+    EXPECT_TRUE(diff.added.empty());
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0].ptr, 0x2000u);
+    EXPECT_EQ(registry.GetCount(), 1u);
+}
+
+TEST(ActorRegistryTest, VisitListEntryReturnsTheActorAfterThePassMovedIt) {
+    ActorRegistry registry;
+    constexpr uint32_t ACTOR_COUNT = 600;
+
+    registry.BeginPass();
+    for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+        registry.Touch(0x10000000 + i * 0x400, "Obj_Grass");
+    }
+    registry.EndPass();
+
+    // the last entry's pass erases most actors, which can shift the last actor into another slot
+    const ActorRegistry::Actor* last = registry.VisitListEntry(0, 1, 0x10000000 + (ACTOR_COUNT - 1) * 0x400, "Obj_Grass");
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(last, registry.Find(0x10000000 + (ACTOR_COUNT - 1) * 0x400));
+    EXPECT_EQ(last->ptr, 0x10000000 + (ACTOR_COUNT - 1) * 0x400);
+    EXPECT_EQ(registry.GetCount(), 1u);
+}
+
+TEST(ActorRegistryTest, ActorsThatComeAndGoBetweenDiffsAreNeverReported) {
+    ActorRegistry registry;
+    ActorRegistry::Diff diff;
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" } });
+    registry.CollectDiff(diff);
+
+    RunPass(registry, { { 0x1000, "GameROMPlayer" }, { 0x3000, "Obj_Arrow" } });
+    RunPass(registry, { { 0x1000, "GameROMPlayer" } });
+    registry.CollectDiff(diff);
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_TRUE(diff.removed.empty());
+    EXPECT_TRUE(diff.updated.empty());
+}
+
+TEST(ActorRegistryTest, GrowKeepsEveryActor) {
+    ActorRegistry registry;
+    constexpr uint32_t ACTOR_COUNT = 5000;
+
+    registry.BeginPass();
+    for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+        registry.Touch(0x10000000 + i * 0x400, "Obj_Grass");
+    }
+    registry.EndPass();
+    EXPECT_EQ(registry.GetCount(), ACTOR_COUNT);
+    EXPECT_EQ(registry.GetNameCount(), 1u);
+
+    // drop every other actor, which shifts the remaining ones around in the table
+    registry.BeginPass();
+    for (uint32_t i = 0; i < ACTOR_COUNT; i += 2) {
+        registry.Touch(0x10000000 + i * 0x400, "Obj_Grass");
+    }
+    registry.EndPass();
+    EXPECT_EQ(registry.GetCount(), ACTOR_COUNT / 2);
+    for (uint32_t i = 0; i < ACTOR_COUNT; i++) {
+        EXPECT_EQ(registry.Find(0x10000000 + i * 0x400) != nullptr, i % 2 == 0) << "actor " << i;
+    }
+
+    uint32_t visited = 0;
+    registry.ForEachActor([&](const ActorRegistry::Actor&) { visited++; });
+    EXPECT_EQ(visited, ACTOR_COUNT / 2);
+}
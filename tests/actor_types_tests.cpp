@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "hooking/actor_types.h"
+
+TEST(ActorTypesTest, ClassifiesActorNames) {
+    EXPECT_EQ(ClassifyActorName("GameROMPlayer"), ActorClass::PLAYER);
+    EXPECT_EQ(ClassifyActorName("GameRomCamera"), ActorClass::CAMERA);
+    EXPECT_EQ(ClassifyActorName("Weapon_Sword_001"), ActorClass::WEAPON);
+    EXPECT_EQ(ClassifyActorName("Npc_HatenoGate001"), ActorClass::NPC);
+    EXPECT_EQ(ClassifyActorName("Enemy_Bokoblin_Junior"), ActorClass::ENEMY);
+    EXPECT_EQ(ClassifyActorName("Obj_TreeApple_A_01"), ActorClass::OTHER);
+    EXPECT_EQ(ClassifyActorName(""), ActorClass::OTHER);
+}
+
+TEST(ActorTypeCacheTest, RemembersTheFirstClassOfAVtable) {
+    ActorTypeCache cache;
+    EXPECT_EQ(cache.Find(0x10203040), ActorClass::UNKNOWN);
+
+    cache.Observe(0x10203040, ActorClass::ENEMY);
+    cache.Observe(0x10203040, ActorClass::ENEMY);
+    EXPECT_EQ(cache.Find(0x10203040), ActorClass::ENEMY);
+    EXPECT_EQ(cache.Find(0x10203044), ActorClass::UNKNOWN);
+
+    // null vtables and unknown classes are never stored
+    cache.Observe(0, ActorClass::PLAYER);
+    cache.Observe(0x10203048, ActorClass::UNKNOWN);
+    EXPECT_EQ(cache.Find(0), ActorClass::UNKNOWN);
+    EXPECT_EQ(cache.Find(0x10203048), ActorClass::UNKNOWN);
+}
+
+TEST(ActorTypeCacheTest, SharedVtablesFallBackToNames) {
+    ActorTypeCache cache;
+    cache.Observe(0x10203040, ActorClass::NPC);
+    cache.Observe(0x10203040, ActorClass::OTHER);
+    EXPECT_EQ(cache.Find(0x10203040), ActorClass::MIXED);
+
+    // a vtable stays mixed once it's been seen with two classes
+    cache.Observe(0x10203040, ActorClass::NPC);
+    EXPECT_EQ(cache.Find(0x10203040), ActorClass::MIXED);
+}
+
+TEST(ActorTypeCacheTest, FindsEveryVtableWhenManyCollide) {
+    // vtables that are close together, which is how they're laid out in the game's memory
+    ActorTypeCache cache;
+    constexpr uint32_t VTABLE_COUNT = 800;
+    for (uint32_t i = 0; i < VTABLE_COUNT; i++) {
+        cache.Observe(0x10000000 + i * 4, (ActorClass)(1 + i % 6));
+    }
+    for (uint32_t i = 0; i < VTABLE_COUNT; i++) {
+        ASSERT_EQ(cache.Find(0x10000000 + i * 4), (ActorClass)(1 + i % 6)) << i;
+    }
+    EXPECT_EQ(cache.Find(0x10000000 + VTABLE_COUNT * 4), ActorClass::UNKNOWN);
+}
+
+TEST(ActorTypeCacheTest, ThreadsObservingTheSameVtablesAgree) {
+    ActorTypeCache cache;
+    constexpr uint32_t VTABLE_COUNT = 200;
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&cache] {
+            for (uint32_t i = 0; i < VTABLE_COUNT; i++) {
+                cache.Observe(0x20000000 + i * 8, (ActorClass)(1 + i % 6));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // every vtable was inserted once, and none of them was mistaken for a shared one
+    for (uint32_t i = 0; i < VTABLE_COUNT; i++) {
+        ASSERT_EQ(cache.Find(0x20000000 + i * 8), (ActorClass)(1 + i % 6)) << i;
+    }
+}
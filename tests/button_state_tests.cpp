@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "utils/button_state.h"
+
+using namespace std::chrono_literals;
+
+// feeds the button state one sample every 10 ms, like the input updates while the game runs at a steady rate
+class ButtonStateTest : public testing::Test {
+protected:
+    ButtonState::Event Sample(bool down, std::chrono::milliseconds duration = 10ms) {
+        ButtonState::Event event = ButtonState::Event::None;
+        for (auto end = m_now + duration; m_now < end; m_now += 10ms) {
+            m_state.Update(down, m_now);
+            if (m_state.lastEvent != ButtonState::Event::None) {
+                event = m_state.lastEvent;
+            }
+        }
+        return event;
+    }
+
+    ButtonState m_state;
+    std::chrono::steady_clock::time_point m_now = std::chrono::steady_clock::time_point(1h);
+};
+
+TEST_F(ButtonStateTest, NothingHappensWhileReleased) {
+    EXPECT_EQ(Sample(false, 1s), ButtonState::Event::None);
+}
+
+TEST_F(ButtonStateTest, ShortPressFiresAfterTheDoublePressWindow) {
+    EXPECT_EQ(Sample(true, 100ms), ButtonState::Event::None);
+    EXPECT_EQ(Sample(false, ButtonState::DOUBLE_PRESS_WINDOW), ButtonState::Event::None);
+    EXPECT_EQ(Sample(false, 20ms), ButtonState::Event::ShortPress);
+    EXPECT_EQ(Sample(false, 1s), ButtonState::Event::None);
+}
+
+TEST_F(ButtonStateTest, LongPressFiresWhileHeld) {
+    EXPECT_EQ(Sample(true, ButtonState::LONG_PRESS_THRESHOLD), ButtonState::Event::None);
+    EXPECT_EQ(Sample(true), ButtonState::Event::LongPress);
+    EXPECT_EQ(Sample(true), ButtonState::Event::LongPress);
+}
+
+TEST_F(ButtonStateTest, SecondPressWithinTheWindowIsADoublePress) {
+    EXPECT_EQ(Sample(true, 50ms), ButtonState::Event::None);
+    EXPECT_EQ(Sample(false, 50ms), ButtonState::Event::None);
+    EXPECT_EQ(Sample(true), ButtonState::Event::DoublePress);
+    EXPECT_EQ(Sample(true, 50ms), ButtonState::Event::None);
+    EXPECT_EQ(Sample(false, 1s), ButtonState::Event::None);
+}
+
+TEST_F(ButtonStateTest, ResetForgetsAPendingPress) {
+    Sample(true, 50ms);
+    Sample(false);
+    m_state.resetButtonState();
+    EXPECT_EQ(Sample(false, 1s), ButtonState::Event::None);
+}
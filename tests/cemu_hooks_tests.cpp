@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "hooking/offline_hooks.h"
+
+// the hooks only read an actor's vtable and the pointer to its name, the vtables are made up so that every actor has its own
+static uint32_t AllocateActor(GuestArena& arena, uint32_t vtable, std::string_view name) {
+    ActorWiiU actor = {};
+    actor.vtable = vtable;
+    actor.name.c_str = arena.AllocateString(name);
+    return arena.AllocateValue(actor);
+}
+
+static PPCInterpreter_t RouteActorJob(const OfflineHooks& hooks, uint32_t actorPtr, uint32_t jobNamePtr, uint32_t side) {
+    PPCInterpreter_t hCPU = {};
+    hCPU.gpr[3] = actorPtr;
+    hCPU.gpr[4] = jobNamePtr;
+    hCPU.gpr[5] = side;
+    hooks.Call("hook_RouteActorJob", hCPU);
+    return hCPU;
+}
+
+TEST(CemuHooksTest, RoutesThePlayerJobsToOneSide) {
+    OfflineHooks hooks;
+    GuestArena& arena = hooks.GetArena();
+    const uint32_t player = AllocateActor(arena, 0x10000100, "GameROMPlayer");
+    const uint32_t climbJob = arena.AllocateString("job0_1");
+    const uint32_t ragdollJob = arena.AllocateString("job2_1_ragdoll_related");
+
+    // 2 runs the altered (climbing only) version of the job, 1 skips it and 0 runs it like the game would
+    EXPECT_EQ(RouteActorJob(hooks, player, climbJob, 0).gpr[3], 2u);
+    EXPECT_EQ(RouteActorJob(hooks, player, climbJob, 1).gpr[3], 0u);
+    EXPECT_EQ(RouteActorJob(hooks, player, ragdollJob, 0).gpr[3], 0u);
+    EXPECT_EQ(RouteActorJob(hooks, player, ragdollJob, 1).gpr[3], 1u);
+}
+
+TEST(CemuHooksTest, RoutesOtherActorJobsToOneSide) {
+    OfflineHooks hooks;
+    GuestArena& arena = hooks.GetArena();
+    const uint32_t enemy = AllocateActor(arena, 0x10000200, "Enemy_Bokoblin_Junior");
+    const uint32_t climbJob = arena.AllocateString("job0_1");
+    const uint32_t job = arena.AllocateString("job4");
+    const uint32_t unknownJob = arena.AllocateString("job3");
+
+    EXPECT_EQ(RouteActorJob(hooks, enemy, climbJob, 0).gpr[3], 1u);
+    EXPECT_EQ(RouteActorJob(hooks, enemy, climbJob, 1).gpr[3], 0u);
+    EXPECT_EQ(RouteActorJob(hooks, enemy, job, 1).gpr[3], 1u);
+    EXPECT_EQ(RouteActorJob(hooks, enemy, unknownJob, 0).gpr[3], 0u);
+    EXPECT_EQ(RouteActorJob(hooks, enemy, unknownJob, 1).gpr[3], 0u);
+}
+
+TEST(CemuHooksTest, ActorListUpdatesReachTheRegistry) {
+    OfflineHooks hooks;
+    GuestArena& arena = hooks.GetArena();
+    const std::array actors = {
+        AllocateActor(arena, 0x10000300, "GameROMPlayer"),
+        AllocateActor(arena, 0x10000400, "GameRomCamera"),
+        AllocateActor(arena, 0x10000500, ""),
+    };
+
+    // clears what the previous tests left in the registry
+    ActorRegistry::Diff diff;
+    CemuHooks::CollectActorDiff(diff);
+
+    for (uint32_t i = 0; i < actors.size(); i++) {
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[5] = i;
+        hCPU.gpr[6] = actors[i];
+        hCPU.gpr[7] = (uint32_t)actors.size();
+        hooks.Call("hook_UpdateActorList", hCPU);
+    }
+
+    CemuHooks::CollectActorDiff(diff);
+    ASSERT_EQ(diff.added.size(), 2u);
+    EXPECT_TRUE(diff.removed.empty());
+    std::ranges::sort(diff.added, {}, &ActorRegistry::Change::ptr);
+    EXPECT_EQ(diff.added[0].ptr, actors[0]);
+    EXPECT_EQ(diff.added[0].type, ActorClass::PLAYER);
+    EXPECT_EQ(diff.added[1].ptr, actors[1]);
+    EXPECT_EQ(diff.added[1].type, ActorClass::CAMERA);
+    EXPECT_EQ(CemuHooks::GetActorClass(actors[0]), ActorClass::PLAYER);
+}
+
+TEST(CemuHooksTest, CaptureContainsEveryPageThatAHookReads) {
+    OfflineHooks hooks;
+    GuestArena& arena = hooks.GetArena();
+    // the job name is on its own page, so that it's only captured if the hook reads it through the memory helpers
+    const uint32_t player = AllocateActor(arena, 0x10000600, "GameROMPlayer");
+    const uint32_t jobName = arena.Allocate(HookCapture::PAGE_SIZE, HookCapture::PAGE_SIZE);
+    arena.WriteString(jobName, "job0_1");
+
+    const auto captureStart = std::filesystem::file_time_type::clock::now();
+    ASSERT_TRUE(HookCapture::Start(1));
+    RouteActorJob(hooks, player, jobName, 0);
+    HookCapture::EndFrame();
+    ASSERT_FALSE(HookCapture::IsCapturing());
+
+    std::optional<std::filesystem::path> capturePath;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path())) {
+        if (entry.path().extension() == HookCapture::FILE_EXTENSION && entry.last_write_time() >= captureStart - std::chrono::seconds(1)) {
+            capturePath = entry.path();
+        }
+    }
+    ASSERT_TRUE(capturePath.has_value());
+
+    std::ifstream file(capturePath.value(), std::ios::binary);
+    HookCapture::Header header;
+    HookCapture::RecordType type;
+    ASSERT_TRUE(file.read(reinterpret_cast<char*>(&header), sizeof(header)));
+
+    std::set<uint32_t> pages;
+    while (file.read(reinterpret_cast<char*>(&type), sizeof(type))) {
+        if (type == HookCapture::RecordType::HOOK) {
+            uint32_t hookId;
+            uint16_t nameLength;
+            file.read(reinterpret_cast<char*>(&hookId), sizeof(hookId));
+            file.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+            file.ignore(nameLength);
+        }
+        else if (type == HookCapture::RecordType::XR_STATE) {
+            uint32_t inputSize;
+            file.read(reinterpret_cast<char*>(&inputSize), sizeof(inputSize));
+            file.ignore(inputSize + sizeof(uint8_t) + sizeof(std::array<XrView, 2>));
+        }
+        else if (type == HookCapture::RecordType::CALL) {
+            HookCapture::CallHeader call;
+            file.read(reinterpret_cast<char*>(&call), sizeof(call));
+            EXPECT_EQ(call.writeCount, 0u);
+            EXPECT_EQ(call.after.gpr[3], 2u);
+            for (uint32_t i = 0; i < call.pageCount; i++) {
+                uint32_t address;
+                uint8_t stored;
+                file.read(reinterpret_cast<char*>(&address), sizeof(address));
+                file.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+                file.ignore(stored != 0 ? HookCapture::PAGE_SIZE : 0);
+                pages.emplace(address);
+            }
+        }
+        else if (type == HookCapture::RecordType::FRAME) {
+            file.ignore(sizeof(uint32_t));
+        }
+    }
+    file.close();
+    std::filesystem::remove(capturePath.value());
+
+    EXPECT_TRUE(pages.contains(jobName));
+    EXPECT_TRUE(pages.contains((player + offsetof(ActorWiiU, vtable)) & ~(HookCapture::PAGE_SIZE - 1)));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "hooking/cutscene_settings.h"
+
+TEST(CutsceneSettingsTest, ParsesEveryFlag) {
+    HybridEventSettings settings = {};
+    std::vector<std::string_view> unknownFlags;
+    const std::string_view eventName = CutsceneSettings::ParseEntry("SomeEvent,FP_ON,PAN_OFF,HND_OFF,CTRL_OFF", settings, [&](std::string_view flag) { unknownFlags.emplace_back(flag); });
+
+    EXPECT_EQ(eventName, "SomeEvent");
+    EXPECT_TRUE(unknownFlags.empty());
+    EXPECT_EQ(settings, (HybridEventSettings{ .firstPerson = true, .disablePlayerDrivenLinkHands = true, .ignoreCameraRotation = true, .demoEnableCameraInput = true }));
+
+    CutsceneSettings::ParseEntry("SomeEvent,FP_OFF,PAN_ON,HND_ON,CTRL_ON", settings, [&](std::string_view flag) { unknownFlags.emplace_back(flag); });
+    EXPECT_EQ(settings, (HybridEventSettings{ .firstPerson = false, .disablePlayerDrivenLinkHands = false, .ignoreCameraRotation = false, .demoEnableCameraInput = false }));
+}
+
+TEST(CutsceneSettingsTest, ReportsUnknownFlags) {
+    HybridEventSettings settings = {};
+    std::vector<std::string_view> unknownFlags;
+    CutsceneSettings::ParseEntry("SomeEvent,FP_ON,FP_MAYBE,,PAN_OFF", settings, [&](std::string_view flag) { unknownFlags.emplace_back(flag); });
+
+    EXPECT_EQ(unknownFlags, (std::vector<std::string_view>{ "FP_MAYBE", "" }));
+    EXPECT_TRUE(settings.firstPerson);
+    EXPECT_TRUE(settings.ignoreCameraRotation);
+}
+
+TEST(CutsceneSettingsTest, EntryWithoutFlagsUsesTheDefaults) {
+    HybridEventSettings settings = { .firstPerson = true };
+    EXPECT_EQ(CutsceneSettings::ParseEntry("SomeEvent", settings, [](std::string_view) { ADD_FAILURE(); }), "SomeEvent");
+    EXPECT_EQ(settings, HybridEventSettings{});
+}
+
+TEST(CutsceneSettingsTest, FindsEventsOfTheCompiledTable) {
+    ASSERT_GT(CutsceneSettings::ENTRY_COUNT, 0u);
+
+    const auto settings = CutsceneSettings::FindDefault("AncientBall_Kakariko");
+    ASSERT_TRUE(settings.has_value());
+    EXPECT_TRUE(settings->firstPerson);
+    EXPECT_TRUE(settings->ignoreCameraRotation);
+    EXPECT_TRUE(settings->disablePlayerDrivenLinkHands);
+
+    EXPECT_FALSE(CutsceneSettings::FindDefault("NotAnEvent").has_value());
+    EXPECT_FALSE(CutsceneSettings::FindDefault("").has_value());
+}
+
+// joins entries into the layout of the graphic pack's table in guest memory: null-terminated entries followed by an empty one
+static std::string BuildGuestTable(const std::vector<std::string>& entries) {
+    std::string table;
+    for (const std::string& entry : entries) {
+        table += entry;
+        table += '\0';
+    }
+    table += '\0';
+    return table;
+}
+
+static std::string FormatEntry(std::string_view eventName, const HybridEventSettings& settings) {
+    std::string entry(eventName);
+    entry += settings.firstPerson ? ",FP_ON" : ",FP_OFF";
+    entry += settings.ignoreCameraRotation ? ",PAN_OFF" : ",PAN_ON";
+    entry += settings.disablePlayerDrivenLinkHands ? ",HND_OFF" : ",HND_ON";
+    entry += settings.demoEnableCameraInput ? ",CTRL_OFF" : ",CTRL_ON";
+    return entry;
+}
+
+static std::vector<std::string> GetCompiledEntries() {
+    return std::vector<std::string>(CUTSCENE_SETTINGS_TABLE.begin(), CUTSCENE_SETTINGS_TABLE.end());
+}
+
+TEST(CutsceneSettingsTest, CompiledTableRoundTripsThroughTheGuestTable) {
+    // every entry of the compiled table parses back to the same settings after formatting it again
+    for (size_t i = 0; i < CutsceneSettings::ENTRY_COUNT; i++) {
+        HybridEventSettings settings = {};
+        const std::string entry = FormatEntry(CutsceneSettings::EVENT_NAME_LIST[i], CutsceneSettings::EVENT_SETTINGS[i]);
+        EXPECT_EQ(CutsceneSettings::ParseEntry(entry, settings, [](std::string_view) { ADD_FAILURE(); }), CutsceneSettings::EVENT_NAME_LIST[i]);
+        EXPECT_EQ(settings, CutsceneSettings::EVENT_SETTINGS[i]) << entry;
+        EXPECT_EQ(CutsceneSettings::FindDefault(CutsceneSettings::EVENT_NAME_LIST[i]), settings) << entry;
+    }
+
+    // an unchanged graphic pack doesn't override anything
+    const std::string table = BuildGuestTable(GetCompiledEntries());
+    CutsceneSettings::Overrides overrides;
+    EXPECT_EQ(CutsceneSettings::ReadOverrides(table.c_str(), overrides, [](std::string_view) { ADD_FAILURE(); }), CutsceneSettings::ENTRY_COUNT);
+    EXPECT_TRUE(overrides.empty());
+}
+
+TEST(CutsceneSettingsTest, OverridesOnlyContainTheUsersChanges) {
+    std::vector<std::string> entries = GetCompiledEntries();
+    ASSERT_GE(entries.size(), 2u);
+
+    // change the first entry, remove the last one and add an event that the compiled table doesn't know
+    const std::string_view changedEvent = CutsceneSettings::EVENT_NAME_LIST.front();
+    HybridEventSettings changedSettings = CutsceneSettings::EVENT_SETTINGS.front();
+    changedSettings.firstPerson = !changedSettings.firstPerson;
+    entries.front() = FormatEntry(changedEvent, changedSettings);
+
+    const std::string_view removedEvent = CutsceneSettings::EVENT_NAME_LIST.back();
+    entries.pop_back();
+
+    const HybridEventSettings addedSettings = { .firstPerson = true, .ignoreCameraRotation = true };
+    entries.emplace_back(FormatEntry("UserAddedEvent", addedSettings));
+
+    // lines without a comma aren't entries
+    entries.emplace_back("just a comment");
+
+    const std::string table = BuildGuestTable(entries);
+    CutsceneSettings::Overrides overrides = { { "StaleOverride", std::nullopt } };
+    EXPECT_EQ(CutsceneSettings::ReadOverrides(table.c_str(), overrides, [](std::string_view) { ADD_FAILURE(); }), CutsceneSettings::ENTRY_COUNT);
+
+    ASSERT_EQ(overrides.size(), 3u);
+    ASSERT_TRUE(overrides.contains(changedEvent));
+    EXPECT_EQ(overrides.find(changedEvent)->second, changedSettings);
+    ASSERT_TRUE(overrides.contains(removedEvent));
+    EXPECT_FALSE(overrides.find(removedEvent)->second.has_value());
+    ASSERT_TRUE(overrides.contains("UserAddedEvent"));
+    EXPECT_EQ(overrides.find("UserAddedEvent")->second, addedSettings);
+}
+
+TEST(CutsceneSettingsTest, EmptyGuestTableRemovesEveryEvent) {
+    CutsceneSettings::Overrides overrides;
+    EXPECT_EQ(CutsceneSettings::ReadOverrides("\0", overrides, [](std::string_view) { ADD_FAILURE(); }), 0u);
+    EXPECT_EQ(overrides.size(), CutsceneSettings::ENTRY_COUNT);
+    for (const auto& [eventName, settings] : overrides) {
+        EXPECT_FALSE(settings.has_value()) << eventName;
+    }
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "hooking/offline_hooks.h"
+#include "stub_openxr_runtime.h"
+#include "utils/frame_latency.h"
+
+// XrTimes are nanoseconds on the runtime's clock, these start at an arbitrary point like the runtime's do
+static constexpr XrTime MS = 1'000'000;
+static constexpr XrTime DISPLAY_TIME = 5'000'000 * MS;
+
+TEST(FrameLatencyTest, LatenciesAreMeasuredAgainstTheDisplayTime) {
+    FrameLatency latency;
+    FrameLatency::FrameTags tags;
+    latency.OnViewsLocated(DISPLAY_TIME - 20 * MS);
+    latency.TagViews(tags);
+    latency.OnInputPolled(DISPLAY_TIME - 30 * MS);
+    latency.OnInputUsed();
+    latency.TagInput(tags);
+    latency.OnPresent(DISPLAY_TIME - 12 * MS);
+    latency.TagPresent(tags);
+
+    const FrameLatency::Timestamps timestamps = FrameLatency::GetTimestamps(tags, DISPLAY_TIME);
+    ASSERT_TRUE(timestamps.GetMotionToPhotonMs().has_value());
+    EXPECT_DOUBLE_EQ(timestamps.GetMotionToPhotonMs().value(), 20.0);
+    ASSERT_TRUE(timestamps.GetInputToPhotonMs().has_value());
+    EXPECT_DOUBLE_EQ(timestamps.GetInputToPhotonMs().value(), 30.0);
+    ASSERT_TRUE(timestamps.GetPresentToPhotonMs().has_value());
+    EXPECT_DOUBLE_EQ(timestamps.GetPresentToPhotonMs().value(), 12.0);
+}
+
+TEST(FrameLatencyTest, UnknownTimesHaveNoLatency) {
+    FrameLatency latency;
+
+    // nothing was reported yet
+    FrameLatency::FrameTags tags;
+    latency.TagViews(tags);
+    latency.TagInput(tags);
+    latency.TagPresent(tags);
+    FrameLatency::Timestamps timestamps = FrameLatency::GetTimestamps(tags, DISPLAY_TIME);
+    EXPECT_FALSE(timestamps.GetMotionToPhotonMs().has_value());
+    EXPECT_FALSE(timestamps.GetInputToPhotonMs().has_value());
+    EXPECT_FALSE(timestamps.GetPresentToPhotonMs().has_value());
+
+    // a frame without a display time, which happens before the first xrWaitFrame
+    latency.OnViewsLocated(DISPLAY_TIME - 10 * MS);
+    latency.TagViews(tags);
+    latency.OnPresent(DISPLAY_TIME - 10 * MS);
+    latency.TagPresent(tags);
+    timestamps = FrameLatency::GetTimestamps(tags, 0);
+    EXPECT_FALSE(timestamps.GetMotionToPhotonMs().has_value());
+    EXPECT_FALSE(timestamps.GetPresentToPhotonMs().has_value());
+}
+
+TEST(FrameLatencyTest, EventsAfterTheDisplayTimeHaveNoLatency) {
+    FrameLatency latency;
+    FrameLatency::FrameTags tags;
+    latency.OnViewsLocated(DISPLAY_TIME + 5 * MS);
+    latency.TagViews(tags);
+    latency.OnPresent(DISPLAY_TIME + 1);
+    latency.TagPresent(tags);
+
+    const FrameLatency::Timestamps timestamps = FrameLatency::GetTimestamps(tags, DISPLAY_TIME);
+    EXPECT_FALSE(timestamps.GetMotionToPhotonMs().has_value());
+    EXPECT_FALSE(timestamps.GetPresentToPhotonMs().has_value());
+
+    // an event at exactly the display time has no latency, but it's known
+    ASSERT_TRUE(FrameLatency::Timestamps::GetLatencyMs(DISPLAY_TIME, DISPLAY_TIME).has_value());
+    EXPECT_DOUBLE_EQ(FrameLatency::Timestamps::GetLatencyMs(DISPLAY_TIME, DISPLAY_TIME).value(), 0.0);
+}
+
+TEST(FrameLatencyTest, OnlyUsedInputCounts) {
+    FrameLatency latency;
+    latency.OnInputPolled(DISPLAY_TIME - 40 * MS);
+    latency.OnInputUsed();
+
+    // input that was synced after the game last read it isn't what the frame was made with
+    latency.OnInputPolled(DISPLAY_TIME - 5 * MS);
+    FrameLatency::FrameTags tags;
+    latency.TagInput(tags);
+    const FrameLatency::Timestamps timestamps = FrameLatency::GetTimestamps(tags, DISPLAY_TIME);
+    ASSERT_TRUE(timestamps.GetInputToPhotonMs().has_value());
+    EXPECT_DOUBLE_EQ(timestamps.GetInputToPhotonMs().value(), 40.0);
+}
+
+TEST(FrameLatencyTest, ViewsLocateTimeIsTheLatestLocate) {
+    FrameLatency latency;
+    EXPECT_EQ(latency.GetViewsLocateTime(), 0);
+    latency.OnViewsLocated(DISPLAY_TIME - 25 * MS);
+    latency.OnViewsLocated(DISPLAY_TIME - 15 * MS);
+    EXPECT_EQ(latency.GetViewsLocateTime(), DISPLAY_TIME - 15 * MS);
+}
+
+TEST(FrameLatencyTest, FramesKeepTheInputTheyWereFirstTaggedWith) {
+    FrameLatency latency;
+    FrameLatency::FrameTags tags;
+    latency.OnInputPolled(DISPLAY_TIME - 30 * MS);
+    latency.OnInputUsed();
+    latency.TagInput(tags);
+
+    // the game already read the input for the next frame while this one is still being copied
+    latency.OnInputPolled(DISPLAY_TIME - 10 * MS);
+    latency.OnInputUsed();
+    latency.TagInput(tags);
+    EXPECT_EQ(tags.inputPollTime, DISPLAY_TIME - 30 * MS);
+}
+
+// Runs two frames through the stub runtime in the order that the renderer calls it, where the game already starts on the second
+// frame (and locates its views and reads its input) before the first one is submitted, like it does with the two render frames.
+TEST(FrameLatencyTest, StubRuntimeFramesAreMeasuredWithTheirOwnTimes) {
+    constexpr XrDuration DISPLAY_PERIOD = 11 * MS;
+    constexpr XrDuration DISPLAY_LATENCY = 40 * MS;
+    StubOpenXRRuntime runtime(DISPLAY_TIME, DISPLAY_PERIOD, DISPLAY_LATENCY);
+
+    OfflineHooks hooks;
+    FrameLatency& latency = hooks.GetHost().GetFrameLatency();
+    const uint32_t vpadStatus = hooks.GetArena().Allocate(0xAC);
+
+    std::array<FrameLatency::FrameTags, 2> tags = {};
+    std::array<XrFrameState, 2> frameStates = {};
+    const auto startFrame = [&](uint32_t frameIdx) {
+        XrFrameWaitInfo waitInfo = { XR_TYPE_FRAME_WAIT_INFO };
+        frameStates[frameIdx] = { XR_TYPE_FRAME_STATE };
+        ASSERT_EQ(runtime.xrWaitFrame(XR_NULL_HANDLE, &waitInfo, &frameStates[frameIdx]), XR_SUCCESS);
+
+        runtime.Advance(2 * MS);
+        XrViewLocateInfo locateInfo = { XR_TYPE_VIEW_LOCATE_INFO, nullptr, XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, frameStates[frameIdx].predictedDisplayTime, XR_NULL_HANDLE };
+        XrViewState viewState = { XR_TYPE_VIEW_STATE };
+        std::array<XrView, 2> views = { XrView{ XR_TYPE_VIEW }, XrView{ XR_TYPE_VIEW } };
+        uint32_t viewCount = 0;
+        ASSERT_EQ(runtime.xrLocateViews(XR_NULL_HANDLE, &locateInfo, &viewState, (uint32_t)views.size(), &viewCount, views.data()), XR_SUCCESS);
+        latency.OnViewsLocated(runtime.GetCurrentXrTime());
+
+        runtime.Advance(1 * MS);
+        XrActionsSyncInfo syncInfo = { XR_TYPE_ACTIONS_SYNC_INFO };
+        ASSERT_EQ(runtime.xrSyncActions(XR_NULL_HANDLE, &syncInfo), XR_SUCCESS);
+        latency.OnInputPolled(runtime.GetCurrentXrTime());
+
+        // the game reads the input through the hook, which reports it to the host's FrameLatency
+        runtime.Advance(3 * MS);
+        PPCInterpreter_t hCPU = {};
+        hCPU.gpr[4] = vpadStatus;
+        hooks.Call("hook_InjectXRInput", hCPU);
+
+        latency.TagViews(tags[frameIdx]);
+        latency.TagInput(tags[frameIdx]);
+    };
+    const auto endFrame = [&](uint32_t frameIdx) {
+        latency.OnPresent(runtime.GetCurrentXrTime());
+        latency.TagPresent(tags[frameIdx]);
+        XrFrameEndInfo frameEndInfo = { XR_TYPE_FRAME_END_INFO, nullptr, frameStates[frameIdx].predictedDisplayTime, XR_ENVIRONMENT_BLEND_MODE_OPAQUE, 0, nullptr };
+        ASSERT_EQ(runtime.xrEndFrame(XR_NULL_HANDLE, &frameEndInfo), XR_SUCCESS);
+    };
+
+    // the views are located 2 ms and the input is synced 3 ms after the wait, and every frame is presented 14 ms after the game read its input,
+    // so the first frame would be measured against the second frame's views and input if it didn't keep its own
+    startFrame(0);
+    runtime.Advance(4 * MS);
+    startFrame(1);
+    runtime.Advance(4 * MS);
+    endFrame(0);
+    runtime.Advance(10 * MS);
+    endFrame(1);
+
+    ASSERT_EQ(runtime.GetSubmittedDisplayTimes().size(), 2u);
+    EXPECT_EQ(runtime.GetSubmittedDisplayTimes()[0], DISPLAY_TIME + DISPLAY_LATENCY);
+    EXPECT_EQ(runtime.GetSubmittedDisplayTimes()[1], DISPLAY_TIME + 10 * MS + DISPLAY_LATENCY);
+
+    for (uint32_t frameIdx = 0; frameIdx < 2; frameIdx++) {
+        const FrameLatency::Timestamps timestamps = FrameLatency::GetTimestamps(tags[frameIdx], runtime.GetSubmittedDisplayTimes()[frameIdx]);
+        ASSERT_TRUE(timestamps.GetMotionToPhotonMs().has_value());
+        EXPECT_DOUBLE_EQ(timestamps.GetMotionToPhotonMs().value(), 38.0);
+        ASSERT_TRUE(timestamps.GetInputToPhotonMs().has_value());
+        EXPECT_DOUBLE_EQ(timestamps.GetInputToPhotonMs().value(), 37.0);
+        ASSERT_TRUE(timestamps.GetPresentToPhotonMs().has_value());
+        EXPECT_DOUBLE_EQ(timestamps.GetPresentToPhotonMs().value(), 20.0);
+    }
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "utils/frame_time_stats.h"
+
+using Histogram = FrameTimeStats::Histogram;
+
+TEST(FrameTimeStatsHistogramTest, EveryValueFitsInItsBucket) {
+    uint32_t previousIndex = 0;
+    for (uint32_t microseconds = 0; microseconds <= Histogram::MAX_MICROSECONDS; microseconds++) {
+        const uint32_t index = Histogram::GetBucketIndex(microseconds);
+        ASSERT_LT(index, Histogram::BUCKET_COUNT) << microseconds;
+        ASSERT_GE(index, previousIndex) << microseconds;
+        previousIndex = index;
+
+        // the bucket's upper bound is at most 1/32 above the value, and the bucket before it ends below the value
+        const uint32_t upperBound = Histogram::GetBucketUpperBound(index);
+        ASSERT_GE(upperBound, microseconds);
+        ASSERT_LE(upperBound - microseconds, microseconds / Histogram::SUB_BUCKET_COUNT);
+        if (index > 0) {
+            ASSERT_LT(Histogram::GetBucketUpperBound(index - 1), microseconds);
+        }
+    }
+    EXPECT_EQ(Histogram::GetBucketIndex(Histogram::MAX_MICROSECONDS), Histogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(Histogram::GetBucketIndex(std::numeric_limits<uint32_t>::max()), Histogram::BUCKET_COUNT - 1);
+}
+
+TEST(FrameTimeStatsHistogramTest, PercentilesAreWithinTheBucketPrecision) {
+    Histogram histogram;
+    for (int i = 1; i <= 1000; i++) {
+        histogram.Record(i * 0.05); // 0.05 ms to 50 ms
+    }
+    EXPECT_EQ(histogram.GetCount(), 1000u);
+    EXPECT_DOUBLE_EQ(histogram.GetMaxMs(), 50.0);
+
+    for (double percentile : { 0.5, 0.95, 0.99 }) {
+        const double exact = percentile * 50.0;
+        const double estimate = histogram.GetPercentileMs(percentile);
+        EXPECT_GE(estimate, exact - 0.001) << percentile;
+        EXPECT_LE(estimate, exact * (1.0 + 1.0 / Histogram::SUB_BUCKET_COUNT) + 0.001) << percentile;
+    }
+
+    // the highest percentile is capped by the exact maximum instead of its bucket's upper bound
+    EXPECT_DOUBLE_EQ(histogram.GetPercentileMs(1.0), 50.0);
+}
+
+TEST(FrameTimeStatsHistogramTest, OutOfRangeValuesAreClamped) {
+    Histogram histogram;
+    histogram.Record(-1.0);
+    histogram.Record(0.0);
+    EXPECT_DOUBLE_EQ(histogram.GetPercentileMs(1.0), 0.0);
+
+    histogram.Record(10000.0);
+    EXPECT_EQ(histogram.GetCount(), 3u);
+    EXPECT_DOUBLE_EQ(histogram.GetMaxMs(), 10000.0);
+    // the last bucket holds everything that's slower than the histogram can tell apart
+    EXPECT_NEAR(histogram.GetPercentileMs(1.0), Histogram::GetBucketUpperBound(Histogram::BUCKET_COUNT - 1) / 1000.0, 0.001);
+}
+
+TEST(FrameTimeStatsHistogramTest, AddingMergesTheCounts) {
+    Histogram fast;
+    Histogram slow;
+    for (int i = 0; i < 90; i++) fast.Record(11.0);
+    for (int i = 0; i < 10; i++) slow.Record(40.0);
+
+    Histogram window;
+    window.Add(fast);
+    window.Add(slow);
+    EXPECT_EQ(window.GetCount(), 100u);
+    EXPECT_DOUBLE_EQ(window.GetMaxMs(), 40.0);
+    EXPECT_NEAR(window.GetPercentileMs(0.5), 11.0, 11.0 / Histogram::SUB_BUCKET_COUNT);
+    EXPECT_NEAR(window.GetPercentileMs(0.95), 40.0, 40.0 / Histogram::SUB_BUCKET_COUNT);
+
+    window.Clear();
+    EXPECT_EQ(window.GetCount(), 0u);
+    EXPECT_DOUBLE_EQ(window.GetMaxMs(), 0.0);
+    EXPECT_DOUBLE_EQ(window.GetPercentileMs(0.5), 0.0);
+}
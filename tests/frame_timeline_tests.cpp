@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "utils/frame_timeline.h"
+
+#include <sstream>
+
+// the timeline is shared by the whole process, so every test only looks at the spans with its own names
+static std::vector<FrameTimeline::DumpedSpan> CollectNamed(std::string_view name, bool* coversDuration = nullptr) {
+    std::vector<FrameTimeline::DumpedSpan> spans;
+    for (const FrameTimeline::DumpedSpan& span : FrameTimeline::Collect(std::chrono::seconds(5), coversDuration)) {
+        if (span.name == name) {
+            spans.emplace_back(span);
+        }
+    }
+    return spans;
+}
+
+TEST(FrameTimelineTest, ScopesOnlyRecordWhileEnabled) {
+    FrameTimeline::SetEnabled(false);
+    {
+        FrameTimeline::Scope scope("test.disabled");
+    }
+    EXPECT_TRUE(CollectNamed("test.disabled").empty());
+
+    FrameTimeline::SetEnabled(true);
+    {
+        FrameTimeline::Scope scope("test.enabled");
+    }
+    FrameTimeline::SetEnabled(false);
+
+    const std::vector<FrameTimeline::DumpedSpan> spans = CollectNamed("test.enabled");
+    ASSERT_EQ(spans.size(), 1u);
+    EXPECT_LE(spans[0].start, spans[0].end);
+    EXPECT_NE(spans[0].threadId, 0u);
+}
+
+TEST(FrameTimelineTest, CollectsSpansOldestFirstAndSkipsOldOnes) {
+    const uint64_t now = FrameTimeline::Now();
+    FrameTimeline::Record("test.order", now - 3000, now - 2000);
+    FrameTimeline::Record("test.order", now - 2000, now - 1000);
+    // ended long before the duration that's collected
+    FrameTimeline::Record("test.order", 1, 2);
+
+    const std::vector<FrameTimeline::DumpedSpan> spans = CollectNamed("test.order");
+    ASSERT_EQ(spans.size(), 2u);
+    EXPECT_EQ(spans[0].end, now - 2000);
+    EXPECT_EQ(spans[1].end, now - 1000);
+}
+
+TEST(FrameTimelineTest, ReportsWhenTheRingWasOverwritten) {
+    const uint64_t now = FrameTimeline::Now();
+    FrameTimeline::Record("test.overwritten", now, now);
+    for (size_t i = 0; i < FrameTimeline::CAPACITY; i++) {
+        FrameTimeline::Record("test.filler", now, now);
+    }
+
+    bool coversDuration = true;
+    EXPECT_TRUE(CollectNamed("test.overwritten", &coversDuration).empty());
+    EXPECT_EQ(CollectNamed("test.filler").size(), FrameTimeline::CAPACITY);
+    EXPECT_FALSE(coversDuration);
+
+    // once a span older than the duration is still in the ring, everything that's newer is known to be there
+    FrameTimeline::Record("test.old", 1, 2);
+    for (size_t i = 0; i < 10; i++) {
+        FrameTimeline::Record("test.filler", now, now);
+    }
+    CollectNamed("test.old", &coversDuration);
+    EXPECT_TRUE(coversDuration);
+}
+
+TEST(FrameTimelineTest, WritesAChromeTrace) {
+    const std::array<FrameTimeline::DumpedSpan, 2> spans = {
+        FrameTimeline::DumpedSpan{ .name = "first", .start = 1000, .end = 1000, .threadId = 7 },
+        FrameTimeline::DumpedSpan{ .name = "second", .start = 1000, .end = 1000, .threadId = 8 },
+    };
+
+    std::ostringstream out;
+    FrameTimeline::WriteChromeTrace(out, spans);
+    EXPECT_EQ(out.str(),
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"first\",\"ph\":\"X\",\"pid\":1,\"tid\":7,\"ts\":0.000,\"dur\":0.000}\n"
+        ",{\"name\":\"second\",\"ph\":\"X\",\"pid\":1,\"tid\":8,\"ts\":0.000,\"dur\":0.000}\n"
+        "]}\n");
+
+    std::ostringstream empty;
+    FrameTimeline::WriteChromeTrace(empty, {});
+    EXPECT_EQ(empty.str(), "{\"traceEvents\":[\n]}\n");
+}
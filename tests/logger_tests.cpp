@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "utils/logger.h"
+
+static std::mutex s_outputMutex;
+static std::string s_output;
+
+// starts the logger with its output going into s_output, and returns the lines that start with prefix once it's shut down
+class LoggerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        s_output.clear();
+        Log::setOutputOverride([](const std::string& text) {
+            std::scoped_lock lock(s_outputMutex);
+            s_output += text;
+        });
+        m_log.emplace();
+    }
+
+    void TearDown() override {
+        m_log.reset();
+        Log::setOutputOverride(nullptr);
+    }
+
+    std::vector<std::string> StopAndGetLines(std::string_view prefix) {
+        m_log.reset();
+        std::vector<std::string> lines;
+        std::scoped_lock lock(s_outputMutex);
+        for (auto line : std::views::split(std::string_view(s_output), '\n')) {
+            std::string_view lineView(line.begin(), line.end());
+            if (lineView.starts_with(prefix)) {
+                lines.emplace_back(lineView.substr(prefix.size()));
+            }
+        }
+        return lines;
+    }
+
+    std::optional<Log> m_log;
+};
+
+TEST_F(LoggerTest, KeepsTheOrderOfOneThread) {
+    // more messages than fit in a queue, so logging has to wait for the logging thread in between
+    constexpr int MESSAGE_COUNT = 2000;
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        Log::print<INFO>("msg {}", i);
+    }
+
+    const std::vector<std::string> lines = StopAndGetLines("msg ");
+    ASSERT_EQ(lines.size(), (size_t)MESSAGE_COUNT);
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        EXPECT_EQ(lines[i], std::to_string(i));
+    }
+}
+
+TEST_F(LoggerTest, KeepsTheOrderBetweenThreadsTakingTurns) {
+    // the threads take turns logging bursts that are larger than a queue, so a message is always logged after the previous one
+    constexpr int THREAD_COUNT = 3;
+    constexpr int BURST_SIZE = 300;
+    constexpr int TURN_COUNT = 30;
+    std::atomic_int turn = 0;
+    std::atomic_int nextMessage = 0;
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREAD_COUNT; thread++) {
+        threads.emplace_back([&, thread] {
+            for (int t = thread; t < TURN_COUNT; t += THREAD_COUNT) {
+                while (turn.load() != t) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < BURST_SIZE; i++) {
+                    Log::print<INFO>("msg {}", nextMessage.fetch_add(1));
+                }
+                turn.store(t + 1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const std::vector<std::string> lines = StopAndGetLines("msg ");
+    ASSERT_EQ(lines.size(), (size_t)(TURN_COUNT * BURST_SIZE));
+    for (size_t i = 0; i < lines.size(); i++) {
+        ASSERT_EQ(lines[i], std::to_string(i));
+    }
+}
+
+TEST_F(LoggerTest, WritesEveryMessageOfConcurrentThreads) {
+    constexpr int THREAD_COUNT = 8;
+    constexpr int MESSAGE_COUNT = 1000;
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREAD_COUNT; thread++) {
+        threads.emplace_back([thread] {
+            for (int i = 0; i < MESSAGE_COUNT; i++) {
+                Log::print<INFO>("msg {} {}", thread, i);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // the messages of different threads can interleave in any way, but every thread's own messages stay in order
+    std::array<int, THREAD_COUNT> nextMessage = {};
+    for (const std::string& line : StopAndGetLines("msg ")) {
+        int thread = -1;
+        int message = -1;
+        ASSERT_EQ(sscanf(line.c_str(), "%d %d", &thread, &message), 2) << line;
+        ASSERT_TRUE(thread >= 0 && thread < THREAD_COUNT) << line;
+        EXPECT_EQ(message, nextMessage[thread]) << line;
+        nextMessage[thread] = message + 1;
+    }
+    for (int count : nextMessage) {
+        EXPECT_EQ(count, MESSAGE_COUNT);
+    }
+}
+
+TEST_F(LoggerTest, MessagesThatAreTooLongAreWrittenInOrder) {
+    Log::print<INFO>("msg 0");
+    Log::print<INFO>((std::string("msg 1 ") + std::string(Log::Entry::MAX_ARGS_SIZE, 'x')).c_str());
+    Log::print<INFO>("msg 2");
+
+    const std::vector<std::string> lines = StopAndGetLines("msg ");
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "0");
+    EXPECT_TRUE(lines[1].starts_with("1 x"));
+    EXPECT_EQ(lines[2], "2");
+}
+
+TEST(LogTypeMaskTest, ParsesEnabledAndDisabledTypes) {
+    const uint32_t info = Log::getLogTypeBit(INFO);
+    const uint32_t controls = Log::getLogTypeBit(CONTROLS);
+    const uint32_t rendering = Log::getLogTypeBit(RENDERING);
+
+    EXPECT_EQ(Log::parseLogTypeMask("controls", info), info | controls);
+    EXPECT_EQ(Log::parseLogTypeMask("controls,-info", info), controls);
+    EXPECT_EQ(Log::parseLogTypeMask(" Controls , +RENDERING ,,", 0), controls | rendering);
+    EXPECT_EQ(Log::parseLogTypeMask("", info), info);
+
+    uint32_t all = 0;
+    for (LogType type : Log::ALL_LOG_TYPES) {
+        all |= Log::getLogTypeBit(type);
+    }
+    EXPECT_EQ(Log::parseLogTypeMask("all", 0), all);
+    EXPECT_EQ(Log::parseLogTypeMask("all,-ppc", 0), all & ~Log::getLogTypeBit(PPC));
+    EXPECT_EQ(Log::parseLogTypeMask("-all,info", all), info);
+}
+
+TEST(LogTypeMaskTest, ReturnsUnknownNames) {
+    std::vector<std::string> invalidNames;
+    EXPECT_EQ(Log::parseLogTypeMask("controls,bogus,-Nope,-", 0, &invalidNames), Log::getLogTypeBit(CONTROLS));
+    EXPECT_EQ(invalidNames, (std::vector<std::string>{ "bogus", "nope", "" }));
+
+    // the names can also be ignored
+    EXPECT_EQ(Log::parseLogTypeMask("bogus", 0), 0u);
+}
+
+TEST(LogTypeMaskTest, ErrorsAndWarningsCantBeDisabled) {
+    const bool wasInfoEnabled = Log::isLogTypeEnabled(INFO);
+
+    Log::setLogTypeEnabled(INFO, false);
+    Log::setLogTypeEnabled(WARNING, false);
+    EXPECT_FALSE(Log::isLogTypeEnabled(INFO));
+    EXPECT_FALSE(Log::isLogTypeEnabled<INFO>());
+    EXPECT_TRUE(Log::isLogTypeEnabled(WARNING));
+    EXPECT_TRUE(Log::isLogTypeEnabled<WARNING>());
+    EXPECT_TRUE(Log::isLogTypeEnabled<ERROR>());
+
+    Log::setLogTypeEnabled(INFO, true);
+    EXPECT_TRUE(Log::isLogTypeEnabled(INFO));
+    EXPECT_TRUE(Log::isLogTypeEnabled<INFO>());
+    Log::setLogTypeEnabled(INFO, wasInfoEnabled);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "utils/metrics.h"
+
+// the registry is shared by the whole process, so every test uses metric names of its own
+
+TEST(MetricsTest, PercentilesAreTheUpperBoundOfTheirBucket) {
+    Metrics::MetricInfo info = { .name = "test", .type = Metrics::MetricType::HISTOGRAM, .firstSlot = 0, .bucketBounds = { 1.0, 2.0, 4.0 } };
+    Metrics::MetricSnapshot snapshot = { .total = 10, .buckets = { 5, 3, 2, 0 } };
+
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.5), 1.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.51), 2.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.8), 2.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.81), 4.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.99), 4.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 1.0), 4.0);
+}
+
+TEST(MetricsTest, PercentilesAboveTheLastBoundAreClamped) {
+    Metrics::MetricInfo info = { .name = "test", .type = Metrics::MetricType::HISTOGRAM, .firstSlot = 0, .bucketBounds = { 1.0, 2.0 } };
+    Metrics::MetricSnapshot snapshot = { .total = 4, .buckets = { 1, 0, 3 } };
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.25), 1.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.5), 2.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.99), 2.0);
+
+    // nothing was recorded yet
+    EXPECT_DOUBLE_EQ(Metrics::MetricSnapshot().GetPercentile(info, 0.5), 0.0);
+}
+
+TEST(MetricsTest, HistogramSumsUpEveryThread) {
+    const Metrics::Histogram histogram("test.histogram_threads", { 1.0, 10.0, 100.0 });
+
+    histogram.Record(0.5);  // first bucket
+    histogram.Record(1.0);  // the bounds are inclusive
+    histogram.Record(50.0); // third bucket
+    std::thread([&] {
+        histogram.Record(5.0);
+        histogram.Record(500.0); // above the last bound
+    }).join();
+    Metrics::Registry::Get().EndFrame();
+
+    const auto [info, snapshot] = histogram.GetSnapshot();
+    EXPECT_EQ(info.name, "test.histogram_threads");
+    EXPECT_EQ(snapshot.total, 5u);
+    EXPECT_EQ(snapshot.lastFrame, 5u);
+    EXPECT_DOUBLE_EQ(snapshot.value, 556.5);
+    EXPECT_EQ(snapshot.buckets, (std::vector<uint64_t>{ 2, 1, 1, 1 }));
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.4), 1.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.6), 10.0);
+
+    // the last frame only counts what was recorded since the previous EndFrame
+    histogram.Record(2.0);
+    Metrics::Registry::Get().EndFrame();
+    const auto [nextInfo, nextSnapshot] = histogram.GetSnapshot();
+    EXPECT_EQ(nextSnapshot.total, 6u);
+    EXPECT_EQ(nextSnapshot.lastFrame, 1u);
+    EXPECT_DOUBLE_EQ(nextSnapshot.lastFrameValue, 2.0);
+}
+
+TEST(MetricsTest, ResetStartsCountingFromZero) {
+    const Metrics::Histogram histogram("test.histogram_reset", { 1.0 });
+    const Metrics::Counter counter("test.counter_reset");
+
+    histogram.Record(3.0);
+    counter.Add(7);
+    Metrics::Registry::Get().EndFrame();
+    Metrics::Registry::Get().Reset();
+
+    histogram.Record(0.5);
+    counter.Add(2);
+    Metrics::Registry::Get().EndFrame();
+
+    const auto [info, snapshot] = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.total, 1u);
+    EXPECT_DOUBLE_EQ(snapshot.value, 0.5);
+    EXPECT_EQ(snapshot.buckets, (std::vector<uint64_t>{ 1, 0 }));
+    EXPECT_DOUBLE_EQ(snapshot.GetPercentile(info, 0.99), 1.0);
+
+    bool foundCounter = false;
+    Metrics::Registry::Get().ForEach([&](const Metrics::MetricInfo& metric, const Metrics::MetricSnapshot& metricSnapshot) {
+        if (metric.name == "test.counter_reset") {
+            foundCounter = true;
+            EXPECT_EQ(metricSnapshot.total, 2u);
+            EXPECT_EQ(metricSnapshot.lastFrame, 2u);
+        }
+    });
+    EXPECT_TRUE(foundCounter);
+}
+
+TEST(MetricsTest, RegisteringTheSameNameTwiceSharesTheSlots) {
+    const Metrics::Counter first("test.counter_shared");
+    const Metrics::Counter second("test.counter_shared");
+    EXPECT_EQ(first.Add(), 1u);
+    EXPECT_EQ(second.Add(), 2u);
+}
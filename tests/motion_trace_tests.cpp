@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "hooking/motion_trace.h"
+
+class MotionTraceTest : public testing::Test {
+protected:
+    void SetUp() override {
+        m_path = std::filesystem::temp_directory_path() / (std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + std::string(MotionTrace::FILE_EXTENSION));
+    }
+
+    void TearDown() override {
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+    }
+
+    // records count samples whose values are derived from their index
+    void RecordSamples(MotionTrace::Writer& writer, int count) {
+        for (int i = 0; i < count; i++) {
+            XrSpaceLocation location = { XR_TYPE_SPACE_LOCATION };
+            location.pose = { .orientation = { 0.0f, 0.0f, 0.0f, 1.0f }, .position = { (float)i, 1.0f, -2.0f } };
+            XrSpaceVelocity velocity = { XR_TYPE_SPACE_VELOCITY };
+            velocity.linearVelocity = { 0.0f, (float)i, 0.0f };
+            velocity.angularVelocity = { 0.0f, 0.0f, (float)-i };
+            const glm::fmat4 headsetMtx = RigidPose(glm::angleAxis(0.5f, glm::fvec3(0.0f, 1.0f, 0.0f)), glm::fvec3(0.0f, 1.6f, (float)i)).ToMatrix();
+            writer.Record((uint8_t)(i % 2), 3, location, velocity, headsetMtx, (XrTime)i * 11'000'000);
+        }
+    }
+
+    std::filesystem::path m_path;
+};
+
+TEST_F(MotionTraceTest, ReadsBackWhatWasRecorded) {
+    // more samples than are buffered at once, so the file is written in several batches
+    constexpr int SAMPLE_COUNT = MotionTrace::Writer::FLUSH_SAMPLES * 2 + 10;
+    {
+        MotionTrace::Writer writer;
+        ASSERT_TRUE(writer.Open(m_path));
+        RecordSamples(writer, SAMPLE_COUNT);
+        EXPECT_EQ(writer.GetSampleCount(), (uint64_t)SAMPLE_COUNT);
+        EXPECT_EQ(writer.GetPath().string(), m_path.string());
+    }
+
+    const std::optional<std::vector<MotionTrace::Sample>> samples = MotionTrace::Read(m_path);
+    ASSERT_TRUE(samples.has_value());
+    ASSERT_EQ(samples->size(), (size_t)SAMPLE_COUNT);
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        const MotionTrace::Sample& sample = (*samples)[i];
+        ASSERT_EQ(sample.time, (XrTime)i * 11'000'000) << i;
+        ASSERT_EQ(sample.hand, i % 2) << i;
+        ASSERT_EQ(sample.weaponType, 3) << i;
+        ASSERT_FLOAT_EQ(MotionTrace::GetHandLocation(sample).pose.position.x, (float)i) << i;
+        ASSERT_FLOAT_EQ(MotionTrace::GetHandVelocity(sample).linearVelocity.y, (float)i) << i;
+        ASSERT_FLOAT_EQ(MotionTrace::GetHandVelocity(sample).angularVelocity.z, (float)-i) << i;
+
+        const glm::fmat4 headsetMtx = MotionTrace::GetHeadsetMatrix(sample);
+        ASSERT_NEAR(headsetMtx[3].y, 1.6f, 0.0001f) << i;
+        ASSERT_NEAR(headsetMtx[3].z, (float)i, 0.0001f) << i;
+    }
+}
+
+TEST_F(MotionTraceTest, KeepsTheCompleteSamplesOfACutOffRecording) {
+    {
+        MotionTrace::Writer writer;
+        ASSERT_TRUE(writer.Open(m_path));
+        RecordSamples(writer, 5);
+    }
+    std::filesystem::resize_file(m_path, sizeof(MotionTrace::Header) + 3 * sizeof(MotionTrace::Sample) + 17);
+
+    const std::optional<std::vector<MotionTrace::Sample>> samples = MotionTrace::Read(m_path);
+    ASSERT_TRUE(samples.has_value());
+    EXPECT_EQ(samples->size(), 3u);
+}
+
+TEST_F(MotionTraceTest, RejectsFilesOfOtherRecorders) {
+    EXPECT_FALSE(MotionTrace::Read(m_path).has_value());
+
+    MotionTrace::Header header = {};
+    header.version = MotionTrace::VERSION + 1;
+    std::ofstream(m_path, std::ios::binary).write((const char*)&header, sizeof(header));
+    EXPECT_FALSE(MotionTrace::Read(m_path).has_value());
+
+    // too short to even hold a header
+    std::ofstream(m_path, std::ios::binary | std::ios::trunc).write("BVMT", 4);
+    EXPECT_FALSE(MotionTrace::Read(m_path).has_value());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "hooking/name_lists.h"
+
+// names that differ from a listed name by a single character or by case, leaving out the ones that are listed themselves
+template <size_t N>
+static std::vector<std::string> NearMisses(const std::array<std::string_view, N>& names) {
+    std::vector<std::string> misses;
+    for (std::string_view name : names) {
+        std::string changedCase(name);
+        changedCase[0] = (char)(std::isupper((unsigned char)changedCase[0]) ? std::tolower((unsigned char)changedCase[0]) : std::toupper((unsigned char)changedCase[0]));
+        std::string changedLast(name);
+        changedLast.back()++;
+        std::string changedMiddle(name);
+        changedMiddle[name.size() / 2]++;
+
+        for (std::string miss : { std::string(name.substr(0, name.size() - 1)), std::string(name) + "_", std::string(name) + " ", "_" + std::string(name), changedCase, changedLast, changedMiddle }) {
+            if (std::ranges::find(names, miss) == names.end()) {
+                misses.emplace_back(std::move(miss));
+            }
+        }
+    }
+    return misses;
+}
+
+TEST(NameListsTest, FindsEveryNonDroppableItem) {
+    for (size_t i = 0; i < NameLists::NON_DROPPABLE_ITEM_NAMES.size(); i++) {
+        const std::string_view name = NameLists::NON_DROPPABLE_ITEM_NAMES[i];
+        EXPECT_EQ(NameLists::NON_DROPPABLE_ITEMS.find(name), (int32_t)i) << name;
+        EXPECT_FALSE(NameLists::IsDroppable(name)) << name;
+    }
+}
+
+TEST(NameListsTest, MissesNamesCloseToANonDroppableItem) {
+    const std::vector<std::string> misses = NearMisses(NameLists::NON_DROPPABLE_ITEM_NAMES);
+    ASSERT_GT(misses.size(), NameLists::NON_DROPPABLE_ITEM_NAMES.size());
+    for (const std::string& miss : misses) {
+        EXPECT_EQ(NameLists::NON_DROPPABLE_ITEMS.find(miss), -1) << miss;
+        // every arrow is kept in the hands, listed or not
+        EXPECT_EQ(NameLists::IsDroppable(miss), !miss.contains("Arrow")) << miss;
+    }
+}
+
+TEST(NameListsTest, DropsWeaponsThatArentListed) {
+    EXPECT_TRUE(NameLists::IsDroppable("Weapon_Sword_001"));
+    EXPECT_TRUE(NameLists::IsDroppable("Weapon_Lsword_057"));
+    EXPECT_TRUE(NameLists::IsDroppable("Weapon_Shield_001"));
+    EXPECT_TRUE(NameLists::IsDroppable(""));
+    EXPECT_FALSE(NameLists::IsDroppable("Weapon_Sword_070"));
+    EXPECT_FALSE(NameLists::IsDroppable("Obj_ArrowNormal_A_01"));
+}
+
+TEST(NameListsTest, MapsEveryActorJobNameToItsJob) {
+    static constexpr std::array<std::pair<std::string_view, NameLists::ActorJob>, 7> JOBS = { {
+        { "job0_1", NameLists::ActorJob::JOB0_1 },
+        { "job0_2", NameLists::ActorJob::JOB0_2 },
+        { "job1_1", NameLists::ActorJob::JOB1_1 },
+        { "job1_2", NameLists::ActorJob::JOB1_2 },
+        { "job2_1_ragdoll_related", NameLists::ActorJob::JOB2_1_RAGDOLL_RELATED },
+        { "job2_2", NameLists::ActorJob::JOB2_2 },
+        { "job4", NameLists::ActorJob::JOB4 },
+    } };
+    ASSERT_EQ(NameLists::ACTOR_JOB_NAME_LIST.size(), JOBS.size());
+    for (size_t i = 0; i < JOBS.size(); i++) {
+        EXPECT_EQ(NameLists::ACTOR_JOB_NAME_LIST[i], JOBS[i].first);
+        EXPECT_EQ(NameLists::FindActorJob(JOBS[i].first), JOBS[i].second) << JOBS[i].first;
+    }
+}
+
+TEST(NameListsTest, OtherActorJobsAreUnknown) {
+    const std::vector<std::string> misses = NearMisses(NameLists::ACTOR_JOB_NAME_LIST);
+    ASSERT_GT(misses.size(), NameLists::ACTOR_JOB_NAME_LIST.size());
+    for (const std::string& miss : misses) {
+        EXPECT_EQ(NameLists::FindActorJob(miss), NameLists::ActorJob::UNKNOWN) << miss;
+    }
+    for (std::string_view job : { "", "job", "job0", "job2_1", "job3", "job5", "job2_1_ragdoll" }) {
+        EXPECT_EQ(NameLists::FindActorJob(job), NameLists::ActorJob::UNKNOWN) << job;
+    }
+}
+
+TEST(NameListsTest, FindsEveryFaceBone) {
+    for (size_t i = 0; i < NameLists::FACE_BONE_NAME_LIST.size(); i++) {
+        const std::string_view name = NameLists::FACE_BONE_NAME_LIST[i];
+        EXPECT_EQ(NameLists::FACE_BONE_NAMES.find(name), (int32_t)i) << name;
+        EXPECT_TRUE(NameLists::IsFaceBone(name)) << name;
+    }
+    for (std::string_view prefix : NameLists::FACE_BONE_PREFIXES) {
+        EXPECT_TRUE(NameLists::IsFaceBone(prefix)) << prefix;
+        EXPECT_TRUE(NameLists::IsFaceBone(std::string(prefix) + "_L")) << prefix;
+    }
+}
+
+TEST(NameListsTest, MissesBonesCloseToAFaceBone) {
+    const std::vector<std::string> misses = NearMisses(NameLists::FACE_BONE_NAME_LIST);
+    ASSERT_GT(misses.size(), NameLists::FACE_BONE_NAME_LIST.size());
+    for (const std::string& miss : misses) {
+        EXPECT_EQ(NameLists::FACE_BONE_NAMES.find(miss), -1) << miss;
+    }
+
+    // the names are only compared whole and the prefixes only at the start of a bone name
+    for (std::string_view bone : { "Nose_L", "Neck_1", "Head_Top", "Ponytail_A_2", "Teeth", "eye_L", "L_Eye", "Spine_2", "Clavicle_L" }) {
+        EXPECT_FALSE(NameLists::IsFaceBone(bone)) << bone;
+    }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "utils/name_set.h"
+
+static constexpr auto BONE_NAMES = std::to_array<std::string_view>({
+    "Skl_Root", "Spine_1", "Spine_2", "Neck", "Head", "Clavicle_L", "Arm_1_L", "Arm_2_L", "Wrist_L", "Clavicle_R", "Arm_1_R", "Arm_2_R", "Wrist_R",
+    "Leg_1_L", "Leg_2_L", "Ankle_L", "Toe_L", "Leg_1_R", "Leg_2_R", "Ankle_R", "Toe_R", "Weapon_L", "Weapon_R"
+});
+static constexpr NameSet s_boneNames = BONE_NAMES;
+
+// the lookups are constexpr, so a broken hash already fails to compile
+static_assert(s_boneNames.find("Skl_Root") == 0);
+static_assert(s_boneNames.find("Weapon_R") == (int32_t)BONE_NAMES.size() - 1);
+static_assert(!s_boneNames.contains("Skl_Root2"));
+
+TEST(NameSetTest, FindsEveryNameAtItsIndex) {
+    for (size_t i = 0; i < BONE_NAMES.size(); i++) {
+        EXPECT_EQ(s_boneNames.find(BONE_NAMES[i]), (int32_t)i) << BONE_NAMES[i];
+        EXPECT_TRUE(s_boneNames.contains(BONE_NAMES[i]));
+    }
+    EXPECT_EQ(s_boneNames.size(), BONE_NAMES.size());
+}
+
+TEST(NameSetTest, MissesNamesThatArentInTheSet) {
+    // names that land in an occupied slot still need to compare unequal
+    for (std::string_view name : { "", "Skl", "Skl_Root ", "skl_root", "Arm_3_L", "Wrist_", "Wrist_LR" }) {
+        EXPECT_EQ(s_boneNames.find(name), -1) << name;
+        EXPECT_FALSE(s_boneNames.contains(name)) << name;
+    }
+}
+
+TEST(NameSetTest, MissesNamesThatDifferAfterAnEmbeddedNul) {
+    using namespace std::string_view_literals;
+    EXPECT_EQ(s_boneNames.find("Head\0Tail"sv), -1);
+}
+
+TEST(NameSetTest, WorksWithASingleName) {
+    static constexpr NameSet single = std::to_array<std::string_view>({ "GameROMPlayer" });
+    EXPECT_EQ(single.find("GameROMPlayer"), 0);
+    EXPECT_EQ(single.find("GameRomCamera"), -1);
+    EXPECT_EQ(single.find(""), -1);
+}
+
+TEST(NameSetTest, FindsEveryNameOfALargeSet) {
+    // enough names that most buckets need a seed instead of a direct slot
+    static constexpr size_t COUNT = 500;
+    static constexpr auto NAMES = [] {
+        std::array<std::array<char, 12>, COUNT> names = {};
+        for (size_t i = 0; i < COUNT; i++) {
+            const std::string_view prefix = "Obj_";
+            std::ranges::copy(prefix, names[i].begin());
+            names[i][4] = (char)('0' + i / 100);
+            names[i][5] = (char)('0' + i / 10 % 10);
+            names[i][6] = (char)('0' + i % 10);
+        }
+        return names;
+    }();
+    static constexpr NameSet<COUNT> set = [] {
+        std::array<std::string_view, COUNT> views = {};
+        for (size_t i = 0; i < COUNT; i++) {
+            views[i] = std::string_view(NAMES[i].data(), 7);
+        }
+        return views;
+    }();
+
+    for (size_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(set.find(std::string_view(NAMES[i].data(), 7)), (int32_t)i);
+    }
+    EXPECT_EQ(set.find("Obj_500"), -1);
+    EXPECT_EQ(set.find("Obj_0000"), -1);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "utils/rigid_pose.h"
+
+static void ExpectNear(const glm::fvec3& a, const glm::fvec3& b, float epsilon = 0.0001f) {
+    EXPECT_NEAR(glm::distance(a, b), 0.0f, epsilon) << glm::to_string(a) << " vs " << glm::to_string(b);
+}
+
+// q and -q are the same rotation
+static void ExpectSameRotation(const glm::fquat& a, const glm::fquat& b, float epsilon = 0.0001f) {
+    EXPECT_NEAR(std::abs(glm::dot(a, b)), 1.0f, epsilon) << glm::to_string(a) << " vs " << glm::to_string(b);
+}
+
+static void ExpectNear(const glm::fmat4& a, const glm::fmat4& b, float epsilon = 0.0001f) {
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            EXPECT_NEAR(a[col][row], b[col][row], epsilon) << "at column " << col << ", row " << row;
+        }
+    }
+}
+
+// a few poses that aren't aligned with any axis, so that mixed up multiplication orders show up
+static const std::array<RigidPose, 3> POSES = {
+    RigidPose(glm::angleAxis(0.7f, glm::normalize(glm::fvec3(1.0f, 2.0f, 3.0f))), glm::fvec3(0.5f, -1.0f, 2.0f)),
+    RigidPose(glm::angleAxis(-2.1f, glm::normalize(glm::fvec3(-0.3f, 1.0f, 0.2f))), glm::fvec3(-3.0f, 0.25f, 1.0f)),
+    RigidPose(glm::angleAxis(3.0f, glm::normalize(glm::fvec3(0.0f, 0.1f, 1.0f))), glm::fvec3(0.0f, 1.6f, 0.0f)),
+};
+
+TEST(RigidPoseTest, ComposingWithTheInverseIsTheIdentity) {
+    for (const RigidPose& pose : POSES) {
+        const RigidPose identity = pose * pose.Inverse();
+        ExpectSameRotation(identity.rotation, glm::identity<glm::fquat>());
+        ExpectNear(identity.position, glm::fvec3(0.0f));
+
+        const RigidPose otherIdentity = pose.Inverse() * pose;
+        ExpectSameRotation(otherIdentity.rotation, glm::identity<glm::fquat>());
+        ExpectNear(otherIdentity.position, glm::fvec3(0.0f));
+    }
+}
+
+TEST(RigidPoseTest, MatchesTheMatrixMath) {
+    for (const RigidPose& a : POSES) {
+        for (const RigidPose& b : POSES) {
+            ExpectNear((a * b).ToMatrix(), a.ToMatrix() * b.ToMatrix());
+        }
+        ExpectNear(a.Inverse().ToMatrix(), glm::inverse(a.ToMatrix()));
+        ExpectNear(InverseRigid(a.ToMatrix()), glm::inverse(a.ToMatrix()));
+
+        const glm::fvec3 point = glm::fvec3(0.3f, -0.7f, 1.1f);
+        ExpectNear(a.TransformPoint(point), glm::fvec3(a.ToMatrix() * glm::fvec4(point, 1.0f)));
+        ExpectNear(a.TransformDirection(point), glm::fvec3(a.ToMatrix() * glm::fvec4(point, 0.0f)));
+    }
+}
+
+TEST(RigidPoseTest, RoundTripsThroughMatrices) {
+    for (const RigidPose& pose : POSES) {
+        const RigidPose fromMatrix(pose.ToMatrix());
+        ExpectSameRotation(fromMatrix.rotation, pose.rotation);
+        ExpectNear(fromMatrix.position, pose.position);
+
+        const RigidPose fromMatrix34(pose.ToMatrix34());
+        ExpectSameRotation(fromMatrix34.rotation, pose.rotation);
+        ExpectNear(fromMatrix34.position, pose.position);
+    }
+}
+
+TEST(RigidPoseTest, SlerpHitsBothEnds) {
+    const RigidPose& a = POSES[0];
+    const RigidPose& b = POSES[1];
+    ExpectSameRotation(RigidPose::Slerp(a, b, 0.0f).rotation, a.rotation);
+    ExpectNear(RigidPose::Slerp(a, b, 0.0f).position, a.position);
+    ExpectSameRotation(RigidPose::Slerp(a, b, 1.0f).rotation, b.rotation);
+    ExpectNear(RigidPose::Slerp(a, b, 1.0f).position, b.position);
+    ExpectNear(RigidPose::Slerp(a, b, 0.5f).position, (a.position + b.position) * 0.5f);
+}
+
+TEST(SwingTwistTest, SwingTimesTwistIsTheRotation) {
+    const glm::fvec3 axis = glm::normalize(glm::fvec3(0.2f, 1.0f, -0.4f));
+    for (const RigidPose& pose : POSES) {
+        const auto [swing, twist] = SwingTwist(pose.rotation, axis);
+        ExpectSameRotation(swing * twist, pose.rotation);
+        EXPECT_NEAR(glm::length(swing), 1.0f, 0.0001f);
+        EXPECT_NEAR(glm::length(twist), 1.0f, 0.0001f);
+
+        // the twist only rotates around the axis, and the swing doesn't rotate around it at all
+        ExpectNear(twist * axis, axis);
+        EXPECT_NEAR(glm::dot(glm::fvec3(swing.x, swing.y, swing.z), axis), 0.0f, 0.0001f);
+    }
+}
+
+TEST(SwingTwistTest, PureRotationsSplitCompletely) {
+    const glm::fquat yaw = glm::angleAxis(1.2f, glm::fvec3(0.0f, 1.0f, 0.0f));
+    const auto [yawSwing, yawTwist] = SwingTwistY(yaw);
+    ExpectSameRotation(yawTwist, yaw);
+    ExpectSameRotation(yawSwing, glm::identity<glm::fquat>());
+
+    const glm::fquat pitch = glm::angleAxis(0.8f, glm::fvec3(1.0f, 0.0f, 0.0f));
+    const auto [pitchSwing, pitchTwist] = SwingTwistY(pitch);
+    ExpectSameRotation(pitchTwist, glm::identity<glm::fquat>());
+    ExpectSameRotation(pitchSwing, pitch);
+
+    // yawing after pitching keeps the yaw in the twist
+    const auto [swing, twist] = SwingTwistY(pitch * yaw);
+    ExpectSameRotation(twist, yaw);
+    ExpectSameRotation(swing, pitch);
+}
+
+TEST(SwingTwistTest, HalfTurnPerpendicularToTheAxisHasNoTwist) {
+    const glm::fquat halfTurn = glm::angleAxis(glm::pi<float>(), glm::fvec3(1.0f, 0.0f, 0.0f));
+    const auto [swing, twist] = SwingTwistY(halfTurn);
+    ExpectSameRotation(twist, glm::identity<glm::fquat>());
+    ExpectSameRotation(swing, halfTurn);
+}
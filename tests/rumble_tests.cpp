@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include "hooking/rumble.h"
+
+using namespace std::chrono_literals;
+
+// records every call of the rumble thread with the time it was made, so that the tests can check when the output changed
+class FakeHapticsSink : public HapticsSink {
+public:
+    struct Call {
+        bool apply = false;
+        Hand hand = Hand::BOTH;
+        float amplitude = 0.0f;
+        std::optional<std::chrono::nanoseconds> duration;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    void Apply(Hand hand, float frequency, float amplitude, std::optional<std::chrono::nanoseconds> duration) override {
+        AddCall({ .apply = true, .hand = hand, .amplitude = amplitude, .duration = duration, .time = std::chrono::steady_clock::now() });
+    }
+
+    void Stop(Hand hand) override {
+        AddCall({ .apply = false, .hand = hand, .time = std::chrono::steady_clock::now() });
+    }
+
+    // returns false if there weren't that many calls before the timeout
+    bool WaitForCalls(size_t count, std::chrono::milliseconds timeout = 2000ms) {
+        std::unique_lock lock(m_mutex);
+        return m_condition.wait_for(lock, timeout, [&] { return m_calls.size() >= count; });
+    }
+
+    std::vector<Call> GetCalls() {
+        std::scoped_lock lock(m_mutex);
+        return m_calls;
+    }
+
+private:
+    void AddCall(const Call& call) {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_calls.emplace_back(call);
+        }
+        m_condition.notify_all();
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<Call> m_calls;
+};
+
+// the sink is owned by the manager, so the tests keep a pointer to it that stays valid until the manager is destroyed
+struct RumbleFixture {
+    FakeHapticsSink* sink = new FakeHapticsSink();
+    RumbleManager manager = RumbleManager(std::unique_ptr<HapticsSink>(sink));
+};
+
+// every step of a pattern is two bits, and the motor is on while either of them is set
+static std::vector<uint8_t> MakePattern(std::initializer_list<bool> steps) {
+    std::vector<uint8_t> pattern((steps.size() * 2 + 7) / 8, 0);
+    size_t step = 0;
+    for (bool on : steps) {
+        if (on) {
+            pattern[step * 2 / 8] |= (uint8_t)(3 << (step * 2 % 8));
+        }
+        step++;
+    }
+    return pattern;
+}
+
+TEST(RumbleTest, PatternEdgesArePlayedOnTime) {
+    RumbleFixture rumble;
+
+    // on, on, off, off, on, off: the output only changes at steps 0, 2, 4 and 5
+    std::vector<uint8_t> pattern = MakePattern({ true, true, false, false, true, false });
+    rumble.manager.controlMotor(pattern.data(), 12);
+    ASSERT_TRUE(rumble.sink->WaitForCalls(4));
+
+    const std::vector<FakeHapticsSink::Call> calls = rumble.sink->GetCalls();
+    ASSERT_EQ(calls.size(), 4u);
+    const std::array<bool, 4> expectedApply = { true, false, true, false };
+    const std::array<uint32_t, 4> expectedSteps = { 0, 2, 4, 5 };
+
+    // the edges are timed from the first one, the rumble thread never wakes up early but can be late on a busy machine
+    std::chrono::nanoseconds maxLateness = 0ns;
+    for (size_t i = 0; i < calls.size(); i++) {
+        EXPECT_EQ(calls[i].apply, expectedApply[i]) << "call " << i;
+        EXPECT_EQ(calls[i].hand, HapticsSink::Hand::BOTH) << "call " << i;
+        if (calls[i].apply) {
+            EXPECT_FLOAT_EQ(calls[i].amplitude, 1.0f);
+            EXPECT_FALSE(calls[i].duration.has_value());
+        }
+
+        const std::chrono::nanoseconds expected = RumbleManager::PATTERN_STEP * expectedSteps[i];
+        const std::chrono::nanoseconds actual = calls[i].time - calls[0].time;
+        EXPECT_GE(actual, expected - 1ms) << "call " << i;
+        maxLateness = std::max(maxLateness, actual - expected);
+    }
+    EXPECT_LT(maxLateness, 15ms);
+}
+
+TEST(RumbleTest, ParksWhileNothingIsPlaying) {
+    RumbleFixture rumble;
+    std::this_thread::sleep_for(50ms);
+    const uint64_t idleWakes = rumble.manager.GetWakeCount();
+    EXPECT_LE(idleWakes, 1u);
+
+    // a pattern with two edges wakes the thread for the command, both edges and the end of the pattern
+    std::vector<uint8_t> pattern = MakePattern({ true, false, false });
+    rumble.manager.controlMotor(pattern.data(), 6);
+    ASSERT_TRUE(rumble.sink->WaitForCalls(2));
+    std::this_thread::sleep_for(RumbleManager::PATTERN_STEP * 3 + 30ms);
+    const uint64_t patternWakes = rumble.manager.GetWakeCount() - idleWakes;
+    EXPECT_GE(patternWakes, 2u);
+    EXPECT_LE(patternWakes, 4u);
+
+    // nothing wakes it up once the pattern is over
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(rumble.manager.GetWakeCount() - idleWakes, patternWakes);
+    EXPECT_EQ(rumble.sink->GetCalls().size(), 2u);
+}
+
+TEST(RumbleTest, PulsesOnlyPlayOnTheirHand) {
+    RumbleFixture rumble;
+    rumble.manager.startSimpleRumble(true, 0.05, 0.5f, 0.25f);
+    ASSERT_TRUE(rumble.sink->WaitForCalls(1));
+
+    // the runtime stops a pulse by itself once its duration is over, so there's no stop call afterwards
+    std::this_thread::sleep_for(100ms);
+    const std::vector<FakeHapticsSink::Call> calls = rumble.sink->GetCalls();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_TRUE(calls[0].apply);
+    EXPECT_EQ(calls[0].hand, HapticsSink::Hand::LEFT);
+    EXPECT_FLOAT_EQ(calls[0].amplitude, 0.25f);
+    ASSERT_TRUE(calls[0].duration.has_value());
+    EXPECT_LE(calls[0].duration.value(), 50ms);
+    EXPECT_GT(calls[0].duration.value(), 30ms);
+}
+
+TEST(RumbleTest, StopAlsoStopsPulses) {
+    RumbleFixture rumble;
+    rumble.manager.startSimpleRumble(false, 10.0, 0.5f, 0.5f);
+    ASSERT_TRUE(rumble.sink->WaitForCalls(1));
+
+    rumble.manager.stopMotor();
+    ASSERT_TRUE(rumble.sink->WaitForCalls(2));
+    std::this_thread::sleep_for(50ms);
+
+    const std::vector<FakeHapticsSink::Call> calls = rumble.sink->GetCalls();
+    ASSERT_EQ(calls.size(), 2u);
+    EXPECT_FALSE(calls[1].apply);
+    EXPECT_EQ(calls[1].hand, HapticsSink::Hand::BOTH);
+}
+
+TEST(RumbleTest, StopReachesTheRuntimeWhileIdle) {
+    RumbleFixture rumble;
+
+    // the game stops the motor without knowing whether anything is playing, which has to stop whatever the runtime still plays
+    rumble.manager.stopMotor();
+    ASSERT_TRUE(rumble.sink->WaitForCalls(1));
+    const std::vector<FakeHapticsSink::Call> calls = rumble.sink->GetCalls();
+    EXPECT_FALSE(calls[0].apply);
+    EXPECT_EQ(calls[0].hand, HapticsSink::Hand::BOTH);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "hooking/screen_tracker.h"
+
+// a fake piece of guest memory with the screen manager and its screen pointer table in it
+class GuestScreens {
+public:
+    GuestScreens() : m_memory(MEMORY_SIZE) {
+        WriteU32(SCREEN_MANAGER_INSTANCE_ADDR, SCREEN_MANAGER_ADDR);
+        WriteU32(SCREEN_MANAGER_ADDR + 0x18, SCREEN_TABLE_ADDR);
+    }
+
+    // what Cemu's memory base would be if the guest addresses started at the beginning of the buffer
+    uint64_t GetMemoryBaseAddress() const { return (uint64_t)m_memory.data() - MEMORY_START; }
+
+    void SetOpen(ScreenId screen, bool open) {
+        WriteU32(SCREEN_TABLE_ADDR + std::to_underlying(screen) * sizeof(uint32_t), open ? 0x20000000 + std::to_underlying(screen) : 0);
+    }
+    void RemoveScreenManager() { WriteU32(SCREEN_MANAGER_INSTANCE_ADDR, 0); }
+
+private:
+    static constexpr uint32_t MEMORY_START = 0x10000000;
+    static constexpr uint32_t SCREEN_MANAGER_INSTANCE_ADDR = 0x1047E650;
+    static constexpr uint32_t SCREEN_MANAGER_ADDR = 0x10480000;
+    static constexpr uint32_t SCREEN_TABLE_ADDR = 0x10481000;
+    static constexpr size_t MEMORY_SIZE = SCREEN_TABLE_ADDR + ScreenTracker::SCREEN_COUNT * sizeof(uint32_t) - MEMORY_START;
+
+    void WriteU32(uint32_t address, uint32_t value) {
+        BEType<uint32_t> beValue = value;
+        memcpy(m_memory.data() + (address - MEMORY_START), &beValue, sizeof(beValue));
+    }
+
+    std::vector<uint8_t> m_memory;
+};
+
+TEST(ScreenTrackerTest, ReportsOpenedAndClosedScreensOnce) {
+    GuestScreens guest;
+    ScreenTracker tracker;
+
+    guest.SetOpen(ScreenId::PauseMenuInfo_00, true);
+    guest.SetOpen(ScreenId::MessageDialog, true);
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    ASSERT_EQ(tracker.GetEvents().size(), 2u);
+    for (const auto& event : tracker.GetEvents()) {
+        EXPECT_TRUE(event.opened);
+        EXPECT_TRUE(event.screen == ScreenId::PauseMenuInfo_00 || event.screen == ScreenId::MessageDialog);
+    }
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::PauseMenuInfo_00));
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::MessageDialog));
+    EXPECT_FALSE(tracker.IsOpen(ScreenId::ShopBG_00));
+
+    // nothing changed, so there's nothing to report
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    EXPECT_TRUE(tracker.GetEvents().empty());
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::PauseMenuInfo_00));
+
+    guest.SetOpen(ScreenId::PauseMenuInfo_00, false);
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    ASSERT_EQ(tracker.GetEvents().size(), 1u);
+    EXPECT_EQ(tracker.GetEvents()[0].screen, ScreenId::PauseMenuInfo_00);
+    EXPECT_FALSE(tracker.GetEvents()[0].opened);
+    EXPECT_FALSE(tracker.IsOpen(ScreenId::PauseMenuInfo_00));
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::MessageDialog));
+}
+
+TEST(ScreenTrackerTest, ScreensAboveTheFirstWordArePublished) {
+    GuestScreens guest;
+    ScreenTracker tracker;
+
+    guest.SetOpen(ScreenId::ErrorViewerDRC_00, true);
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::ErrorViewerDRC_00));
+    EXPECT_TRUE(tracker.GetOpenScreens()[std::to_underlying(ScreenId::ErrorViewerDRC_00)]);
+    EXPECT_EQ(tracker.GetOpenScreens().count(), 1u);
+}
+
+TEST(ScreenTrackerTest, MissingScreenManagerClosesEverything) {
+    GuestScreens guest;
+    ScreenTracker tracker;
+
+    guest.SetOpen(ScreenId::ShopBG_00, true);
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    EXPECT_TRUE(tracker.IsOpen(ScreenId::ShopBG_00));
+
+    guest.RemoveScreenManager();
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    ASSERT_EQ(tracker.GetEvents().size(), 1u);
+    EXPECT_FALSE(tracker.GetEvents()[0].opened);
+    EXPECT_FALSE(tracker.IsOpen(ScreenId::ShopBG_00));
+    EXPECT_TRUE(tracker.GetOpenScreens().none());
+}
+
+TEST(ScreenTrackerTest, ReadsTheGuestMemoryThreeTimesPerScan) {
+    GuestScreens guest;
+    ScreenTracker tracker;
+
+    for (int i = 0; i < 10; i++) {
+        tracker.Scan(guest.GetMemoryBaseAddress());
+    }
+    EXPECT_EQ(tracker.GetScanCount(), 10u);
+    EXPECT_EQ(tracker.GetGuestReadCount(), 30u);
+
+    // without a screen manager only its pointer is read
+    guest.RemoveScreenManager();
+    tracker.Scan(guest.GetMemoryBaseAddress());
+    EXPECT_EQ(tracker.GetGuestReadCount(), 31u);
+}
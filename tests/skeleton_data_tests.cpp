@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "hooking/skeleton_data.h"
+
+#include <sstream>
+
+using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+// how the bone tables were parsed at startup before they were compiled, which is what the compiled tables have to match
+static float ParseWithStream(std::string_view str) {
+    std::istringstream stream{ std::string(str) };
+    float value = 0.0f;
+    stream >> value;
+    return value;
+}
+
+static std::array<float, 3> ParseVec3WithStream(std::string_view str) {
+    std::istringstream stream{ std::string(str) };
+    std::array<float, 3> values = {};
+    stream >> values[0] >> values[1] >> values[2];
+    return values;
+}
+
+static void ExpectBitEqual(float actual, float expected, std::string_view context) {
+    EXPECT_EQ(std::bit_cast<uint32_t>(actual), std::bit_cast<uint32_t>(expected)) << context << ": " << actual << " vs " << expected;
+}
+
+TEST(SkeletonDataTest, ParseFloatMatchesTheStreamBitForBit) {
+    const std::vector<std::string_view> numbers = {
+        "0", "-0", "1", "-1", "+2.5", "0.99426", "-0.00002", "1.5708", "-1.5708", "0.1", "0.3", "3.14159265", "100000", "16777217",
+        "0.000001", "123456789.123", "9999999999999999999", "0.0000000000000000001",
+        // decimals where rounding to a double first and then to a float ends up one bit off
+        "0.03593212179839611", "0.01577670592814684", "0.13513805717229843", "0.029479675926268101", "1.5559238791465759", "0.5369217693805695",
+    };
+    for (std::string_view number : numbers) {
+        ExpectBitEqual(SkeletonData::ParseFloat(number), ParseWithStream(number), number);
+    }
+}
+
+TEST(SkeletonDataTest, ParseFloatRejectsInvalidNumbers) {
+    for (std::string_view number : { "", "-", ".", "1.2.3", "1e5", "abc", "12345678901234567890" }) {
+        EXPECT_ANY_THROW(SkeletonData::ParseFloat(number)) << number;
+    }
+}
+
+TEST(SkeletonDataTest, CompiledTableMatchesTheStreamParse) {
+    size_t boneIdx = 0;
+    SkeletonData::ForEachBoneLine(SkeletonSources::GameROMPlayer, [&](size_t, std::string_view content) {
+        ASSERT_LT(boneIdx, PlayerSkeleton::BONE_COUNT);
+        const SkeletonData::BoneData& bone = PlayerSkeleton::BONES[boneIdx];
+
+        const size_t p1 = content.find('|');
+        const size_t p2 = content.find('|', p1 + 1);
+        EXPECT_EQ(bone.name, SkeletonData::Trim(content.substr(0, p1)));
+
+        const std::array<float, 3> position = ParseVec3WithStream(content.substr(p1 + 1, p2 - p1 - 1));
+        const std::array<float, 3> rotation = ParseVec3WithStream(content.substr(p2 + 1));
+        for (size_t i = 0; i < 3; i++) {
+            ExpectBitEqual(bone.position[i], position[i], bone.name);
+            ExpectBitEqual(bone.rotationEuler[i], rotation[i], bone.name);
+        }
+        boneIdx++;
+    });
+    EXPECT_EQ(boneIdx, PlayerSkeleton::BONE_COUNT);
+}
+
+TEST(SkeletonDataTest, ParentsFollowTheIndentation) {
+    EXPECT_EQ(PlayerSkeleton::BONES[0].parentIndex, -1);
+    for (size_t i = 1; i < PlayerSkeleton::BONE_COUNT; i++) {
+        EXPECT_LT(PlayerSkeleton::BONES[i].parentIndex, (int32_t)i) << PlayerSkeleton::BONES[i].name;
+    }
+
+    const int32_t arm1 = PlayerSkeleton::FindBone("Arm_1_L");
+    const int32_t arm2 = PlayerSkeleton::FindBone("Arm_2_L");
+    const int32_t armAssist = PlayerSkeleton::FindBone("Arm_1_Assist_L");
+    ASSERT_NE(arm1, -1);
+    EXPECT_EQ(PlayerSkeleton::BONES[arm2].parentIndex, arm1);
+    EXPECT_EQ(PlayerSkeleton::BONES[armAssist].parentIndex, arm1);
+    EXPECT_EQ(PlayerSkeleton::FindBone("NotABone"), -1);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "hooking/skeleton.h"
+
+using PlayerSkeleton = SkeletonData::CompiledSkeleton<SkeletonSources::GameROMPlayer>;
+
+static void ExpectNear(const glm::mat4& a, const glm::mat4& b, float epsilon = 0.0001f) {
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            EXPECT_NEAR(a[col][row], b[col][row], epsilon) << "at column " << col << ", row " << row;
+        }
+    }
+}
+
+class SkeletonTest : public testing::Test {
+protected:
+    void SetUp() override {
+        m_skeleton.Load(PlayerSkeleton::BONES, &PlayerSkeleton::FindBone);
+    }
+
+    // the world matrices that a full recalculation with 4x4 matrices would give
+    void ExpectWorldMatricesMatchHierarchy() {
+        std::vector<glm::mat4> expected(m_skeleton.GetBoneCount());
+        for (int i = 0; i < (int)m_skeleton.GetBoneCount(); i++) {
+            const int parentIndex = m_skeleton.GetParentIndex(i);
+            const glm::mat4 local = glm::mat4(m_skeleton.GetLocalMatrix(i));
+            expected[i] = parentIndex == -1 ? local : expected[parentIndex] * local;
+            ExpectNear(glm::mat4(m_skeleton.GetWorldMatrix(i)), expected[i]);
+        }
+    }
+
+    Skeleton m_skeleton;
+};
+
+TEST_F(SkeletonTest, LoadsEveryBoneOfTheDataFile) {
+    EXPECT_EQ(m_skeleton.GetBoneCount(), PlayerSkeleton::BONE_COUNT);
+    EXPECT_EQ(m_skeleton.GetBoneIndex("Root"), 0);
+    EXPECT_EQ(m_skeleton.GetParentIndex(m_skeleton.GetBoneIndex("Skl_Root")), m_skeleton.GetBoneIndex("Root"));
+    EXPECT_EQ(m_skeleton.GetParentIndex(m_skeleton.GetBoneIndex("Wrist_L")), m_skeleton.GetBoneIndex("Arm_2_L"));
+    EXPECT_EQ(m_skeleton.GetBoneIndex("NotABone"), -1);
+}
+
+TEST_F(SkeletonTest, ParentsPrecedeTheirChildren) {
+    for (int i = 0; i < (int)m_skeleton.GetBoneCount(); i++) {
+        EXPECT_LT(m_skeleton.GetParentIndex(i), i);
+    }
+}
+
+TEST_F(SkeletonTest, WorldMatricesMatchTheHierarchy) {
+    ExpectWorldMatricesMatchHierarchy();
+}
+
+TEST_F(SkeletonTest, ChangingALocalMatrixUpdatesItsDescendants) {
+    const int rootIndex = m_skeleton.GetBoneIndex("Skl_Root");
+    const int wristIndex = m_skeleton.GetBoneIndex("Wrist_R");
+    const glm::vec3 wristBefore = m_skeleton.GetWorldMatrix(wristIndex)[3];
+
+    const glm::vec3 offset = glm::vec3(1.0f, 2.0f, 3.0f);
+    m_skeleton.SetLocalMatrix(rootIndex, RigidPose(glm::angleAxis(0.5f, glm::vec3(0, 1, 0)), m_skeleton.GetLocalPos(rootIndex) + offset).ToMatrix34());
+    m_skeleton.UpdateWorldMatrices();
+
+    EXPECT_GT(glm::distance(glm::vec3(m_skeleton.GetWorldMatrix(wristIndex)[3]), wristBefore), 1.0f);
+    ExpectWorldMatricesMatchHierarchy();
+}
+
+TEST_F(SkeletonTest, LocalMatrixFromWorldInvertsTheParent) {
+    const int wristIndex = m_skeleton.GetBoneIndex("Wrist_L");
+    const glm::mat4 world = glm::mat4(m_skeleton.GetWorldMatrix(wristIndex));
+    ExpectNear(m_skeleton.CalculateLocalMatrixFromWorld(wristIndex, world), glm::mat4(m_skeleton.GetLocalMatrix(wristIndex)));
+}
+
+TEST_F(SkeletonTest, TwoBoneIKReachesTheTarget) {
+    for (const auto& [suffix, poleDir, forwardSign] : { std::tuple("_L", glm::vec3(-1.0f, -1.0f, -0.5f), 1.0f), std::tuple("_R", glm::vec3(1.0f, -1.0f, -0.5f), -1.0f) }) {
+        const int arm1 = m_skeleton.GetBoneIndex(std::string("Arm_1") + suffix);
+        const int arm2 = m_skeleton.GetBoneIndex(std::string("Arm_2") + suffix);
+        const int wrist = m_skeleton.GetBoneIndex(std::string("Wrist") + suffix);
+        ASSERT_NE(arm1, -1);
+
+        const glm::vec3 shoulderPos = m_skeleton.GetWorldMatrix(arm1)[3];
+        const glm::vec3 targetPos = shoulderPos + glm::normalize(glm::vec3(0.3f, -0.5f, 0.2f)) * 0.4f;
+        m_skeleton.SolveTwoBoneIK(arm1, arm2, wrist, targetPos, poleDir, forwardSign);
+
+        EXPECT_NEAR(glm::distance(glm::vec3(m_skeleton.GetWorldMatrix(arm1)[3]), shoulderPos), 0.0f, 0.0001f) << suffix;
+        EXPECT_NEAR(glm::distance(glm::vec3(m_skeleton.GetWorldMatrix(wrist)[3]), targetPos), 0.0f, 0.001f) << suffix;
+        ExpectWorldMatricesMatchHierarchy();
+    }
+}
+
+TEST_F(SkeletonTest, TwoBoneIKStretchesTowardsAnUnreachableTarget) {
+    const int arm1 = m_skeleton.GetBoneIndex("Arm_1_L");
+    const int arm2 = m_skeleton.GetBoneIndex("Arm_2_L");
+    const int wrist = m_skeleton.GetBoneIndex("Wrist_L");
+    const float armLength = glm::length(m_skeleton.GetLocalPos(arm2)) + glm::length(m_skeleton.GetLocalPos(wrist));
+
+    const glm::vec3 shoulderPos = m_skeleton.GetWorldMatrix(arm1)[3];
+    const glm::vec3 direction = glm::normalize(glm::vec3(0.0f, -1.0f, 1.0f));
+    m_skeleton.SolveTwoBoneIK(arm1, arm2, wrist, shoulderPos + direction * 10.0f, glm::vec3(-1.0f, -1.0f, -0.5f), 1.0f);
+
+    const glm::vec3 wristPos = m_skeleton.GetWorldMatrix(wrist)[3];
+    EXPECT_NEAR(glm::distance(wristPos, shoulderPos), armLength, 0.01f);
+    EXPECT_GT(glm::dot(glm::normalize(wristPos - shoulderPos), direction), 0.99f);
+}
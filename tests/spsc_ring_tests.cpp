@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "utils/spsc_ring.h"
+
+TEST(SpscRingTest, RejectsPushesWhenFull) {
+    SpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.IsEmpty());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.TryPush(i));
+    }
+    EXPECT_EQ(ring.GetSize(), 4u);
+    EXPECT_FALSE(ring.TryPush(4));
+    EXPECT_EQ(ring.GetSize(), 4u);
+
+    // popping a single item makes room for a single push again
+    int value = -1;
+    EXPECT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.TryPush(5));
+    EXPECT_FALSE(ring.TryPush(6));
+
+    for (int expected : { 1, 2, 3, 5 }) {
+        EXPECT_TRUE(ring.TryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(ring.TryPop(value));
+    EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRingTest, KeepsTheOrderWhileWrappingAround) {
+    SpscRing<uint32_t, 8> ring;
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    // push and pop uneven amounts so that the head and tail end up at every offset in the ring
+    for (uint32_t round = 0; round < 100; round++) {
+        for (uint32_t i = 0; i < 1 + round % 7 && ring.TryPush(pushed); i++) {
+            pushed++;
+        }
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < 1 + round % 5 && ring.TryPop(value); i++) {
+            EXPECT_EQ(value, popped);
+            popped++;
+        }
+        EXPECT_EQ(ring.GetSize(), pushed - popped);
+    }
+
+    uint32_t value = 0;
+    while (ring.TryPop(value)) {
+        EXPECT_EQ(value, popped);
+        popped++;
+    }
+    EXPECT_EQ(popped, pushed);
+    EXPECT_GT(pushed, 8u * 10);
+}
+
+TEST(SpscRingTest, HandsOverEveryItemBetweenTwoThreads) {
+    constexpr uint32_t ITEM_COUNT = 100000;
+    SpscRing<uint32_t, 16> ring;
+
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < ITEM_COUNT;) {
+            if (ring.TryPush(i)) i++;
+            else std::this_thread::yield();
+        }
+    });
+
+    uint32_t expected = 0;
+    while (expected < ITEM_COUNT) {
+        uint32_t value = 0;
+        if (!ring.TryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value, expected);
+        expected++;
+    }
+    producer.join();
+    EXPECT_TRUE(ring.IsEmpty());
+}
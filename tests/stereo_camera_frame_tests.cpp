@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "hooking/stereo_camera_frame.h"
+
+// provides the two calls that StereoCameraFrame::Sync makes on RND_Renderer
+struct FakeRenderer {
+    uint64_t viewsGeneration = 0;
+    std::optional<std::array<XrView, 2>> views;
+
+    uint64_t GetViewsGeneration() const { return viewsGeneration; }
+    std::optional<std::array<XrView, 2>> GetPoses() const { return views; }
+
+    void SetViews(const XrFovf& leftFov, const XrFovf& rightFov) {
+        std::array<XrView, 2> newViews = {};
+        newViews[0] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { -0.032f, 0.0f, 0.0f } }, leftFov };
+        newViews[1] = { XR_TYPE_VIEW, nullptr, { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.032f, 0.0f, 0.0f } }, rightFov };
+        views = newViews;
+        viewsGeneration++;
+    }
+};
+
+// an asymmetric fov like most headsets have, mirrored for the other eye
+static constexpr XrFovf LEFT_FOV = { -0.9f, 0.7f, 0.8f, -0.85f };
+static constexpr XrFovf RIGHT_FOV = { -0.7f, 0.9f, 0.8f, -0.85f };
+
+// the sead matrices are stored row by row, so a point is multiplied from the left in glm
+static glm::vec3 Project(const BEMatrix44& matrix, const glm::vec3& point) {
+    const glm::vec4 clip = glm::vec4(point, 1.0f) * matrix.getLE();
+    return glm::vec3(clip) / clip.w;
+}
+
+TEST(StereoCameraFrameTest, SyncFailsWithoutViews) {
+    FakeRenderer renderer;
+    StereoCameraFrame frame;
+    EXPECT_FALSE(frame.Sync(renderer));
+    EXPECT_EQ(frame.GetSyncCount(), 0u);
+}
+
+TEST(StereoCameraFrameTest, OnlySyncsWhenTheViewsChange) {
+    FakeRenderer renderer;
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+
+    StereoCameraFrame frame;
+    EXPECT_TRUE(frame.Sync(renderer));
+    EXPECT_TRUE(frame.Sync(renderer));
+    EXPECT_EQ(frame.GetSyncCount(), 1u);
+    EXPECT_FLOAT_EQ(frame.GetEye(1).pose.position.x, 0.032f);
+
+    renderer.SetViews(RIGHT_FOV, LEFT_FOV);
+    EXPECT_TRUE(frame.Sync(renderer));
+    EXPECT_EQ(frame.GetSyncCount(), 2u);
+    EXPECT_FLOAT_EQ(frame.GetEye(0).fov.angleLeft, RIGHT_FOV.angleLeft);
+}
+
+TEST(StereoCameraFrameTest, ProjectionMapsTheFrustumToClipSpace) {
+    FakeRenderer renderer;
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+    StereoCameraFrame frame;
+    ASSERT_TRUE(frame.Sync(renderer));
+
+    const float nearZ = 0.1f;
+    const float farZ = 25000.0f;
+    const auto& projection = frame.GetProjection(0, nearZ, farZ, 1.0f, 0.0f);
+
+    // the corners of the near plane end up on the corners of clip space, looking down -z
+    const glm::vec3 bottomLeft = Project(projection.matrix, glm::vec3(tanf(LEFT_FOV.angleLeft) * nearZ, tanf(LEFT_FOV.angleDown) * nearZ, -nearZ));
+    EXPECT_NEAR(bottomLeft.x, -1.0f, 0.0001f);
+    EXPECT_NEAR(bottomLeft.y, -1.0f, 0.0001f);
+    EXPECT_NEAR(bottomLeft.z, -1.0f, 0.0001f);
+
+    const glm::vec3 topRight = Project(projection.matrix, glm::vec3(tanf(LEFT_FOV.angleRight) * 100.0f, tanf(LEFT_FOV.angleUp) * 100.0f, -100.0f));
+    EXPECT_NEAR(topRight.x, 1.0f, 0.0001f);
+    EXPECT_NEAR(topRight.y, 1.0f, 0.0001f);
+
+    const glm::vec3 farPoint = Project(projection.matrix, glm::vec3(0.0f, 0.0f, -farZ));
+    EXPECT_NEAR(farPoint.z, 1.0f, 0.0001f);
+}
+
+TEST(StereoCameraFrameTest, DeviceMatrixRemapsDepth) {
+    FakeRenderer renderer;
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+    StereoCameraFrame frame;
+    ASSERT_TRUE(frame.Sync(renderer));
+
+    // the device z range of the game's projections is [0, 1], which sead gets with a scale of 0.5 and an offset of 1
+    const auto& projection = frame.GetProjection(1, 0.1f, 1000.0f, 0.5f, 1.0f);
+    EXPECT_NEAR(Project(projection.deviceMatrix, glm::vec3(0.0f, 0.0f, -0.1f)).z, 0.0f, 0.0001f);
+    EXPECT_NEAR(Project(projection.deviceMatrix, glm::vec3(0.0f, 0.0f, -1000.0f)).z, 1.0f, 0.0001f);
+}
+
+TEST(StereoCameraFrameTest, ReusesProjectionsUntilTheViewsChange) {
+    FakeRenderer renderer;
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+    StereoCameraFrame frame;
+    ASSERT_TRUE(frame.Sync(renderer));
+
+    for (int i = 0; i < 3; i++) {
+        frame.GetProjection(0, 0.1f, 25000.0f, 1.0f, 0.0f);
+        frame.GetProjection(0, 0.5f, 1000.0f, 1.0f, 0.0f);
+        frame.GetProjection(1, 0.1f, 25000.0f, 1.0f, 0.0f);
+    }
+    EXPECT_EQ(frame.GetProjectionBuildCount(), 3u);
+
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+    ASSERT_TRUE(frame.Sync(renderer));
+    frame.GetProjection(0, 0.1f, 25000.0f, 1.0f, 0.0f);
+    EXPECT_EQ(frame.GetProjectionBuildCount(), 4u);
+}
+
+TEST(StereoCameraFrameTest, ApplyToUsesTheGamesPlanes) {
+    FakeRenderer renderer;
+    renderer.SetViews(LEFT_FOV, RIGHT_FOV);
+    StereoCameraFrame frame;
+    ASSERT_TRUE(frame.Sync(renderer));
+
+    BESeadPerspectiveProjection perspectiveProjection = {};
+    perspectiveProjection.zNear = 0.25f;
+    perspectiveProjection.zFar = 500.0f;
+    perspectiveProjection.deviceZScale = 1.0f;
+    perspectiveProjection.deviceZOffset = 0.0f;
+    perspectiveProjection.dirty = true;
+    frame.ApplyTo(0, perspectiveProjection);
+
+    EXPECT_FALSE(perspectiveProjection.dirty.getLE());
+    EXPECT_FLOAT_EQ(perspectiveProjection.fovYRadiansOrAngle.getLE(), LEFT_FOV.angleUp - LEFT_FOV.angleDown);
+    EXPECT_FLOAT_EQ(perspectiveProjection.aspect.getLE(), (LEFT_FOV.angleRight - LEFT_FOV.angleLeft) / (LEFT_FOV.angleUp - LEFT_FOV.angleDown));
+
+    const auto& projection = frame.GetProjection(0, 0.25f, 500.0f, 1.0f, 0.0f);
+    EXPECT_EQ(std::memcmp(&perspectiveProjection.matrix, &projection.matrix, sizeof(BEMatrix44)), 0);
+    EXPECT_EQ(frame.GetProjectionBuildCount(), 1u);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// A stand-in for the parts of an OpenXR runtime that the renderer's frame loop calls, for testing what the layer does with the
+// times that the runtime reports. Nothing is rendered, and the runtime's clock only moves when the test advances it, so every XrTime
+// that it reports is known up front. The functions take the same arguments as the OpenXR functions that they're named after.
+class StubOpenXRRuntime {
+public:
+    StubOpenXRRuntime(XrTime startTime, XrDuration displayPeriod, XrDuration displayLatency): m_now(startTime), m_displayPeriod(displayPeriod), m_displayLatency(displayLatency) {}
+
+    void Advance(XrDuration duration) { m_now += duration; }
+
+    // what OpenXR::GetCurrentXrTime returns, which converts the current time of the OS to the runtime's clock
+    XrTime GetCurrentXrTime() const { return m_now; }
+
+    // every frame is displayed a fixed latency after the wait for it returned
+    XrResult xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
+        frameState->predictedDisplayTime = m_now + m_displayLatency;
+        frameState->predictedDisplayPeriod = m_displayPeriod;
+        frameState->shouldRender = XR_TRUE;
+        return XR_SUCCESS;
+    }
+
+    XrResult xrLocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState, uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrView* views) {
+        *viewCountOutput = 2;
+        if (viewCapacityInput < 2) {
+            return viewCapacityInput == 0 ? XR_SUCCESS : XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        viewState->viewStateFlags = XR_VIEW_STATE_ORIENTATION_VALID_BIT | XR_VIEW_STATE_POSITION_VALID_BIT;
+        for (uint32_t i = 0; i < 2; i++) {
+            views[i].pose = { { 0.0f, 0.0f, 0.0f, 1.0f }, { i == 0 ? -0.032f : 0.032f, 1.6f, 0.0f } };
+            views[i].fov = { -0.8f, 0.8f, 0.8f, -0.8f };
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
+        return XR_SUCCESS;
+    }
+
+    XrResult xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
+        m_submittedDisplayTimes.emplace_back(frameEndInfo->displayTime);
+        return XR_SUCCESS;
+    }
+
+    const std::vector<XrTime>& GetSubmittedDisplayTimes() const { return m_submittedDisplayTimes; }
+
+private:
+    XrTime m_now;
+    XrDuration m_displayPeriod;
+    XrDuration m_displayLatency;
+    std::vector<XrTime> m_submittedDisplayTimes;
+};
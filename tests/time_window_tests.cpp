@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "utils/time_window.h"
+
+static constexpr XrTime MS = 1'000'000;
+
+TEST(TimeWindowTest, DerivativeNeedsTwoSamples) {
+    TimeWindow<float> window(30 * MS);
+    EXPECT_TRUE(window.IsEmpty());
+    EXPECT_FLOAT_EQ(window.GetDerivative(), 0.0f);
+
+    window.Push(1000 * MS, 5.0f);
+    EXPECT_FLOAT_EQ(window.GetSpan(), 0.0f);
+    EXPECT_FLOAT_EQ(window.GetDerivative(), 0.0f);
+}
+
+TEST(TimeWindowTest, DerivativeIsTheSameAtAnyRate) {
+    // a value that rises by 2 per second, sampled at 90 and 500 Hz
+    for (XrTime interval : { 1'000'000'000 / 90, 1'000'000'000 / 500 }) {
+        TimeWindow<float> window(30 * MS);
+        for (XrTime time = 0; time < 500 * MS; time += interval) {
+            window.Push(time, 2.0f * ((float)time / 1e9f));
+        }
+        EXPECT_NEAR(window.GetDerivative(), 2.0f, 0.001f) << interval;
+
+        // the window covers at least its duration, but never more than one extra interval
+        EXPECT_GE(window.GetSpan(), 0.030f - 0.0001f) << interval;
+        EXPECT_LT(window.GetSpan(), 0.030f + (float)interval / 1e9f) << interval;
+    }
+}
+
+TEST(TimeWindowTest, DropsSamplesOlderThanTheDuration) {
+    TimeWindow<float> window(30 * MS);
+    window.Push(0, 100.0f);
+    window.Push(10 * MS, 0.0f);
+    window.Push(20 * MS, 0.0f);
+    window.Push(40 * MS, 0.0f);
+    window.Push(50 * MS, 0.0f);
+
+    // the sample at 0 ms was the newest one that's older than the duration until the one at 20 ms took over
+    EXPECT_EQ(window.Front().time, 20 * MS);
+    EXPECT_EQ(window.Back().time, 50 * MS);
+    EXPECT_FLOAT_EQ(window.GetDerivative(), 0.0f);
+
+    window.Clear();
+    EXPECT_TRUE(window.IsEmpty());
+    EXPECT_FLOAT_EQ(window.GetSpan(), 0.0f);
+}
+
+TEST(TimeWindowTest, LongGapKeepsTheLastSample) {
+    TimeWindow<float> window(30 * MS);
+    window.Push(0, 1.0f);
+    window.Push(10 * MS, 2.0f);
+    window.Push(1000 * MS, 3.0f);
+
+    // the previous sample stays so that there's still a span to take the derivative over
+    EXPECT_EQ(window.Front().time, 10 * MS);
+    EXPECT_NEAR(window.GetDerivative(), 1.0f / 0.99f, 0.0001f);
+}
+
+TEST(WindowedMaxTest, MatchesABruteForceMax) {
+    constexpr XrTime DURATION = 100 * MS;
+    WindowedMax<float> max(DURATION);
+    WindowedMin<float> min(DURATION);
+    std::vector<std::pair<XrTime, float>> samples;
+
+    // irregular intervals and values that go up and down, with repeated values
+    uint32_t random = 12345;
+    XrTime time = 0;
+    for (int i = 0; i < 2000; i++) {
+        random = random * 1664525 + 1013904223;
+        time += (1 + (random >> 24) % 20) * MS;
+        const float value = (float)((random >> 8) % 50);
+
+        max.Push(time, value);
+        min.Push(time, value);
+        samples.emplace_back(time, value);
+
+        float expectedMax = -std::numeric_limits<float>::infinity();
+        float expectedMin = std::numeric_limits<float>::infinity();
+        for (const auto& [sampleTime, sampleValue] : samples) {
+            if (time - sampleTime <= DURATION) {
+                expectedMax = std::max(expectedMax, sampleValue);
+                expectedMin = std::min(expectedMin, sampleValue);
+            }
+        }
+        ASSERT_EQ(max.Get(), expectedMax) << "at sample " << i;
+        ASSERT_EQ(min.Get(), expectedMin) << "at sample " << i;
+    }
+}
+
+TEST(WindowedMaxTest, ForgetsThePeakAfterTheDuration) {
+    WindowedMax<float> max(100 * MS);
+    max.Push(0, 10.0f);
+    max.Push(50 * MS, 3.0f);
+    EXPECT_EQ(max.Get(), 10.0f);
+
+    max.Push(100 * MS, 2.0f);
+    EXPECT_EQ(max.Get(), 10.0f);
+
+    max.Push(101 * MS, 1.0f);
+    EXPECT_EQ(max.Get(), 3.0f);
+
+    max.Clear();
+    EXPECT_TRUE(max.IsEmpty());
+}
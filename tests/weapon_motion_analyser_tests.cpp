@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include "hooking/motion_trace.h"
+#include "hooking/weapon.h"
+
+static constexpr XrTime MS = 1'000'000;
+static constexpr XrTime SECOND = 1000 * MS;
+
+// A swing down around the shoulder followed by a thrust forward, with the hand at rest before, between and after them.
+// The motion is a function of time, so it can be sampled at any rate.
+static constexpr XrTime SLASH_START = 200 * MS;
+static constexpr XrTime SLASH_DURATION = 400 * MS;
+static constexpr XrTime STAB_START = 900 * MS;
+static constexpr XrTime STAB_DURATION = 400 * MS;
+static constexpr XrTime SWING_DURATION = 1600 * MS;
+
+static MotionTrace::Sample SampleSwing(XrTime time) {
+    const glm::fvec3 headsetPos = glm::fvec3(0.0f, 1.6f, 0.0f);
+    const glm::fvec3 shoulderPos = glm::fvec3(0.2f, 1.4f, 0.0f);
+    const glm::fvec3 armOffset = glm::fvec3(0.0f, 0.0f, -0.4f);
+
+    // the slash turns the hand by 2 rad at up to 10 rad/s, which it's at halfway through
+    constexpr float SLASH_SPEED = 10.0f;
+    const float slashPhase = std::clamp((float)(time - SLASH_START) / (float)SLASH_DURATION, 0.0f, 1.0f);
+    const float slashSpeed = time > SLASH_START && time < SLASH_START + SLASH_DURATION ? SLASH_SPEED * sinf(glm::pi<float>() * slashPhase) : 0.0f;
+    const float slashAngle = SLASH_SPEED * (float)SLASH_DURATION / (float)SECOND / glm::pi<float>() * (1.0f - cosf(glm::pi<float>() * slashPhase));
+    const glm::fquat rotation = glm::angleAxis(-slashAngle, glm::fvec3(1.0f, 0.0f, 0.0f));
+    const glm::fvec3 angularVelocity = rotation * glm::fvec3(-slashSpeed, 0.0f, 0.0f);
+    glm::fvec3 position = shoulderPos + rotation * armOffset;
+    glm::fvec3 linearVelocity = glm::cross(angularVelocity, position - shoulderPos);
+
+    // the stab thrusts the hand forward along where it's pointing at up to 2 m/s, and pulls it back in the second half
+    constexpr float STAB_SPEED = 2.0f;
+    const float stabPhase = std::clamp((float)(time - STAB_START) / (float)STAB_DURATION, 0.0f, 1.0f);
+    const float stabSpeed = time > STAB_START && time < STAB_START + STAB_DURATION ? STAB_SPEED * sinf(glm::two_pi<float>() * stabPhase) : 0.0f;
+    const float stabDistance = STAB_SPEED * (float)STAB_DURATION / (float)SECOND / glm::two_pi<float>() * (1.0f - cosf(glm::two_pi<float>() * stabPhase));
+    const glm::fvec3 forward = rotation * glm::fvec3(0.0f, 0.0f, -1.0f);
+    position += forward * stabDistance;
+    linearVelocity += forward * stabSpeed;
+
+    return {
+        .time = time,
+        .handPose = { { rotation.x, rotation.y, rotation.z, rotation.w }, { position.x, position.y, position.z } },
+        .linearVelocity = { linearVelocity.x, linearVelocity.y, linearVelocity.z },
+        .angularVelocity = { angularVelocity.x, angularVelocity.y, angularVelocity.z },
+        .headsetPose = { { 0.0f, 0.0f, 0.0f, 1.0f }, { headsetPos.x, headsetPos.y, headsetPos.z } }
+    };
+}
+
+static std::vector<MotionTrace::Sample> ResampleSwing(uint32_t rate) {
+    std::vector<MotionTrace::Sample> samples;
+    for (XrTime time = 0; time <= SWING_DURATION; time += SECOND / rate) {
+        samples.emplace_back(SampleSwing(time));
+    }
+    return samples;
+}
+
+// an attack from when it was locked until it ended, where the hit only counts once it's active
+struct DetectedAttack {
+    AttackType attackType;
+    XrTime lockTime;
+    std::optional<XrTime> activeTime;
+    std::optional<XrTime> endTime;
+};
+
+static std::vector<DetectedAttack> DetectAttacks(const std::vector<MotionTrace::Sample>& samples) {
+    WeaponMotionAnalyser analyser;
+    std::vector<DetectedAttack> attacks;
+    for (const MotionTrace::Sample& sample : samples) {
+        analyser.Update(MotionTrace::GetHandLocation(sample), MotionTrace::GetHandVelocity(sample), MotionTrace::GetHeadsetMatrix(sample), sample.time);
+
+        const bool isLocked = !attacks.empty() && !attacks.back().endTime.has_value();
+        if (isLocked && attacks.back().attackType != analyser.GetAttackType()) {
+            attacks.back().endTime = sample.time;
+        }
+        if (analyser.GetAttackType() != AttackType::None && (attacks.empty() || attacks.back().endTime.has_value())) {
+            attacks.push_back({ analyser.GetAttackType(), sample.time });
+        }
+        if (analyser.IsAttacking() && !attacks.empty() && !attacks.back().activeTime.has_value()) {
+            attacks.back().activeTime = sample.time;
+        }
+    }
+    return attacks;
+}
+
+TEST(WeaponMotionAnalyserTest, DetectsTheSlashAndTheStab) {
+    const std::vector<DetectedAttack> attacks = DetectAttacks(ResampleSwing(500));
+    ASSERT_EQ(attacks.size(), 2u);
+
+    // each attack is locked and becomes active during its motion, and ends once the hand slows down or turns around
+    EXPECT_EQ(attacks[0].attackType, AttackType::Slash);
+    EXPECT_GT(attacks[0].lockTime, SLASH_START);
+    ASSERT_TRUE(attacks[0].activeTime.has_value());
+    EXPECT_GT(attacks[0].activeTime.value(), attacks[0].lockTime);
+    ASSERT_TRUE(attacks[0].endTime.has_value());
+    EXPECT_LE(attacks[0].endTime.value(), SLASH_START + SLASH_DURATION);
+
+    EXPECT_EQ(attacks[1].attackType, AttackType::Stab);
+    EXPECT_GT(attacks[1].lockTime, STAB_START);
+    ASSERT_TRUE(attacks[1].activeTime.has_value());
+    EXPECT_GT(attacks[1].activeTime.value(), attacks[1].lockTime);
+    ASSERT_TRUE(attacks[1].endTime.has_value());
+    EXPECT_LE(attacks[1].endTime.value(), STAB_START + STAB_DURATION);
+}
+
+// the same swing at game frame rates and at the input rates of headsets, which has to be classified the same way at each of them
+TEST(WeaponMotionAnalyserTest, ClassifiesTheSameSwingAtAnyRate) {
+    const std::vector<DetectedAttack> reference = DetectAttacks(ResampleSwing(500));
+
+    for (uint32_t rate : { 20u, 30u, 60u, 72u, 90u, 120u, 144u }) {
+        const std::vector<DetectedAttack> attacks = DetectAttacks(ResampleSwing(rate));
+        ASSERT_EQ(attacks.size(), reference.size()) << rate << " Hz";
+
+        // a change can only be seen at the next sample, and confirming an attack can take another one
+        const XrTime tolerance = 2 * SECOND / rate;
+        for (size_t i = 0; i < reference.size(); i++) {
+            EXPECT_EQ(attacks[i].attackType, reference[i].attackType) << rate << " Hz, attack " << i;
+            EXPECT_LE(std::abs(attacks[i].lockTime - reference[i].lockTime), tolerance) << rate << " Hz, attack " << i;
+            ASSERT_EQ(attacks[i].activeTime.has_value(), reference[i].activeTime.has_value()) << rate << " Hz, attack " << i;
+            ASSERT_EQ(attacks[i].endTime.has_value(), reference[i].endTime.has_value()) << rate << " Hz, attack " << i;
+            if (reference[i].activeTime.has_value()) {
+                EXPECT_LE(std::abs(attacks[i].activeTime.value() - reference[i].activeTime.value()), tolerance) << rate << " Hz, attack " << i;
+            }
+            if (reference[i].endTime.has_value()) {
+                EXPECT_LE(std::abs(attacks[i].endTime.value() - reference[i].endTime.value()), tolerance) << rate << " Hz, attack " << i;
+            }
+        }
+    }
+}
+
+// what the analyser of a hand decided after a sample
+struct Detection {
+    AttackType attackType;
+    bool isAttacking;
+    float attackStrength;
+};
+
+// feeds the samples of both hands through their own analyser, with the same calls as CemuHooks::hook_EnableWeaponAttackSensor
+static std::vector<Detection> Detect(const std::vector<MotionTrace::Sample>& samples) {
+    std::array<WeaponMotionAnalyser, 2> analysers;
+    std::vector<Detection> detections;
+    for (const MotionTrace::Sample& sample : samples) {
+        WeaponMotionAnalyser& analyser = analysers[sample.hand];
+        analyser.ResetIfWeaponTypeChanged((WeaponType)sample.weaponType);
+        analyser.Update(MotionTrace::GetHandLocation(sample), MotionTrace::GetHandVelocity(sample), MotionTrace::GetHeadsetMatrix(sample), sample.time);
+        detections.push_back({ analyser.GetAttackType(), analyser.IsAttacking(), analyser.GetAttackStrength() });
+    }
+    return detections;
+}
+
+// A trace is recorded from the same values that the analyser is given in the game, so replaying it has to detect exactly the same.
+// Both hands swing, the left one with a spear and a quarter second later, and the right one switches to another sword between its attacks.
+TEST(WeaponMotionAnalyserTest, RecordedTracesDetectTheSameAttacks) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / (std::string("RecordedTracesDetectTheSameAttacks") + std::string(MotionTrace::FILE_EXTENSION));
+
+    for (uint32_t rate : { 90u, 500u }) {
+        std::vector<MotionTrace::Sample> samples;
+        for (const MotionTrace::Sample& sample : ResampleSwing(rate)) {
+            MotionTrace::Sample& rightHand = samples.emplace_back(sample);
+            rightHand.hand = 1;
+            rightHand.weaponType = sample.time < (SLASH_START + SLASH_DURATION + STAB_START) / 2 ? LargeSword : SmallSword;
+
+            MotionTrace::Sample& leftHand = samples.emplace_back(SampleSwing(sample.time - 250 * MS));
+            leftHand.time = sample.time;
+            leftHand.hand = 0;
+            leftHand.weaponType = Spear;
+        }
+
+        {
+            MotionTrace::Writer writer;
+            ASSERT_TRUE(writer.Open(path));
+            for (const MotionTrace::Sample& sample : samples) {
+                writer.Record(sample.hand, sample.weaponType, MotionTrace::GetHandLocation(sample), MotionTrace::GetHandVelocity(sample), MotionTrace::GetHeadsetMatrix(sample), sample.time);
+            }
+        }
+        const std::optional<std::vector<MotionTrace::Sample>> recording = MotionTrace::Read(path);
+        std::filesystem::remove(path);
+        ASSERT_TRUE(recording.has_value());
+        ASSERT_EQ(recording->size(), samples.size());
+
+        const std::vector<Detection> expected = Detect(samples);
+        const std::vector<Detection> replayed = Detect(recording.value());
+        std::array<uint32_t, 2> attacks = { 0, 0 };
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(replayed[i].attackType, expected[i].attackType) << rate << " Hz, sample " << i;
+            ASSERT_EQ(replayed[i].isAttacking, expected[i].isAttacking) << rate << " Hz, sample " << i;
+            ASSERT_FLOAT_EQ(replayed[i].attackStrength, expected[i].attackStrength) << rate << " Hz, sample " << i;
+            if (expected[i].isAttacking && (i < 2 || !expected[i - 2].isAttacking)) {
+                attacks[samples[i].hand]++;
+            }
+        }
+
+        // the slash and the stab of both hands
+        EXPECT_EQ(attacks[0], 2u) << rate << " Hz";
+        EXPECT_EQ(attacks[1], 2u) << rate << " Hz";
+    }
+}
@@ -0,0 +1,306 @@
+#include "hooking/hook_capture.h"
+
+// Reads the hook captures that were recorded with the "Capture Hook Calls" button and reports how often and in which order
+// the graphic pack calls each hook per frame, so that changes to the patches or the hooks can be compared without running the game.
+//
+// Captured calls aren't timed, since the capture itself is slower than most hooks. Passing the statistics that the hook profiler
+// exported with "Export CSV" through --timings estimates the CPU time per frame of each hook from its mean duration instead.
+
+struct HookStats {
+    std::string name;
+    uint64_t calls = 0;
+    uint32_t minCallsPerFrame = std::numeric_limits<uint32_t>::max();
+    uint32_t maxCallsPerFrame = 0;
+    uint64_t pages = 0;
+    uint64_t writtenBytes = 0;
+    std::optional<double> meanUs;
+};
+
+struct CaptureReport {
+    uint32_t frames = 0;
+    uint64_t calls = 0;
+    uint64_t xrStates = 0;
+    std::vector<HookStats> hooks;
+    std::vector<uint32_t> sequence; // the hook ids of the calls in the frame that was selected with --sequence
+};
+
+template <typename T>
+static bool ReadValue(std::ifstream& file, T& value) {
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+static std::optional<CaptureReport> ReadCapture(const std::filesystem::path& path, std::optional<uint32_t> sequenceFrame) {
+    std::ifstream file(path, std::ios::binary);
+    HookCapture::Header header;
+    if (!file.is_open() || !ReadValue(file, header)) {
+        return std::nullopt;
+    }
+    if (header.magic != HookCapture::MAGIC || header.version != HookCapture::VERSION || header.registersSize != sizeof(PPCInterpreter_t)) {
+        Log::print<ERROR>("{} was captured by an incompatible version of BetterVR", path.string());
+        return std::nullopt;
+    }
+
+    CaptureReport report;
+    std::vector<uint32_t> frameCalls;
+    std::vector<char> skipped;
+    const auto skip = [&](size_t size) {
+        skipped.resize(size);
+        return (bool)file.read(skipped.data(), (std::streamsize)size);
+    };
+    const auto getHook = [&](uint32_t hookId) -> HookStats& {
+        if (report.hooks.size() <= hookId) {
+            report.hooks.resize(hookId + 1);
+            frameCalls.resize(hookId + 1, 0);
+        }
+        // a hook that shows up for the first time wasn't called in any of the previous frames
+        if (report.hooks[hookId].calls == 0 && report.frames > 0) {
+            report.hooks[hookId].minCallsPerFrame = 0;
+        }
+        return report.hooks[hookId];
+    };
+
+    // a capture of a game that crashed can end in the middle of a record, in which case everything before it is still used
+    bool truncated = false;
+    HookCapture::RecordType type;
+    while (!truncated && ReadValue(file, type)) {
+        switch (type) {
+            case HookCapture::RecordType::HOOK: {
+                uint32_t hookId = 0;
+                uint16_t nameLength = 0;
+                if (!ReadValue(file, hookId) || !ReadValue(file, nameLength)) {
+                    truncated = true;
+                    break;
+                }
+                HookStats& hook = getHook(hookId);
+                hook.name.resize(nameLength);
+                if (!file.read(hook.name.data(), nameLength)) {
+                    truncated = true;
+                    break;
+                }
+                break;
+            }
+            case HookCapture::RecordType::FRAME: {
+                uint32_t frameIndex = 0;
+                if (!ReadValue(file, frameIndex)) {
+                    truncated = true;
+                    break;
+                }
+                for (size_t i = 0; i < report.hooks.size(); i++) {
+                    report.hooks[i].minCallsPerFrame = std::min(report.hooks[i].minCallsPerFrame, frameCalls[i]);
+                    report.hooks[i].maxCallsPerFrame = std::max(report.hooks[i].maxCallsPerFrame, frameCalls[i]);
+                    frameCalls[i] = 0;
+                }
+                report.frames++;
+                break;
+            }
+            case HookCapture::RecordType::XR_STATE: {
+                uint32_t inputSize = 0;
+                if (!ReadValue(file, inputSize) || !skip(inputSize + sizeof(uint8_t) + sizeof(std::array<XrView, 2>))) {
+                    truncated = true;
+                    break;
+                }
+                report.xrStates++;
+                break;
+            }
+            case HookCapture::RecordType::CALL: {
+                HookCapture::CallHeader call;
+                if (!ReadValue(file, call)) {
+                    truncated = true;
+                    break;
+                }
+                for (uint32_t i = 0; i < call.pageCount; i++) {
+                    uint32_t address = 0;
+                    uint8_t stored = 0;
+                    if (!ReadValue(file, address) || !ReadValue(file, stored) || (stored != 0 && !skip(header.pageSize))) {
+                        truncated = true;
+                        break;
+                    }
+                }
+                uint64_t writtenBytes = 0;
+                for (uint32_t i = 0; i < call.writeCount && !truncated; i++) {
+                    uint32_t address = 0;
+                    uint32_t size = 0;
+                    if (!ReadValue(file, address) || !ReadValue(file, size) || !skip(size)) {
+                        truncated = true;
+                        break;
+                    }
+                    writtenBytes += size;
+                }
+                if (truncated) {
+                    break;
+                }
+
+                HookStats& hook = getHook(call.hookId);
+                hook.calls++;
+                hook.pages += call.pageCount;
+                hook.writtenBytes += writtenBytes;
+                frameCalls[call.hookId]++;
+                report.calls++;
+                if (sequenceFrame.has_value() && report.frames == sequenceFrame.value()) {
+                    report.sequence.emplace_back(call.hookId);
+                }
+                break;
+            }
+            default: {
+                Log::print<ERROR>("{} contains an unknown record type {}", path.string(), std::to_underlying(type));
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (truncated) {
+        Log::print<WARNING>("{} ends in the middle of a record, it was probably captured while the game crashed", path.string());
+    }
+
+    // calls after the last frame record belong to a frame that wasn't finished when the capture stopped
+    for (HookStats& hook : report.hooks) {
+        if (hook.minCallsPerFrame == std::numeric_limits<uint32_t>::max()) {
+            hook.minCallsPerFrame = 0;
+        }
+    }
+    return report;
+}
+
+// reads the mean duration of every hook from a BetterVR_hooks_[time].csv file
+static bool ReadTimings(const std::filesystem::path& path, CaptureReport& report) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line) || !line.starts_with("hook,calls,")) {
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        std::vector<std::string_view> fields;
+        for (auto field : std::views::split(std::string_view(line), ',')) {
+            fields.emplace_back(field.begin(), field.end());
+        }
+        if (fields.size() < 6) {
+            continue;
+        }
+
+        double meanUs = 0.0;
+        std::from_chars(fields[5].data(), fields[5].data() + fields[5].size(), meanUs);
+        for (HookStats& hook : report.hooks) {
+            if (hook.name == fields[0]) {
+                hook.meanUs = meanUs;
+            }
+        }
+    }
+    return true;
+}
+
+static void PrintReport(const CaptureReport& report, bool csv) {
+    const double frames = (double)std::max<uint32_t>(report.frames, 1);
+
+    std::vector<const HookStats*> hooks;
+    for (const HookStats& hook : report.hooks) {
+        if (hook.calls > 0) {
+            hooks.emplace_back(&hook);
+        }
+    }
+    std::ranges::sort(hooks, std::greater{}, &HookStats::calls);
+
+    if (csv) {
+        std::cout << "hook,calls,calls_per_frame,min_calls_per_frame,max_calls_per_frame,pages_per_call,written_bytes_per_call,mean_us,us_per_frame\n";
+        for (const HookStats* hook : hooks) {
+            const double callsPerFrame = (double)hook->calls / frames;
+            std::cout << std::format("{},{},{:.2f},{},{},{:.2f},{:.2f},{},{}\n",
+                hook->name, hook->calls, callsPerFrame, hook->minCallsPerFrame, hook->maxCallsPerFrame,
+                (double)hook->pages / (double)hook->calls, (double)hook->writtenBytes / (double)hook->calls,
+                hook->meanUs.has_value() ? std::format("{:.3f}", hook->meanUs.value()) : "",
+                hook->meanUs.has_value() ? std::format("{:.3f}", hook->meanUs.value() * callsPerFrame) : ""
+            );
+        }
+        return;
+    }
+
+    std::cout << std::format("{} frames, {} hook calls ({:.1f} per frame), {} controller or headset updates\n\n", report.frames, report.calls, (double)report.calls / frames, report.xrStates);
+    std::cout << std::format("{:<40} {:>10} {:>10} {:>12} {:>10} {:>12}\n", "hook", "calls", "per frame", "min-max", "pages", "us/frame");
+    double totalUsPerFrame = 0.0;
+    bool hasAllTimings = true;
+    for (const HookStats* hook : hooks) {
+        const double callsPerFrame = (double)hook->calls / frames;
+        std::string usPerFrame = "-";
+        if (hook->meanUs.has_value()) {
+            usPerFrame = std::format("{:.2f}", hook->meanUs.value() * callsPerFrame);
+            totalUsPerFrame += hook->meanUs.value() * callsPerFrame;
+        }
+        else {
+            hasAllTimings = false;
+        }
+        std::cout << std::format("{:<40} {:>10} {:>10.1f} {:>12} {:>10.1f} {:>12}\n",
+            hook->name, hook->calls, callsPerFrame, std::format("{}-{}", hook->minCallsPerFrame, hook->maxCallsPerFrame), (double)hook->pages / (double)hook->calls, usPerFrame
+        );
+    }
+    if (totalUsPerFrame > 0.0) {
+        std::cout << std::format("\nestimated hook time per frame: {:.2f} us{}\n", totalUsPerFrame, hasAllTimings ? "" : " (some hooks have no timings)");
+    }
+
+    if (!report.sequence.empty()) {
+        // consecutive calls of the same hook are merged, which keeps the ~100 bone matrix calls on a single line
+        std::cout << "\ncall order:\n";
+        for (size_t i = 0; i < report.sequence.size();) {
+            size_t count = 1;
+            while (i + count < report.sequence.size() && report.sequence[i + count] == report.sequence[i]) {
+                count++;
+            }
+            std::cout << std::format("  {} x{}\n", report.hooks[report.sequence[i]].name, count);
+            i += count;
+        }
+    }
+}
+
+static void PrintUsage() {
+    std::cerr << std::format(
+        "usage: hook_capture_report [options] <capture{}>\n"
+        "  --csv                print one line per hook as CSV\n"
+        "  --sequence <frame>   print the order in which the hooks were called during a frame\n"
+        "  --timings <csv>      estimate the time per frame from the statistics of the hook profiler\n",
+        HookCapture::FILE_EXTENSION
+    );
+}
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    std::optional<uint32_t> sequenceFrame;
+    std::optional<std::filesystem::path> timingsPath;
+    std::optional<std::filesystem::path> capturePath;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--csv") {
+            csv = true;
+        }
+        else if (arg == "--sequence" && i + 1 < argc) {
+            sequenceFrame = (uint32_t)std::stoul(argv[++i]);
+        }
+        else if (arg == "--timings" && i + 1 < argc) {
+            timingsPath = argv[++i];
+        }
+        else if (arg.starts_with("--") || capturePath.has_value()) {
+            PrintUsage();
+            return 1;
+        }
+        else {
+            capturePath = arg;
+        }
+    }
+
+    if (!capturePath.has_value()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::optional<CaptureReport> report = ReadCapture(capturePath.value(), sequenceFrame);
+    if (!report.has_value()) {
+        Log::print<ERROR>("Couldn't read {}, it's either missing, truncated or not a hook capture", capturePath->string());
+        return 1;
+    }
+    if (timingsPath.has_value() && !ReadTimings(timingsPath.value(), report.value())) {
+        Log::print<ERROR>("Couldn't read {}, it's either missing or not exported by the hook profiler", timingsPath->string());
+        return 1;
+    }
+
+    PrintReport(report.value(), csv);
+    return 0;
+}
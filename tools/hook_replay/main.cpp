@@ -0,0 +1,299 @@
+#include "hooking/hook_capture.h"
+#include "hooking/offline_hooks.h"
+
+// Replays hook captures that were recorded with the "Capture Hook Calls" button through the real hooks, so that changes to the
+// hooks can be checked against what they did in the game and timed without running Cemu, the game or a headset.
+//
+// Every captured call loads the guest memory pages that the call touched into a GuestArena, runs the hook with the registers that
+// it was called with and compares the registers and the written bytes with the ones that were captured. The controller and headset
+// state is played back through an OfflineHookHost, in the order in which the hooks saw it.
+//
+// The hooks keep state between calls (the actor types, the held weapons, the camera of the current frame, ...), so a replay is only
+// expected to match from the start of a capture onwards, and calls that were made on other threads in the game all run on this one.
+
+struct HookReplayStats {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t registerMismatches = 0;
+    uint64_t memoryMismatches = 0;
+    double totalUs = 0.0;
+    double maxUs = 0.0;
+};
+
+struct ReplayReport {
+    uint32_t frames = 0;
+    uint64_t calls = 0;
+    uint64_t skippedCalls = 0;
+    std::vector<HookReplayStats> hooks;
+};
+
+template <typename T>
+static bool ReadValue(std::ifstream& file, T& value) {
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+static std::optional<ReplayReport> ReplayCapture(const std::filesystem::path& path, OfflineHooks& hooks, bool verbose) {
+    std::ifstream file(path, std::ios::binary);
+    HookCapture::Header header;
+    if (!file.is_open() || !ReadValue(file, header)) {
+        return std::nullopt;
+    }
+    if (header.magic != HookCapture::MAGIC || header.version != HookCapture::VERSION || header.registersSize != sizeof(PPCInterpreter_t) || header.pageSize != HookCapture::PAGE_SIZE) {
+        Log::print<ERROR>("{} was captured by an incompatible version of BetterVR", path.string());
+        return std::nullopt;
+    }
+
+    GuestArena& arena = hooks.GetArena();
+    OfflineHookHost& host = hooks.GetHost();
+
+    ReplayReport report;
+    std::vector<HookProfiler::HookFunction> hookFunctions;
+    // the last stored copy of every page, which is what a page that isn't stored again contained before the call
+    std::unordered_map<uint32_t, std::vector<uint8_t>> pages;
+    std::vector<uint32_t> pageLoads;
+    std::vector<uint8_t> written;
+
+    const auto getHook = [&](uint32_t hookId) -> HookReplayStats& {
+        if (report.hooks.size() <= hookId) {
+            report.hooks.resize(hookId + 1);
+            hookFunctions.resize(hookId + 1, nullptr);
+        }
+        return report.hooks[hookId];
+    };
+
+    bool truncated = false;
+    HookCapture::RecordType type;
+    while (!truncated && ReadValue(file, type)) {
+        switch (type) {
+            case HookCapture::RecordType::HOOK: {
+                uint32_t hookId = 0;
+                uint16_t nameLength = 0;
+                if (!ReadValue(file, hookId) || !ReadValue(file, nameLength)) {
+                    truncated = true;
+                    break;
+                }
+                HookReplayStats& hook = getHook(hookId);
+                hook.name.resize(nameLength);
+                if (!file.read(hook.name.data(), nameLength)) {
+                    truncated = true;
+                    break;
+                }
+                hookFunctions[hookId] = hooks.Find(hook.name);
+                if (hookFunctions[hookId] == nullptr) {
+                    Log::print<WARNING>("{} isn't registered by CemuHooks anymore, its calls are skipped", hook.name);
+                }
+                break;
+            }
+            case HookCapture::RecordType::FRAME: {
+                uint32_t frameIndex = 0;
+                if (!ReadValue(file, frameIndex)) {
+                    truncated = true;
+                    break;
+                }
+                host.EndFrame();
+                report.frames++;
+                break;
+            }
+            case HookCapture::RecordType::XR_STATE: {
+                uint32_t inputSize = 0;
+                InputState input = {};
+                uint8_t hasViews = 0;
+                std::array<XrView, 2> views = {};
+                if (!ReadValue(file, inputSize)) {
+                    truncated = true;
+                    break;
+                }
+                if (inputSize != sizeof(InputState)) {
+                    Log::print<ERROR>("{} stores a controller state of {} bytes, but this version of BetterVR uses {} bytes", path.string(), inputSize, sizeof(InputState));
+                    return std::nullopt;
+                }
+                if (!ReadValue(file, input) || !ReadValue(file, hasViews) || !ReadValue(file, views)) {
+                    truncated = true;
+                    break;
+                }
+                host.SetInput(input);
+                host.SetViews(hasViews != 0 ? std::optional(views) : std::nullopt);
+                break;
+            }
+            case HookCapture::RecordType::CALL: {
+                HookCapture::CallHeader call;
+                if (!ReadValue(file, call)) {
+                    truncated = true;
+                    break;
+                }
+
+                pageLoads.clear();
+                for (uint32_t i = 0; i < call.pageCount; i++) {
+                    uint32_t address = 0;
+                    uint8_t stored = 0;
+                    if (!ReadValue(file, address) || !ReadValue(file, stored)) {
+                        truncated = true;
+                        break;
+                    }
+                    if (stored != 0) {
+                        std::vector<uint8_t>& page = pages[address];
+                        page.resize(HookCapture::PAGE_SIZE);
+                        if (!file.read(reinterpret_cast<char*>(page.data()), HookCapture::PAGE_SIZE)) {
+                            truncated = true;
+                            break;
+                        }
+                    }
+                    pageLoads.emplace_back(address);
+                }
+
+                // the pages have to be loaded before the call, since the replayed calls before this one wrote to them as well
+                for (uint32_t address : pageLoads) {
+                    if (auto it = pages.find(address); it != pages.end()) {
+                        arena.Write(address, it->second.data(), HookCapture::PAGE_SIZE);
+                    }
+                }
+
+                HookReplayStats& hook = getHook(call.hookId);
+                const HookProfiler::HookFunction hookFunction = hookFunctions[call.hookId];
+                std::optional<double> durationUs;
+                PPCInterpreter_t hCPU = call.before;
+                if (!truncated && hookFunction != nullptr) {
+                    const auto start = std::chrono::steady_clock::now();
+                    hookFunction(&hCPU);
+                    durationUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                }
+
+                bool memoryMatches = true;
+                for (uint32_t i = 0; i < call.writeCount && !truncated; i++) {
+                    uint32_t address = 0;
+                    uint32_t size = 0;
+                    if (!ReadValue(file, address) || !ReadValue(file, size)) {
+                        truncated = true;
+                        break;
+                    }
+                    written.resize(size);
+                    if (!file.read(reinterpret_cast<char*>(written.data()), size)) {
+                        truncated = true;
+                        break;
+                    }
+                    if (durationUs.has_value() && memcmp(arena.GetBase() + address, written.data(), size) != 0) {
+                        memoryMatches = false;
+                        if (verbose) {
+                            Log::print<WARNING>("{} wrote different bytes to {:08x} than in call {}", hook.name, address, report.calls);
+                        }
+                    }
+                }
+                if (truncated) {
+                    break;
+                }
+
+                report.calls++;
+                if (!durationUs.has_value()) {
+                    report.skippedCalls++;
+                    break;
+                }
+
+                const bool registersMatch = memcmp(&hCPU, &call.after, sizeof(PPCInterpreter_t)) == 0;
+                if (!registersMatch && verbose) {
+                    Log::print<WARNING>("{} returned different registers than in call {}", hook.name, report.calls - 1);
+                }
+                hook.calls++;
+                hook.registerMismatches += registersMatch ? 0 : 1;
+                hook.memoryMismatches += memoryMatches ? 0 : 1;
+                hook.totalUs += durationUs.value();
+                hook.maxUs = std::max(hook.maxUs, durationUs.value());
+                break;
+            }
+            default: {
+                Log::print<ERROR>("{} contains an unknown record type {}", path.string(), std::to_underlying(type));
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (truncated) {
+        Log::print<WARNING>("{} ends in the middle of a record, it was probably captured while the game crashed", path.string());
+    }
+    return report;
+}
+
+static uint64_t PrintReport(const ReplayReport& report, bool csv) {
+    std::vector<const HookReplayStats*> hooks;
+    for (const HookReplayStats& hook : report.hooks) {
+        if (hook.calls > 0) {
+            hooks.emplace_back(&hook);
+        }
+    }
+    std::ranges::sort(hooks, std::greater{}, &HookReplayStats::totalUs);
+
+    uint64_t mismatchedCalls = 0;
+    for (const HookReplayStats* hook : hooks) {
+        mismatchedCalls += std::max(hook->registerMismatches, hook->memoryMismatches);
+    }
+
+    if (csv) {
+        std::cout << "hook,calls,register_mismatches,memory_mismatches,mean_us,max_us,us_per_frame\n";
+        for (const HookReplayStats* hook : hooks) {
+            std::cout << std::format("{},{},{},{},{:.3f},{:.3f},{:.3f}\n",
+                hook->name, hook->calls, hook->registerMismatches, hook->memoryMismatches,
+                hook->totalUs / (double)hook->calls, hook->maxUs, hook->totalUs / (double)std::max<uint32_t>(report.frames, 1)
+            );
+        }
+        return mismatchedCalls;
+    }
+
+    std::cout << std::format("{} frames, {} hook calls replayed, {} skipped\n\n", report.frames, report.calls - report.skippedCalls, report.skippedCalls);
+    std::cout << std::format("{:<40} {:>10} {:>12} {:>12} {:>10} {:>10} {:>10}\n", "hook", "calls", "reg. diffs", "mem. diffs", "mean us", "max us", "us/frame");
+    double totalUs = 0.0;
+    for (const HookReplayStats* hook : hooks) {
+        std::cout << std::format("{:<40} {:>10} {:>12} {:>12} {:>10.3f} {:>10.3f} {:>10.3f}\n",
+            hook->name, hook->calls, hook->registerMismatches, hook->memoryMismatches,
+            hook->totalUs / (double)hook->calls, hook->maxUs, hook->totalUs / (double)std::max<uint32_t>(report.frames, 1)
+        );
+        totalUs += hook->totalUs;
+    }
+    std::cout << std::format("\nhook time per frame: {:.2f} us, {} calls didn't match the capture\n", totalUs / (double)std::max<uint32_t>(report.frames, 1), mismatchedCalls);
+    return mismatchedCalls;
+}
+
+static void PrintUsage() {
+    std::cerr << std::format(
+        "usage: hook_replay [options] <capture{}>\n"
+        "  --csv       print one line per hook as CSV\n"
+        "  --verbose   print every call whose registers or written memory differ from the capture\n",
+        HookCapture::FILE_EXTENSION
+    );
+}
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    bool verbose = false;
+    std::optional<std::filesystem::path> capturePath;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--csv") {
+            csv = true;
+        }
+        else if (arg == "--verbose") {
+            verbose = true;
+        }
+        else if (arg.starts_with("--") || capturePath.has_value()) {
+            PrintUsage();
+            return 1;
+        }
+        else {
+            capturePath = arg;
+        }
+    }
+
+    if (!capturePath.has_value()) {
+        PrintUsage();
+        return 1;
+    }
+
+    OfflineHooks hooks;
+    std::optional<ReplayReport> report = ReplayCapture(capturePath.value(), hooks, verbose);
+    if (!report.has_value()) {
+        Log::print<ERROR>("Couldn't read {}, it's either missing, truncated or not a hook capture", capturePath->string());
+        return 1;
+    }
+
+    // returns 2 if any call differs, so that scripts can tell a changed hook apart from a capture that couldn't be read
+    return PrintReport(report.value(), csv) > 0 ? 2 : 0;
+}
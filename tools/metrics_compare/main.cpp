@@ -0,0 +1,215 @@
+// Compares two metrics files that were written with BETTERVR_METRICS_CSV, so that a change that's supposed to make something faster
+// can be checked by playing the same section of the game before and after it.
+// It also compares two results files of BetterVR_Bench --json, where every benchmark is treated as a histogram of nanoseconds.
+//
+// Counters are compared by their average rate, gauges by their average value and histograms by their mean, p50 and p99,
+// which the metrics registry writes as running totals, so only the last row of a histogram is used.
+
+struct MetricStats {
+    std::string type;
+    double perSecondSum = 0.0;
+    double valueSum = 0.0;
+    uint32_t rows = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+};
+
+struct Comparison {
+    std::string metric;
+    std::string type;
+    std::string stat;
+    double before;
+    double after;
+
+    double GetChangePercent() const {
+        return before != 0.0 ? (after - before) / before * 100.0 : 0.0;
+    }
+};
+
+static std::vector<std::string_view> SplitLine(std::string_view line) {
+    std::vector<std::string_view> fields;
+    for (auto field : std::views::split(line, ',')) {
+        fields.emplace_back(field.begin(), field.end());
+    }
+    return fields;
+}
+
+static double ParseNumber(std::string_view field) {
+    double value = 0.0;
+    std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+// returns the raw value of a field on a line that BetterVR_Bench wrote, which never contains nested objects or escaped quotes
+static std::string_view FindJsonField(std::string_view line, std::string_view key) {
+    const std::string pattern = std::format("\"{}\":", key);
+    const size_t start = line.find(pattern);
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    std::string_view value = line.substr(start + pattern.size());
+    if (value.starts_with('"')) {
+        value.remove_prefix(1);
+        return value.substr(0, value.find('"'));
+    }
+    return value.substr(0, value.find_first_of(",}"));
+}
+
+static std::map<std::string, MetricStats> ReadBenchResults(std::ifstream& file) {
+    std::map<std::string, MetricStats> metrics;
+    std::string line;
+    while (std::getline(file, line)) {
+        const std::string_view name = FindJsonField(line, "name");
+        if (name.empty()) {
+            continue;
+        }
+        metrics[std::string(name)] = {
+            .type = "histogram",
+            .rows = 1,
+            .mean = ParseNumber(FindJsonField(line, "mean_ns")),
+            .p50 = ParseNumber(FindJsonField(line, "p50_ns")),
+            .p99 = ParseNumber(FindJsonField(line, "p99_ns"))
+        };
+    }
+    return metrics;
+}
+
+static std::optional<std::map<std::string, MetricStats>> ReadMetrics(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        return std::nullopt;
+    }
+    if (line.starts_with("{\"benchmarks\":")) {
+        return ReadBenchResults(file);
+    }
+    if (!line.starts_with("time_s,metric,type,")) {
+        return std::nullopt;
+    }
+
+    std::map<std::string, MetricStats> metrics;
+    while (std::getline(file, line)) {
+        const std::vector<std::string_view> fields = SplitLine(line);
+        if (fields.size() < 8) {
+            continue;
+        }
+
+        MetricStats& stats = metrics[std::string(fields[1])];
+        stats.type = fields[2];
+        stats.perSecondSum += ParseNumber(fields[4]);
+        stats.valueSum += ParseNumber(fields[5]);
+        stats.rows++;
+        stats.mean = ParseNumber(fields[5]);
+        stats.p50 = ParseNumber(fields[6]);
+        stats.p99 = ParseNumber(fields[7]);
+    }
+    return metrics;
+}
+
+static std::vector<Comparison> CompareMetrics(const std::map<std::string, MetricStats>& before, const std::map<std::string, MetricStats>& after) {
+    std::vector<Comparison> comparisons;
+    for (const auto& [name, stats] : before) {
+        const auto it = after.find(name);
+        if (it == after.end() || it->second.type != stats.type || stats.rows == 0 || it->second.rows == 0) {
+            continue;
+        }
+        const MetricStats& other = it->second;
+
+        if (stats.type == "counter") {
+            comparisons.emplace_back(Comparison{ name, stats.type, "per_second", stats.perSecondSum / stats.rows, other.perSecondSum / other.rows });
+        }
+        else if (stats.type == "gauge") {
+            comparisons.emplace_back(Comparison{ name, stats.type, "value", stats.valueSum / stats.rows, other.valueSum / other.rows });
+        }
+        else if (stats.type == "histogram") {
+            comparisons.emplace_back(Comparison{ name, stats.type, "mean", stats.mean, other.mean });
+            comparisons.emplace_back(Comparison{ name, stats.type, "p50", stats.p50, other.p50 });
+            comparisons.emplace_back(Comparison{ name, stats.type, "p99", stats.p99, other.p99 });
+        }
+    }
+    return comparisons;
+}
+
+static void PrintJson(const std::vector<Comparison>& comparisons) {
+    std::cout << "{\"comparisons\":[\n";
+    for (size_t i = 0; i < comparisons.size(); i++) {
+        const Comparison& comparison = comparisons[i];
+        std::cout << std::format("{}{{\"metric\":\"{}\",\"type\":\"{}\",\"stat\":\"{}\",\"before\":{},\"after\":{},\"change_percent\":{:.2f}}}\n",
+            i == 0 ? "" : ",", comparison.metric, comparison.type, comparison.stat, comparison.before, comparison.after, comparison.GetChangePercent()
+        );
+    }
+    std::cout << "]}\n";
+}
+
+static void PrintTable(const std::vector<Comparison>& comparisons) {
+    std::cout << std::format("{:<40} {:<10} {:>14} {:>14} {:>9}\n", "metric", "stat", "before", "after", "change");
+    for (const Comparison& comparison : comparisons) {
+        std::cout << std::format("{:<40} {:<10} {:>14.4f} {:>14.4f} {:>+8.1f}%\n", comparison.metric, comparison.stat, comparison.before, comparison.after, comparison.GetChangePercent());
+    }
+}
+
+static void PrintUsage() {
+    std::cerr <<
+        "usage: metrics_compare [options] <before.csv|before.json> <after.csv|after.json>\n"
+        "  --json                  print the comparison as JSON\n"
+        "  --fail-above <percent>  exit with 1 if the mean or p99 of a histogram grew by more than this\n";
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    std::optional<double> failAbovePercent;
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        }
+        else if (arg == "--fail-above" && i + 1 < argc) {
+            failAbovePercent = std::stod(argv[++i]);
+        }
+        else if (arg.starts_with("--")) {
+            PrintUsage();
+            return 1;
+        }
+        else {
+            files.emplace_back(arg);
+        }
+    }
+
+    if (files.size() != 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    const auto before = ReadMetrics(files[0]);
+    const auto after = ReadMetrics(files[1]);
+    if (!before.has_value() || !after.has_value()) {
+        Log::print<ERROR>("Couldn't read {}, it's either missing or not a metrics file", files[before.has_value() ? 1 : 0].string());
+        return 1;
+    }
+
+    const std::vector<Comparison> comparisons = CompareMetrics(before.value(), after.value());
+    if (json) {
+        PrintJson(comparisons);
+    }
+    else {
+        PrintTable(comparisons);
+    }
+
+    bool regressed = false;
+    if (failAbovePercent.has_value()) {
+        for (const Comparison& comparison : comparisons) {
+            if (comparison.type == "histogram" && comparison.stat != "p50" && comparison.GetChangePercent() > failAbovePercent.value()) {
+                Log::print<WARNING>("{} {} grew by {:.1f}%", comparison.metric, comparison.stat, comparison.GetChangePercent());
+                regressed = true;
+            }
+        }
+    }
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+#include "hooking/weapon.h"
+#include "hooking/motion_trace.h"
+
+// Replays controller traces that were recorded with the "Record Motion Trace" option through WeaponMotionAnalyser,
+// so that changes to the attack detection can be compared against the same recorded motion.
+//
+// There's no ground truth in a recording, so swings are approximated from the hand speed: a swing starts once the hand
+// moves faster than --swing-speed and ends after the hand has been slower than that for --swing-gap milliseconds.
+// Attacks that are detected outside of a swing are counted as false positives.
+
+struct ReplayOptions {
+    float swingSpeed = 1.0f;
+    XrTime swingGap = std::chrono::nanoseconds(std::chrono::milliseconds(100)).count();
+    bool csv = false;
+};
+
+struct TraceResult {
+    std::string name;
+    uint64_t samples = 0;
+    uint32_t swings = 0;
+    uint32_t detectedSwings = 0;
+    uint32_t attacks = 0;
+    uint32_t slashes = 0;
+    uint32_t stabs = 0;
+    uint32_t falsePositives = 0;
+    std::vector<double> latenciesMs;
+    std::vector<double> updateTimesNs;
+
+    void Append(const TraceResult& other) {
+        samples += other.samples;
+        swings += other.swings;
+        detectedSwings += other.detectedSwings;
+        attacks += other.attacks;
+        slashes += other.slashes;
+        stabs += other.stabs;
+        falsePositives += other.falsePositives;
+        latenciesMs.insert(latenciesMs.end(), other.latenciesMs.begin(), other.latenciesMs.end());
+        updateTimesNs.insert(updateTimesNs.end(), other.updateTimesNs.begin(), other.updateTimesNs.end());
+    }
+};
+
+static double Mean(const std::vector<double>& values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    return sum / (double)values.size();
+}
+
+static double Percentile(std::vector<double> values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const size_t idx = std::min(values.size() - 1, (size_t)(percentile * (double)(values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+static TraceResult ReplayTrace(const std::string& name, const std::vector<MotionTrace::Sample>& samples, const ReplayOptions& options) {
+    struct HandState {
+        WeaponMotionAnalyser analyser;
+        bool wasAttacking = false;
+        bool inSwing = false;
+        bool swingDetected = false;
+        XrTime swingStart = 0;
+        XrTime lastFastSample = 0;
+    };
+    std::array<HandState, 2> hands;
+
+    TraceResult result = { .name = name };
+    result.updateTimesNs.reserve(samples.size());
+
+    for (const MotionTrace::Sample& sample : samples) {
+        if (sample.hand >= hands.size()) {
+            continue;
+        }
+        HandState& hand = hands[sample.hand];
+
+        const XrSpaceLocation location = MotionTrace::GetHandLocation(sample);
+        const XrSpaceVelocity velocity = MotionTrace::GetHandVelocity(sample);
+        const glm::fmat4 headsetMtx = MotionTrace::GetHeadsetMatrix(sample);
+
+        // same calls as CemuHooks::hook_EnableWeaponAttackSensor
+        const auto updateStart = std::chrono::steady_clock::now();
+        hand.analyser.ResetIfWeaponTypeChanged((WeaponType)sample.weaponType);
+        hand.analyser.Update(location, velocity, headsetMtx, sample.time);
+        const auto updateEnd = std::chrono::steady_clock::now();
+        result.updateTimesNs.emplace_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(updateEnd - updateStart).count());
+        result.samples++;
+
+        // track the swings in the recording
+        if (glm::length(ToGLM(sample.linearVelocity)) >= options.swingSpeed) {
+            if (!hand.inSwing) {
+                hand.inSwing = true;
+                hand.swingDetected = false;
+                hand.swingStart = sample.time;
+                result.swings++;
+            }
+            hand.lastFastSample = sample.time;
+        }
+        else if (hand.inSwing && sample.time - hand.lastFastSample > options.swingGap) {
+            hand.inSwing = false;
+        }
+
+        // compare the start of every detected attack with them
+        const bool isAttacking = hand.analyser.IsAttacking();
+        if (isAttacking && !hand.wasAttacking) {
+            result.attacks++;
+            if (hand.analyser.GetAttackType() == AttackType::Slash) {
+                result.slashes++;
+            }
+            else if (hand.analyser.GetAttackType() == AttackType::Stab) {
+                result.stabs++;
+            }
+
+            if (!hand.inSwing) {
+                result.falsePositives++;
+            }
+            else if (!hand.swingDetected) {
+                hand.swingDetected = true;
+                result.detectedSwings++;
+                result.latenciesMs.emplace_back((double)(sample.time - hand.swingStart) / 1000000.0);
+            }
+        }
+        hand.wasAttacking = isAttacking;
+    }
+    return result;
+}
+
+static void PrintResult(const TraceResult& result, const ReplayOptions& options) {
+    if (options.csv) {
+        std::cout << std::format("{},{},{},{},{},{},{},{},{:.2f},{:.2f},{:.1f},{:.1f}\n",
+            result.name, result.samples, result.swings, result.detectedSwings, result.attacks, result.slashes, result.stabs, result.falsePositives,
+            Mean(result.latenciesMs), Percentile(result.latenciesMs, 0.95), Mean(result.updateTimesNs), Percentile(result.updateTimesNs, 0.99)
+        );
+        return;
+    }
+
+    std::cout << std::format("{}\n", result.name);
+    std::cout << std::format("  samples:          {}\n", result.samples);
+    std::cout << std::format("  swings:           {} ({} detected, {} missed)\n", result.swings, result.detectedSwings, result.swings - result.detectedSwings);
+    std::cout << std::format("  attacks:          {} ({} slashes, {} stabs)\n", result.attacks, result.slashes, result.stabs);
+    std::cout << std::format("  false positives:  {}\n", result.falsePositives);
+    std::cout << std::format("  latency:          {:.2f} ms mean, {:.2f} ms p95\n", Mean(result.latenciesMs), Percentile(result.latenciesMs, 0.95));
+    std::cout << std::format("  cpu per sample:   {:.1f} ns mean, {:.1f} ns p99\n", Mean(result.updateTimesNs), Percentile(result.updateTimesNs, 0.99));
+}
+
+static void PrintUsage() {
+    std::cerr << std::format(
+        "usage: motion_replay [options] <trace{} or directory>...\n"
+        "  --csv                print one line per trace as CSV\n"
+        "  --verbose            print the log messages of the motion analyser\n"
+        "  --swing-speed <m/s>  hand speed at which a swing starts (default 1.0)\n"
+        "  --swing-gap <ms>     time below the swing speed after which a swing ends (default 100)\n",
+        MotionTrace::FILE_EXTENSION
+    );
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    std::vector<std::filesystem::path> traces;
+
+    // only warnings and errors are printed unless --verbose is passed
+    for (LogType type : Log::ALL_LOG_TYPES) {
+        Log::setLogTypeEnabled(type, false);
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--csv") {
+            options.csv = true;
+        }
+        else if (arg == "--verbose") {
+            for (LogType type : Log::ALL_LOG_TYPES) {
+                Log::setLogTypeEnabled(type, true);
+            }
+        }
+        else if (arg == "--swing-speed" && i + 1 < argc) {
+            options.swingSpeed = std::stof(argv[++i]);
+        }
+        else if (arg == "--swing-gap" && i + 1 < argc) {
+            options.swingGap = std::chrono::nanoseconds(std::chrono::milliseconds(std::stoll(argv[++i]))).count();
+        }
+        else if (arg.starts_with("--")) {
+            PrintUsage();
+            return 1;
+        }
+        else if (std::filesystem::is_directory(arg)) {
+            // sorted, so that batch runs always list the traces in the same order
+            std::vector<std::filesystem::path> dirTraces;
+            for (const auto& entry : std::filesystem::directory_iterator(arg)) {
+                if (entry.is_regular_file() && entry.path().extension().string() == MotionTrace::FILE_EXTENSION) {
+                    dirTraces.emplace_back(entry.path());
+                }
+            }
+            std::ranges::sort(dirTraces);
+            traces.insert(traces.end(), dirTraces.begin(), dirTraces.end());
+        }
+        else {
+            traces.emplace_back(arg);
+        }
+    }
+
+    if (traces.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (options.csv) {
+        std::cout << "trace,samples,swings,detected_swings,attacks,slashes,stabs,false_positives,latency_mean_ms,latency_p95_ms,update_mean_ns,update_p99_ns\n";
+    }
+
+    TraceResult total = { .name = "total" };
+    bool failed = false;
+    for (const auto& path : traces) {
+        const auto samples = MotionTrace::Read(path);
+        if (!samples.has_value()) {
+            Log::print<ERROR>("Couldn't read {}, it's either missing or not a compatible motion trace", path.string());
+            failed = true;
+            continue;
+        }
+
+        const TraceResult result = ReplayTrace(path.filename().string(), samples.value(), options);
+        PrintResult(result, options);
+        total.Append(result);
+    }
+
+    if (traces.size() > 1) {
+        PrintResult(total, options);
+    }
+    return failed ? 1 : 0;
+}